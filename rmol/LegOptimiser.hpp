@@ -0,0 +1,232 @@
+#ifndef __RMOL_LEGOPTIMISER_HPP
+#define __RMOL_LEGOPTIMISER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
+// StdAir
+#include <stdair/stdair_maths_types.hpp>
+// RMOL
+#include <rmol/OptimizationType.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Work buffers of the leg optimisations.
+   *
+   * The buffers only grow, so that, once a workspace has been used for
+   * the largest problem (number of classes, capacity and number of
+   * draws), the following optimisations do not allocate any memory.
+   * A workspace must not be shared by concurrent optimisations.
+   */
+  class LegOptimisationWorkspace {
+    friend class LegOptimiser;
+  public:
+    /** Make the buffers large enough for the given problem size, so that
+        the next optimisations of at most that size do not allocate. */
+    void reserve (const unsigned int iNbOfClasses,
+                  const unsigned int iCapacity,
+                  const stdair::NbOfSamples_T iNbOfSamples);
+
+  private:
+    /** Define a list of values. */
+    typedef std::vector<double> ValueList_T;
+
+    /** Define a list of indices. */
+    typedef std::vector<unsigned int> IndexList_T;
+
+  private:
+    /** Cumulated protections, by class. */
+    ValueList_T _protectionList;
+
+    /** Bid prices, by seat. */
+    ValueList_T _bidPriceList;
+
+    /** Current EMSR value of each class (EMSR), or cumulative
+        distribution of the demand of the current class (DP). */
+    ValueList_T _classValueList;
+
+    /** Rank of the next EMSR value of each class (EMSR). */
+    IndexList_T _rankList;
+
+    /** Partial sums of the demand draws (MC), or value function of the
+        previous class (DP). */
+    ValueList_T _partialSumList;
+
+    /** Demand draws of the current class (MC), or value function of the
+        current class (DP). */
+    ValueList_T _sampleList;
+  };
+
+  /**
+   * @brief Packed description of independent leg-cabin problems.
+   *
+   * The classes of all the problems are stored one after the other, in
+   * the same way for the yields, the demand means and the demand
+   * standard deviations: the classes of the problem i are the ones
+   * within [offset(i), offset(i+1)). The arrays are owned by the caller.
+   */
+  struct LegOptimisationBatch {
+    /** Number of problems (N). */
+    unsigned int _nbOfProblems;
+
+    /** Offsets of the classes of the problems (N+1 values, the first one
+        being 0 and the last one the total number of classes). */
+    const unsigned int* _classOffsetList;
+
+    /** Yields of the classes. */
+    const double* _yieldList;
+
+    /** Demand means of the classes. */
+    const double* _meanList;
+
+    /** Demand standard deviations of the classes. */
+    const double* _stdDevList;
+
+    /** Capacities of the problems (N values). */
+    const unsigned int* _capacityList;
+  };
+
+  /**
+   * @brief Optimisation of a single leg-cabin given by plain arrays.
+   *
+   * The optimisation does not need any BOM tree: the classes are given
+   * by their yields and by the means and standard deviations of their
+   * (independent, normally distributed) demands, from the highest class
+   * to the lowest one, and the results are written into caller-provided
+   * buffers. Apart from the workspace, there is no state, so that
+   * several optimisations may run concurrently, each one with its own
+   * workspace.
+   */
+  class LegOptimiser {
+  public:
+    /**
+     * Optimise the leg-cabin with the given algorithm.
+     *
+     * The cumulated protection of the class j is the number of seats
+     * protected for the classes 0 to j against the lower classes (the
+     * one of the lowest class being the capacity). The bid price of the
+     * seat k (k being lower than the capacity) is the opportunity cost
+     * of the (k+1)-th remaining seat. EMSR-a and EMSR-b only give
+     * protections (bounded by the capacity, and non-decreasing from the
+     * highest class): a seat is then priced at the yield of the lowest
+     * class available when it is the last remaining one.
+     *
+     * @param const OptimizationType::EN_OptimizationType& Algorithm:
+     *        OPT_MC, OPT_DP, HEUR_EMSR, HEUR_EMSRA or HEUR_EMSRB.
+     * @param const unsigned int Number of classes (n).
+     * @param const double* Yields of the n classes (positive and
+     *        strictly decreasing).
+     * @param const double* Demand means of the n classes.
+     * @param const double* Demand standard deviations of the n classes.
+     * @param const unsigned int Capacity (C).
+     * @param const stdair::NbOfSamples_T Number of draws (OPT_MC only).
+     * @param LegOptimisationWorkspace& Work buffers.
+     * @param double* Cumulated protections of the n classes (may be NULL).
+     * @param double* Bid prices of the C seats (may be NULL).
+     * @exception OptimisationException when the algorithm is not
+     *            supported or when the classes are not consistent.
+     */
+    static void optimise (const OptimizationType::EN_OptimizationType&,
+                          const unsigned int iNbOfClasses,
+                          const double* iYieldList,
+                          const double* iMeanList,
+                          const double* iStdDevList,
+                          const unsigned int iCapacity,
+                          const stdair::NbOfSamples_T iNbOfSamples,
+                          LegOptimisationWorkspace&,
+                          double* oProtectionList,
+                          double* oBidPriceList);
+
+    /**
+     * Optimise independent leg-cabins with the given algorithm.
+     *
+     * The problems are split into contiguous blocks, one block (with its
+     * own workspace) per thread. As the Monte-Carlo draws of a problem
+     * do not depend on the other problems, the results do not depend on
+     * the number of threads.
+     *
+     * @param const LegOptimisationBatch& Problems (N).
+     * @param const OptimizationType::EN_OptimizationType& Algorithm (see
+     *        optimise()).
+     * @param const stdair::NbOfSamples_T Number of draws (OPT_MC only).
+     * @param const unsigned int Maximal capacity (Cmax), i.e., the number
+     *        of columns of the bid-price matrix.
+     * @param const unsigned int Maximal number of threads.
+     * @param double* Cumulated protections of the classes, stored as the
+     *        classes of the batch (may be NULL).
+     * @param double* Bid-price matrix (N rows of Cmax values, the seats
+     *        beyond the capacity of a problem being priced 0; may be
+     *        NULL).
+     * @exception OptimisationException when a problem is not consistent
+     *            or exceeds the maximal capacity.
+     */
+    static void optimiseBatch (const LegOptimisationBatch&,
+                               const OptimizationType::EN_OptimizationType&,
+                               const stdair::NbOfSamples_T iNbOfSamples,
+                               const unsigned int iMaxCapacity,
+                               const unsigned int iNbOfThreads,
+                               double* oProtectionList,
+                               double* oBidPriceMatrix);
+
+  private:
+    /** Optimise with the EMSR heuristic. */
+    static void optimiseByEmsr (const unsigned int iNbOfClasses,
+                                const double* iYieldList,
+                                const double* iMeanList,
+                                const double* iStdDevList,
+                                const unsigned int iCapacity,
+                                LegOptimisationWorkspace&);
+
+    /** Optimise with the EMSR-a heuristic. */
+    static void optimiseByEmsrA (const unsigned int iNbOfClasses,
+                                 const double* iYieldList,
+                                 const double* iMeanList,
+                                 const double* iStdDevList,
+                                 LegOptimisationWorkspace&);
+
+    /** Optimise with the EMSR-b heuristic. */
+    static void optimiseByEmsrB (const unsigned int iNbOfClasses,
+                                 const double* iYieldList,
+                                 const double* iMeanList,
+                                 const double* iStdDevList,
+                                 LegOptimisationWorkspace&);
+
+    /** Optimise with the Monte-Carlo integration algorithm, the demands
+        of each class being drawn with the seed the BOM optimiser gives
+        to the corresponding booking class. */
+    static void optimiseByMC (const unsigned int iNbOfClasses,
+                              const double* iYieldList,
+                              const double* iMeanList,
+                              const double* iStdDevList,
+                              const unsigned int iCapacity,
+                              const stdair::NbOfSamples_T iNbOfSamples,
+                              LegOptimisationWorkspace&);
+
+    /** Optimise with the (static) dynamic programming algorithm, on the
+        discretised demands. */
+    static void optimiseByDP (const unsigned int iNbOfClasses,
+                              const double* iYieldList,
+                              const double* iMeanList,
+                              const double* iStdDevList,
+                              const unsigned int iCapacity,
+                              LegOptimisationWorkspace&);
+
+    /** Keep the protections given by the quantiles of the EMSR-a and
+        EMSR-b heuristics within [0, C], and non-decreasing from the
+        highest class to the lowest one. */
+    static void boundProtections (const unsigned int iNbOfClasses,
+                                  const unsigned int iCapacity,
+                                  LegOptimisationWorkspace&);
+
+    /** Derive the bid prices from the protections, for the heuristics
+        which only give protections. */
+    static void computeBidPricesFromProtections (const unsigned int,
+                                                 const double* iYieldList,
+                                                 const unsigned int iCapacity,
+                                                 LegOptimisationWorkspace&);
+  };
+}
+#endif // __RMOL_LEGOPTIMISER_HPP
@@ -0,0 +1,101 @@
+#ifndef __RMOL_OPTIMISATIONCONTROL_HPP
+#define __RMOL_OPTIMISATIONCONTROL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <chrono>
+
+namespace RMOL {
+
+  /**
+   * @brief Control of a running optimisation: cancellation and deadline.
+   *
+   * The optimisation checks the control before forecasting, between the
+   * leg-cabins of the flight-dates it optimises, between the network
+   * iterations (never within one, so that the bid prices of the network
+   * all come from the same iteration) and within the network linear
+   * programs. Once a stop has been requested (cancellation or
+   * deadline), nothing more is optimised: the leg-cabins which were not
+   * reached keep the bid prices of their previous (complete)
+   * optimisation, the network iterations stop after the last complete
+   * one, and an interrupted linear program leaves the bid prices
+   * untouched. The optimisation then records that it was interrupted.
+   *
+   * The deadline must be set before the optimisation is launched;
+   * cancel() may be called from any thread. The control must outlive
+   * the optimisation.
+   */
+  class OptimisationControl {
+  public:
+    /** Define the clock of the deadlines. */
+    typedef std::chrono::steady_clock Clock_T;
+
+  public:
+    // ////// Getters //////
+    /** Whether the optimisation has been cancelled. */
+    bool isCancelled() const {
+      return _isCancelled.load();
+    }
+
+    /** Whether a deadline is set. */
+    bool hasDeadline() const {
+      return _hasDeadline;
+    }
+
+    /** Whether the optimisation must stop, i.e., whether it has been
+        cancelled or its deadline has passed. */
+    bool isStopRequested() const;
+
+    /** Whether the optimisation stopped before completion. */
+    bool isInterrupted() const {
+      return _isInterrupted.load();
+    }
+
+  public:
+    // ////// Setters //////
+    /** Set the deadline of the optimisation. */
+    void setDeadline (const Clock_T::time_point&);
+
+    /** Set the deadline of the optimisation, from now on. */
+    void setTimeBudget (const Clock_T::duration&);
+
+    /** Cancel the optimisation. */
+    void cancel() {
+      _isCancelled.store (true);
+    }
+
+    /** Record that the optimisation stopped before completion. */
+    void setInterrupted() {
+      _isInterrupted.store (true);
+    }
+
+  public:
+    /** Constructor (no deadline). */
+    OptimisationControl();
+
+    /** Destructor. */
+    ~OptimisationControl();
+
+  private:
+    /** Copy constructor (not implemented, as the control is shared by the
+        caller and the optimisation). */
+    OptimisationControl (const OptimisationControl&);
+
+  private:
+    /** Whether the optimisation has been cancelled. */
+    std::atomic<bool> _isCancelled;
+
+    /** Whether the optimisation stopped before completion. */
+    std::atomic<bool> _isInterrupted;
+
+    /** Whether a deadline is set. */
+    bool _hasDeadline;
+
+    /** Deadline of the optimisation. */
+    Clock_T::time_point _deadline;
+  };
+}
+#endif // __RMOL_OPTIMISATIONCONTROL_HPP
@@ -6,6 +6,8 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <string>
+#include <vector>
+#include <future>
 // StdAir
 #include <stdair/stdair_basic_types.hpp>
 #include <stdair/stdair_inventory_types.hpp>
@@ -31,15 +33,53 @@ namespace stdair {
   class Inventory;
   class OnDDate;
   class SegmentCabin;
+  class LegCabin;
 }
 
 namespace RMOL {
 
   /// Forward declarations
   class RMOL_ServiceContext;
+  struct DCPEventIndex;
+  struct LegCabinImageTable;
+  struct OnDIncidenceMatrix;
+  struct OnDForecastTable;
+  struct LegOptimisationBatch;
+  class OptimisationControl;
+  struct NetworkIterationReport;
+  struct BidPriceAccelerator;
 
   /**
    * @brief Interface for the RMOL Services.
+   *
+   * Thread safety. Once loaded, a service may serve requests from
+   * several threads:
+   * <ul>
+   *   <li>the leg-cabin optimisations (optimize() on a given leg-cabin)
+   *       and the flight-date optimisations without partnership
+   *       (optimise() with the NONE partnership technique) only read
+   *       the parameters of the service, and only write into the given
+   *       leg-cabin or flight-date; each call works in its own workspace.
+   *       They may therefore run concurrently on distinct leg-cabins or
+   *       flight-dates. The same goes for the batch optimisations
+   *       (optimiseBatch()), which only write into the given arrays;</li>
+   *   <li>all the other business methods, which read or write the state
+   *       of the service (e.g., the forecast date, the lazily built
+   *       indices) or the BOM tree as a whole (e.g., the network
+   *       optimisations), are serialised: concurrent calls are executed
+   *       one after the other;</li>
+   *   <li>the StdAir logger not being synchronised, the methods which
+   *       may run concurrently do not log (the optimisation of the dummy
+   *       leg-cabin, serialised, logs its results though). Only the
+   *       serialised methods log, and the caller must not log from other
+   *       threads while requests are served;</li>
+   *   <li>the parameters (e.g., setNbOfThreads()) must be set before
+   *       the requests are served, and the references returned by the
+   *       getters (e.g., getNetworkIterationReport()) are valid only
+   *       until the next serialised call.</li>
+   * </ul>
+   * The caller remains responsible for not optimising a same leg-cabin
+   * or flight-date from several threads at once.
    */
   class RMOL_Service {
   public:
@@ -128,6 +168,117 @@ namespace RMOL {
     ~RMOL_Service();
 
 
+  public:
+    // ////////////////// Parameters //////////////////
+    /**
+     * Set the number of threads used by the parallel algorithms, e.g.,
+     * the forecasting of the segment-cabins of a flight-date.
+     *
+     * The results do not depend on the number of threads. By default,
+     * a single thread is used, i.e., everything is executed serially.
+     *
+     * @param const unsigned int Number of threads. Zero means one thread
+     *        per hardware core.
+     */
+    void setNbOfThreads (const unsigned int);
+
+    /**
+     * Get the number of threads used by the parallel algorithms.
+     */
+    unsigned int getNbOfThreads() const;
+
+    /**
+     * Reset the forecast state, i.e., the sliding windows of the
+     * historical bookings of the similar segments and the cache of the
+     * segment-cabin forecasts.
+     *
+     * Between two forecasts, only the similar segments which have
+     * passed a DCP interval in the meantime are read from the snapshot
+     * tables, and a segment-cabin is not forecasted twice on the same
+     * snapshots with the same methods. The forecast state must therefore
+     * be reset whenever the snapshots of the departed similar segments
+     * are modified other than by the daily recording. It is reset
+     * automatically when the BOM tree is (re-)built.
+     */
+    void resetForecastState();
+
+    /**
+     * Record that the snapshots have been updated (e.g., by the daily
+     * recording), so that the segment-cabins are forecasted again, even
+     * on the same day with the same methods. The sliding windows of the
+     * historical bookings are kept, as the snapshots of the departed
+     * similar segments do not change.
+     */
+    void notifySnapshotUpdate();
+
+    /**
+     * Get the report of the last network optimisation with advanced RM
+     * cooperation, i.e., its number of iterations and whether the bid
+     * prices converged.
+     */
+    const NetworkIterationReport& getNetworkIterationReport() const;
+
+    /**
+     * Set the acceleration of the iterations on the bid prices of the
+     * network (read by the demand projection and exchanged between
+     * partners), during the network optimisation with advanced RM
+     * cooperation (see BidPriceAccelerator). By default, the iterations
+     * are not accelerated.
+     *
+     * @param const BidPriceAccelerationMethod_T& Acceleration method.
+     * @param const double Damping factor, within ]0, 1].
+     */
+    void setBidPriceAcceleration (const BidPriceAccelerationMethod_T&,
+                                  const double iDampingFactor);
+
+    /**
+     * Get the acceleration method of the iterations on the bid prices
+     * of the network.
+     */
+    BidPriceAccelerationMethod_T getBidPriceAccelerationMethod() const;
+
+    /**
+     * Get the damping factor of the accelerated iterations on the bid
+     * prices of the network.
+     */
+    double getBidPriceDampingFactor() const;
+
+    /**
+     * Set the method of the network optimisation with advanced RM
+     * cooperation (A-RMC partnership technique). By default, the leg
+     * optimisations are iterated on the bid prices exchanged between
+     * partners (see optimiseOnDUsingAdvancedRMCooperation()); the
+     * deterministic linear program of the network gives the bid prices
+     * in a single resolution instead, and the randomised linear program
+     * averages them over demand scenarios (see
+     * optimiseOnDUsingNetworkLP()).
+     *
+     * @param const NetworkOptimisationMethod_T& Network optimisation method.
+     */
+    void setNetworkOptimisationMethod (const NetworkOptimisationMethod_T&);
+
+    /**
+     * Get the method of the network optimisation with advanced RM
+     * cooperation.
+     */
+    NetworkOptimisationMethod_T getNetworkOptimisationMethod() const;
+
+    /**
+     * Set the number of demand scenarios of the randomised linear program
+     * of the network (see setNetworkOptimisationMethod()).
+     *
+     * @param const stdair::NbOfSamples_T& Number of scenarios (at least
+     *        one).
+     */
+    void setNbOfRLPScenarios (const stdair::NbOfSamples_T&);
+
+    /**
+     * Get the number of demand scenarios of the randomised linear program
+     * of the network.
+     */
+    stdair::NbOfSamples_T getNbOfRLPScenarios() const;
+
+
   public:
     // /////////////// Business Methods /////////////////
     /**
@@ -149,11 +300,41 @@ namespace RMOL {
     void buildComplementaryLinks (stdair::BomRoot&); 
 
     /**
-     * Optimization.
+     * Optimization of the dummy leg-cabin of the BOM tree (serialised, see
+     * the class documentation).
      */
     template <unsigned int I>
     void optimize (const stdair::NbOfSamples_T iDraws = 0);
 
+    /**
+     * Optimization of the given leg-cabin (reentrant: the leg-cabin is the
+     * only object written, so that distinct leg-cabins may be optimised
+     * concurrently).
+     */
+    template <unsigned int I>
+    void optimize (stdair::LegCabin&,
+                   const stdair::NbOfSamples_T iDraws = 0) const;
+
+    /**
+     * Optimise a batch of independent leg-cabin problems, given by plain
+     * arrays (see LegOptimiser::optimiseBatch()), on the threads of the
+     * service. No BOM tree is involved, so that the call is reentrant.
+     *
+     * @param const LegOptimisationBatch& Problems (N).
+     * @param const OptimizationType::EN_OptimizationType& Algorithm.
+     * @param const stdair::NbOfSamples_T Number of draws (Monte-Carlo).
+     * @param const unsigned int Maximal capacity (Cmax).
+     * @param double* Cumulated protections, stored as the classes of the
+     *        batch (may be NULL).
+     * @param double* N x Cmax bid-price matrix (may be NULL).
+     */
+    void optimiseBatch (const LegOptimisationBatch&,
+                        const OptimizationType::EN_OptimizationType&,
+                        const stdair::NbOfSamples_T iDraws,
+                        const unsigned int iMaxCapacity,
+                        double* oProtectionList,
+                        double* oBidPriceMatrix) const;
+
     /**
      * Retrieve one sample segment-cabin of the dummy inventory of "XX".
      * @param const bool Boolean to choose the sample segment-cabin.
@@ -166,6 +347,11 @@ namespace RMOL {
 
     /**
      * Optimise (revenue management) an flight-date/network-date
+     *
+     * Without partnership, only the given flight-date is written, so that
+     * distinct flight-dates may be optimised concurrently; with
+     * partnerships, the whole network is optimised, and the call is
+     * serialised (see the class documentation).
      */
     bool optimise (stdair::FlightDate&, const stdair::DateTime_T&,
                    const stdair::UnconstrainingMethod&,
@@ -174,6 +360,33 @@ namespace RMOL {
                    const stdair::OptimisationMethod&,
                    const stdair::PartnershipTechnique&);
 
+    /**
+     * Optimise (revenue management) a flight-date/network-date
+     * asynchronously (see optimise()), on a dedicated thread.
+     *
+     * The given control (which must outlive the optimisation) is checked
+     * before the forecast, between the leg-cabins of the flight-dates,
+     * between the network iterations and within the network linear
+     * programs. When a stop is requested (cancellation or deadline), the
+     * optimisation returns as soon as possible with the best complete
+     * result available: the leg-cabins of a flight-date which were not
+     * reached keep the bid prices of their previous optimisation, the
+     * network keeps the bid prices of its last complete iteration, and
+     * an interrupted linear program leaves them untouched. The control
+     * then tells whether the optimisation was interrupted.
+     *
+     * @return std::future<bool> The result of optimise(); an exception
+     *         thrown by the optimisation is re-thrown by get().
+     */
+    std::future<bool> optimiseAsync (stdair::FlightDate&,
+                                     const stdair::DateTime_T&,
+                                     const stdair::UnconstrainingMethod&,
+                                     const stdair::ForecastingMethod&,
+                                     const stdair::PreOptimisationMethod&,
+                                     const stdair::OptimisationMethod&,
+                                     const stdair::PartnershipTechnique&,
+                                     OptimisationControl&);
+
     /**
      * Forecaster
      */
@@ -273,20 +486,51 @@ namespace RMOL {
      * Optimiser
      *
      * O&D-based optimisation (using demand aggregation or demand aggregation).
+     * When a control is given, it is checked between the flight-dates.
      */
-    void optimiseOnD (const stdair::DateTime_T&);
+    void optimiseOnD (const stdair::DateTime_T&,
+                      OptimisationControl* ioControl_ptr = NULL);
 
     /**
      * O&D-based optimisation using displacement-adjusted yield.
+     * When a control is given, it is checked between the iterations.
      */
-    void optimiseOnDUsingRMCooperation (const stdair::DateTime_T&);
+    void optimiseOnDUsingRMCooperation (const stdair::DateTime_T&,
+                                        OptimisationControl* ioControl_ptr =
+                                        NULL);
 
     /**
      * Advanced version of O&D-based optimisation using
      * displacement-adjusted yield.
      * Network optimisation instead of separate inventory optimisation.
+     * When a control is given, it is checked between the network
+     * iterations (a stop keeps the bid prices of the last complete one).
+     */
+    void optimiseOnDUsingAdvancedRMCooperation (const stdair::DateTime_T&,
+                                                OptimisationControl*
+                                                ioControl_ptr = NULL);
+
+    /**
+     * Network optimisation using the deterministic linear program of the
+     * O&D-dates hitting a DCP (see NetworkLP), the bid prices of the
+     * leg-cabins being the shadow prices of their capacities. The program
+     * is solved once, starting from the optimal basis of the former RM
+     * events (warm start), and the bid prices are sent to the partners.
+     *
+     * With the randomised linear program, the bid prices are the averages
+     * of the shadow prices of the programs of demand scenarios drawn from
+     * the O&D forecasts, which are solved concurrently, from the optimal
+     * basis of the deterministic program.
+     *
+     * When a control is given, it is checked within the resolutions: a
+     * stop leaves the bid prices untouched.
+     *
+     * @return bool Whether the program was solved to optimality (the bid
+     *         prices are left untouched otherwise).
      */
-    void optimiseOnDUsingAdvancedRMCooperation (const stdair::DateTime_T&);
+    bool optimiseOnDUsingNetworkLP (const stdair::DateTime_T&,
+                                    OptimisationControl* ioControl_ptr =
+                                    NULL);
 
     /**
      * Update Bid Price (BP) and send to partners
@@ -393,27 +637,96 @@ namespace RMOL {
     /**
      * Single resource optimization using the Monte Carlo algorithm.
      */
-    void optimalOptimisationByMCIntegration (const stdair::NbOfSamples_T&);
+    void optimalOptimisationByMCIntegration (const stdair::NbOfSamples_T&,
+                                             stdair::LegCabin&) const;
     
     /**
      * Single resource optimization using dynamic programming.
      */
-    void optimalOptimisationByDP();
+    void optimalOptimisationByDP (stdair::LegCabin&) const;
 
     /**
      * Single resource optimization using EMSR heuristic.
      */
-    void heuristicOptimisationByEmsr();
+    void heuristicOptimisationByEmsr (stdair::LegCabin&) const;
 
     /**
      * Single resource optimization using EMSR-a heuristic.
      */
-    void heuristicOptimisationByEmsrA();
+    void heuristicOptimisationByEmsrA (stdair::LegCabin&) const;
 
     /**
      * Single resource optimization using EMSR-b heuristic.
      */
-    void heuristicOptimisationByEmsrB();
+    void heuristicOptimisationByEmsrB (stdair::LegCabin&) const;
+
+    /**
+     * Retrieve the dummy leg-cabin of the (persistent) BOM tree.
+     */
+    stdair::LegCabin& retrieveDummyLegCabin();
+
+    /**
+     * Optimise a flight-date/network-date (see optimise()), under the
+     * given control, if any.
+     */
+    bool optimise (stdair::FlightDate&, const stdair::DateTime_T&,
+                   const stdair::UnconstrainingMethod&,
+                   const stdair::ForecastingMethod&,
+                   const stdair::PreOptimisationMethod&,
+                   const stdair::OptimisationMethod&,
+                   const stdair::PartnershipTechnique&,
+                   OptimisationControl* ioControl_ptr);
+
+    /**
+     * Get the calendar index of the flight-dates and O&D-dates hitting a
+     * DCP, building it from the given BOM tree when needed.
+     */
+    const DCPEventIndex& getDCPEventIndex (const stdair::BomRoot&);
+
+    /**
+     * Get the table linking the leg-cabins to their images held by the
+     * marketing partners, building it from the given BOM tree when
+     * needed.
+     */
+    const LegCabinImageTable& getLegCabinImageTable (const stdair::BomRoot&);
+
+    /**
+     * Get the incidence matrix between the segment-cabins of the
+     * O&D-dates and the leg-cabins, building it from the given BOM tree
+     * when needed.
+     */
+    const OnDIncidenceMatrix& getOnDIncidenceMatrix (const stdair::BomRoot&);
+
+    /**
+     * Get the table of the O&D forecast parameters, by DTD, building it
+     * when needed.
+     */
+    const OnDForecastTable& getOnDForecastTable();
+
+    /**
+     * Update the bid prices of the given flight-dates and send them to
+     * the partners. The flight-dates are processed concurrently, as each
+     * one only writes into its own leg-cabins and into their images.
+     */
+    void updateBidPrice (const std::vector<stdair::FlightDate*>&,
+                         stdair::BomRoot&);
+
+    /**
+     * Update the bid prices of the given flight-dates, accelerate the
+     * convergence of the bid prices of all their leg-cabins with the
+     * given accelerator, and send them to the partners.
+     */
+    void updateBidPrice (const std::vector<stdair::FlightDate*>&,
+                         stdair::BomRoot&, BidPriceAccelerator&);
+
+    /**
+     * Project the demand of the given O&D-dates onto the leg-cabins,
+     * using dynamic yield proration. The prorated demands are computed
+     * concurrently, then added to the leg-cabins in the order of the
+     * O&D-dates.
+     */
+    void projectOnDDemandOnLegCabinsUsingDYP
+    (const std::vector<stdair::OnDDate*>&);
 
 
   private:
@@ -422,9 +735,6 @@ namespace RMOL {
      * Service Context.
      */
     RMOL_ServiceContext* _rmolServiceContext;
-
-    /** Forecaster : previous forecast date. */
-    stdair::Date_T _previousForecastDate;
   };
 }
 #endif // __RMOL_SVC_RMOL_SERVICE_HPP
@@ -178,6 +178,35 @@ namespace RMOL {
     /** Define the vector of censorship flags. */
   typedef std::vector<stdair::Flag_T> FlagVector_T;
 
+  /** Define the index of a DCP within the default DCP list (0 being the
+      furthest DCP from the departure). */
+  typedef unsigned short DCPIndex_T;
+
+  /** Define the stamp of the state of the snapshot tables, incremented
+      on each snapshot update. */
+  typedef unsigned long SnapshotStamp_T;
+
+  /** Define a dense vector of factors (e.g., sell-up or dispatching
+      factors), or of demand figures, indexed by class. */
+  typedef std::vector<double> ClassFactorVector_T;
+
+  /** Define the acceleration methods of the iterations on the bid prices
+      of the network (network optimisation with advanced RM
+      cooperation). */
+  typedef enum {
+    BP_ACCELERATION_NONE = 0, // Plain fixed-point iterations
+    BP_ACCELERATION_DAMPED,   // Damped fixed-point iterations
+    BP_ACCELERATION_ANDERSON  // Anderson acceleration (depth 1)
+  } BidPriceAccelerationMethod_T;
+
+  /** Define the methods of the network optimisation with advanced RM
+      cooperation (A-RMC partnership technique). */
+  typedef enum {
+    NETWORK_OPTIMISATION_ITERATIVE = 0, // Iterations of leg optimisations
+    NETWORK_OPTIMISATION_DLP,           // Deterministic linear program
+    NETWORK_OPTIMISATION_RLP            // Randomised linear program
+  } NetworkOptimisationMethod_T;
+
   /** Define the map between booking class and demand. */
   typedef std::map<stdair::BookingClass*, stdair::MeanStdDevPair_T> BookingClassMeanStdDevPairMap_T;
 }
@@ -29,4 +29,40 @@ namespace RMOL {
   
   /** Default negative value used to initialze a double variable. */
   const double DEFAULT_INITIALIZER_DOUBLE_NEGATIVE = -10.0;
+
+  /** Default number of threads for the parallel algorithms
+      (1 means that everything is executed serially). */
+  const unsigned int DEFAULT_NUMBER_OF_THREADS = 1;
+
+  /** Default number of similar segments (departed, or which have passed
+      the DCP interval) used to forecast the demand of a DCP interval. */
+  const unsigned short DEFAULT_HISTORICAL_BOOKING_WINDOW_SIZE = 52;
+
+  /** Default maximal number of iterations (sweeps over the whole network)
+      of the network optimisation with advanced RM cooperation. */
+  const unsigned short DEFAULT_MAX_NB_OF_NETWORK_ITERATIONS = 50;
+
+  /** Default maximal number of iterations (sweeps over an inventory) of
+      the O&D optimisation with RM cooperation. As with the advanced RM
+      cooperation, the iterations stop once the bid price variation is
+      under DEFAULT_STOPPING_CRITERION. */
+  const unsigned short DEFAULT_MAX_NB_OF_RMC_ITERATIONS = 10;
+
+  /** Default acceleration method of the iterations on the bid prices
+      exchanged between partners (plain fixed-point iterations). */
+  const BidPriceAccelerationMethod_T DEFAULT_BID_PRICE_ACCELERATION_METHOD =
+    BP_ACCELERATION_NONE;
+
+  /** Default damping factor of the accelerated iterations on the bid
+      prices exchanged between partners. */
+  const double DEFAULT_BID_PRICE_DAMPING_FACTOR = 0.5;
+
+  /** Default method of the network optimisation with advanced RM
+      cooperation (iterations of leg optimisations). */
+  const NetworkOptimisationMethod_T DEFAULT_NETWORK_OPTIMISATION_METHOD =
+    NETWORK_OPTIMISATION_ITERATIVE;
+
+  /** Default number of demand scenarios of the randomised linear program
+      of the network. */
+  const stdair::NbOfSamples_T DEFAULT_NB_OF_RLP_SCENARIOS = 30;
 }
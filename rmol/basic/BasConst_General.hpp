@@ -6,6 +6,8 @@
 // //////////////////////////////////////////////////////////////////////
 // StdAir
 #include <stdair/stdair_types.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
 
 namespace RMOL {
 
@@ -25,5 +27,39 @@ namespace RMOL {
 
   /** Default negative value used to initialze a double variable. */
   extern const double DEFAULT_INITIALIZER_DOUBLE_NEGATIVE;
+
+  /** Default number of threads for the parallel algorithms
+      (1 means that everything is executed serially). */
+  extern const unsigned int DEFAULT_NUMBER_OF_THREADS;
+
+  /** Default number of similar segments (departed, or which have passed
+      the DCP interval) used to forecast the demand of a DCP interval. */
+  extern const unsigned short DEFAULT_HISTORICAL_BOOKING_WINDOW_SIZE;
+
+  /** Default maximal number of iterations (sweeps over the whole network)
+      of the network optimisation with advanced RM cooperation. */
+  extern const unsigned short DEFAULT_MAX_NB_OF_NETWORK_ITERATIONS;
+
+  /** Default maximal number of iterations (sweeps over an inventory) of
+      the O&D optimisation with RM cooperation. As with the advanced RM
+      cooperation, the iterations stop once the bid price variation is
+      under DEFAULT_STOPPING_CRITERION. */
+  extern const unsigned short DEFAULT_MAX_NB_OF_RMC_ITERATIONS;
+
+  /** Default acceleration method of the iterations on the bid prices
+      exchanged between partners. */
+  extern const BidPriceAccelerationMethod_T DEFAULT_BID_PRICE_ACCELERATION_METHOD;
+
+  /** Default damping factor of the accelerated iterations on the bid
+      prices exchanged between partners. */
+  extern const double DEFAULT_BID_PRICE_DAMPING_FACTOR;
+
+  /** Default method of the network optimisation with advanced RM
+      cooperation. */
+  extern const NetworkOptimisationMethod_T DEFAULT_NETWORK_OPTIMISATION_METHOD;
+
+  /** Default number of demand scenarios of the randomised linear program
+      of the network. */
+  extern const stdair::NbOfSamples_T DEFAULT_NB_OF_RLP_SCENARIOS;
 }
 #endif // __RMOL_BAS_BASCONST_GENERAL_HPP
@@ -0,0 +1,36 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// RMOL
+#include <rmol/OptimisationControl.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  OptimisationControl::OptimisationControl ()
+    : _isCancelled (false), _isInterrupted (false), _hasDeadline (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  OptimisationControl::~OptimisationControl () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool OptimisationControl::isStopRequested() const {
+    if (_isCancelled.load() == true) {
+      return true;
+    }
+    return (_hasDeadline == true && Clock_T::now() >= _deadline);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OptimisationControl::setDeadline (const Clock_T::time_point& iDeadline) {
+    _deadline = iDeadline;
+    _hasDeadline = true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OptimisationControl::setTimeBudget (const Clock_T::duration& iBudget) {
+    setDeadline (Clock_T::now() + iBudget);
+  }
+}
@@ -0,0 +1,282 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <cmath>
+// RMOL
+#include <rmol/bom/BasisFactorisation.hpp>
+
+namespace RMOL {
+
+  namespace {
+    /** Smallest absolute value of an acceptable pivot. */
+    const double LU_PIVOT_TOLERANCE = 1e-9;
+
+    /** Absolute values under which the values of the factors are
+        dropped. */
+    const double LU_DROP_TOLERANCE = 1e-14;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BasisFactorisation::BasisFactorisation () : _nbOfRows (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BasisFactorisation::~BasisFactorisation () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int BasisFactorisation::getNbOfNonZeros() const {
+    return (_lowerValueList.size() + _diagonalList.size()
+            + _upperValueList.size() + _etaPivotList.size()
+            + _etaValueList.size());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BasisFactorisation::
+  factorise (const unsigned int iNbOfRows,
+             const std::vector<unsigned int>& iColumnPointerList,
+             const std::vector<unsigned int>& iRowIndexList,
+             const std::vector<double>& iValueList,
+             std::vector<unsigned int>& oBasisList) {
+    const unsigned int m = iNbOfRows;
+    assert (iColumnPointerList.empty() == false);
+    assert (iRowIndexList.size() == iValueList.size());
+    const unsigned int lNbOfCandidates = iColumnPointerList.size() - 1;
+
+    _nbOfRows = m;
+    _pivotRowList.clear();
+    _lowerPointerList.assign (1, 0);
+    _lowerRowIndexList.clear();
+    _lowerValueList.clear();
+    _diagonalList.clear();
+    _upperPointerList.assign (1, 0);
+    _upperPositionList.clear();
+    _upperValueList.clear();
+    _etaPositionList.clear();
+    _etaPivotList.clear();
+    _etaPointerList.assign (1, 0);
+    _etaIndexList.clear();
+    _etaValueList.clear();
+    oBasisList.clear();
+
+    // Number of values of each row, so as to break the ties between the
+    // pivots in favour of the sparsest rows.
+    std::vector<unsigned int> lRowCountList (m, 0);
+    for (unsigned int lPos = 0; lPos < iRowIndexList.size(); ++lPos) {
+      assert (iRowIndexList[lPos] < m);
+      ++lRowCountList[iRowIndexList[lPos]];
+    }
+
+    // Position of each row, once it has been pivoted (m before).
+    std::vector<unsigned int> lPositionList (m, m);
+    std::vector<double> lWork (m, 0.0);
+    for (unsigned int c = 0; c < lNbOfCandidates && oBasisList.size() < m;
+         ++c) {
+      // Eliminate the candidate column with the former pivots (left-
+      // looking elimination).
+      for (unsigned int lPos = iColumnPointerList[c];
+           lPos < iColumnPointerList[c + 1]; ++lPos) {
+        lWork[iRowIndexList[lPos]] += iValueList[lPos];
+      }
+      const unsigned int lNbOfPivots = _pivotRowList.size();
+      for (unsigned int k = 0; k < lNbOfPivots; ++k) {
+        const double lPivotValue = lWork[_pivotRowList[k]];
+        if (lPivotValue == 0.0) {
+          continue;
+        }
+        for (unsigned int lPos = _lowerPointerList[k];
+             lPos < _lowerPointerList[k + 1]; ++lPos) {
+          lWork[_lowerRowIndexList[lPos]] -= _lowerValueList[lPos] * lPivotValue;
+        }
+      }
+
+      // Pivot on the largest value among the rows not pivoted yet.
+      unsigned int lPivotRowIdx = m;
+      double lMaxValue = LU_PIVOT_TOLERANCE;
+      for (unsigned int r = 0; r < m; ++r) {
+        if (lPositionList[r] < m) {
+          continue;
+        }
+        const double lValue = std::fabs (lWork[r]);
+        if (lValue > lMaxValue
+            || (lValue == lMaxValue && lPivotRowIdx < m
+                && lRowCountList[r] < lRowCountList[lPivotRowIdx])) {
+          lMaxValue = lValue;
+          lPivotRowIdx = r;
+        }
+      }
+
+      // Store the column of U and the elimination column of L, unless the
+      // candidate depends on the former columns.
+      if (lPivotRowIdx < m) {
+        const double lPivot = lWork[lPivotRowIdx];
+        for (unsigned int r = 0; r < m; ++r) {
+          const double lValue = lWork[r];
+          if (r == lPivotRowIdx || std::fabs (lValue) <= LU_DROP_TOLERANCE) {
+            continue;
+          }
+          if (lPositionList[r] < m) {
+            _upperPositionList.push_back (lPositionList[r]);
+            _upperValueList.push_back (lValue);
+          } else {
+            _lowerRowIndexList.push_back (r);
+            _lowerValueList.push_back (lValue / lPivot);
+          }
+        }
+        lPositionList[lPivotRowIdx] = _pivotRowList.size();
+        _pivotRowList.push_back (lPivotRowIdx);
+        _diagonalList.push_back (lPivot);
+        _upperPointerList.push_back (_upperValueList.size());
+        _lowerPointerList.push_back (_lowerValueList.size());
+        oBasisList.push_back (c);
+      }
+      lWork.assign (m, 0.0);
+    }
+
+    // Complete the basis with the unit columns of the rows left
+    // uncovered, which the former pivots do not alter.
+    for (unsigned int r = 0; r < m; ++r) {
+      if (lPositionList[r] < m) {
+        continue;
+      }
+      lPositionList[r] = _pivotRowList.size();
+      _pivotRowList.push_back (r);
+      _diagonalList.push_back (1.0);
+      _upperPointerList.push_back (_upperValueList.size());
+      _lowerPointerList.push_back (_lowerValueList.size());
+      oBasisList.push_back (lNbOfCandidates + r);
+    }
+    assert (oBasisList.size() == m);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BasisFactorisation::solve (std::vector<double>& ioVector) const {
+    const unsigned int m = _nbOfRows;
+    assert (ioVector.size() == m);
+
+    // Forward substitution with L, by row.
+    for (unsigned int k = 0; k < m; ++k) {
+      const double lPivotValue = ioVector[_pivotRowList[k]];
+      if (lPivotValue == 0.0) {
+        continue;
+      }
+      for (unsigned int lPos = _lowerPointerList[k];
+           lPos < _lowerPointerList[k + 1]; ++lPos) {
+        ioVector[_lowerRowIndexList[lPos]] -= _lowerValueList[lPos] * lPivotValue;
+      }
+    }
+
+    // Backward substitution with U, from the rows to the positions.
+    std::vector<double> lSolution (m, 0.0);
+    for (unsigned int k = m; k-- > 0; ) {
+      const double lValue = ioVector[_pivotRowList[k]] / _diagonalList[k];
+      lSolution[k] = lValue;
+      if (lValue == 0.0) {
+        continue;
+      }
+      for (unsigned int lPos = _upperPointerList[k];
+           lPos < _upperPointerList[k + 1]; ++lPos) {
+        ioVector[_pivotRowList[_upperPositionList[lPos]]] -=
+          _upperValueList[lPos] * lValue;
+      }
+    }
+
+    // Eta columns, in the order of the updates.
+    const unsigned int lNbOfEtas = _etaPositionList.size();
+    for (unsigned int e = 0; e < lNbOfEtas; ++e) {
+      const unsigned int r = _etaPositionList[e];
+      const double lValue = lSolution[r] / _etaPivotList[e];
+      lSolution[r] = lValue;
+      if (lValue == 0.0) {
+        continue;
+      }
+      for (unsigned int lPos = _etaPointerList[e];
+           lPos < _etaPointerList[e + 1]; ++lPos) {
+        lSolution[_etaIndexList[lPos]] -= _etaValueList[lPos] * lValue;
+      }
+    }
+    ioVector.swap (lSolution);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BasisFactorisation::
+  solveTranspose (std::vector<double>& ioVector) const {
+    const unsigned int m = _nbOfRows;
+    assert (ioVector.size() == m);
+
+    // Eta columns, from the last update.
+    for (unsigned int e = _etaPositionList.size(); e-- > 0; ) {
+      const unsigned int r = _etaPositionList[e];
+      double lValue = ioVector[r];
+      for (unsigned int lPos = _etaPointerList[e];
+           lPos < _etaPointerList[e + 1]; ++lPos) {
+        lValue -= _etaValueList[lPos] * ioVector[_etaIndexList[lPos]];
+      }
+      ioVector[r] = lValue / _etaPivotList[e];
+    }
+
+    // Forward substitution with the transpose of U, from the positions to
+    // the rows.
+    std::vector<double> lSolution (m, 0.0);
+    for (unsigned int k = 0; k < m; ++k) {
+      double lValue = ioVector[k];
+      for (unsigned int lPos = _upperPointerList[k];
+           lPos < _upperPointerList[k + 1]; ++lPos) {
+        lValue -= _upperValueList[lPos]
+          * lSolution[_pivotRowList[_upperPositionList[lPos]]];
+      }
+      lSolution[_pivotRowList[k]] = lValue / _diagonalList[k];
+    }
+
+    // Backward substitution with the transpose of L, by row.
+    for (unsigned int k = m; k-- > 0; ) {
+      double lValue = 0.0;
+      for (unsigned int lPos = _lowerPointerList[k];
+           lPos < _lowerPointerList[k + 1]; ++lPos) {
+        lValue += _lowerValueList[lPos] * lSolution[_lowerRowIndexList[lPos]];
+      }
+      lSolution[_pivotRowList[k]] -= lValue;
+    }
+    ioVector.swap (lSolution);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BasisFactorisation::update (const unsigned int iPosition,
+                                   const std::vector<double>& iColumn) {
+    const unsigned int m = _nbOfRows;
+    assert (iPosition < m);
+    assert (iColumn.size() == m);
+    const double lPivot = iColumn[iPosition];
+    assert (std::fabs (lPivot) > LU_PIVOT_TOLERANCE);
+
+    _etaPositionList.push_back (iPosition);
+    _etaPivotList.push_back (lPivot);
+    for (unsigned int k = 0; k < m; ++k) {
+      const double lValue = iColumn[k];
+      if (k == iPosition || std::fabs (lValue) <= LU_DROP_TOLERANCE) {
+        continue;
+      }
+      _etaIndexList.push_back (k);
+      _etaValueList.push_back (lValue);
+    }
+    _etaPointerList.push_back (_etaValueList.size());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BasisFactorisation::toStream (std::ostream& ioOut) const {
+    ioOut << describe() << std::endl;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string BasisFactorisation::describe() const {
+    std::ostringstream ostr;
+    ostr << "Basis factorisation (" << _nbOfRows << " rows): "
+         << _lowerValueList.size() << " values in L, "
+         << _diagonalList.size() + _upperValueList.size() << " values in U, "
+         << _etaPositionList.size() << " updates";
+    return ostr.str();
+  }
+}
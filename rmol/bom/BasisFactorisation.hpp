@@ -0,0 +1,171 @@
+#ifndef __RMOL_BOM_BASISFACTORISATION_HPP
+#define __RMOL_BOM_BASISFACTORISATION_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Sparse LU factorisation of the basis of a linear program,
+   * updated in product form.
+   *
+   * The basis B (m x m) is factorised as B = L.U, where L is stored as
+   * the list of its elimination columns and U column after column, both
+   * with their non-zero values only. The basic columns are numbered by
+   * position, in the order in which they were pivoted.
+   *
+   * When the column at a position is replaced by another one (simplex
+   * iteration), the factorisation is not re-computed: an eta column
+   * (product form of the inverse) is appended instead, so that
+   * B' = B.E^-1. The caller re-factorises the basis once the number of
+   * updates makes the solves slower (or less accurate) than a fresh
+   * factorisation.
+   */
+  struct BasisFactorisation : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of rows (i.e., of basic columns). */
+    unsigned int getNbOfRows() const {
+      return _nbOfRows;
+    }
+
+    /** Get the number of updates since the last factorisation. */
+    unsigned int getNbOfUpdates() const {
+      return _etaPositionList.size();
+    }
+
+    /** Get the number of non-zero values of the factors (L, U and the
+        eta columns). */
+    unsigned int getNbOfNonZeros() const;
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Factorise a basis holding as many of the given columns as
+     * possible, completed with the unit columns of the rows left
+     * uncovered.
+     *
+     * The columns are pivoted in the given order, each one on the row
+     * (not yet pivoted) of its largest value, the ties going to the
+     * sparsest row. A column depending on the former ones (no acceptable
+     * pivot) is left out of the basis.
+     *
+     * @param const unsigned int Number of rows (m).
+     * @param const std::vector<unsigned int>& Column pointers of the
+     *        candidate columns (compressed sparse column format).
+     * @param const std::vector<unsigned int>& Row indices.
+     * @param const std::vector<double>& Values.
+     * @param std::vector<unsigned int>& Basic columns, by position (m
+     *        values): either the index of a candidate column, or the
+     *        number of candidate columns plus the row of a unit column.
+     */
+    void factorise (const unsigned int iNbOfRows,
+                    const std::vector<unsigned int>& iColumnPointerList,
+                    const std::vector<unsigned int>& iRowIndexList,
+                    const std::vector<double>& iValueList,
+                    std::vector<unsigned int>& oBasisList);
+
+    /**
+     * Solve B.x = a (FTRAN).
+     *
+     * @param std::vector<double>& The vector a, by row, replaced by the
+     *        solution x, by position.
+     */
+    void solve (std::vector<double>& ioVector) const;
+
+    /**
+     * Solve y.B = d (BTRAN).
+     *
+     * @param std::vector<double>& The vector d, by position, replaced by
+     *        the solution y, by row.
+     */
+    void solveTranspose (std::vector<double>& ioVector) const;
+
+    /**
+     * Replace the column at the given position by another one.
+     *
+     * @param const unsigned int Position of the replaced column.
+     * @param const std::vector<double>& The new column a, given as
+     *        B^-1.a (i.e., as returned by solve()), by position.
+     */
+    void update (const unsigned int iPosition,
+                 const std::vector<double>& iColumn);
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    BasisFactorisation ();
+
+    /** Destructor. */
+    virtual ~BasisFactorisation();
+
+  private:
+    /** Number of rows. */
+    unsigned int _nbOfRows;
+
+    /** Pivot row, by position. */
+    std::vector<unsigned int> _pivotRowList;
+
+    /** Elimination columns of L: the multipliers of the position k are
+        stored from _lowerPointerList[k] (included) to
+        _lowerPointerList[k+1] (excluded) of the row indices and
+        values. */
+    std::vector<unsigned int> _lowerPointerList;
+
+    /** Row indices of the multipliers of L. */
+    std::vector<unsigned int> _lowerRowIndexList;
+
+    /** Values of the multipliers of L. */
+    std::vector<double> _lowerValueList;
+
+    /** Diagonal of U, by position. */
+    std::vector<double> _diagonalList;
+
+    /** Columns of U, without their diagonal: the values of the position
+        k, in the rows of the positions lower than k, are stored from
+        _upperPointerList[k] (included) to _upperPointerList[k+1]
+        (excluded) of the position indices and values. */
+    std::vector<unsigned int> _upperPointerList;
+
+    /** Position indices of the values of U. */
+    std::vector<unsigned int> _upperPositionList;
+
+    /** Values of U. */
+    std::vector<double> _upperValueList;
+
+    /** Positions of the eta columns. */
+    std::vector<unsigned int> _etaPositionList;
+
+    /** Pivot values of the eta columns. */
+    std::vector<double> _etaPivotList;
+
+    /** Other values of the eta columns: the ones of the eta column e are
+        stored from _etaPointerList[e] (included) to _etaPointerList[e+1]
+        (excluded) of the position indices and values. */
+    std::vector<unsigned int> _etaPointerList;
+
+    /** Position indices of the values of the eta columns. */
+    std::vector<unsigned int> _etaIndexList;
+
+    /** Values of the eta columns. */
+    std::vector<double> _etaValueList;
+  };
+}
+#endif // __RMOL_BOM_BASISFACTORISATION_HPP
@@ -0,0 +1,113 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// RMOL
+#include <rmol/bom/BidPriceAccelerator.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  BidPriceAccelerator::
+  BidPriceAccelerator (const BidPriceAccelerationMethod_T& iMethod,
+                       const double iDampingFactor)
+    : _method (iMethod), _dampingFactor (iDampingFactor) {
+    assert (_dampingFactor > 0.0 && _dampingFactor <= 1.0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BidPriceAccelerator::~BidPriceAccelerator () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceAccelerator::reset () {
+    _previousBidPriceList.clear();
+    _previousResidualList.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceAccelerator::
+  accelerate (const std::vector<double>& iBidPriceList,
+              std::vector<double>& ioBidPriceList) {
+    if (_method == BP_ACCELERATION_NONE) {
+      return;
+    }
+    const unsigned int lNbOfBidPrices = iBidPriceList.size();
+    assert (ioBidPriceList.size() == lNbOfBidPrices);
+
+    // Residuals and damped iterates.
+    std::vector<double> lResidualList (lNbOfBidPrices);
+    std::vector<double> lDampedBidPriceList (lNbOfBidPrices);
+    for (unsigned int idx = 0; idx < lNbOfBidPrices; ++idx) {
+      lResidualList[idx] = ioBidPriceList[idx] - iBidPriceList[idx];
+      lDampedBidPriceList[idx] =
+        iBidPriceList[idx] + _dampingFactor * lResidualList[idx];
+    }
+
+    // Anderson mixing, with the previous iterate.
+    double lGamma = 0.0;
+    const bool hasHistory =
+      (_method == BP_ACCELERATION_ANDERSON
+       && _previousBidPriceList.size() == lNbOfBidPrices);
+    if (hasHistory == true) {
+      double lNumerator = 0.0;
+      double lDenominator = 0.0;
+      for (unsigned int idx = 0; idx < lNbOfBidPrices; ++idx) {
+        const double lDeltaResidual =
+          lResidualList[idx] - _previousResidualList[idx];
+        lNumerator += lDeltaResidual * lResidualList[idx];
+        lDenominator += lDeltaResidual * lDeltaResidual;
+      }
+      if (lDenominator > 0.0) {
+        lGamma = lNumerator / lDenominator;
+      }
+    }
+
+    for (unsigned int idx = 0; idx < lNbOfBidPrices; ++idx) {
+      double lBidPrice = lDampedBidPriceList[idx];
+      if (lGamma != 0.0) {
+        const double lDeltaBidPrice =
+          iBidPriceList[idx] - _previousBidPriceList[idx];
+        const double lDeltaResidual =
+          lResidualList[idx] - _previousResidualList[idx];
+        const double lAndersonBidPrice = lBidPrice
+          - lGamma * (lDeltaBidPrice + _dampingFactor * lDeltaResidual);
+        if (lAndersonBidPrice > 0.0) {
+          lBidPrice = lAndersonBidPrice;
+        }
+      }
+      ioBidPriceList[idx] = lBidPrice;
+    }
+
+    _previousBidPriceList = iBidPriceList;
+    _previousResidualList.swap (lResidualList);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceAccelerator::toStream (std::ostream& ioOut) const {
+    ioOut << describe();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string BidPriceAccelerator::describe() const {
+    std::ostringstream ostr;
+    switch (_method) {
+    case BP_ACCELERATION_NONE:
+      ostr << "No bid price acceleration";
+      break;
+    case BP_ACCELERATION_DAMPED:
+      ostr << "Damped bid price iterations";
+      break;
+    case BP_ACCELERATION_ANDERSON:
+      ostr << "Anderson bid price acceleration";
+      break;
+    default:
+      assert (false);
+      break;
+    }
+    ostr << " (damping factor " << _dampingFactor << ").";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,99 @@
+#ifndef __RMOL_BOM_BIDPRICEACCELERATOR_HPP
+#define __RMOL_BOM_BIDPRICEACCELERATOR_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Acceleration of the fixed-point iterations on the bid prices
+   * of the network.
+   *
+   * At each iteration k, the network optimisation maps the bid prices
+   * x(k) of the leg-cabins (read by the demand projection, and exchanged
+   * between partners) onto new bid prices G(x(k)). With the residual
+   * f(k) = G(x(k)) - x(k) and the damping (mixing) factor b:
+   * <ul>
+   *  <li>the damped iterations give x(k+1) = x(k) + b.f(k);</li>
+   *  <li>the Anderson iterations (of depth 1) give
+   *      x(k+1) = x(k) + b.f(k) - g.(dx + b.df), where dx = x(k) - x(k-1),
+   *      df = f(k) - f(k-1) and g = (df.f(k)) / (df.df).</li>
+   * </ul>
+   * A bid price which would not be positive is given the damped value.
+   */
+  struct BidPriceAccelerator : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the acceleration method. */
+    const BidPriceAccelerationMethod_T& getMethod() const {
+      return _method;
+    }
+
+    /** Get the damping factor. */
+    const double& getDampingFactor() const {
+      return _dampingFactor;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Compute the next iterate.
+     *
+     * @param const std::vector<double>& Bid prices x(k), which were given
+     *        to the network optimisation.
+     * @param std::vector<double>& Bid prices G(x(k)), given back by the
+     *        network optimisation, replaced by the bid prices x(k+1).
+     */
+    void accelerate (const std::vector<double>& iBidPriceList,
+                     std::vector<double>& ioBidPriceList);
+
+    /** Forget the previous iterates. */
+    void reset();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    BidPriceAccelerator (const BidPriceAccelerationMethod_T&,
+                         const double iDampingFactor);
+
+    /** Destructor. */
+    virtual ~BidPriceAccelerator();
+
+  private:
+    /** Default constructor (not implemented). */
+    BidPriceAccelerator ();
+
+  private:
+    /** Acceleration method. */
+    const BidPriceAccelerationMethod_T _method;
+
+    /** Damping factor, within ]0, 1]. */
+    const double _dampingFactor;
+
+    /** Previous iterate x(k-1). */
+    std::vector<double> _previousBidPriceList;
+
+    /** Previous residual f(k-1). */
+    std::vector<double> _previousResidualList;
+  };
+}
+#endif // __RMOL_BOM_BIDPRICEACCELERATOR_HPP
@@ -0,0 +1,254 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <map>
+#include <algorithm>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/LegDate.hpp>
+#include <stdair/bom/LegCabin.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/OnDDate.hpp>
+// RMOL
+#include <rmol/bom/BidPriceActiveSet.hpp>
+
+namespace RMOL {
+
+  namespace {
+
+    /** Define the list of leg-cabins travelled by an O&D-date. */
+    typedef std::vector<stdair::LegCabin*> OnDLegCabinList_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Retrieve the leg-cabins the bid prices of which are read (i.e., the
+     * operating leg-cabins) and the leg-cabins which receive the demand
+     * (i.e., the operated leg-cabins), when the demand of the given
+     * O&D-date is projected using dynamic yield proration.
+     */
+    void getOnDLegCabinLists (const stdair::OnDDate& iOnDDate,
+                              OnDLegCabinList_T& ioReadList,
+                              OnDLegCabinList_T& ioWrittenList) {
+      const stdair::StringDemandStructMap_T& lStringDemandStructMap =
+        iOnDDate.getDemandInfoMap();
+      for (stdair::StringDemandStructMap_T::const_iterator itStrDS =
+             lStringDemandStructMap.begin();
+           itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
+        const std::string& lCabinClassPath = itStrDS->first;
+        const stdair::CabinClassPairList_T& lCabinClassPairList =
+          iOnDDate.getCabinClassPairList (lCabinClassPath);
+        const stdair::SegmentDateList_T& lOnDSegmentDateList =
+          stdair::BomManager::getList<stdair::SegmentDate> (iOnDDate);
+        assert (lCabinClassPairList.size() == lOnDSegmentDateList.size());
+
+        stdair::CabinClassPairList_T::const_iterator itCCP =
+          lCabinClassPairList.begin();
+        for (stdair::SegmentDateList_T::const_iterator itSD =
+               lOnDSegmentDateList.begin();
+             itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
+          const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
+          assert (lSegmentDate_ptr != NULL);
+          const stdair::SegmentDate* lOperatingSegmentDate_ptr =
+            lSegmentDate_ptr->getOperatingSegmentDate();
+          const bool isOperated = (lOperatingSegmentDate_ptr == NULL);
+          if (isOperated == false) {
+            lSegmentDate_ptr = lOperatingSegmentDate_ptr;
+          }
+          const stdair::CabinCode_T& lCabinCode = itCCP->first;
+          const stdair::SegmentCabin* lSegmentCabin_ptr = stdair::BomManager::
+            getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr, lCabinCode);
+          assert (lSegmentCabin_ptr != NULL);
+          const stdair::LegCabinList_T& lLegCabinList =
+            stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
+          ioReadList.insert (ioReadList.end(),
+                             lLegCabinList.begin(), lLegCabinList.end());
+          if (isOperated == true) {
+            ioWrittenList.insert (ioWrittenList.end(),
+                                  lLegCabinList.begin(), lLegCabinList.end());
+          }
+        }
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BidPriceActiveSet::BidPriceActiveSet () : _isRecorded (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BidPriceActiveSet::~BidPriceActiveSet () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int BidPriceActiveSet::getNbOfActiveLegCabins() const {
+    return std::count (_activeFlagList.begin(), _activeFlagList.end(), true);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceActiveSet::
+  build (const std::vector<stdair::FlightDate*>& iFlightDateList,
+         const std::vector<stdair::OnDDate*>& iOnDDateList) {
+    _legCabinList.clear();
+    _watchedLegCabinList.clear();
+    _dependencyIndexList.clear();
+    _dependencyList.clear();
+    _bidPriceList.clear();
+    _isRecorded = false;
+
+    // Gather the leg-cabins of the flight-dates.
+    typedef std::map<const stdair::LegCabin*, unsigned int> LegCabinIndexMap_T;
+    LegCabinIndexMap_T lLegCabinIndexMap;
+    for (std::vector<stdair::FlightDate*>::const_iterator itFD =
+           iFlightDateList.begin(); itFD != iFlightDateList.end(); ++itFD) {
+      const stdair::FlightDate* lFD_ptr = *itFD;
+      assert (lFD_ptr != NULL);
+      const bool hasLegDateList =
+        stdair::BomManager::hasList<stdair::LegDate> (*lFD_ptr);
+      if (hasLegDateList == false) {
+        continue;
+      }
+      const stdair::LegDateList_T& lLDList =
+        stdair::BomManager::getList<stdair::LegDate> (*lFD_ptr);
+      for (stdair::LegDateList_T::const_iterator itLD = lLDList.begin();
+           itLD != lLDList.end(); ++itLD) {
+        const stdair::LegDate* lLD_ptr = *itLD;
+        assert (lLD_ptr != NULL);
+        const stdair::LegCabinList_T& lLCList =
+          stdair::BomManager::getList<stdair::LegCabin> (*lLD_ptr);
+        for (stdair::LegCabinList_T::const_iterator itLC = lLCList.begin();
+             itLC != lLCList.end(); ++itLC) {
+          stdair::LegCabin* lLC_ptr = *itLC;
+          assert (lLC_ptr != NULL);
+          lLegCabinIndexMap.insert (LegCabinIndexMap_T::
+                                    value_type (lLC_ptr, _legCabinList.size()));
+          _legCabinList.push_back (lLC_ptr);
+        }
+      }
+    }
+    const unsigned int lNbOfLegCabins = _legCabinList.size();
+    _activeFlagList.assign (lNbOfLegCabins, true);
+
+    // Register, for each leg-cabin receiving the demand of an O&D-date,
+    // the leg-cabins the bid prices of which are read for that O&D-date.
+    LegCabinIndexMap_T lWatchedIndexMap;
+    std::vector<std::vector<unsigned int> > lDependencyLists (lNbOfLegCabins);
+    for (std::vector<stdair::OnDDate*>::const_iterator itOD =
+           iOnDDateList.begin(); itOD != iOnDDateList.end(); ++itOD) {
+      const stdair::OnDDate* lOnDDate_ptr = *itOD;
+      assert (lOnDDate_ptr != NULL);
+      OnDLegCabinList_T lReadList;
+      OnDLegCabinList_T lWrittenList;
+      getOnDLegCabinLists (*lOnDDate_ptr, lReadList, lWrittenList);
+
+      std::vector<unsigned int> lReadIndexList;
+      for (OnDLegCabinList_T::const_iterator itLC = lReadList.begin();
+           itLC != lReadList.end(); ++itLC) {
+        const stdair::LegCabin* lLC_ptr = *itLC;
+        assert (lLC_ptr != NULL);
+        const std::pair<LegCabinIndexMap_T::iterator, bool> lInsertion =
+          lWatchedIndexMap.insert (LegCabinIndexMap_T::
+                                   value_type (lLC_ptr,
+                                               _watchedLegCabinList.size()));
+        if (lInsertion.second == true) {
+          _watchedLegCabinList.push_back (lLC_ptr);
+        }
+        lReadIndexList.push_back (lInsertion.first->second);
+      }
+
+      for (OnDLegCabinList_T::const_iterator itLC = lWrittenList.begin();
+           itLC != lWrittenList.end(); ++itLC) {
+        LegCabinIndexMap_T::const_iterator itIndex =
+          lLegCabinIndexMap.find (*itLC);
+        if (itIndex == lLegCabinIndexMap.end()) {
+          continue;
+        }
+        std::vector<unsigned int>& lDependencyList =
+          lDependencyLists[itIndex->second];
+        lDependencyList.insert (lDependencyList.end(),
+                                lReadIndexList.begin(), lReadIndexList.end());
+      }
+    }
+
+    // Store the (sorted and unique) dependencies, row after row.
+    _dependencyIndexList.reserve (lNbOfLegCabins + 1);
+    _dependencyIndexList.push_back (0);
+    for (unsigned int lLCIdx = 0; lLCIdx < lNbOfLegCabins; ++lLCIdx) {
+      std::vector<unsigned int>& lDependencyList = lDependencyLists[lLCIdx];
+      std::sort (lDependencyList.begin(), lDependencyList.end());
+      lDependencyList.erase (std::unique (lDependencyList.begin(),
+                                          lDependencyList.end()),
+                             lDependencyList.end());
+      _dependencyList.insert (_dependencyList.end(),
+                              lDependencyList.begin(), lDependencyList.end());
+      _dependencyIndexList.push_back (_dependencyList.size());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceActiveSet::update() {
+    const unsigned int lNbOfWatchedLegCabins = _watchedLegCabinList.size();
+
+    // Flag the bid prices which changed since the last update.
+    std::vector<bool> lChangedFlagList (lNbOfWatchedLegCabins, true);
+    if (_isRecorded == true) {
+      assert (_bidPriceList.size() == lNbOfWatchedLegCabins);
+      for (unsigned int lWatchedIdx = 0; lWatchedIdx < lNbOfWatchedLegCabins;
+           ++lWatchedIdx) {
+        const stdair::LegCabin* lLC_ptr = _watchedLegCabinList[lWatchedIdx];
+        assert (lLC_ptr != NULL);
+        lChangedFlagList[lWatchedIdx] =
+          (lLC_ptr->getCurrentBidPrice() != _bidPriceList[lWatchedIdx]);
+      }
+
+      // A leg-cabin is active when one of its dependencies changed.
+      const unsigned int lNbOfLegCabins = _legCabinList.size();
+      for (unsigned int lLCIdx = 0; lLCIdx < lNbOfLegCabins; ++lLCIdx) {
+        bool isActive = false;
+        for (unsigned int lDepIdx = _dependencyIndexList[lLCIdx];
+             lDepIdx < _dependencyIndexList[lLCIdx+1] && isActive == false;
+             ++lDepIdx) {
+          isActive = lChangedFlagList[_dependencyList[lDepIdx]];
+        }
+        _activeFlagList[lLCIdx] = isActive;
+      }
+    }
+
+    // Record the current bid prices.
+    _bidPriceList.resize (lNbOfWatchedLegCabins);
+    for (unsigned int lWatchedIdx = 0; lWatchedIdx < lNbOfWatchedLegCabins;
+         ++lWatchedIdx) {
+      const stdair::LegCabin* lLC_ptr = _watchedLegCabinList[lWatchedIdx];
+      assert (lLC_ptr != NULL);
+      _bidPriceList[lWatchedIdx] = lLC_ptr->getCurrentBidPrice();
+    }
+    _isRecorded = true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void BidPriceActiveSet::toStream (std::ostream& ioOut) const {
+    const unsigned int lNbOfLegCabins = _legCabinList.size();
+    for (unsigned int lLCIdx = 0; lLCIdx < lNbOfLegCabins; ++lLCIdx) {
+      const stdair::LegCabin* lLC_ptr = _legCabinList[lLCIdx];
+      assert (lLC_ptr != NULL);
+      ioOut << lLC_ptr->getFullerKey() << ": "
+            << ((_activeFlagList[lLCIdx] == true) ? "active" : "inactive")
+            << ", " << (_dependencyIndexList[lLCIdx+1]
+                        - _dependencyIndexList[lLCIdx])
+            << " dependencies" << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string BidPriceActiveSet::describe() const {
+    std::ostringstream ostr;
+    ostr << "Bid price active set: " << getNbOfActiveLegCabins() << " active"
+         << " leg-cabins out of " << _legCabinList.size() << ", "
+         << _watchedLegCabinList.size() << " watched bid prices.";
+    return ostr.str();
+  }
+}
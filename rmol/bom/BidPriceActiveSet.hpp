@@ -0,0 +1,118 @@
+#ifndef __RMOL_BOM_BIDPRICEACTIVESET_HPP
+#define __RMOL_BOM_BIDPRICEACTIVESET_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class FlightDate;
+  class OnDDate;
+  class LegCabin;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Active set of the leg-cabins to be re-optimised during the
+   * iterations of an O&D optimisation with dynamic yield proration.
+   *
+   * The demand projected onto a leg-cabin only depends on the bid prices
+   * of the leg-cabins travelled by the O&D-dates feeding it. As the
+   * Monte Carlo optimisation is deterministic, a leg-cabin for which none
+   * of those bid prices changed since its last optimisation would get
+   * the very same bid price vector: it can be skipped.
+   */
+  struct BidPriceActiveSet : public stdair::StructAbstract {
+
+  public:
+    /** Define the list of leg-cabins. */
+    typedef std::vector<stdair::LegCabin*> LegCabinList_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the leg-cabins to be optimised, flight-date after
+        flight-date. */
+    const LegCabinList_T& getLegCabinList() const {
+      return _legCabinList;
+    }
+
+    /** Get the flags telling, for each leg-cabin to be optimised, whether
+        it is active (i.e., must be re-optimised). */
+    const FlagVector_T& getActiveFlagList() const {
+      return _activeFlagList;
+    }
+
+    /** Get the number of active leg-cabins. */
+    unsigned int getNbOfActiveLegCabins() const;
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Build the dependencies between the leg-cabins of the given
+     * flight-dates and the bid prices read when projecting the demand of
+     * the given O&D-dates. All the leg-cabins are then active.
+     */
+    void build (const std::vector<stdair::FlightDate*>&,
+                const std::vector<stdair::OnDDate*>&);
+
+    /**
+     * Flag as active the leg-cabins depending on a bid price which
+     * changed since the previous call (all of them on the first call),
+     * and record the current bid prices.
+     */
+    void update();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    BidPriceActiveSet ();
+
+    /** Destructor. */
+    virtual ~BidPriceActiveSet();
+
+  private:
+    /** Leg-cabins to be optimised. */
+    LegCabinList_T _legCabinList;
+
+    /** Leg-cabins the bid prices of which are read by the projection. */
+    std::vector<const stdair::LegCabin*> _watchedLegCabinList;
+
+    /** Dependencies of the leg-cabins to be optimised, stored row after
+        row: the watched leg-cabins of the leg-cabin of index i are given
+        by the indices from _dependencyIndexList[i] (included) to
+        _dependencyIndexList[i+1] (excluded) of _dependencyList. */
+    std::vector<unsigned int> _dependencyIndexList;
+
+    /** Indices of the watched leg-cabins (see above). */
+    std::vector<unsigned int> _dependencyList;
+
+    /** Bid prices of the watched leg-cabins, at the last update. */
+    std::vector<stdair::BidPrice_T> _bidPriceList;
+
+    /** Whether the leg-cabins to be optimised are active. */
+    FlagVector_T _activeFlagList;
+
+    /** Whether the bid prices have been recorded at least once. */
+    bool _isRecorded;
+  };
+}
+#endif // __RMOL_BOM_BIDPRICEACTIVESET_HPP
@@ -0,0 +1,161 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/SegmentSnapshotTable.hpp>
+#include <stdair/bom/BookingClass.hpp>
+// RMOL
+#include <rmol/bom/HistoricalBooking.hpp>
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/ClassBookingMatrix.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  ClassBookingMatrix::ClassBookingMatrix ()
+    : _isGathered (false), _nbOfClasses (0), _segmentBegin (0),
+      _nbOfSegments (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ClassBookingMatrix::~ClassBookingMatrix () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassBookingMatrix::
+  gather (const stdair::SegmentSnapshotTable& iSegmentSnapshotTable,
+          const stdair::BookingClassList_T& iBookingClassList,
+          const stdair::DCP_T& iDCPBegin, const stdair::DCP_T& iDCPEnd,
+          const stdair::NbOfSegments_T& iSegmentBegin,
+          const stdair::NbOfSegments_T& iSegmentEnd,
+          const bool iAddPriceOrientedBookings) {
+    const short lNbOfSegments = iSegmentEnd - iSegmentBegin + 1;
+    if (_isGathered == true && _segmentBegin == iSegmentBegin
+        && _nbOfSegments == lNbOfSegments) {
+      return;
+    }
+
+    if (lNbOfSegments <= 0) {
+      _isGathered = true;
+      _nbOfClasses = iBookingClassList.size();
+      _segmentBegin = iSegmentBegin;
+      _nbOfSegments = 0;
+      _bookingVector.clear();
+      _censorshipFlagVector.clear();
+      return;
+    }
+
+    // Retrieve the booking class indices within the snapshot table.
+    std::vector<stdair::ClassIndex_T> lClassIdxList;
+    lClassIdxList.reserve (iBookingClassList.size());
+    for (stdair::BookingClassList_T::const_iterator itBC =
+           iBookingClassList.begin(); itBC != iBookingClassList.end();
+         ++itBC) {
+      const stdair::BookingClass* lBC_ptr = *itBC;
+      assert (lBC_ptr != NULL);
+      lClassIdxList.push_back (iSegmentSnapshotTable.
+                               getClassIndex (lBC_ptr->describeKey()));
+    }
+
+    // Retrieve the gross daily booking and availability snapshots, once
+    // for all the classes.
+    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lProductBookingView =
+      iSegmentSnapshotTable.getConstSegmentCabinDTDRangeProductOrientedGrossBookingSnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
+    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lPriceBookingView =
+      iSegmentSnapshotTable.getConstSegmentCabinDTDRangePriceOrientedGrossBookingSnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
+    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lAvlView =
+      iSegmentSnapshotTable.getConstSegmentCabinDTDRangeAvailabilitySnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
+
+    const stdair::ClassIndexMap_T& lVTIdxMap =
+      iSegmentSnapshotTable.getClassIndexMap();
+    gather (lProductBookingView, lPriceBookingView, lAvlView, lClassIdxList,
+            lVTIdxMap.size(), iSegmentBegin, iAddPriceOrientedBookings);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassBookingMatrix::
+  gather (const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iProductBookingView,
+          const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iPriceBookingView,
+          const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iAvlView,
+          const std::vector<stdair::ClassIndex_T>& iClassIdxList,
+          const stdair::NbOfClasses_T iNbOfValueTypes,
+          const stdair::NbOfSegments_T& iSegmentBegin,
+          const bool iAddPriceOrientedBookings) {
+    assert (iNbOfValueTypes > 0);
+    _isGathered = true;
+    _nbOfClasses = iClassIdxList.size();
+    _segmentBegin = iSegmentBegin;
+    _nbOfSegments = iAvlView.shape()[0] / iNbOfValueTypes;
+    _bookingVector.assign (_nbOfClasses * _nbOfSegments, 0.0);
+    _censorshipFlagVector.assign (_nbOfClasses * _nbOfSegments, false);
+    const short lNbOfDTDs = iAvlView.shape()[1];
+
+    // Browse the similar segments, and for each of them, all the classes.
+    for (short i = 0; i < _nbOfSegments; ++i) {
+      for (unsigned int c = 0; c < _nbOfClasses; ++c) {
+        const stdair::UnsignedIndex_T lIdx =
+          i*iNbOfValueTypes + iClassIdxList[c];
+
+        // Parse the DTDs during the period and compute the censorship flag
+        stdair::Flag_T lCensorshipFlag = false;
+        for (short j = 0; j < lNbOfDTDs; ++j) {
+          if (iAvlView[lIdx][j] < 1.0) {
+            lCensorshipFlag = true;
+            break;
+          }
+        }
+
+        // Sum the bookings over the period
+        stdair::NbOfBookings_T lNbOfHistoricalBkgs = 0.0;
+        if (iAddPriceOrientedBookings == true) {
+          for (short j = 0; j < lNbOfDTDs; ++j) {
+            lNbOfHistoricalBkgs +=
+              iPriceBookingView[lIdx][j] + iProductBookingView[lIdx][j];
+          }
+        } else {
+          for (short j = 0; j < lNbOfDTDs; ++j) {
+            lNbOfHistoricalBkgs += iProductBookingView[lIdx][j];
+          }
+        }
+
+        _bookingVector[c * _nbOfSegments + i] = lNbOfHistoricalBkgs;
+        _censorshipFlagVector[c * _nbOfSegments + i] = lCensorshipFlag;
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassBookingMatrix::
+  fillHistoricalBookingHolder (const unsigned int iClass,
+                               HistoricalBookingHolder& ioHBHolder) const {
+    assert (iClass < _nbOfClasses);
+    for (short i = 0; i < _nbOfSegments; ++i) {
+      const HistoricalBooking lHistoricalBkg (getNbOfBookings (iClass, i),
+                                              getCensorshipFlag (iClass, i));
+      ioHBHolder.addHistoricalBooking (lHistoricalBkg);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassBookingMatrix::toStream (std::ostream& ioOut) const {
+    for (unsigned int c = 0; c < _nbOfClasses; ++c) {
+      ioOut << "Class " << c << ":";
+      for (short i = 0; i < _nbOfSegments; ++i) {
+        ioOut << " " << getNbOfBookings (c, i)
+              << (getCensorshipFlag (c, i) ? "*" : "");
+      }
+      ioOut << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string ClassBookingMatrix::describe() const {
+    std::ostringstream ostr;
+    ostr << "Bookings of " << _nbOfClasses << " classes on " << _nbOfSegments
+         << " similar segments, from the segment " << _segmentBegin << ".";
+    return ostr.str();
+  }
+}
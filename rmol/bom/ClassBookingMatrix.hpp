@@ -0,0 +1,162 @@
+#ifndef __RMOL_BOM_CLASSBOOKINGMATRIX_HPP
+#define __RMOL_BOM_CLASSBOOKINGMATRIX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/bom/BookingClassTypes.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentSnapshotTable;
+}
+
+namespace RMOL {
+  /** Forward declaration. */
+  struct HistoricalBookingHolder;
+
+  /**
+   * @brief Dense (classes x similar segments) matrix of the historical
+   * bookings of a DCP interval, along with their censorship flags.
+   *
+   * The booking and availability snapshot views of the DCP interval are
+   * read only once for all the classes of the list, in a single sweep
+   * over the similar segments, instead of once per class. The rows
+   * follow the order of the given booking class list.
+   */
+  struct ClassBookingMatrix : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of classes (rows). */
+    unsigned int getNbOfClasses() const {
+      return _nbOfClasses;
+    }
+
+    /** Get the number of similar segments (columns). */
+    short getNbOfSegments() const {
+      return _nbOfSegments;
+    }
+
+    /** Get the index of the first similar segment. */
+    const stdair::NbOfSegments_T& getSegmentBegin() const {
+      return _segmentBegin;
+    }
+
+    /** Get the summed bookings of the given class on the (i+1)-th
+        similar segment. */
+    const stdair::NbOfBookings_T& getNbOfBookings (const unsigned int iClass,
+                                                   const short i) const {
+      return _bookingVector.at (iClass * _nbOfSegments + i);
+    }
+
+    /** Get the censorship flag of the given class on the (i+1)-th
+        similar segment. */
+    stdair::Flag_T getCensorshipFlag (const unsigned int iClass,
+                                      const short i) const {
+      return _censorshipFlagVector.at (iClass * _nbOfSegments + i);
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Gather the historical bookings of all the given classes over the
+     * given DCP interval and range of similar segments. Nothing is done
+     * when the matrix has already been gathered for that very range.
+     *
+     * @param const stdair::SegmentSnapshotTable& Snapshot table.
+     * @param const stdair::BookingClassList_T& Booking classes (rows).
+     * @param const stdair::DCP_T& DCP range start.
+     * @param const stdair::DCP_T& DCP range end.
+     * @param const stdair::NbOfSegments_T& Segment range start index.
+     * @param const stdair::NbOfSegments_T& Segment range end index.
+     * @param const bool Whether the price-oriented bookings are added to
+     *        the product-oriented ones.
+     */
+    void gather (const stdair::SegmentSnapshotTable&,
+                 const stdair::BookingClassList_T&,
+                 const stdair::DCP_T&, const stdair::DCP_T&,
+                 const stdair::NbOfSegments_T&, const stdair::NbOfSegments_T&,
+                 const bool iAddPriceOrientedBookings);
+
+    /**
+     * Gather the historical bookings of the given classes from the
+     * given booking and availability views of a DCP interval. The rows
+     * of the views are indexed by the similar segment, then by the
+     * value type within the snapshot table, and their columns by the
+     * DTDs of the DCP interval.
+     *
+     * @param const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&
+     *        Product-oriented gross booking view.
+     * @param const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&
+     *        Price-oriented gross booking view.
+     * @param const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&
+     *        Availability view.
+     * @param const std::vector<stdair::ClassIndex_T>& Indices of the
+     *        classes (rows) within the snapshot table.
+     * @param const stdair::NbOfClasses_T Number of value types within
+     *        the snapshot table.
+     * @param const stdair::NbOfSegments_T& Segment range start index.
+     * @param const bool Whether the price-oriented bookings are added to
+     *        the product-oriented ones.
+     */
+    void gather (const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&,
+                 const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&,
+                 const stdair::ConstSegmentCabinDTDRangeSnapshotView_T&,
+                 const std::vector<stdair::ClassIndex_T>&,
+                 const stdair::NbOfClasses_T iNbOfValueTypes,
+                 const stdair::NbOfSegments_T&,
+                 const bool iAddPriceOrientedBookings);
+
+    /** Add the historical bookings of the given class (row) to the
+        given holder. */
+    void fillHistoricalBookingHolder (const unsigned int iClass,
+                                      HistoricalBookingHolder&) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    ClassBookingMatrix ();
+
+    /** Destructor. */
+    virtual ~ClassBookingMatrix();
+
+  private:
+    /** Whether the matrix has been gathered. */
+    bool _isGathered;
+
+    /** Number of classes (rows). */
+    unsigned int _nbOfClasses;
+
+    /** Index of the first similar segment. */
+    stdair::NbOfSegments_T _segmentBegin;
+
+    /** Number of similar segments (columns). */
+    short _nbOfSegments;
+
+    /** Summed bookings, row by row. */
+    std::vector<stdair::NbOfBookings_T> _bookingVector;
+
+    /** Censorship flags, row by row. */
+    FlagVector_T _censorshipFlagVector;
+  };
+}
+#endif // __RMOL_BOM_CLASSBOOKINGMATRIX_HPP
@@ -0,0 +1,143 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cassert>
+#include <cmath>
+// StdAir
+#include <stdair/bom/BookingClass.hpp>
+// RMOL
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/ClassCurveMatrix.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  ClassCurveMatrix::ClassCurveMatrix () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ClassCurveMatrix::~ClassCurveMatrix () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int ClassCurveMatrix::
+  getClassIndex (const stdair::BookingClass& iBookingClass) const {
+    const unsigned int lNbOfClasses = getNbOfClasses();
+    for (unsigned int c = 0; c < lNbOfClasses; ++c) {
+      if (_bookingClassVector[c] == &iBookingClass) {
+        return c;
+      }
+    }
+    assert (false);
+    return lNbOfClasses;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  std::vector<double> ClassCurveMatrix::
+  reset (const stdair::FRAT5Curve_T& iFRAT5Curve,
+         const stdair::BookingClassList_T& iBCList) {
+    assert (iBCList.empty() == false);
+    _bookingClassVector.assign (iBCList.begin(), iBCList.end());
+
+    const DCPIndex_T lNbOfDCPs = DCPCalendar::getNbOfDCPs();
+    _factorVector.assign (lNbOfDCPs * getNbOfClasses(), 1.0);
+
+    std::vector<double> oSellUpCoefList;
+    oSellUpCoefList.reserve (lNbOfDCPs);
+    for (DCPIndex_T idx = 0; idx < lNbOfDCPs; ++idx) {
+      stdair::FRAT5Curve_T::const_iterator itFRAT5 =
+        iFRAT5Curve.find (DCPCalendar::getDCP (idx));
+      assert (itFRAT5 != iFRAT5Curve.end());
+      const stdair::FRAT5_T& lFRAT5 = itFRAT5->second;
+      oSellUpCoefList.push_back (log(0.5)/(lFRAT5-1));
+    }
+    return oSellUpCoefList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassCurveMatrix::
+  buildSellUpCurves (const stdair::FRAT5Curve_T& iFRAT5Curve,
+                     const stdair::BookingClassList_T& iBCList) {
+    const std::vector<double> lSellUpCoefList = reset (iFRAT5Curve, iBCList);
+
+    // The sell-up factors of the lowest class (the last one) are all 1.0.
+    // Compute the ones of the higher classes using the formula
+    // Pro_sell_up_from_Q_to_F = e ^ ((y_F/y_Q - 1) * ln (0.5) / (FRAT5 - 1))
+    const unsigned int lNbOfClasses = getNbOfClasses();
+    const stdair::Yield_T& lLowestYield =
+      getBookingClass (lNbOfClasses - 1).getYield();
+    for (unsigned int c = 0; c + 1 < lNbOfClasses; ++c) {
+      const stdair::Yield_T& lCurrentYield = getBookingClass (c).getYield();
+      for (DCPIndex_T idx = 0; idx < lSellUpCoefList.size(); ++idx) {
+        _factorVector[idx * lNbOfClasses + c] =
+          exp ((lCurrentYield/lLowestYield - 1.0) * lSellUpCoefList[idx]);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassCurveMatrix::
+  buildDispatchingCurves (const stdair::FRAT5Curve_T& iFRAT5Curve,
+                          const stdair::BookingClassList_T& iBCList) {
+    const std::vector<double> lSellUpCoefList = reset (iFRAT5Curve, iBCList);
+
+    // Each class gets the difference between its sell-up factor and the
+    // one of the class just above, the highest class getting its whole
+    // sell-up factor. If there is only one class in the cabin, all the
+    // dispatching factors will be 1.
+    const unsigned int lNbOfClasses = getNbOfClasses();
+    const stdair::Yield_T& lLowestYield =
+      getBookingClass (lNbOfClasses - 1).getYield();
+    for (DCPIndex_T idx = 0; idx < lSellUpCoefList.size(); ++idx) {
+      double* lFactorList = _factorVector.data() + idx * lNbOfClasses;
+      double lBasedFactor = 1.0;
+      for (unsigned int c = lNbOfClasses - 1; c > 0; --c) {
+        const stdair::Yield_T& lNextYield = getBookingClass (c-1).getYield();
+        const double lSellUpFactor =
+          exp ((lNextYield/lLowestYield - 1.0) * lSellUpCoefList[idx]);
+        lFactorList[c] = lBasedFactor - lSellUpFactor;
+        lBasedFactor = lSellUpFactor;
+      }
+      lFactorList[0] = lBasedFactor;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ClassCurveMatrix::toStream (std::ostream& ioOut) const {
+    const unsigned int lNbOfClasses = getNbOfClasses();
+    for (unsigned int c = 0; c < lNbOfClasses; ++c) {
+      ioOut << getBookingClass (c).describeKey() << ":";
+      for (DCPIndex_T idx = 0; idx < DCPCalendar::getNbOfDCPs(); ++idx) {
+        ioOut << " " << getFactor (c, idx);
+      }
+      ioOut << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string ClassCurveMatrix::describe() const {
+    std::ostringstream ostr;
+    ostr << "Curves of " << getNbOfClasses() << " classes on "
+         << DCPCalendar::getNbOfDCPs() << " DCPs.";
+    return ostr.str();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string ClassCurveMatrix::describeFactors() const {
+    std::ostringstream ostr;
+    ostr << std::setprecision (std::numeric_limits<double>::max_digits10);
+    const unsigned int lNbOfClasses = getNbOfClasses();
+    for (unsigned int c = 0; c < lNbOfClasses; ++c) {
+      ostr << getBookingClass (c).describeKey() << ";";
+    }
+    for (ClassFactorVector_T::const_iterator itFactor = _factorVector.begin();
+         itFactor != _factorVector.end(); ++itFactor) {
+      ostr << " " << *itFactor;
+    }
+    return ostr.str();
+  }
+}
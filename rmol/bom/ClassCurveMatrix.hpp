@@ -0,0 +1,115 @@
+#ifndef __RMOL_BOM_CLASSCURVEMATRIX_HPP
+#define __RMOL_BOM_CLASSCURVEMATRIX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/stdair_rm_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/bom/BookingClassTypes.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Dense (classes x DCPs) matrix of per-class curves defined on
+   * the DCPs, e.g., the sell-up or the dispatching factor curves.
+   *
+   * The rows follow the order of the given booking class list, and the
+   * columns are the DCP indices of the DCPCalendar. The factors of all
+   * the classes for a given DCP are contiguous in memory.
+   */
+  struct ClassCurveMatrix : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of classes (rows). */
+    unsigned int getNbOfClasses() const {
+      return _bookingClassVector.size();
+    }
+
+    /** Get the booking class of the given row. */
+    stdair::BookingClass& getBookingClass (const unsigned int iClass) const {
+      stdair::BookingClass* lBookingClass_ptr =
+        _bookingClassVector.at (iClass);
+      assert (lBookingClass_ptr != NULL);
+      return *lBookingClass_ptr;
+    }
+
+    /** Get the index (row) of the given booking class, which must be
+        part of the matrix. */
+    unsigned int getClassIndex (const stdair::BookingClass&) const;
+
+    /** Get the factor of the given class for the given DCP index. */
+    const double& getFactor (const unsigned int iClass,
+                             const DCPIndex_T& iDCPIndex) const {
+      return _factorVector.at (iDCPIndex * getNbOfClasses() + iClass);
+    }
+
+    /** Get the factors of all the classes for the given DCP index. */
+    const double* getFactorList (const DCPIndex_T& iDCPIndex) const {
+      return _factorVector.data() + iDCPIndex * getNbOfClasses();
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Compute the sell-up factors, from the lowest class of the list,
+     * of each class and each DCP.
+     */
+    void buildSellUpCurves (const stdair::FRAT5Curve_T&,
+                            const stdair::BookingClassList_T&);
+
+    /**
+     * Compute the dispatching factors, i.e., the part of the Q-equivalent
+     * demand going to each class, of each class and each DCP.
+     */
+    void buildDispatchingCurves (const stdair::FRAT5Curve_T&,
+                                 const stdair::BookingClassList_T&);
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+    /** Give a description of the classes and of all their factors, to
+        the last bit, e.g., as the version of the bookings converted
+        with the curves. */
+    const std::string describeFactors() const;
+
+  public:
+    /** Constructor. */
+    ClassCurveMatrix ();
+
+    /** Destructor. */
+    virtual ~ClassCurveMatrix();
+
+  private:
+    /** Reset the matrix for the given classes, with all the factors set
+        to 1.0, and return the FRAT5 coefficient, ln(0.5) / (FRAT5 - 1),
+        of each DCP. */
+    std::vector<double> reset (const stdair::FRAT5Curve_T&,
+                               const stdair::BookingClassList_T&);
+
+  private:
+    /** Booking classes (rows). */
+    std::vector<stdair::BookingClass*> _bookingClassVector;
+
+    /** Factors, DCP by DCP. */
+    ClassFactorVector_T _factorVector;
+  };
+}
+#endif // __RMOL_BOM_CLASSCURVEMATRIX_HPP
@@ -0,0 +1,135 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <vector>
+// StdAir
+#include <stdair/basic/BasConst_Inventory.hpp>
+// RMOL
+#include <rmol/bom/DCPCalendar.hpp>
+
+namespace RMOL {
+
+  namespace {
+
+    /**
+     * Tables of the DCP calendar, built once from the default DCP list.
+     */
+    struct DCPTables {
+      /** Constructor. */
+      DCPTables () {
+        const stdair::DCPList_T& lWholeDCPList = stdair::DEFAULT_DCP_LIST;
+        for (stdair::DCPList_T::const_iterator itDCP = lWholeDCPList.begin();
+             itDCP != lWholeDCPList.end(); ++itDCP) {
+          const stdair::DCP_T& lDCP = *itDCP;
+          assert (lDCP >= 0);
+          assert (_dcpVector.empty() == true || lDCP < _dcpVector.back());
+          _dcpVector.push_back (lDCP);
+        }
+        assert (_dcpVector.empty() == false);
+
+        // DTD -> DCP index lookup, the DTDs which are not DCPs being
+        // mapped onto the number of DCPs.
+        const DCPIndex_T lNbOfDCPs = _dcpVector.size();
+        _dcpIndexVector.assign (_dcpVector.front() + 1, lNbOfDCPs);
+        for (DCPIndex_T idx = 0; idx < lNbOfDCPs; ++idx) {
+          _dcpIndexVector[_dcpVector[idx]] = idx;
+        }
+
+        // DTD -> DCP interval index lookup, the DTDs from the last DCP
+        // onwards being mapped onto the number of intervals.
+        const DCPIndex_T lNbOfIntervals = lNbOfDCPs - 1;
+        _intervalIndexVector.assign (_dcpVector.front() + 1, lNbOfIntervals);
+        for (DCPIndex_T idx = 0; idx < lNbOfIntervals; ++idx) {
+          for (stdair::DTD_T lDTD = _dcpVector[idx];
+               lDTD > _dcpVector[idx+1]; --lDTD) {
+            _intervalIndexVector[lDTD] = idx;
+          }
+        }
+      }
+
+      /** DCPs, by index. */
+      std::vector<stdair::DCP_T> _dcpVector;
+
+      /** DCP indices, by DTD. */
+      std::vector<DCPIndex_T> _dcpIndexVector;
+
+      /** DCP interval indices, by DTD. */
+      std::vector<DCPIndex_T> _intervalIndexVector;
+    };
+
+    /** Retrieve the tables (built on the first call, in a thread-safe
+        way). */
+    const DCPTables& getDCPTables() {
+      static const DCPTables lDCPTables;
+      return lDCPTables;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPIndex_T DCPCalendar::getNbOfDCPs() {
+    return getDCPTables()._dcpVector.size();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::DCP_T& DCPCalendar::getDCP (const DCPIndex_T& iDCPIndex) {
+    const DCPTables& lDCPTables = getDCPTables();
+    assert (iDCPIndex < lDCPTables._dcpVector.size());
+    return lDCPTables._dcpVector[iDCPIndex];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPIndex_T DCPCalendar::getDCPIndex (const stdair::DCP_T& iDCP) {
+    const DCPTables& lDCPTables = getDCPTables();
+    assert (iDCP >= 0
+            && static_cast<unsigned int> (iDCP)
+            < lDCPTables._dcpIndexVector.size());
+    const DCPIndex_T& oDCPIndex = lDCPTables._dcpIndexVector[iDCP];
+    assert (oDCPIndex < lDCPTables._dcpVector.size());
+    return oDCPIndex;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DCPCalendar::isDCP (const stdair::DTD_T& iDTD) {
+    const DCPTables& lDCPTables = getDCPTables();
+    if (iDTD < 0
+        || static_cast<unsigned int> (iDTD)
+        >= lDCPTables._dcpIndexVector.size()) {
+      return false;
+    }
+    return (lDCPTables._dcpIndexVector[iDTD] < lDCPTables._dcpVector.size());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPIndex_T DCPCalendar::getNbOfIntervals() {
+    return getNbOfDCPs() - 1;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPIndex_T DCPCalendar::getIntervalIndex (const stdair::DTD_T& iDTD) {
+    const DCPTables& lDCPTables = getDCPTables();
+    if (iDTD < 0) {
+      return lDCPTables._dcpVector.size() - 1;
+    }
+    if (static_cast<unsigned int> (iDTD)
+        >= lDCPTables._intervalIndexVector.size()) {
+      return 0;
+    }
+    return lDCPTables._intervalIndexVector[iDTD];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::DCP_T& DCPCalendar::
+  getIntervalBegin (const DCPIndex_T& iIntervalIndex) {
+    assert (iIntervalIndex < getNbOfIntervals());
+    return getDCP (iIntervalIndex);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::DCP_T& DCPCalendar::
+  getIntervalEnd (const DCPIndex_T& iIntervalIndex) {
+    assert (iIntervalIndex < getNbOfIntervals());
+    return getDCP (iIntervalIndex + 1);
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef __RMOL_BOM_DCPCALENDAR_HPP
+#define __RMOL_BOM_DCPCALENDAR_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+namespace RMOL {
+
+  /**
+   * Class enumerating the DCPs of the default DCP list
+   * (stdair::DEFAULT_DCP_LIST), so that curves defined on the DCPs can
+   * be stored in dense arrays.
+   *
+   * The DCPs are indexed from the furthest one from the departure
+   * (index 0) to the departure day, following the order of the list.
+   * The DCP interval of index k spans the DTDs from the DCP of index k
+   * down to the DCP of index k+1, excluded.
+   *
+   * The lookup tables are built once, from the DCP list, on the first
+   * call; the queries then allocate nothing and run in constant time.
+   */
+  class DCPCalendar {
+  public:
+    /** Get the number of DCPs. */
+    static DCPIndex_T getNbOfDCPs();
+
+    /** Get the DCP of the given index. */
+    static const stdair::DCP_T& getDCP (const DCPIndex_T&);
+
+    /** Get the index of the given DCP, which must be part of the DCP
+        list. */
+    static DCPIndex_T getDCPIndex (const stdair::DCP_T&);
+
+    /** State whether the given DTD is a DCP. */
+    static bool isDCP (const stdair::DTD_T&);
+
+    /** Get the number of DCP intervals. */
+    static DCPIndex_T getNbOfIntervals();
+
+    /**
+     * Get the index of the DCP interval holding the given DTD, i.e., of
+     * the first interval which has not elapsed yet at that DTD. The DTDs
+     * before the first DCP are mapped onto the first interval, and the
+     * DTDs from the last DCP onwards onto the number of intervals (no
+     * interval left).
+     */
+    static DCPIndex_T getIntervalIndex (const stdair::DTD_T&);
+
+    /** Get the start (DCP) of the DCP interval of the given index. */
+    static const stdair::DCP_T& getIntervalBegin (const DCPIndex_T&);
+
+    /** Get the end (next DCP, excluded) of the DCP interval of the given
+        index. */
+    static const stdair::DCP_T& getIntervalEnd (const DCPIndex_T&);
+  };
+}
+#endif // __RMOL_BOM_DCPCALENDAR_HPP
@@ -0,0 +1,174 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/OnDDate.hpp>
+// RMOL
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/DCPEventIndex.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPEventIndex::DCPEventIndex () : _isBuilt (false), _emptyDueSet() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DCPEventIndex::~DCPEventIndex () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueSet* DCPEventIndex::
+  getDueSet (const stdair::Date_T& iDate,
+             const stdair::Inventory& iInventory) const {
+    assert (_isBuilt == true);
+    DueSetMap_T::const_iterator itDueSet =
+      _dueSetMap.find (DueKey_T (iDate, &iInventory));
+    if (itDueSet == _dueSetMap.end()) {
+      return &_emptyDueSet;
+    }
+    return &itDueSet->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueSet* DCPEventIndex::
+  getDueSet (const stdair::Date_T& iDate) const {
+    assert (_isBuilt == true);
+    NetworkDueSetMap_T::const_iterator itDueSet =
+      _networkDueSetMap.find (iDate);
+    if (itDueSet == _networkDueSetMap.end()) {
+      return &_emptyDueSet;
+    }
+    return &itDueSet->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueFlightDateList_T& DCPEventIndex::
+  getDueFlightDateList (const stdair::Date_T& iDate,
+                        const stdair::Inventory& iInventory) const {
+    const DueSet* lDueSet_ptr = getDueSet (iDate, iInventory);
+    assert (lDueSet_ptr != NULL);
+    return lDueSet_ptr->_flightDateList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueOnDDateList_T& DCPEventIndex::
+  getDueOnDDateList (const stdair::Date_T& iDate,
+                     const stdair::Inventory& iInventory) const {
+    const DueSet* lDueSet_ptr = getDueSet (iDate, iInventory);
+    assert (lDueSet_ptr != NULL);
+    return lDueSet_ptr->_onDDateList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueFlightDateList_T& DCPEventIndex::
+  getDueFlightDateList (const stdair::Date_T& iDate) const {
+    const DueSet* lDueSet_ptr = getDueSet (iDate);
+    assert (lDueSet_ptr != NULL);
+    return lDueSet_ptr->_flightDateList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex::DueOnDDateList_T& DCPEventIndex::
+  getDueOnDDateList (const stdair::Date_T& iDate) const {
+    const DueSet* lDueSet_ptr = getDueSet (iDate);
+    assert (lDueSet_ptr != NULL);
+    return lDueSet_ptr->_onDDateList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DCPEventIndex::build (const stdair::BomRoot& iBomRoot) {
+    _dueSetMap.clear();
+    _networkDueSetMap.clear();
+    _isBuilt = true;
+
+    const DCPIndex_T lNbOfDCPs = DCPCalendar::getNbOfDCPs();
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInventory_ptr = *itInv;
+      assert (lInventory_ptr != NULL);
+
+      // Register each flight-date on the dates of its DCPs.
+      const bool hasFlightDateList =
+        stdair::BomManager::hasList<stdair::FlightDate> (*lInventory_ptr);
+      if (hasFlightDateList == true) {
+        const stdair::FlightDateList_T& lFlightDateList =
+          stdair::BomManager::getList<stdair::FlightDate> (*lInventory_ptr);
+        for (stdair::FlightDateList_T::const_iterator itFD =
+               lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+          stdair::FlightDate* lFlightDate_ptr = *itFD;
+          assert (lFlightDate_ptr != NULL);
+          const stdair::Date_T& lDepartureDate =
+            lFlightDate_ptr->getDepartureDate();
+          for (DCPIndex_T idx = 0; idx < lNbOfDCPs; ++idx) {
+            const stdair::DateOffset_T lDCPOffset (DCPCalendar::getDCP (idx));
+            const stdair::Date_T lDueDate = lDepartureDate - lDCPOffset;
+            DueSet& lDueSet = _dueSetMap[DueKey_T (lDueDate, lInventory_ptr)];
+            lDueSet._flightDateList.push_back (lFlightDate_ptr);
+            DueSet& lNetworkDueSet = _networkDueSetMap[lDueDate];
+            lNetworkDueSet._flightDateList.push_back (lFlightDate_ptr);
+          }
+        }
+      }
+
+      // Register each O&D-date on the dates of its DCPs.
+      const bool hasOnDDateList =
+        stdair::BomManager::hasList<stdair::OnDDate> (*lInventory_ptr);
+      if (hasOnDDateList == true) {
+        const stdair::OnDDateList_T& lOnDDateList =
+          stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
+        for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
+             itOD != lOnDDateList.end(); ++itOD) {
+          stdair::OnDDate* lOnDDate_ptr = *itOD;
+          assert (lOnDDate_ptr != NULL);
+          const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
+          for (DCPIndex_T idx = 0; idx < lNbOfDCPs; ++idx) {
+            const stdair::DateOffset_T lDCPOffset (DCPCalendar::getDCP (idx));
+            const stdair::Date_T lDueDate = lDepartureDate - lDCPOffset;
+            DueSet& lDueSet = _dueSetMap[DueKey_T (lDueDate, lInventory_ptr)];
+            lDueSet._onDDateList.push_back (lOnDDate_ptr);
+            DueSet& lNetworkDueSet = _networkDueSetMap[lDueDate];
+            lNetworkDueSet._onDDateList.push_back (lOnDDate_ptr);
+          }
+        }
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DCPEventIndex::clear () {
+    _dueSetMap.clear();
+    _networkDueSetMap.clear();
+    _isBuilt = false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DCPEventIndex::toStream (std::ostream& ioOut) const {
+    for (DueSetMap_T::const_iterator itDueSet = _dueSetMap.begin();
+         itDueSet != _dueSetMap.end(); ++itDueSet) {
+      const DueKey_T& lDueKey = itDueSet->first;
+      const DueSet& lDueSet = itDueSet->second;
+      assert (lDueKey.second != NULL);
+      ioOut << lDueKey.first << ", " << lDueKey.second->describeKey() << ": "
+            << lDueSet._flightDateList.size() << " flight-dates, "
+            << lDueSet._onDDateList.size() << " O&D-dates" << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DCPEventIndex::describe() const {
+    std::ostringstream ostr;
+    ostr << "DCP event index (built: " << _isBuilt << ", "
+         << _dueSetMap.size() << " due sets).";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,141 @@
+#ifndef __RMOL_BOM_DCPEVENTINDEX_HPP
+#define __RMOL_BOM_DCPEVENTINDEX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+#include <map>
+// StdAir
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class Inventory;
+  class FlightDate;
+  class OnDDate;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Calendar index of the flight-dates and O&D-dates, by the dates
+   * on which they hit a DCP.
+   *
+   * A flight-date (resp. O&D-date) departing on the date D hits a DCP on
+   * the date D - DCP, for each DCP of the DCPCalendar. The index is built
+   * once from the BOM tree, so that each RM event only browses the
+   * flight-dates and O&D-dates which are due on its date, rather than the
+   * whole inventory. Within an inventory, the due objects are given in
+   * the order of the BOM tree.
+   *
+   * The index must be cleared whenever flight-dates or O&D-dates are
+   * added to (or removed from) the BOM tree.
+   */
+  struct DCPEventIndex : public stdair::StructAbstract {
+
+  public:
+    /** Define the list of due flight-dates. */
+    typedef std::vector<stdair::FlightDate*> DueFlightDateList_T;
+
+    /** Define the list of due O&D-dates. */
+    typedef std::vector<stdair::OnDDate*> DueOnDDateList_T;
+
+  public:
+    // ////// Getters //////
+    /** State whether the index has been built. */
+    bool isBuilt() const {
+      return _isBuilt;
+    }
+
+    /** Get the flight-dates of the given inventory hitting a DCP on the
+        given date. */
+    const DueFlightDateList_T&
+    getDueFlightDateList (const stdair::Date_T&,
+                          const stdair::Inventory&) const;
+
+    /** Get the O&D-dates of the given inventory hitting a DCP on the given
+        date. */
+    const DueOnDDateList_T& getDueOnDDateList (const stdair::Date_T&,
+                                               const stdair::Inventory&) const;
+
+    /** Get the flight-dates of all the inventories hitting a DCP on the
+        given date, inventory after inventory. */
+    const DueFlightDateList_T&
+    getDueFlightDateList (const stdair::Date_T&) const;
+
+    /** Get the O&D-dates of all the inventories hitting a DCP on the given
+        date, inventory after inventory. */
+    const DueOnDDateList_T& getDueOnDDateList (const stdair::Date_T&) const;
+
+  public:
+    // ////// Business Methods //////
+    /** Build the index from the flight-dates and O&D-dates of all the
+        inventories of the BOM tree. */
+    void build (const stdair::BomRoot&);
+
+    /** Clear the index. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    DCPEventIndex ();
+
+    /** Destructor. */
+    virtual ~DCPEventIndex();
+
+  private:
+    /** Objects of an inventory which are due on a given date. */
+    struct DueSet {
+      /** Due flight-dates. */
+      DueFlightDateList_T _flightDateList;
+
+      /** Due O&D-dates. */
+      DueOnDDateList_T _onDDateList;
+    };
+
+    /** Define the key of a due set, i.e., the date and the inventory. */
+    typedef std::pair<stdair::Date_T, const stdair::Inventory*> DueKey_T;
+
+    /** Define the map of due sets. */
+    typedef std::map<DueKey_T, DueSet> DueSetMap_T;
+
+    /** Define the map of the due sets of the whole network. */
+    typedef std::map<stdair::Date_T, DueSet> NetworkDueSetMap_T;
+
+    /** Retrieve the due set of the given date and inventory, if any. */
+    const DueSet* getDueSet (const stdair::Date_T&,
+                             const stdair::Inventory&) const;
+
+    /** Retrieve the due set of the given date, if any. */
+    const DueSet* getDueSet (const stdair::Date_T&) const;
+
+  private:
+    /** Whether the index has been built. */
+    bool _isBuilt;
+
+    /** Due sets, by date and inventory. */
+    DueSetMap_T _dueSetMap;
+
+    /** Due sets of the whole network, by date. */
+    NetworkDueSetMap_T _networkDueSetMap;
+
+    /** Empty due set, for the dates on which nothing is due. */
+    const DueSet _emptyDueSet;
+  };
+}
+#endif // __RMOL_BOM_DCPEVENTINDEX_HPP
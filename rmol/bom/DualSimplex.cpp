@@ -0,0 +1,400 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+// RMOL
+#include <rmol/OptimisationControl.hpp>
+#include <rmol/bom/DualSimplex.hpp>
+
+namespace RMOL {
+
+  namespace {
+    /** Tolerance on the violation of the bounds of the basic variables. */
+    const double LP_PRIMAL_TOLERANCE = 1e-7;
+
+    /** Tolerance on the sign of the reduced costs. */
+    const double LP_DUAL_TOLERANCE = 1e-7;
+
+    /** Smallest absolute value of an acceptable pivot. */
+    const double LP_PIVOT_TOLERANCE = 1e-9;
+
+    /** Number of iterations (i.e., of updates) between two factorisations
+        of the basis. */
+    const unsigned int LP_REFACTORISATION_FREQUENCY = 100;
+
+    /** Maximal number of iterations, by variable. */
+    const unsigned int LP_MAX_NB_OF_ITERATIONS_BY_VARIABLE = 20;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DualSimplex::DualSimplex ()
+    : _nbOfRows (0), _nbOfColumns (0), _columnPointerList_ptr (NULL),
+      _rowIndexList_ptr (NULL), _objectiveList_ptr (NULL),
+      _isOptimal (false), _isInfeasible (false), _isUnbounded (false),
+      _isInterrupted (false), _nbOfIterations (0), _objectiveValue (0.0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DualSimplex::~DualSimplex () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double DualSimplex::getCost (const unsigned int iVarIdx) const {
+    if (iVarIdx < _nbOfColumns) {
+      return -(*_objectiveList_ptr)[iVarIdx];
+    }
+    return 0.0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double DualSimplex::getUpperBound (const unsigned int iVarIdx) const {
+    assert (iVarIdx < _upperBoundList.size());
+    return _upperBoundList[iVarIdx];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double DualSimplex::
+  getProduct (const unsigned int iVarIdx,
+              const std::vector<double>& iRowValueList) const {
+    if (iVarIdx >= _nbOfColumns) {
+      return iRowValueList[iVarIdx - _nbOfColumns];
+    }
+    const std::vector<unsigned int>& lColumnPointerList =
+      *_columnPointerList_ptr;
+    const std::vector<unsigned int>& lRowIndexList = *_rowIndexList_ptr;
+    double oProduct = 0.0;
+    for (unsigned int lPos = lColumnPointerList[iVarIdx];
+         lPos < lColumnPointerList[iVarIdx + 1]; ++lPos) {
+      oProduct += iRowValueList[lRowIndexList[lPos]];
+    }
+    return oProduct;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DualSimplex::getBasisColumn (const unsigned int iVarIdx,
+                                    std::vector<double>& oColumn) const {
+    oColumn.assign (_nbOfRows, 0.0);
+    if (iVarIdx >= _nbOfColumns) {
+      oColumn[iVarIdx - _nbOfColumns] = 1.0;
+    } else {
+      const std::vector<unsigned int>& lColumnPointerList =
+        *_columnPointerList_ptr;
+      const std::vector<unsigned int>& lRowIndexList = *_rowIndexList_ptr;
+      for (unsigned int lPos = lColumnPointerList[iVarIdx];
+           lPos < lColumnPointerList[iVarIdx + 1]; ++lPos) {
+        oColumn[lRowIndexList[lPos]] += 1.0;
+      }
+    }
+    _basisFactorisation.solve (oColumn);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DualSimplex::pivot (const unsigned int iRowIdx,
+                           const unsigned int iVarIdx,
+                           const std::vector<double>& iColumn) {
+    assert (std::fabs (iColumn[iRowIdx]) > LP_PIVOT_TOLERANCE);
+    _basisFactorisation.update (iRowIdx, iColumn);
+
+    // Swap the basic variables.
+    _basicFlagList[_basisList[iRowIdx]] = false;
+    _basisList[iRowIdx] = iVarIdx;
+    _basicFlagList[iVarIdx] = true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DualSimplex::factorise (const FlagVector_T& iBasicFlagList) {
+    const unsigned int m = _nbOfRows;
+    const unsigned int n = _nbOfColumns;
+    const std::vector<unsigned int>& lColumnPointerList =
+      *_columnPointerList_ptr;
+    const std::vector<unsigned int>& lRowIndexList = *_rowIndexList_ptr;
+
+    // Candidate columns: the flagged slacks, then the flagged columns, so
+    // that a flagged column only replaces a slack which is not flagged.
+    std::vector<unsigned int> lCandidateList;
+    std::vector<unsigned int> lCandidatePointerList (1, 0);
+    std::vector<unsigned int> lCandidateRowIndexList;
+    for (unsigned int r = 0; r < m; ++r) {
+      if (iBasicFlagList[n + r] == true) {
+        lCandidateList.push_back (n + r);
+        lCandidateRowIndexList.push_back (r);
+        lCandidatePointerList.push_back (lCandidateRowIndexList.size());
+      }
+    }
+    for (unsigned int j = 0; j < n; ++j) {
+      if (iBasicFlagList[j] == true) {
+        lCandidateList.push_back (j);
+        lCandidateRowIndexList.insert (lCandidateRowIndexList.end(),
+                                       lRowIndexList.begin()
+                                       + lColumnPointerList[j],
+                                       lRowIndexList.begin()
+                                       + lColumnPointerList[j + 1]);
+        lCandidatePointerList.push_back (lCandidateRowIndexList.size());
+      }
+    }
+    const std::vector<double> lCandidateValueList
+      (lCandidateRowIndexList.size(), 1.0);
+
+    // The basis is completed with the slacks of the uncovered rows.
+    const unsigned int lNbOfCandidates = lCandidateList.size();
+    std::vector<unsigned int> lBasisList;
+    _basisFactorisation.factorise (m, lCandidatePointerList,
+                                   lCandidateRowIndexList,
+                                   lCandidateValueList, lBasisList);
+    _basisList.resize (m);
+    _basicFlagList.assign (n + m, false);
+    for (unsigned int r = 0; r < m; ++r) {
+      const unsigned int lCandidateIdx = lBasisList[r];
+      const unsigned int lVarIdx = (lCandidateIdx < lNbOfCandidates)
+        ? lCandidateList[lCandidateIdx] : n + lCandidateIdx - lNbOfCandidates;
+      _basisList[r] = lVarIdx;
+      _basicFlagList[lVarIdx] = true;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DualSimplex::
+  solve (const unsigned int iNbOfRows,
+         const std::vector<unsigned int>& iColumnPointerList,
+         const std::vector<unsigned int>& iRowIndexList,
+         const std::vector<double>& iObjectiveList,
+         const std::vector<double>& iUpperBoundList,
+         const std::vector<double>& iRightHandSideList,
+         FlagVector_T& ioBasicFlagList,
+         const OptimisationControl* iControl_ptr) {
+    _nbOfRows = iNbOfRows;
+    _nbOfColumns = iObjectiveList.size();
+    _columnPointerList_ptr = &iColumnPointerList;
+    _rowIndexList_ptr = &iRowIndexList;
+    _objectiveList_ptr = &iObjectiveList;
+    const unsigned int m = _nbOfRows;
+    const unsigned int n = _nbOfColumns;
+    const unsigned int lNbOfVariables = n + m;
+    assert (iColumnPointerList.size() == n + 1);
+    assert (iUpperBoundList.size() == n);
+    assert (iRightHandSideList.size() == m);
+
+    _isOptimal = false;
+    _isInfeasible = false;
+    _isUnbounded = false;
+    _isInterrupted = false;
+    _nbOfIterations = 0;
+    _objectiveValue = 0.0;
+    _primalList.assign (n, 0.0);
+    _dualList.assign (m, 0.0);
+
+    // A row with a negative right-hand side cannot be satisfied, as the
+    // matrix and the variables are non-negative.
+    _upperBoundList.resize (lNbOfVariables);
+    for (unsigned int r = 0; r < m; ++r) {
+      if (iRightHandSideList[r] < 0.0) {
+        _isInfeasible = true;
+        return false;
+      }
+      _upperBoundList[n + r] = iRightHandSideList[r];
+    }
+
+    // Each column is bounded by the right-hand sides of its rows, which
+    // replace the infinite upper bounds. A column without any row and
+    // with a positive objective coefficient cannot be bounded.
+    const double lInfinity = std::numeric_limits<double>::infinity();
+    for (unsigned int j = 0; j < n; ++j) {
+      double lUpperBound = iUpperBoundList[j];
+      if (lUpperBound < lInfinity) {
+        _upperBoundList[j] = lUpperBound;
+        continue;
+      }
+      for (unsigned int lPos = iColumnPointerList[j];
+           lPos < iColumnPointerList[j + 1]; ++lPos) {
+        lUpperBound =
+          std::min (lUpperBound, iRightHandSideList[iRowIndexList[lPos]]);
+      }
+      if (lUpperBound == lInfinity) {
+        if (iObjectiveList[j] > 0.0) {
+          _isUnbounded = true;
+          return false;
+        }
+        lUpperBound = 0.0;
+      }
+      _upperBoundList[j] = lUpperBound;
+    }
+
+    // Starting basis: the given one (warm start) or the slacks.
+    if (ioBasicFlagList.size() == lNbOfVariables) {
+      factorise (ioBasicFlagList);
+    } else {
+      factorise (FlagVector_T (lNbOfVariables, false));
+    }
+    _atUpperFlagList.assign (lNbOfVariables, false);
+
+    std::vector<double> lValueList (lNbOfVariables, 0.0);
+    std::vector<double> lReducedCostList (lNbOfVariables, 0.0);
+    std::vector<double> lSimplexMultiplierList (m);
+    std::vector<double> lRightHandSideList (m);
+    std::vector<double> lPivotRow (m);
+    std::vector<double> lColumn (m);
+
+    const unsigned int lMaxNbOfIterations =
+      LP_MAX_NB_OF_ITERATIONS_BY_VARIABLE * lNbOfVariables;
+    while (true) {
+      // Re-compute the factorisation of the basis from time to time, so
+      // as to keep the eta file short and to get rid of the rounding
+      // errors.
+      if (_basisFactorisation.getNbOfUpdates()
+          >= LP_REFACTORISATION_FREQUENCY) {
+        const FlagVector_T lBasicFlagList (_basicFlagList);
+        factorise (lBasicFlagList);
+      }
+
+      // Simplex multipliers y = c_B.B^-1.
+      for (unsigned int r = 0; r < m; ++r) {
+        lSimplexMultiplierList[r] = getCost (_basisList[r]);
+      }
+      _basisFactorisation.solveTranspose (lSimplexMultiplierList);
+
+      // Reduced costs, and non-basic variables at the bound keeping the
+      // basis dual feasible.
+      lRightHandSideList = iRightHandSideList;
+      for (unsigned int j = 0; j < lNbOfVariables; ++j) {
+        if (_basicFlagList[j] == true) {
+          lReducedCostList[j] = 0.0;
+          continue;
+        }
+        lReducedCostList[j] =
+          getCost (j) - getProduct (j, lSimplexMultiplierList);
+        const double lUpperBound = getUpperBound (j);
+        if (lUpperBound <= 0.0) {
+          _atUpperFlagList[j] = false;
+        } else if (lReducedCostList[j] < -LP_DUAL_TOLERANCE) {
+          _atUpperFlagList[j] = true;
+        } else if (lReducedCostList[j] > LP_DUAL_TOLERANCE) {
+          _atUpperFlagList[j] = false;
+        }
+        lValueList[j] = (_atUpperFlagList[j] == true) ? lUpperBound : 0.0;
+        if (lValueList[j] == 0.0) {
+          continue;
+        }
+        if (j >= n) {
+          lRightHandSideList[j - n] -= lValueList[j];
+          continue;
+        }
+        for (unsigned int lPos = iColumnPointerList[j];
+             lPos < iColumnPointerList[j + 1]; ++lPos) {
+          lRightHandSideList[iRowIndexList[lPos]] -= lValueList[j];
+        }
+      }
+
+      // Basic variables x_B = B^-1.(b - N.x_N), and the most violated
+      // bound, if any.
+      unsigned int lLeavingRowIdx = m;
+      double lMaxViolation = LP_PRIMAL_TOLERANCE;
+      _basisFactorisation.solve (lRightHandSideList);
+      for (unsigned int r = 0; r < m; ++r) {
+        const double lValue = lRightHandSideList[r];
+        const unsigned int lBasicVarIdx = _basisList[r];
+        lValueList[lBasicVarIdx] = lValue;
+        const double lUpperBound = getUpperBound (lBasicVarIdx);
+        const double lViolation = (lValue < 0.0) ? -lValue
+          : lValue - lUpperBound;
+        if (lViolation > lMaxViolation) {
+          lMaxViolation = lViolation;
+          lLeavingRowIdx = r;
+        }
+      }
+
+      // The basis is primal feasible: it is optimal.
+      if (lLeavingRowIdx == m) {
+        _isOptimal = true;
+        break;
+      }
+      if (_nbOfIterations >= lMaxNbOfIterations) {
+        break;
+      }
+      if (iControl_ptr != NULL && iControl_ptr->isStopRequested() == true) {
+        _isInterrupted = true;
+        break;
+      }
+      ++_nbOfIterations;
+
+      // Ratio test on the pivot row, so that the reduced costs keep their
+      // signs when the leaving variable is moved to its violated bound.
+      const unsigned int lLeavingVarIdx = _basisList[lLeavingRowIdx];
+      const bool isBelowLowerBound = (lValueList[lLeavingVarIdx] < 0.0);
+      lPivotRow.assign (m, 0.0);
+      lPivotRow[lLeavingRowIdx] = 1.0;
+      _basisFactorisation.solveTranspose (lPivotRow);
+      unsigned int lEnteringVarIdx = lNbOfVariables;
+      double lMinRatio = 0.0;
+      double lMaxPivot = 0.0;
+      for (unsigned int j = 0; j < lNbOfVariables; ++j) {
+        if (_basicFlagList[j] == true || getUpperBound (j) <= 0.0) {
+          continue;
+        }
+        const double lAlpha = getProduct (j, lPivotRow);
+        const double lSignedAlpha = (isBelowLowerBound == true) ? -lAlpha
+          : lAlpha;
+        const bool isEligible = (_atUpperFlagList[j] == false)
+          ? (lSignedAlpha > LP_PIVOT_TOLERANCE)
+          : (lSignedAlpha < -LP_PIVOT_TOLERANCE);
+        if (isEligible == false) {
+          continue;
+        }
+        const double lRatio =
+          std::fabs (lReducedCostList[j]) / std::fabs (lAlpha);
+        if (lEnteringVarIdx == lNbOfVariables || lRatio < lMinRatio - 1e-12
+            || (lRatio <= lMinRatio + 1e-12
+                && std::fabs (lAlpha) > lMaxPivot)) {
+          lEnteringVarIdx = j;
+          lMinRatio = lRatio;
+          lMaxPivot = std::fabs (lAlpha);
+        }
+      }
+
+      // No variable can move the leaving one back within its bounds:
+      // the program is infeasible.
+      if (lEnteringVarIdx == lNbOfVariables) {
+        _isInfeasible = true;
+        break;
+      }
+
+      getBasisColumn (lEnteringVarIdx, lColumn);
+      pivot (lLeavingRowIdx, lEnteringVarIdx, lColumn);
+      _atUpperFlagList[lLeavingVarIdx] = !isBelowLowerBound;
+    }
+
+    // Solution.
+    for (unsigned int j = 0; j < n; ++j) {
+      const double lValue =
+        std::min (std::max (lValueList[j], 0.0), _upperBoundList[j]);
+      _primalList[j] = lValue;
+      _objectiveValue += iObjectiveList[j] * lValue;
+    }
+    for (unsigned int k = 0; k < m; ++k) {
+      _dualList[k] = -lSimplexMultiplierList[k];
+    }
+    ioBasicFlagList = _basicFlagList;
+    return _isOptimal;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DualSimplex::toStream (std::ostream& ioOut) const {
+    ioOut << describe() << std::endl;
+    for (unsigned int k = 0; k < _dualList.size(); ++k) {
+      ioOut << "Row " << k << ": dual " << _dualList[k] << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DualSimplex::describe() const {
+    std::ostringstream ostr;
+    ostr << "Dual simplex (" << _nbOfRows << " rows, " << _nbOfColumns
+         << " columns): optimal: " << _isOptimal << ", "
+         << _nbOfIterations << " iterations, objective " << _objectiveValue;
+    return ostr.str();
+  }
+}
@@ -0,0 +1,226 @@
+#ifndef __RMOL_BOM_DUALSIMPLEX_HPP
+#define __RMOL_BOM_DUALSIMPLEX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/BasisFactorisation.hpp>
+
+namespace RMOL {
+
+  // Forward declarations
+  class OptimisationControl;
+
+  /**
+   * @brief Bounded dual simplex solver for the packing linear programs
+   * of the network optimisation.
+   *
+   * The solved linear program is:
+   * max c.x subject to A.x <= b and 0 <= x <= u,
+   * where A is a 0/1 matrix given column by column (compressed sparse
+   * column format). A slack variable s, bounded by 0 <= s <= b, is added
+   * to each row, so that all the variables are boxed (an infinite upper
+   * bound u being replaced by the smallest right-hand side of the rows
+   * of its column): any basis is then dual feasible, once its non-basic
+   * variables are set to the bound given by the sign of their reduced
+   * cost. The solver may therefore start from any basis, e.g., from the
+   * optimal basis of a former (similar) program (warm start), the slacks
+   * being used where the given basis is incomplete or singular.
+   *
+   * The program is infeasible when a right-hand side is negative, and
+   * unbounded when a column with a positive objective coefficient and an
+   * infinite upper bound does not belong to any row.
+   *
+   * The basis is kept as a sparse LU factorisation (see
+   * BasisFactorisation), updated in product form at each iteration and
+   * re-computed from scratch on a regular basis.
+   *
+   * When a control is given, it is checked before each iteration: once a
+   * stop is requested, the resolution is interrupted (without reaching
+   * optimality).
+   */
+  struct DualSimplex : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** State whether the last solved program reached optimality. */
+    bool isOptimal() const {
+      return _isOptimal;
+    }
+
+    /** State whether the last solved program was found infeasible. */
+    bool isInfeasible() const {
+      return _isInfeasible;
+    }
+
+    /** State whether the last solved program was found unbounded. */
+    bool isUnbounded() const {
+      return _isUnbounded;
+    }
+
+    /** State whether the last resolution was interrupted by its
+        control. */
+    bool isInterrupted() const {
+      return _isInterrupted;
+    }
+
+    /** Get the number of iterations of the last resolution. */
+    const unsigned int& getNbOfIterations() const {
+      return _nbOfIterations;
+    }
+
+    /** Get the value of the objective function. */
+    const double& getObjectiveValue() const {
+      return _objectiveValue;
+    }
+
+    /** Get the primal solution x, by column. */
+    const std::vector<double>& getPrimalList() const {
+      return _primalList;
+    }
+
+    /** Get the dual solution (shadow prices of the rows), by row. */
+    const std::vector<double>& getDualList() const {
+      return _dualList;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Solve the given linear program, and return whether it reached
+     * optimality.
+     *
+     * @param const unsigned int Number of rows.
+     * @param const std::vector<unsigned int>& Column pointers: the rows of
+     *        the column j are given by the positions from the j-th pointer
+     *        (included) to the (j+1)-th one (excluded) of the row indices.
+     * @param const std::vector<unsigned int>& Row indices.
+     * @param const std::vector<double>& Objective coefficients c, by
+     *        column.
+     * @param const std::vector<double>& Upper bounds u, by column (may be
+     *        infinite).
+     * @param const std::vector<double>& Right-hand sides b, by row.
+     * @param FlagVector_T& Basis, i.e., whether each variable (the columns
+     *        followed by the slacks of the rows) is basic: used as the
+     *        starting basis when it has the right size (warm start), and
+     *        replaced by the final basis.
+     * @param const OptimisationControl* Control of the resolution, if any.
+     */
+    bool solve (const unsigned int iNbOfRows,
+                const std::vector<unsigned int>& iColumnPointerList,
+                const std::vector<unsigned int>& iRowIndexList,
+                const std::vector<double>& iObjectiveList,
+                const std::vector<double>& iUpperBoundList,
+                const std::vector<double>& iRightHandSideList,
+                FlagVector_T& ioBasicFlagList,
+                const OptimisationControl* iControl_ptr = NULL);
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    DualSimplex ();
+
+    /** Destructor. */
+    virtual ~DualSimplex();
+
+  private:
+    /** Get the cost (minimisation form) of the given variable. */
+    double getCost (const unsigned int iVarIdx) const;
+
+    /** Get the upper bound of the given variable. */
+    double getUpperBound (const unsigned int iVarIdx) const;
+
+    /** Get the scalar product of the column of the given variable with
+        the given vector (by row). */
+    double getProduct (const unsigned int iVarIdx,
+                       const std::vector<double>& iRowValueList) const;
+
+    /** Get the column of the given variable in the current basis, i.e.,
+        the inverse of the basis multiplied by that column. */
+    void getBasisColumn (const unsigned int iVarIdx,
+                         std::vector<double>& oColumn) const;
+
+    /** Replace the basic variable of the given row by the given variable,
+        the column of which in the current basis is given. */
+    void pivot (const unsigned int iRowIdx, const unsigned int iVarIdx,
+                const std::vector<double>& iColumn);
+
+    /** Factorise a basis holding as many of the flagged variables as
+        possible (the slacks first), completed with slacks. */
+    void factorise (const FlagVector_T& iBasicFlagList);
+
+  private:
+    /** Number of rows of the program being solved. */
+    unsigned int _nbOfRows;
+
+    /** Number of columns (without the slacks) of the program being
+        solved. */
+    unsigned int _nbOfColumns;
+
+    /** Upper bounds of the variables (the columns followed by the
+        slacks), infinite bounds being replaced by the implied ones. */
+    std::vector<double> _upperBoundList;
+
+    /** Column pointers of the program being solved. */
+    const std::vector<unsigned int>* _columnPointerList_ptr;
+
+    /** Row indices of the program being solved. */
+    const std::vector<unsigned int>* _rowIndexList_ptr;
+
+    /** Objective coefficients of the program being solved. */
+    const std::vector<double>* _objectiveList_ptr;
+
+    /** Basic variable, by row. */
+    std::vector<unsigned int> _basisList;
+
+    /** Whether each variable is basic. */
+    FlagVector_T _basicFlagList;
+
+    /** Whether each non-basic variable is at its upper bound. */
+    FlagVector_T _atUpperFlagList;
+
+    /** Factorisation of the basis. */
+    BasisFactorisation _basisFactorisation;
+
+    /** Whether the last solved program reached optimality. */
+    bool _isOptimal;
+
+    /** Whether the last solved program was found infeasible. */
+    bool _isInfeasible;
+
+    /** Whether the last solved program was found unbounded. */
+    bool _isUnbounded;
+
+    /** Whether the last resolution was interrupted by its control. */
+    bool _isInterrupted;
+
+    /** Number of iterations of the last resolution. */
+    unsigned int _nbOfIterations;
+
+    /** Value of the objective function. */
+    double _objectiveValue;
+
+    /** Primal solution, by column. */
+    std::vector<double> _primalList;
+
+    /** Dual solution, by row. */
+    std::vector<double> _dualList;
+  };
+}
+#endif // __RMOL_BOM_DUALSIMPLEX_HPP
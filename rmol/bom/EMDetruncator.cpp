@@ -11,6 +11,8 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
 #include <rmol/bom/EMDetruncator.hpp>
 
 namespace RMOL {
@@ -94,4 +96,169 @@ namespace RMOL {
     }
       
   }
+
+  // ////////////////////////////////////////////////////////////////////
+  void EMDetruncator::unconstrain
+  (HistoricalBookingMatrix& ioHBMatrix, const unsigned int iNbOfThreads) {
+    // The series are independent from each other: each one is
+    // unconstrained by a single task, which writes only into the
+    // elements of that series.
+    const SeriesIndex_T lNbOfSeries = ioHBMatrix.getNbOfSeries();
+    ParallelLoop::run (lNbOfSeries,
+                       [&ioHBMatrix] (const unsigned int iSeries) {
+                         unconstrainSeries (ioHBMatrix, iSeries);
+                       },
+                       iNbOfThreads);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void EMDetruncator::unconstrainSeries
+  (HistoricalBookingMatrix& ioHBMatrix, const SeriesIndex_T iSeries) {
+    // Packed data of the series. The computations below are the same as
+    // the ones performed on a HistoricalBookingHolder, but they run over
+    // contiguous arrays.
+    const short lNbOfFlights = ioHBMatrix.getNbOfFlights (iSeries);
+    const unsigned int lOffset = ioHBMatrix.getOffset (iSeries);
+    const stdair::NbOfBookings_T* lBookings =
+      ioHBMatrix.getHistoricalBookingVector().data() + lOffset;
+    const FlagVector_T& lFlagVector = ioHBMatrix.getCensorshipFlagVector();
+    stdair::NbOfBookings_T* lDemands =
+      ioHBMatrix.getUnconstrainedDemandVector().data() + lOffset;
+
+    // Number and sum of the uncensored booking data.
+    short lNbOfUncensoredData = 0;
+    stdair::NbOfBookings_T lNbOfUncensoredBookings = 0;
+    std::vector<char> toBeUnconstrained (lNbOfFlights, 0);
+    for (short i = 0; i < lNbOfFlights; ++i) {
+      if (lFlagVector[lOffset + i] == false) {
+        ++lNbOfUncensoredData;
+        lNbOfUncensoredBookings += lBookings[i];
+      } else {
+        toBeUnconstrained[i] = 1;
+      }
+    }
+
+    if (lNbOfUncensoredData > 1) {
+      const double lMeanOfUncensoredBookings =
+        static_cast<double>(lNbOfUncensoredBookings/lNbOfUncensoredData);
+
+      double lStdDevOfUncensoredBookings = 0;
+      for (short i = 0; i < lNbOfFlights; ++i) {
+        if (toBeUnconstrained[i] == 0) {
+          const double lDiff = lBookings[i] - lMeanOfUncensoredBookings;
+          lStdDevOfUncensoredBookings += lDiff * lDiff;
+        }
+      }
+      lStdDevOfUncensoredBookings /= (lNbOfUncensoredData - 1);
+      lStdDevOfUncensoredBookings = std::sqrt (lStdDevOfUncensoredBookings);
+
+      double lDemandMean = lMeanOfUncensoredBookings;
+      double lStdDev = lStdDevOfUncensoredBookings;
+
+      if (lStdDev != 0) {
+        bool stopUnconstraining = false;
+        while (stopUnconstraining == false) {
+          stopUnconstraining = true;
+
+          for (short i = 0; i < lNbOfFlights; ++i) {
+            if (toBeUnconstrained[i] == 1) {
+              // Execute the Expectation step.
+              const stdair::NbOfBookings_T demand = lDemands[i];
+              const stdair::NbOfBookings_T expectedDemand =
+                calculateExpectedDemand (static_cast<double> (lBookings[i]),
+                                         lDemandMean, lStdDev, demand);
+
+              const double absDiff =
+                std::fabs (static_cast<double>(expectedDemand - demand));
+              if (absDiff < 0.001) {
+                toBeUnconstrained[i] = 0;
+              } else {
+                stopUnconstraining = false;
+              }
+
+              lDemands[i] = expectedDemand;
+            }
+          }
+
+          // Execute the Maximisation step.
+          if (stopUnconstraining == false) {
+            lDemandMean = 0;
+            for (short i = 0; i < lNbOfFlights; ++i) {
+              lDemandMean += static_cast<double> (lDemands[i]);
+            }
+            lDemandMean /= lNbOfFlights;
+
+            lStdDev = 0;
+            for (short i = 0; i < lNbOfFlights; ++i) {
+              const double lDiff =
+                static_cast<double> (lDemands[i]) - lDemandMean;
+              lStdDev += lDiff * lDiff;
+            }
+            lStdDev /= (lNbOfFlights - 1);
+            lStdDev = std::sqrt (lStdDev);
+          }
+        }
+      }
+    }
+
+    // Compute the distribution parameters of the unconstrained demand,
+    // the same way as Utilities::computeDistributionParameters() does.
+    stdair::MeanValue_T lMean = 0.0;
+    stdair::StdDevValue_T lStdDev = 0.0;
+    if (lNbOfFlights > 0) {
+      for (short i = 0; i < lNbOfFlights; ++i) {
+        lMean += lDemands[i];
+      }
+      lMean /= lNbOfFlights;
+    }
+    if (lNbOfFlights > 1) {
+      for (short i = 0; i < lNbOfFlights; ++i) {
+        lStdDev += (lDemands[i] - lMean) * (lDemands[i] - lMean);
+      }
+      lStdDev /= (lNbOfFlights - 1);
+      lStdDev = std::sqrt (lStdDev);
+    }
+
+    // Sanity check
+    if (lStdDev == 0) {
+      lStdDev = 0.1;
+    }
+    ioHBMatrix.setDistributionParameters (iSeries, lMean, lStdDev);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::NbOfBookings_T EMDetruncator::
+  calculateExpectedDemand (const double iBooking, const double iMean,
+                           const double iSD,
+                           const stdair::NbOfBookings_T iDemand) {
+    double e, d1, d2;
+
+    e = - (iBooking - iMean) * (iBooking - iMean) * 0.625 / (iSD * iSD);
+    e = exp (e);
+
+    double s = std::sqrt (1 - e);
+
+    if (iBooking >= iMean) {
+      if (e < 0.01) {
+        return iDemand;
+      }
+      d1 = 0.5 * (1 - s);
+    }
+    else {
+      d1 = 0.5 * (1 + s);
+    }
+
+    e = - (iBooking - iMean) * (iBooking - iMean) * 0.5 / (iSD * iSD);
+    e = exp (e);
+    d2 = e * iSD / std::sqrt(2 * 3.14159265);
+
+    if (d1 == 0) {
+      return iDemand;
+    }
+
+    const stdair::NbOfBookings_T lDemand =
+      static_cast<stdair::NbOfBookings_T> (iMean + d2/d1);
+
+    return lDemand;
+  }
 }
@@ -4,6 +4,11 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// RMOL
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+
 namespace RMOL {
   // Forward declarations.
   struct HistoricalBookingHolder;
@@ -14,6 +19,38 @@ namespace RMOL {
     /** Unconstrain the censored booking data using the Expection-Maximisation
         algorithm. */
     static void unconstrain (HistoricalBookingHolder&);
+
+    /**
+     * Unconstrain, in one go, all the series of censored booking data of
+     * the matrix, using the Expection-Maximisation algorithm. The mean and
+     * the standard deviation of the unconstrained demand of each series
+     * are then stored within the matrix.
+     *
+     * @param HistoricalBookingMatrix& Series of historical bookings.
+     * @param const unsigned int Number of threads on which the series
+     *        are spread.
+     */
+    static void unconstrain (HistoricalBookingMatrix&, const unsigned int);
+
+    /**
+     * Calculate the expected demand of a censored flight (Expectation
+     * step), given its historical bookings and the current estimation
+     * of the demand distribution.
+     *
+     * @param const double Historical bookings of the flight.
+     * @param const double Current demand mean.
+     * @param const double Current demand standard deviation.
+     * @param const stdair::NbOfBookings_T Current unconstrained demand.
+     */
+    static stdair::NbOfBookings_T
+    calculateExpectedDemand (const double, const double, const double,
+                             const stdair::NbOfBookings_T);
+
+  private:
+    /** Unconstrain the given series of the matrix, and compute the
+        distribution parameters of its unconstrained demand. */
+    static void unconstrainSeries (HistoricalBookingMatrix&,
+                                   const SeriesIndex_T);
   };
 }
 #endif // __RMOL_BOM_EMDETRUNCATOR_HPP
@@ -0,0 +1,123 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/SegmentCabin.hpp>
+// RMOL
+#include <rmol/bom/SegmentCabinForecast.hpp>
+#include <rmol/bom/ForecastCache.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  ForecastCache::ForecastCache () : _snapshotStamp (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  ForecastCache::~ForecastCache () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int ForecastCache::getNbOfForecasts () const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    return _forecastMap.size();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SnapshotStamp_T ForecastCache::getSnapshotStamp () const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    return _snapshotStamp;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool ForecastCache::
+  restore (stdair::SegmentCabin& ioSegmentCabin,
+           const std::string& iSegmentCabinKey,
+           const stdair::Date_T& iEventDate,
+           const stdair::ForecastingMethod& iForecastingMethod,
+           const stdair::UnconstrainingMethod& iUnconstrainingMethod,
+           bool& oIsForecasted) const {
+    boost::shared_ptr<SegmentCabinForecast> lForecast_ptr;
+    SnapshotStamp_T lSnapshotStamp = 0;
+    {
+      std::lock_guard<std::mutex> lLock (_mutex);
+      ForecastMap_T::const_iterator itForecast =
+        _forecastMap.find (iSegmentCabinKey);
+      if (itForecast == _forecastMap.end()) {
+        return false;
+      }
+      lForecast_ptr = itForecast->second;
+      lSnapshotStamp = _snapshotStamp;
+    }
+    assert (lForecast_ptr.get() != NULL);
+
+    if (lForecast_ptr->isFor (iEventDate, lSnapshotStamp, iForecastingMethod,
+                              iUnconstrainingMethod) == false) {
+      return false;
+    }
+
+    // When the segment-cabin could not be forecasted, it was not altered.
+    oIsForecasted = lForecast_ptr->isForecasted();
+    if (oIsForecasted == true) {
+      lForecast_ptr->restore (ioSegmentCabin);
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ForecastCache::
+  save (const stdair::SegmentCabin& iSegmentCabin,
+        const std::string& iSegmentCabinKey,
+        const stdair::Date_T& iEventDate,
+        const SnapshotStamp_T& iSnapshotStamp,
+        const stdair::ForecastingMethod& iForecastingMethod,
+        const stdair::UnconstrainingMethod& iUnconstrainingMethod,
+        const bool iIsForecasted) {
+    boost::shared_ptr<SegmentCabinForecast>
+      lForecast_ptr (new SegmentCabinForecast (iEventDate, iSnapshotStamp,
+                                               iForecastingMethod,
+                                               iUnconstrainingMethod,
+                                               iIsForecasted));
+    if (iIsForecasted == true) {
+      lForecast_ptr->save (iSegmentCabin);
+    }
+
+    std::lock_guard<std::mutex> lLock (_mutex);
+    _forecastMap[iSegmentCabinKey] = lForecast_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ForecastCache::notifySnapshotUpdate () {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    ++_snapshotStamp;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ForecastCache::clear () {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    _forecastMap.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ForecastCache::toStream (std::ostream& ioOut) const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    for (ForecastMap_T::const_iterator itForecast = _forecastMap.begin();
+         itForecast != _forecastMap.end(); ++itForecast) {
+      assert (itForecast->second.get() != NULL);
+      ioOut << itForecast->first << ": " << itForecast->second->describe()
+            << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string ForecastCache::describe() const {
+    std::ostringstream ostr;
+    ostr << "Cache of " << getNbOfForecasts()
+         << " segment-cabin forecasts, on the snapshots "
+         << getSnapshotStamp() << ".";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,140 @@
+#ifndef __RMOL_BOM_FORECASTCACHE_HPP
+#define __RMOL_BOM_FORECASTCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <string>
+#include <map>
+#include <mutex>
+// Boost
+#include <boost/shared_ptr.hpp>
+// StdAir
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/basic/ForecastingMethod.hpp>
+#include <stdair/basic/UnconstrainingMethod.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentCabin;
+}
+
+namespace RMOL {
+  /** Forward declaration. */
+  struct SegmentCabinForecast;
+
+  /**
+   * @brief Cache of the demand forecasts of the segment-cabins.
+   *
+   * For each segment-cabin, the last forecast is kept along with its
+   * parameters, i.e., the date of the RM event, the stamp of the
+   * snapshots and the forecasting and unconstraining methods. When the
+   * same segment-cabin is forecasted again with the same parameters
+   * (e.g., when several RM events occur on the same day), the cached
+   * forecast is set back into the segment-cabin, rather than being
+   * re-computed.
+   *
+   * The snapshot stamp is incremented by notifySnapshotUpdate(), so that
+   * the forecasts made before a snapshot update (even on the same day)
+   * are not reused any more. The cache may be used by several threads
+   * at the same time.
+   */
+  struct ForecastCache : public stdair::StructAbstract {
+
+  public:
+    /** Define the map of cached forecasts, indexed by the keys of the
+        segment-cabins. */
+    typedef std::map<std::string,
+                     boost::shared_ptr<SegmentCabinForecast> > ForecastMap_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the number of cached forecasts. */
+    unsigned int getNbOfForecasts() const;
+
+    /** Get the stamp of the current state of the snapshots. */
+    SnapshotStamp_T getSnapshotStamp() const;
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Set back the cached forecast of the given segment-cabin, when it
+     * was made with the given parameters on the current snapshots.
+     *
+     * @param stdair::SegmentCabin& Segment-cabin.
+     * @param const std::string& Key of the segment-cabin, unique within
+     *        the BOM tree.
+     * @param const stdair::Date_T& Date of the RM event.
+     * @param const stdair::ForecastingMethod& Forecasting method.
+     * @param const stdair::UnconstrainingMethod& Unconstraining method.
+     * @param bool& Whether the segment-cabin could be forecasted.
+     * @return bool Whether there was such a cached forecast.
+     */
+    bool restore (stdair::SegmentCabin&, const std::string&,
+                  const stdair::Date_T&, const stdair::ForecastingMethod&,
+                  const stdair::UnconstrainingMethod&, bool&) const;
+
+    /**
+     * Store the forecast of the given segment-cabin, replacing the
+     * previous one.
+     *
+     * @param const stdair::SegmentCabin& Segment-cabin.
+     * @param const std::string& Key of the segment-cabin.
+     * @param const stdair::Date_T& Date of the RM event.
+     * @param const SnapshotStamp_T& Stamp of the snapshots from which the
+     *        forecast was made, as given by getSnapshotStamp() before
+     *        forecasting.
+     * @param const stdair::ForecastingMethod& Forecasting method.
+     * @param const stdair::UnconstrainingMethod& Unconstraining method.
+     * @param const bool Whether the segment-cabin could be forecasted.
+     */
+    void save (const stdair::SegmentCabin&, const std::string&,
+               const stdair::Date_T&, const SnapshotStamp_T&,
+               const stdair::ForecastingMethod&,
+               const stdair::UnconstrainingMethod&, const bool);
+
+    /** Record that the snapshots have been updated, so that the cached
+        forecasts are not reused any more. */
+    void notifySnapshotUpdate();
+
+    /** Remove all the cached forecasts. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    ForecastCache ();
+
+    /** Destructor. */
+    virtual ~ForecastCache();
+
+  private:
+    /** Copy constructor (not implemented). */
+    ForecastCache (const ForecastCache&);
+
+  private:
+    /** Cached forecasts, indexed by the keys of the segment-cabins. */
+    ForecastMap_T _forecastMap;
+
+    /** Stamp of the current state of the snapshots. */
+    SnapshotStamp_T _snapshotStamp;
+
+    /** Mutex protecting the map of cached forecasts. */
+    mutable std::mutex _mutex;
+  };
+}
+#endif // __RMOL_BOM_FORECASTCACHE_HPP
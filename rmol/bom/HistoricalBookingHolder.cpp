@@ -12,6 +12,7 @@
 // RMOL
 #include <rmol/bom/HistoricalBooking.hpp>
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/EMDetruncator.hpp>
 
 namespace RMOL {
 
@@ -191,44 +192,13 @@ namespace RMOL {
   (const double iMean, const double iSD,
    const short i, const stdair::NbOfBookings_T iDemand) const {
 
-    const HistoricalBooking lHistorialBooking =
+    const HistoricalBooking& lHistorialBooking =
       _historicalBookingVector.at(i);
     const double lBooking =
       static_cast <double> (lHistorialBooking.getNbOfBookings());
-    double e, d1, d2;
-    
-    e = - (lBooking - iMean) * (lBooking - iMean) * 0.625 / (iSD * iSD);
-    //STDAIR_LOG_DEBUG ("e: " << e);
-    e = exp (e);
-    //STDAIR_LOG_DEBUG ("e: " << e);
 
-    double s = std::sqrt (1 - e);
-    //STDAIR_LOG_DEBUG ("s: " << s);
-    
-    if (lBooking >= iMean) {
-      if (e < 0.01) {
-        return iDemand;
-      }
-      d1 = 0.5 * (1 - s);
-    }
-    else {
-      d1 = 0.5 * (1 + s);
-    }
-    //STDAIR_LOG_DEBUG ("d1: " << d1);
-    
-    e = - (lBooking - iMean) * (lBooking - iMean) * 0.5 / (iSD * iSD);
-    e = exp (e);
-    d2 = e * iSD / std::sqrt(2 * 3.14159265);
-    //STDAIR_LOG_DEBUG ("d2: " << d2);
-    
-    if (d1 == 0) {
-      return iDemand;
-    }
-      
-    const stdair::NbOfBookings_T lDemand =
-      static_cast<stdair::NbOfBookings_T> (iMean + d2/d1);
-      
-    return lDemand;
+    return EMDetruncator::calculateExpectedDemand (lBooking, iMean, iSD,
+                                                   iDemand);
   }
 
   // ////////////////////////////////////////////////////////////////////
@@ -0,0 +1,116 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// RMOL
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingMatrix::HistoricalBookingMatrix () : _offsetVector (1, 0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingMatrix::~HistoricalBookingMatrix () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::NbOfBookings_T& HistoricalBookingMatrix::
+  getHistoricalBooking (const SeriesIndex_T iSeries, const short i) const {
+    assert (i < getNbOfFlights (iSeries));
+    return _bookingVector.at (_offsetVector.at (iSeries) + i);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::NbOfBookings_T& HistoricalBookingMatrix::
+  getUnconstrainedDemand (const SeriesIndex_T iSeries, const short i) const {
+    assert (i < getNbOfFlights (iSeries));
+    return _unconstrainedDemandVector.at (_offsetVector.at (iSeries) + i);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Flag_T HistoricalBookingMatrix::
+  getCensorshipFlag (const SeriesIndex_T iSeries, const short i) const {
+    assert (i < getNbOfFlights (iSeries));
+    return _censorshipFlagVector.at (_offsetVector.at (iSeries) + i);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::MeanValue_T& HistoricalBookingMatrix::
+  getDemandMean (const SeriesIndex_T iSeries) const {
+    return _meanVector.at (iSeries);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::StdDevValue_T& HistoricalBookingMatrix::
+  getStandardDeviation (const SeriesIndex_T iSeries) const {
+    return _stdDevVector.at (iSeries);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingMatrix::
+  setDistributionParameters (const SeriesIndex_T iSeries,
+                             const stdair::MeanValue_T& iMean,
+                             const stdair::StdDevValue_T& iStdDev) {
+    _meanVector.at (iSeries) = iMean;
+    _stdDevVector.at (iSeries) = iStdDev;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SeriesIndex_T HistoricalBookingMatrix::
+  addSeries (const HistoricalBookingHolder& iHBHolder) {
+    const SeriesIndex_T lSeriesIndex = getNbOfSeries();
+
+    const short lNbOfFlights = iHBHolder.getNbOfFlights();
+    for (short i = 0; i < lNbOfFlights; ++i) {
+      const stdair::NbOfBookings_T& lBooking =
+        iHBHolder.getHistoricalBooking (i);
+      _bookingVector.push_back (lBooking);
+      _unconstrainedDemandVector.push_back (lBooking);
+      _censorshipFlagVector.push_back (iHBHolder.getCensorshipFlag (i));
+    }
+    _offsetVector.push_back (_bookingVector.size());
+    _meanVector.push_back (0.0);
+    _stdDevVector.push_back (0.0);
+
+    return lSeriesIndex;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingMatrix::clear () {
+    _offsetVector.assign (1, 0);
+    _bookingVector.clear();
+    _censorshipFlagVector.clear();
+    _unconstrainedDemandVector.clear();
+    _meanVector.clear();
+    _stdDevVector.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingMatrix::toStream (std::ostream& ioOut) const {
+    const SeriesIndex_T lNbOfSeries = getNbOfSeries();
+    for (SeriesIndex_T s = 0; s < lNbOfSeries; ++s) {
+      ioOut << "Series " << s << " (mean: " << _meanVector.at (s)
+            << ", std dev: " << _stdDevVector.at (s) << ")" << std::endl;
+      ioOut << "Historical Booking; Unconstrained Demand; Flag" << std::endl;
+
+      const short lNbOfFlights = getNbOfFlights (s);
+      for (short i = 0; i < lNbOfFlights; ++i) {
+        ioOut << getHistoricalBooking (s, i) << "    "
+              << getUnconstrainedDemand (s, i) << "    "
+              << getCensorshipFlag (s, i) << std::endl;
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string HistoricalBookingMatrix::describe() const {
+    std::ostringstream ostr;
+    ostr << "Matrix of " << getNbOfSeries() << " historical booking series.";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,155 @@
+#ifndef __RMOL_BOM_HISTORICALBOOKINGMATRIX_HPP
+#define __RMOL_BOM_HISTORICALBOOKINGMATRIX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+namespace RMOL {
+  /** Forward declaration. */
+  struct HistoricalBookingHolder;
+
+  /** Index of a series within the matrix of historical bookings. */
+  typedef unsigned int SeriesIndex_T;
+
+  /** Define a vector of booking figures. */
+  typedef std::vector<stdair::NbOfBookings_T> NbOfBookingsVector_T;
+
+  /** Define a vector of offsets. */
+  typedef std::vector<unsigned int> OffsetVector_T;
+
+  /**
+   * @brief Packed matrix of historical booking series (series x flights).
+   *
+   * All the series are stored one after the other in the same contiguous
+   * vectors (historical bookings, censorship flags and unconstrained
+   * demand), so that many series (e.g., one per class and per DCP
+   * interval) can be unconstrained at once. The series may have
+   * different numbers of flights. Once unconstrained, the mean and the
+   * standard deviation of the unconstrained demand of each series are
+   * stored along with the series.
+   */
+  struct HistoricalBookingMatrix : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of series. */
+    SeriesIndex_T getNbOfSeries () const {
+      return _offsetVector.size() - 1;
+    }
+
+    /** Get the number of flights of the given series. */
+    short getNbOfFlights (const SeriesIndex_T iSeries) const {
+      return _offsetVector.at (iSeries+1) - _offsetVector.at (iSeries);
+    }
+
+    /** Get the offset of the first flight of the given series within
+        the packed vectors. */
+    unsigned int getOffset (const SeriesIndex_T iSeries) const {
+      return _offsetVector.at (iSeries);
+    }
+
+    /** Get the historical booking of the (i+1)-th flight of the series. */
+    const stdair::NbOfBookings_T& getHistoricalBooking (const SeriesIndex_T,
+                                                        const short i) const;
+
+    /** Get the unconstrained demand of the (i+1)-th flight of the series. */
+    const stdair::NbOfBookings_T& getUnconstrainedDemand (const SeriesIndex_T,
+                                                          const short i) const;
+
+    /** Get the censorship flag of the (i+1)-th flight of the series. */
+    stdair::Flag_T getCensorshipFlag (const SeriesIndex_T,
+                                      const short i) const;
+
+    /** Get the mean of the unconstrained demand of the series. */
+    const stdair::MeanValue_T& getDemandMean (const SeriesIndex_T) const;
+
+    /** Get the standard deviation of the unconstrained demand
+        of the series. */
+    const stdair::StdDevValue_T&
+    getStandardDeviation (const SeriesIndex_T) const;
+
+    /** Get the packed historical bookings. */
+    const NbOfBookingsVector_T& getHistoricalBookingVector() const {
+      return _bookingVector;
+    }
+
+    /** Get the packed censorship flags. */
+    const FlagVector_T& getCensorshipFlagVector() const {
+      return _censorshipFlagVector;
+    }
+
+    /** Get the packed unconstrained demand. */
+    const NbOfBookingsVector_T& getUnconstrainedDemandVector() const {
+      return _unconstrainedDemandVector;
+    }
+
+    /** Get the packed unconstrained demand, for update. */
+    NbOfBookingsVector_T& getUnconstrainedDemandVector() {
+      return _unconstrainedDemandVector;
+    }
+
+  public:
+    // ////// Setters //////
+    /** Set the mean and the standard deviation of the unconstrained
+        demand of the series. */
+    void setDistributionParameters (const SeriesIndex_T,
+                                    const stdair::MeanValue_T&,
+                                    const stdair::StdDevValue_T&);
+
+    /** Append the series held by the given holder. The unconstrained
+        demand is initialised with the historical bookings.
+        @return SeriesIndex_T Index of the new series. */
+    SeriesIndex_T addSeries (const HistoricalBookingHolder&);
+
+    /** Clear all the series. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    HistoricalBookingMatrix ();
+
+    /** Destructor. */
+    virtual ~HistoricalBookingMatrix();
+
+  private:
+    /** Offsets of the series within the packed vectors (N+1 elements,
+        the last one being the total number of flights). */
+    OffsetVector_T _offsetVector;
+
+    /** Packed historical bookings. */
+    NbOfBookingsVector_T _bookingVector;
+
+    /** Packed censorship flags. */
+    FlagVector_T _censorshipFlagVector;
+
+    /** Packed unconstrained demand. */
+    NbOfBookingsVector_T _unconstrainedDemandVector;
+
+    /** Mean of the unconstrained demand, for each series. */
+    std::vector<stdair::MeanValue_T> _meanVector;
+
+    /** Standard deviation of the unconstrained demand, for each series. */
+    std::vector<stdair::StdDevValue_T> _stdDevVector;
+  };
+}
+#endif // __RMOL_BOM_HISTORICALBOOKINGMATRIX_HPP
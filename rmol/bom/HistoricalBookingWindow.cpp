@@ -0,0 +1,122 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// RMOL
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingWindow.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingWindow::
+  HistoricalBookingWindow (const unsigned int iCapacity)
+    : _segmentBegin (0), _historicalBookingBuffer (iCapacity) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingWindow::~HistoricalBookingWindow () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::
+  update (const stdair::NbOfSegments_T& iSegmentBegin,
+          const stdair::NbOfSegments_T& iSegmentEnd,
+          const Preparer_T& iPreparer, HistoricalBookingHolder& ioHBHolder) {
+    const stdair::NbOfSegments_T lSegmentEnd =
+      _segmentBegin + getNbOfFlights() - 1;
+    const bool isSlidable = (getNbOfFlights() > 0
+                             && iSegmentBegin >= _segmentBegin
+                             && iSegmentBegin <= lSegmentEnd + 1
+                             && iSegmentEnd >= lSegmentEnd);
+
+    if (isSlidable == false) {
+      // Prepare the whole range again.
+      clear();
+      _segmentBegin = iSegmentBegin;
+      if (iSegmentEnd >= iSegmentBegin) {
+        HistoricalBookingHolder lHBHolder;
+        iPreparer (lHBHolder, iSegmentBegin, iSegmentEnd);
+        pushBack (lHBHolder);
+      }
+
+    } else {
+      // Evict the segments which have left the window.
+      for (; _segmentBegin < iSegmentBegin; ++_segmentBegin) {
+        popFront();
+      }
+
+      // Prepare only the segments which have entered the window.
+      if (iSegmentEnd > lSegmentEnd) {
+        HistoricalBookingHolder lHBHolder;
+        iPreparer (lHBHolder, lSegmentEnd + 1, iSegmentEnd);
+        pushBack (lHBHolder);
+      }
+    }
+    assert (getNbOfFlights() == 0
+            || _segmentBegin + getNbOfFlights() - 1 == iSegmentEnd);
+
+    // Fill the holder, from the oldest to the newest segment.
+    for (boost::circular_buffer<HistoricalBooking>::const_iterator itHB =
+           _historicalBookingBuffer.begin();
+         itHB != _historicalBookingBuffer.end(); ++itHB) {
+      ioHBHolder.addHistoricalBooking (*itHB);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::pushBack (const HistoricalBooking& iHB) {
+    // Grow the ring buffer rather than overwriting the oldest element.
+    if (_historicalBookingBuffer.full() == true) {
+      const unsigned int lCapacity = _historicalBookingBuffer.capacity();
+      _historicalBookingBuffer.set_capacity ((lCapacity > 0)?2*lCapacity:1);
+    }
+    _historicalBookingBuffer.push_back (iHB);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::
+  pushBack (const HistoricalBookingHolder& iHBHolder) {
+    const short lNbOfFlights = iHBHolder.getNbOfFlights();
+    for (short i = 0; i < lNbOfFlights; ++i) {
+      const HistoricalBooking lHB (iHBHolder.getHistoricalBooking (i),
+                                   iHBHolder.getCensorshipFlag (i));
+      pushBack (lHB);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::popFront () {
+    assert (_historicalBookingBuffer.empty() == false);
+    _historicalBookingBuffer.pop_front();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::clear () {
+    _segmentBegin = 0;
+    _historicalBookingBuffer.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindow::toStream (std::ostream& ioOut) const {
+    ioOut << describe() << std::endl;
+    stdair::NbOfSegments_T lSegment = _segmentBegin;
+    for (boost::circular_buffer<HistoricalBooking>::const_iterator itHB =
+           _historicalBookingBuffer.begin();
+         itHB != _historicalBookingBuffer.end(); ++itHB, ++lSegment) {
+      ioOut << lSegment << "    " << itHB->getNbOfBookings() << "    "
+            << itHB->getFlag() << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string HistoricalBookingWindow::describe() const {
+    std::ostringstream ostr;
+    ostr << "Window of " << getNbOfFlights()
+         << " historical bookings from the similar segment " << _segmentBegin
+         << ".";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,147 @@
+#ifndef __RMOL_BOM_HISTORICALBOOKINGWINDOW_HPP
+#define __RMOL_BOM_HISTORICALBOOKINGWINDOW_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <string>
+#include <mutex>
+// Boost
+#include <boost/function.hpp>
+#include <boost/circular_buffer.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/bom/HistoricalBooking.hpp>
+
+namespace RMOL {
+  /** Forward declaration. */
+  struct HistoricalBookingHolder;
+
+  /**
+   * @brief Sliding window of the historical bookings of a series
+   * (e.g., a class or a cabin) over a DCP interval.
+   *
+   * The window holds, in a ring buffer, one historical booking
+   * (along with its censorship flag) per similar segment, the similar
+   * segments being identified by their index within the snapshot table.
+   * As the historical bookings of a DCP interval do not change any more
+   * once the similar segment has passed that interval, only the
+   * segments entering the window need to be read from the snapshot
+   * table, while the segments leaving the window are simply evicted.
+   */
+  struct HistoricalBookingWindow : public stdair::StructAbstract {
+
+  public:
+    /** Function retrieving the historical bookings of the similar
+        segments within the given range (both ends included). */
+    typedef boost::function<void (HistoricalBookingHolder&,
+                                  const stdair::NbOfSegments_T&,
+                                  const stdair::NbOfSegments_T&)> Preparer_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the index of the first similar segment of the window. */
+    const stdair::NbOfSegments_T& getSegmentBegin() const {
+      return _segmentBegin;
+    }
+
+    /** Get the number of flights (similar segments) within the window. */
+    short getNbOfFlights() const {
+      return _historicalBookingBuffer.size();
+    }
+
+    /** Get the version of the conversion of the bookings held by the
+        window (e.g., a description of the sell-up curves turning them
+        into Q-equivalent bookings). */
+    const std::string& getVersion() const {
+      return _version;
+    }
+
+    /** Get the mutex protecting the window. */
+    std::mutex& getMutex() {
+      return _mutex;
+    }
+
+  public:
+    // ////// Setters //////
+    /** Set the version of the conversion of the bookings held by the
+        window. */
+    void setVersion (const std::string& iVersion) {
+      _version = iVersion;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Slide the window onto the given range of similar segments, and
+     * fill the given holder with the historical bookings of that range.
+     *
+     * When the new range starts within (or right after) the current
+     * window and does not end before it, the segments before the new
+     * range are evicted and only the new segments are prepared.
+     * Otherwise, the whole range is prepared again. The caller is
+     * expected to hold the mutex of the window.
+     *
+     * @param const stdair::NbOfSegments_T& Index of the first segment.
+     * @param const stdair::NbOfSegments_T& Index of the last segment.
+     * @param const Preparer_T& Retrieval of the historical bookings.
+     * @param HistoricalBookingHolder& Holder to be filled.
+     */
+    void update (const stdair::NbOfSegments_T&, const stdair::NbOfSegments_T&,
+                 const Preparer_T&, HistoricalBookingHolder&);
+
+    /** Empty the window (the version is kept). */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  private:
+    /** Append the given historical booking at the end of the window. */
+    void pushBack (const HistoricalBooking&);
+
+    /** Remove the oldest historical booking of the window. */
+    void popFront();
+
+    /** Append the historical bookings of the given holder. */
+    void pushBack (const HistoricalBookingHolder&);
+
+  public:
+    /** Constructor. */
+    HistoricalBookingWindow (const unsigned int iCapacity);
+
+    /** Destructor. */
+    virtual ~HistoricalBookingWindow();
+
+  private:
+    /** Default constructors (not implemented). */
+    HistoricalBookingWindow ();
+    HistoricalBookingWindow (const HistoricalBookingWindow&);
+
+  private:
+    /** Index of the first similar segment of the window. */
+    stdair::NbOfSegments_T _segmentBegin;
+
+    /** Historical bookings, one per similar segment. */
+    boost::circular_buffer<HistoricalBooking> _historicalBookingBuffer;
+
+    /** Version of the conversion of the bookings held by the window. */
+    std::string _version;
+
+    /** Mutex protecting the window. */
+    std::mutex _mutex;
+  };
+}
+#endif // __RMOL_BOM_HISTORICALBOOKINGWINDOW_HPP
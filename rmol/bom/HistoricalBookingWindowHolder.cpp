@@ -0,0 +1,122 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+// RMOL
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingWindowHolder::
+  HistoricalBookingWindowHolder (const unsigned short iWindowSize)
+    : _windowSize (iWindowSize) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  HistoricalBookingWindowHolder::~HistoricalBookingWindowHolder () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int HistoricalBookingWindowHolder::getNbOfWindows () const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    return _windowMap.size();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  boost::shared_ptr<HistoricalBookingWindow> HistoricalBookingWindowHolder::
+  getWindow (const std::string& iKey) {
+    std::lock_guard<std::mutex> lLock (_mutex);
+
+    WindowMap_T::iterator itWindow = _windowMap.find (iKey);
+    if (itWindow == _windowMap.end()) {
+      boost::shared_ptr<HistoricalBookingWindow>
+        lWindow_ptr (new HistoricalBookingWindow (_windowSize));
+      const bool hasInsertBeenSuccessful =
+        _windowMap.insert (WindowMap_T::value_type (iKey, lWindow_ptr)).second;
+      assert (hasInsertBeenSuccessful == true);
+      return lWindow_ptr;
+    }
+
+    assert (itWindow->second.get() != NULL);
+    return itWindow->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindowHolder::
+  prepareHistoricalBooking (const stdair::SegmentCabin& iSegmentCabin,
+                            const std::string& iSeriesKey,
+                            const std::string& iVersion,
+                            const stdair::DCP_T& iDCPBegin,
+                            const stdair::NbOfSegments_T& iSegmentBegin,
+                            const stdair::NbOfSegments_T& iSegmentEnd,
+                            const HistoricalBookingWindow::Preparer_T& iPreparer,
+                            HistoricalBookingHolder& ioHBHolder) {
+    // The window belongs to the segment-cabin of the given flight-date,
+    // as the range of similar segments depends on the departure date.
+    const stdair::SegmentDate& lSegmentDate =
+      stdair::BomManager::getParent<stdair::SegmentDate> (iSegmentCabin);
+    const stdair::FlightDate& lFlightDate =
+      stdair::BomManager::getParent<stdair::FlightDate> (lSegmentDate);
+    const stdair::Inventory& lInventory =
+      stdair::BomManager::getParent<stdair::Inventory> (lFlightDate);
+    std::ostringstream lWindowKey;
+    lWindowKey << lInventory.describeKey() << ", "
+               << lFlightDate.describeKey() << ", "
+               << lSegmentDate.describeKey() << ", "
+               << iSegmentCabin.describeKey() << ", " << iSeriesKey
+               << ", " << iDCPBegin;
+    // The window is held until the end of the update, even when the
+    // holder is cleared in the meantime (e.g., by a reset of the
+    // forecast state).
+    const boost::shared_ptr<HistoricalBookingWindow> lWindow_ptr =
+      getWindow (lWindowKey.str());
+    assert (lWindow_ptr.get() != NULL);
+
+    // The same segment-cabin is normally not forecasted by several
+    // threads at the same time, but nothing prevents it.
+    std::lock_guard<std::mutex> lLock (lWindow_ptr->getMutex());
+
+    // The bookings converted with another version (e.g., before a change
+    // of the FRAT5 curve) are converted again.
+    if (lWindow_ptr->getVersion() != iVersion) {
+      lWindow_ptr->clear();
+      lWindow_ptr->setVersion (iVersion);
+    }
+    lWindow_ptr->update (iSegmentBegin, iSegmentEnd, iPreparer, ioHBHolder);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindowHolder::clear () {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    _windowMap.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void HistoricalBookingWindowHolder::toStream (std::ostream& ioOut) const {
+    std::lock_guard<std::mutex> lLock (_mutex);
+    for (WindowMap_T::const_iterator itWindow = _windowMap.begin();
+         itWindow != _windowMap.end(); ++itWindow) {
+      assert (itWindow->second.get() != NULL);
+      ioOut << itWindow->first << ": " << itWindow->second->describe()
+            << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string HistoricalBookingWindowHolder::describe() const {
+    std::ostringstream ostr;
+    ostr << "Holder of " << getNbOfWindows()
+         << " windows of historical bookings.";
+    return ostr.str();
+  }
+}
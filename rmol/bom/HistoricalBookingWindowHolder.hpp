@@ -0,0 +1,143 @@
+#ifndef __RMOL_BOM_HISTORICALBOOKINGWINDOWHOLDER_HPP
+#define __RMOL_BOM_HISTORICALBOOKINGWINDOWHOLDER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <string>
+#include <map>
+#include <mutex>
+// Boost
+#include <boost/shared_ptr.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/basic/BasConst_General.hpp>
+#include <rmol/bom/HistoricalBookingWindow.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentCabin;
+}
+
+namespace RMOL {
+  /** Forward declaration. */
+  struct HistoricalBookingHolder;
+
+  /**
+   * @brief Persistent forecast state: holder of the sliding windows of
+   * historical bookings.
+   *
+   * There is one window per segment-cabin (of a given flight-date), per
+   * series (e.g., the Q-equivalent bookings of the segment-cabin, or the
+   * product-oriented bookings of a class) and per DCP interval. The
+   * windows are kept from one forecast of the segment-cabin to the next,
+   * so that only the similar segments which have passed the DCP interval
+   * since the previous forecast are read from the snapshot table. As the
+   * flight-dates sharing a snapshot table do not have the same ranges of
+   * similar segments, they do not share their windows.
+   *
+   * The bookings of some series are converted before being held (e.g.,
+   * into Q-equivalent bookings, with the sell-up curves derived from the
+   * FRAT5 curve and the yields of the classes). Each window records the
+   * version of that conversion, and is emptied when it is updated with
+   * another version, so that the bookings are converted again.
+   *
+   * The holder may be used by several threads at the same time. As the
+   * historical bookings of a departed similar segment are assumed not to
+   * change any more, the holder must be cleared whenever the snapshot
+   * tables are rebuilt or modified. A forecast running while the holder
+   * is cleared keeps its window until it is over.
+   */
+  struct HistoricalBookingWindowHolder : public stdair::StructAbstract {
+
+  public:
+    /** Define the map of windows, indexed by their keys. */
+    typedef std::map<std::string,
+                     boost::shared_ptr<HistoricalBookingWindow> > WindowMap_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the number of windows. */
+    unsigned int getNbOfWindows() const;
+
+    /** Get the initial capacity of the windows. */
+    const unsigned short& getWindowSize() const {
+      return _windowSize;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Retrieve the historical bookings of the given series of the
+     * segment-cabin over the given DCP interval, for the given range of
+     * similar segments, and add them to the holder.
+     *
+     * @param const stdair::SegmentCabin& Segment-cabin being forecasted.
+     * @param const std::string& Key of the series, unique within the
+     *        segment-cabin.
+     * @param const std::string& Version of the conversion of the
+     *        historical bookings of the series (empty when they are not
+     *        converted).
+     * @param const stdair::DCP_T& DCP range start.
+     * @param const stdair::NbOfSegments_T& Segment range start index.
+     * @param const stdair::NbOfSegments_T& Segment range end index.
+     * @param const HistoricalBookingWindow::Preparer_T& Retrieval of the
+     *        historical bookings from the snapshot table.
+     * @param HistoricalBookingHolder& Holder to be filled.
+     */
+    void prepareHistoricalBooking (const stdair::SegmentCabin&,
+                                   const std::string&, const std::string&,
+                                   const stdair::DCP_T&,
+                                   const stdair::NbOfSegments_T&,
+                                   const stdair::NbOfSegments_T&,
+                                   const HistoricalBookingWindow::Preparer_T&,
+                                   HistoricalBookingHolder&);
+
+    /** Remove all the windows (e.g., when the snapshots have changed). */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  private:
+    /** Retrieve the window corresponding to the given key, creating it
+        when needed. The window is shared with the caller, so that it
+        outlives a concurrent clearance of the holder. */
+    boost::shared_ptr<HistoricalBookingWindow> getWindow (const std::string&);
+
+  public:
+    /** Constructor. */
+    HistoricalBookingWindowHolder (const unsigned short iWindowSize =
+                                   DEFAULT_HISTORICAL_BOOKING_WINDOW_SIZE);
+
+    /** Destructor. */
+    virtual ~HistoricalBookingWindowHolder();
+
+  private:
+    /** Copy constructor (not implemented). */
+    HistoricalBookingWindowHolder (const HistoricalBookingWindowHolder&);
+
+  private:
+    /** Initial capacity of the windows. */
+    const unsigned short _windowSize;
+
+    /** Windows, indexed by their keys. */
+    WindowMap_T _windowMap;
+
+    /** Mutex protecting the map of windows. */
+    mutable std::mutex _mutex;
+  };
+}
+#endif // __RMOL_BOM_HISTORICALBOOKINGWINDOWHOLDER_HPP
@@ -0,0 +1,222 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <set>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/LegDate.hpp>
+#include <stdair/bom/LegCabin.hpp>
+// RMOL
+#include <rmol/bom/LegCabinImageTable.hpp>
+
+namespace RMOL {
+
+  namespace {
+
+    /** Define the link between a leg-cabin and one of its images. */
+    typedef LegCabinImageTable::LegCabinImage LegCabinImage;
+
+    /** Define the list of links. */
+    typedef LegCabinImageTable::LegCabinImageList_T LegCabinImageList_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Retrieve the leg-cabins of the given (operating) flight-date, along
+     * with their images held by the marketing partners, segment after
+     * segment and partner after partner.
+     */
+    void resolveLegCabinImages (const stdair::FlightDate& iFlightDate,
+                                const stdair::BomRoot& iBomRoot,
+                                LegCabinImageList_T& ioLegCabinImageList) {
+      const stdair::SegmentDateList_T& lSegmentDateList =
+        stdair::BomManager::getList<stdair::SegmentDate> (iFlightDate);
+      const stdair::AirlineCode_T& lOptAC = iFlightDate.getAirlineCode();
+      const std::string lFDKeyStr = iFlightDate.describeKey();
+    
+      for (stdair::SegmentDateList_T::const_iterator itSegmentDate = lSegmentDateList.begin();
+           itSegmentDate != lSegmentDateList.end(); ++itSegmentDate) {
+        stdair::SegmentDate* lSegmentDate_ptr = *itSegmentDate;
+        assert (lSegmentDate_ptr != NULL);
+        const bool hasSegmentDateList =
+          stdair::BomManager::hasList<stdair::SegmentDate>(*lSegmentDate_ptr);
+        if (hasSegmentDateList == true) {
+          const stdair::LegDateList_T& lLegDateList =
+            stdair::BomManager::getList<stdair::LegDate>(*lSegmentDate_ptr);
+          // Get the list of marketing carriers segments.
+          // These are part of maketing partners inventories images held by the operating airline.
+          const stdair::SegmentDateList_T& lMktSegmentDateList =
+            stdair::BomManager::getList<stdair::SegmentDate>(*lSegmentDate_ptr);
+          for (stdair::SegmentDateList_T::const_iterator itMktSD = lMktSegmentDateList.begin();
+               itMktSD != lMktSegmentDateList.end(); ++itMktSD) {
+            // Get the marketing airline code.
+            stdair::SegmentDate* lMktSD_ptr = *itMktSD;
+            assert (lMktSD_ptr != NULL);
+            stdair::FlightDate* lMktFD_ptr =
+              stdair::BomManager::getParentPtr<stdair::FlightDate>(*lMktSD_ptr);
+            assert (lMktFD_ptr != NULL);
+            const stdair::AirlineCode_T& lMktAC = lMktFD_ptr->getAirlineCode();
+            // Get the (real) marketer inventory.
+            const stdair::Inventory* lMktInv_ptr =
+              stdair::BomManager::getObjectPtr<stdair::Inventory>(iBomRoot,lMktAC);
+            assert (lMktInv_ptr != NULL);
+            // Get the image of the operating airline inventory held by the marketer.
+            const stdair::Inventory* lOptInv_ptr =
+              stdair::BomManager::getObjectPtr<stdair::Inventory>(*lMktInv_ptr,lOptAC);
+            assert (lOptInv_ptr != NULL);
+            // Find the image of the concerned flight date.
+            const stdair::FlightDate* lOptFD_ptr =
+              stdair::BomManager::getObjectPtr<stdair::FlightDate>(*lOptInv_ptr,lFDKeyStr);
+            assert (lOptFD_ptr != NULL);
+            // Browse the list of leg dates in the real operating inventory.
+            // Retrieve the image of each leg date.
+            for (stdair::LegDateList_T::const_iterator itLD = lLegDateList.begin();
+                 itLD != lLegDateList.end(); ++itLD) {
+              const stdair::LegDate* lLD_ptr = *itLD;
+              assert (lLD_ptr != NULL);
+              const std::string lLDKeyStr = lLD_ptr->describeKey();
+              stdair::LegDate* lOptLD_ptr =
+                stdair::BomManager::getObjectPtr<stdair::LegDate>(*lOptFD_ptr,lLDKeyStr);
+              assert (lOptLD_ptr != NULL);
+              const stdair::LegCabinList_T& lLegCabinList_T =
+                stdair::BomManager::getList<stdair::LegCabin>(*lLD_ptr);
+              // Browse the list of leg cabins in the real operating inventory.
+              // Retrieve the image of each leg cabin.
+              for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList_T.begin();
+                   itLC != lLegCabinList_T.end(); ++itLC) {
+                stdair::LegCabin* lLC_ptr = *itLC;
+                assert (lLC_ptr != NULL);
+                const std::string lLCKeyStr = lLC_ptr->describeKey();
+                stdair::LegCabin* lOptLC_ptr =
+                  stdair::BomManager::getObjectPtr<stdair::LegCabin>(*lOptLD_ptr, lLCKeyStr);
+                assert (lOptLC_ptr != NULL);
+                const LegCabinImage lLegCabinImage =
+                  { lLC_ptr, lOptLC_ptr, false };
+                ioLegCabinImageList.push_back (lLegCabinImage);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  LegCabinImageTable::LegCabinImageTable ()
+    : _isBuilt (false), _emptyLegCabinImageList() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  LegCabinImageTable::~LegCabinImageTable () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const LegCabinImageTable::LegCabinImageList_T& LegCabinImageTable::
+  getLegCabinImageList (const stdair::FlightDate& iFlightDate) const {
+    assert (_isBuilt == true);
+    LegCabinImageListMap_T::const_iterator itLCImageList =
+      _legCabinImageListMap.find (&iFlightDate);
+    if (itLCImageList == _legCabinImageListMap.end()) {
+      return _emptyLegCabinImageList;
+    }
+    return itLCImageList->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::LegCabin& LegCabinImageTable::
+  getRealLegCabin (stdair::LegCabin& iLegCabin) const {
+    assert (_isBuilt == true);
+    RealLegCabinMap_T::const_iterator itRealLC =
+      _realLegCabinMap.find (&iLegCabin);
+    if (itRealLC == _realLegCabinMap.end()) {
+      return iLegCabin;
+    }
+    assert (itRealLC->second != NULL);
+    return *itRealLC->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegCabinImageTable::build (const stdair::BomRoot& iBomRoot) {
+    _legCabinImageListMap.clear();
+    _realLegCabinMap.clear();
+    _isBuilt = true;
+
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInventory_ptr = *itInv;
+      assert (lInventory_ptr != NULL);
+      const bool hasFlightDateList =
+        stdair::BomManager::hasList<stdair::FlightDate> (*lInventory_ptr);
+      if (hasFlightDateList == false) {
+        continue;
+      }
+      const stdair::FlightDateList_T& lFlightDateList =
+        stdair::BomManager::getList<stdair::FlightDate> (*lInventory_ptr);
+      for (stdair::FlightDateList_T::const_iterator itFD =
+             lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+        const stdair::FlightDate* lFlightDate_ptr = *itFD;
+        assert (lFlightDate_ptr != NULL);
+        LegCabinImageList_T lLegCabinImageList;
+        resolveLegCabinImages (*lFlightDate_ptr, iBomRoot, lLegCabinImageList);
+        if (lLegCabinImageList.empty() == true) {
+          continue;
+        }
+
+        // Flag the first link of each real leg-cabin, and record the real
+        // leg-cabin of each image.
+        std::set<const stdair::LegCabin*> lLegCabinSet;
+        for (LegCabinImageList_T::iterator itLCImage =
+               lLegCabinImageList.begin();
+             itLCImage != lLegCabinImageList.end(); ++itLCImage) {
+          itLCImage->_isFirst =
+            lLegCabinSet.insert (itLCImage->_legCabin).second;
+          _realLegCabinMap[itLCImage->_image] = itLCImage->_legCabin;
+        }
+        _legCabinImageListMap[lFlightDate_ptr].swap (lLegCabinImageList);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegCabinImageTable::clear () {
+    _legCabinImageListMap.clear();
+    _realLegCabinMap.clear();
+    _isBuilt = false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegCabinImageTable::toStream (std::ostream& ioOut) const {
+    for (LegCabinImageListMap_T::const_iterator itLCImageList =
+           _legCabinImageListMap.begin();
+         itLCImageList != _legCabinImageListMap.end(); ++itLCImageList) {
+      const stdair::FlightDate* lFlightDate_ptr = itLCImageList->first;
+      assert (lFlightDate_ptr != NULL);
+      ioOut << lFlightDate_ptr->describeKey() << ": "
+            << itLCImageList->second.size() << " leg-cabin images"
+            << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string LegCabinImageTable::describe() const {
+    std::ostringstream ostr;
+    unsigned int lNbOfLinks = 0;
+    for (LegCabinImageListMap_T::const_iterator itLCImageList =
+           _legCabinImageListMap.begin();
+         itLCImageList != _legCabinImageListMap.end(); ++itLCImageList) {
+      lNbOfLinks += itLCImageList->second.size();
+    }
+    ostr << "Leg-cabin image table (built: " << _isBuilt << ", "
+         << _legCabinImageListMap.size() << " flight-dates, " << lNbOfLinks
+         << " links).";
+    return ostr.str();
+  }
+}
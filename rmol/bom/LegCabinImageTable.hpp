@@ -0,0 +1,125 @@
+#ifndef __RMOL_BOM_LEGCABINIMAGETABLE_HPP
+#define __RMOL_BOM_LEGCABINIMAGETABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+#include <map>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class FlightDate;
+  class LegCabin;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Table linking the leg-cabins of the operating inventories to
+   * their images held by the marketing partners.
+   *
+   * The images are resolved once from the BOM tree (inventory, flight-date,
+   * leg-date and leg-cabin keys), so that the bid prices can be sent to
+   * the partners by a flat loop over the links of each flight-date.
+   * The other way round, each image gives its real leg-cabin, so that
+   * the seats of a code-share leg are counted once by the network
+   * optimisation.
+   *
+   * The table must be cleared whenever flight-dates (or their images) are
+   * added to (or removed from) the BOM tree.
+   */
+  struct LegCabinImageTable : public stdair::StructAbstract {
+
+  public:
+    /**
+     * Link between a (real) leg-cabin and one of its images.
+     */
+    struct LegCabinImage {
+      /** Real leg-cabin, in the operating inventory. */
+      stdair::LegCabin* _legCabin;
+
+      /** Image of the leg-cabin, in the marketing partner inventory. */
+      stdair::LegCabin* _image;
+
+      /** Whether this is the first link of the real leg-cabin, within its
+          flight-date. */
+      bool _isFirst;
+    };
+
+    /** Define the list of links. */
+    typedef std::vector<LegCabinImage> LegCabinImageList_T;
+
+  public:
+    // ////// Getters //////
+    /** State whether the table has been built. */
+    bool isBuilt() const {
+      return _isBuilt;
+    }
+
+    /** Get the links of the leg-cabins of the given (operating)
+        flight-date, segment after segment and partner after partner. The
+        list is empty when the flight-date has no marketing partner. */
+    const LegCabinImageList_T&
+    getLegCabinImageList (const stdair::FlightDate&) const;
+
+    /** Get the real leg-cabin of the given leg-cabin, i.e., the leg-cabin
+        of the operating inventory when it is an image held by a marketing
+        partner, and the leg-cabin itself otherwise. */
+    stdair::LegCabin& getRealLegCabin (stdair::LegCabin&) const;
+
+  public:
+    // ////// Business Methods //////
+    /** Build the table from the flight-dates of all the inventories of
+        the BOM tree. */
+    void build (const stdair::BomRoot&);
+
+    /** Clear the table. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    LegCabinImageTable ();
+
+    /** Destructor. */
+    virtual ~LegCabinImageTable();
+
+  private:
+    /** Define the map of the links, by flight-date. */
+    typedef std::map<const stdair::FlightDate*,
+                     LegCabinImageList_T> LegCabinImageListMap_T;
+
+    /** Define the map of the real leg-cabins, by image. */
+    typedef std::map<const stdair::LegCabin*,
+                     stdair::LegCabin*> RealLegCabinMap_T;
+
+  private:
+    /** Whether the table has been built. */
+    bool _isBuilt;
+
+    /** Links, by flight-date. */
+    LegCabinImageListMap_T _legCabinImageListMap;
+
+    /** Real leg-cabins, by image (inverse of the links). */
+    RealLegCabinMap_T _realLegCabinMap;
+
+    /** Empty list of links, for the flight-dates without partner. */
+    const LegCabinImageList_T _emptyLegCabinImageList;
+  };
+}
+#endif // __RMOL_BOM_LEGCABINIMAGETABLE_HPP
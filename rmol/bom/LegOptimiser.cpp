@@ -0,0 +1,538 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+// Boost Math
+#include <boost/math/distributions/normal.hpp>
+// StdAir
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/RandomGeneration.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+#include <rmol/LegOptimiser.hpp>
+#include <rmol/basic/BasConst_General.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
+
+namespace RMOL {
+
+  namespace {
+
+    // //////////////////////////////////////////////////////////////////
+    /** Probability for the demand to be greater than or equal to the given
+        value (a null standard deviation meaning a deterministic demand). */
+    double getTailProbability (const double iMean, const double iStdDev,
+                               const double iValue) {
+      if (iStdDev <= 0.0) {
+        return (iMean >= iValue) ? 1.0 : 0.0;
+      }
+      const boost::math::normal lNormalDistribution (iMean, iStdDev);
+      return boost::math::cdf (boost::math::complement (lNormalDistribution,
+                                                        iValue));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /** Value which the demand exceeds with the given probability (the
+        inverse cdf, or quantile function, of the complement). */
+    double getComplementQuantile (const double iMean, const double iStdDev,
+                                  const double iProbability) {
+      if (iStdDev <= 0.0) {
+        return iMean;
+      }
+      const boost::math::normal lNormalDistribution (iMean, iStdDev);
+      return boost::math::quantile (boost::math::complement
+                                    (lNormalDistribution, iProbability));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /** Draw the given number of demands, normally distributed, from a
+        generator initialised with the given seed (as the demand samples
+        of a booking class). */
+    void drawDemands (const stdair::RandomSeed_T& iSeed,
+                      const double iMean, const double iStdDev,
+                      const unsigned int iNbOfDraws, double* oDemandList) {
+      stdair::RandomGeneration lGenerator (iSeed);
+      for (unsigned int i = 0; i < iNbOfDraws; ++i) {
+        oDemandList[i] = (iStdDev > 0.0) ?
+          lGenerator.generateNormal (iMean, iStdDev) : iMean;
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimisationWorkspace::
+  reserve (const unsigned int iNbOfClasses, const unsigned int iCapacity,
+           const stdair::NbOfSamples_T iNbOfSamples) {
+    const unsigned int lNbOfValues =
+      std::max (iCapacity + 1, static_cast<unsigned int> (iNbOfSamples));
+    _protectionList.reserve (iNbOfClasses);
+    _bidPriceList.reserve (iCapacity);
+    _classValueList.reserve (std::max (iNbOfClasses, iCapacity + 1));
+    _rankList.reserve (iNbOfClasses);
+    _partialSumList.reserve (lNbOfValues);
+    _sampleList.reserve (lNbOfValues);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::
+  optimise (const OptimizationType::EN_OptimizationType& iOptimizationType,
+            const unsigned int iNbOfClasses, const double* iYieldList,
+            const double* iMeanList, const double* iStdDevList,
+            const unsigned int iCapacity,
+            const stdair::NbOfSamples_T iNbOfSamples,
+            LegOptimisationWorkspace& ioWorkspace,
+            double* oProtectionList, double* oBidPriceList) {
+    // Consistency checks: the yields must be positive and strictly
+    // decreasing, from the highest class to the lowest one.
+    if (iNbOfClasses == 0 || iYieldList == NULL || iMeanList == NULL
+        || iStdDevList == NULL) {
+      throw OptimisationException ("The leg optimisation needs at least "
+                                   "one class");
+    }
+    for (unsigned int j = 0; j < iNbOfClasses; ++j) {
+      if (iYieldList[j] <= 0.0
+          || (j > 0 && iYieldList[j] >= iYieldList[j - 1])) {
+        std::ostringstream ostr;
+        ostr << "The yield of the class " << j << " (" << iYieldList[j]
+             << ") must be positive and lower than the one of the "
+             << "previous class";
+        throw OptimisationException (ostr.str());
+      }
+    }
+
+    ioWorkspace._protectionList.resize (iNbOfClasses);
+    ioWorkspace._bidPriceList.resize (iCapacity);
+
+    switch (iOptimizationType) {
+    case OptimizationType::OPT_MC: {
+      if (iNbOfSamples < 2) {
+        throw OptimisationException ("The Monte-Carlo integration needs at "
+                                     "least two draws");
+      }
+      optimiseByMC (iNbOfClasses, iYieldList, iMeanList, iStdDevList,
+                    iCapacity, iNbOfSamples, ioWorkspace);
+      break;
+    }
+    case OptimizationType::OPT_DP: {
+      optimiseByDP (iNbOfClasses, iYieldList, iMeanList, iStdDevList,
+                    iCapacity, ioWorkspace);
+      break;
+    }
+    case OptimizationType::HEUR_EMSR: {
+      optimiseByEmsr (iNbOfClasses, iYieldList, iMeanList, iStdDevList,
+                      iCapacity, ioWorkspace);
+      break;
+    }
+    case OptimizationType::HEUR_EMSRA: {
+      optimiseByEmsrA (iNbOfClasses, iYieldList, iMeanList, iStdDevList,
+                       ioWorkspace);
+      boundProtections (iNbOfClasses, iCapacity, ioWorkspace);
+      computeBidPricesFromProtections (iNbOfClasses, iYieldList, iCapacity,
+                                       ioWorkspace);
+      break;
+    }
+    case OptimizationType::HEUR_EMSRB: {
+      optimiseByEmsrB (iNbOfClasses, iYieldList, iMeanList, iStdDevList,
+                       ioWorkspace);
+      boundProtections (iNbOfClasses, iCapacity, ioWorkspace);
+      computeBidPricesFromProtections (iNbOfClasses, iYieldList, iCapacity,
+                                       ioWorkspace);
+      break;
+    }
+    default: {
+      std::ostringstream ostr;
+      ostr << "The optimisation method "
+           << OptimizationType::getLabel (iOptimizationType)
+           << " is not supported by the leg optimisation";
+      throw OptimisationException (ostr.str());
+    }
+    }
+
+    // The lowest class is protected the whole capacity.
+    ioWorkspace._protectionList[iNbOfClasses - 1] = iCapacity;
+
+    if (oProtectionList != NULL) {
+      std::copy (ioWorkspace._protectionList.begin(),
+                 ioWorkspace._protectionList.end(), oProtectionList);
+    }
+    if (oBidPriceList != NULL) {
+      std::copy (ioWorkspace._bidPriceList.begin(),
+                 ioWorkspace._bidPriceList.end(), oBidPriceList);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::
+  optimiseBatch (const LegOptimisationBatch& iBatch,
+                 const OptimizationType::EN_OptimizationType& iOptimizationType,
+                 const stdair::NbOfSamples_T iNbOfSamples,
+                 const unsigned int iMaxCapacity,
+                 const unsigned int iNbOfThreads,
+                 double* oProtectionList, double* oBidPriceMatrix) {
+    const unsigned int lNbOfProblems = iBatch._nbOfProblems;
+    if (lNbOfProblems == 0) {
+      return;
+    }
+    if (iBatch._classOffsetList == NULL || iBatch._capacityList == NULL
+        || iBatch._yieldList == NULL || iBatch._meanList == NULL
+        || iBatch._stdDevList == NULL) {
+      throw OptimisationException ("The batch of leg optimisations is not "
+                                   "fully given");
+    }
+
+    // Consistency checks, before any thread is started.
+    const unsigned int* lOffsetList = iBatch._classOffsetList;
+    for (unsigned int i = 0; i < lNbOfProblems; ++i) {
+      if (lOffsetList[i + 1] <= lOffsetList[i]
+          || iBatch._capacityList[i] > iMaxCapacity) {
+        std::ostringstream ostr;
+        ostr << "The problem " << i << " of the batch of leg optimisations "
+             << "has no class, or a capacity (" << iBatch._capacityList[i]
+             << ") greater than the maximal capacity (" << iMaxCapacity
+             << ")";
+        throw OptimisationException (ostr.str());
+      }
+    }
+
+    // One block of contiguous problems, with its own workspace, per thread.
+    const unsigned int lNbOfBlocks =
+      std::max (1u, std::min (iNbOfThreads, lNbOfProblems));
+    std::vector<LegOptimisationWorkspace> lWorkspaceList (lNbOfBlocks);
+    ParallelLoop::run (lNbOfBlocks,
+                       [&] (const unsigned int iBlockIdx) {
+                         LegOptimisationWorkspace& lWorkspace =
+                           lWorkspaceList[iBlockIdx];
+                         const unsigned int lBegin = static_cast<unsigned int>
+                           (std::size_t (lNbOfProblems) * iBlockIdx
+                            / lNbOfBlocks);
+                         const unsigned int lEnd = static_cast<unsigned int>
+                           (std::size_t (lNbOfProblems) * (iBlockIdx + 1)
+                            / lNbOfBlocks);
+                         for (unsigned int i = lBegin; i < lEnd; ++i) {
+                           const unsigned int& lOffset = lOffsetList[i];
+                           const unsigned int& lCapacity =
+                             iBatch._capacityList[i];
+                           double* lBPV = (oBidPriceMatrix == NULL) ? NULL
+                             : oBidPriceMatrix + std::size_t (i)*iMaxCapacity;
+                           optimise (iOptimizationType,
+                                     lOffsetList[i + 1] - lOffset,
+                                     iBatch._yieldList + lOffset,
+                                     iBatch._meanList + lOffset,
+                                     iBatch._stdDevList + lOffset,
+                                     lCapacity, iNbOfSamples, lWorkspace,
+                                     (oProtectionList == NULL) ? NULL
+                                     : oProtectionList + lOffset, lBPV);
+                           if (lBPV != NULL) {
+                             std::fill (lBPV + lCapacity, lBPV + iMaxCapacity,
+                                        0.0);
+                           }
+                         }
+                       },
+                       iNbOfThreads);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::optimiseByEmsr (const unsigned int iNbOfClasses,
+                                     const double* iYieldList,
+                                     const double* iMeanList,
+                                     const double* iStdDevList,
+                                     const unsigned int iCapacity,
+                                     LegOptimisationWorkspace& ioWorkspace) {
+    // The EMSR values of a class, y(j) . Pr (D(j) >= k), decrease with k:
+    // the bid-price vector, made of the C highest EMSR values of all the
+    // classes, is obtained by merging the lists of the classes, keeping
+    // only the current head of each list.
+    LegOptimisationWorkspace::ValueList_T& lHeadList =
+      ioWorkspace._classValueList;
+    LegOptimisationWorkspace::IndexList_T& lRankList = ioWorkspace._rankList;
+    lHeadList.resize (iNbOfClasses);
+    lRankList.assign (iNbOfClasses, 1);
+    for (unsigned int j = 0; j < iNbOfClasses; ++j) {
+      lHeadList[j] =
+        iYieldList[j] * getTailProbability (iMeanList[j], iStdDevList[j], 1);
+    }
+
+    double* lBPV = ioWorkspace._bidPriceList.data();
+    for (unsigned int idx = 0; idx < iCapacity; ++idx) {
+      unsigned int lBestClass = 0;
+      for (unsigned int j = 1; j < iNbOfClasses; ++j) {
+        if (lHeadList[j] > lHeadList[lBestClass]) {
+          lBestClass = j;
+        }
+      }
+      lBPV[idx] = lHeadList[lBestClass];
+
+      const unsigned int lRank = ++lRankList[lBestClass];
+      lHeadList[lBestClass] = iYieldList[lBestClass]
+        * getTailProbability (iMeanList[lBestClass],
+                              iStdDevList[lBestClass], lRank);
+    }
+
+    // The protection of the classes 0 to j is the number of seats whose
+    // bid price is greater than the yield of the next class.
+    unsigned int lCapacityIndex = 0;
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j) {
+      const double& lNextYield = iYieldList[j + 1];
+      while (lCapacityIndex < iCapacity && lBPV[lCapacityIndex] > lNextYield) {
+        ++lCapacityIndex;
+      }
+      ioWorkspace._protectionList[j] = lCapacityIndex;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::optimiseByEmsrA (const unsigned int iNbOfClasses,
+                                      const double* iYieldList,
+                                      const double* iMeanList,
+                                      const double* iStdDevList,
+                                      LegOptimisationWorkspace& ioWorkspace) {
+    // The protection of the classes 0 to j is the sum of the protections
+    // of each of those classes against the class j+1.
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j) {
+      const double& lNextYield = iYieldList[j + 1];
+      double lProtection = 0.0;
+      for (unsigned int k = 0; k <= j; ++k) {
+        lProtection += getComplementQuantile (iMeanList[k], iStdDevList[k],
+                                              lNextYield / iYieldList[k]);
+      }
+      ioWorkspace._protectionList[j] = lProtection;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::optimiseByEmsrB (const unsigned int iNbOfClasses,
+                                      const double* iYieldList,
+                                      const double* iMeanList,
+                                      const double* iStdDevList,
+                                      LegOptimisationWorkspace& ioWorkspace) {
+    // The classes 0 to j are aggregated into a single class, whose yield
+    // is the demand-weighted average yield, and which is protected
+    // against the class j+1.
+    double lAggregatedMean = 0.0;
+    double lAggregatedVariance = 0.0;
+    double lAggregatedYield = iYieldList[0];
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j) {
+      const double lNewMean = lAggregatedMean + iMeanList[j];
+      if (lNewMean > 0) {
+        lAggregatedYield = (lAggregatedYield * lAggregatedMean
+                            + iYieldList[j] * iMeanList[j]) / lNewMean;
+      } else {
+        lAggregatedYield = iYieldList[j];
+      }
+      lAggregatedMean = lNewMean;
+      lAggregatedVariance += iStdDevList[j] * iStdDevList[j];
+
+      const double lYieldRatio = iYieldList[j + 1] / lAggregatedYield;
+      ioWorkspace._protectionList[j] =
+        getComplementQuantile (lAggregatedMean, std::sqrt (lAggregatedVariance),
+                               std::min (lYieldRatio, 1.0));
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::optimiseByMC (const unsigned int iNbOfClasses,
+                                   const double* iYieldList,
+                                   const double* iMeanList,
+                                   const double* iStdDevList,
+                                   const unsigned int iCapacity,
+                                   const stdair::NbOfSamples_T iNbOfSamples,
+                                   LegOptimisationWorkspace& ioWorkspace) {
+    // Each class draws its demands with its own seed, given in turn by a
+    // seed generator, as Optimiser::optimalOptimisationByMCIntegration()
+    // does for the booking classes: both give the same protections and
+    // bid prices.
+    stdair::RandomGeneration lSeedGenerator (stdair::DEFAULT_RANDOM_SEED);
+
+    // Initialise the partial sums with the demand draws of the first class.
+    LegOptimisationWorkspace::ValueList_T& lPartialSumHolder =
+      ioWorkspace._partialSumList;
+    LegOptimisationWorkspace::ValueList_T& lSampleList =
+      ioWorkspace._sampleList;
+    lPartialSumHolder.resize (iNbOfSamples);
+    lSampleList.resize (iNbOfSamples);
+    stdair::RandomSeed_T lRandomSeed =
+      lSeedGenerator.generateUniform01() * 1e9;
+    drawDemands (lRandomSeed, iMeanList[0], iStdDevList[0], iNbOfSamples,
+                 lPartialSumHolder.data());
+
+    double* lBPV = ioWorkspace._bidPriceList.data();
+    unsigned int idx = 1;
+    unsigned int K = iNbOfSamples;
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j) {
+      if (K < 2) {
+        std::ostringstream ostr;
+        ostr << "The Monte-Carlo integration has not enough draws ("
+             << iNbOfSamples << ") for " << iNbOfClasses << " classes";
+        throw OptimisationException (ostr.str());
+      }
+      const double& yj = iYieldList[j];
+      const double& yj1 = iYieldList[j + 1];
+      double* lPSH = lPartialSumHolder.data();
+      std::sort (lPSH, lPSH + K);
+
+      // Compute the optimal index lj = floor {[y(j)-y(j+1)]/y(j) . K},
+      // kept within [1, K-1] when the draws are too few.
+      const double ljdouble = std::floor (K * (yj - yj1) / yj);
+      unsigned int lj = static_cast<unsigned int> (ljdouble);
+      lj = std::min (std::max (lj, 1u), K - 1);
+
+      //  The optimal protection: p(j) = 1/2 [S(j,lj) + S(j, lj+1)]
+      const double pj = (lPSH[lj - 1] + lPSH[lj]) / 2;
+      ioWorkspace._protectionList[j] = pj;
+
+      /** Compute the Bid-Price (Opportunity Cost) at index x
+          (capacity) for x between p(j-1) et p(j). This OC can be
+          proven to be equal to y(j) * Proba (D1 +...+ Dj >= x | D1 > p1,
+          D1 + D2 > p2, ..., D1 +... + D(j-1) > p(j-1)). */
+      const unsigned int pjint =
+        (pj > 0.0) ? static_cast<unsigned int> (pj) : 0;
+      double* itLowerBound = lPSH;
+      for (; idx <= pjint && idx <= iCapacity; ++idx) {
+        itLowerBound = std::lower_bound (itLowerBound, lPSH + K, double (idx));
+        const unsigned int pos = itLowerBound - lPSH;
+        lBPV[idx - 1] = yj * (K - pos) / K;
+      }
+
+      // Update the partial sums with the draws of the next class.
+      K -= lj;
+      lRandomSeed = lSeedGenerator.generateUniform01() * 1e9;
+      drawDemands (lRandomSeed, iMeanList[j + 1], iStdDevList[j + 1], K,
+                   lSampleList.data());
+      for (unsigned int i = 0; i < K; ++i) {
+        lPSH[i] = lPSH[i + lj] + lSampleList[i];
+      }
+    }
+
+    /** Compute the Bid-Price (Opportunity Cost) at index x
+        (capacity) for x between p(n-1) et cabin capacity. */
+    const double& yn = iYieldList[iNbOfClasses - 1];
+    double* lPSH = lPartialSumHolder.data();
+    std::sort (lPSH, lPSH + K);
+    double* itLowerBound = lPSH;
+    for (; idx <= iCapacity; ++idx) {
+      itLowerBound = std::lower_bound (itLowerBound, lPSH + K, double (idx));
+      const unsigned int pos = itLowerBound - lPSH;
+      lBPV[idx - 1] = yn * (K - pos) / K;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::optimiseByDP (const unsigned int iNbOfClasses,
+                                   const double* iYieldList,
+                                   const double* iMeanList,
+                                   const double* iStdDevList,
+                                   const unsigned int iCapacity,
+                                   LegOptimisationWorkspace& ioWorkspace) {
+    // The demands are discretised (the demand d being the mass of the
+    // normal distribution within [d-1/2, d+1/2), the negative values
+    // being counted as null demands), and the classes are processed from
+    // the highest one: V(j, x) is the expected revenue of the classes 0
+    // to j with x seats, the class j being sold the seats exceeding the
+    // protection p(j-1) of the higher classes.
+    LegOptimisationWorkspace::ValueList_T& lCdfList =
+      ioWorkspace._classValueList;
+    LegOptimisationWorkspace::ValueList_T& lPreviousValueList =
+      ioWorkspace._partialSumList;
+    LegOptimisationWorkspace::ValueList_T& lValueList =
+      ioWorkspace._sampleList;
+    lCdfList.resize (iCapacity + 1);
+    lPreviousValueList.assign (iCapacity + 1, 0.0);
+    lValueList.resize (iCapacity + 1);
+
+    unsigned int lProtection = 0;
+    for (unsigned int j = 0; j < iNbOfClasses; ++j) {
+      const double& lYield = iYieldList[j];
+
+      // Cumulative distribution, Pr (D(j) <= d), for d within [0, C]. The
+      // demands whose probability is negligible are not enumerated.
+      unsigned int lMaxDemand = iCapacity;
+      for (unsigned int d = 0; d <= iCapacity; ++d) {
+        lCdfList[d] = 1.0 - getTailProbability (iMeanList[j], iStdDevList[j],
+                                                d + 0.5);
+        if (lCdfList[d] >= 1.0 - DEFAULT_EPSILON
+            && lMaxDemand == iCapacity) {
+          lMaxDemand = d;
+        }
+      }
+
+      for (unsigned int x = 0; x <= iCapacity; ++x) {
+        const unsigned int lNbOfSeatsForSale =
+          (x > lProtection) ? x - lProtection : 0;
+        const unsigned int lLastDemand =
+          std::min (lNbOfSeatsForSale, lMaxDemand + 1);
+        double lValue = 0.0;
+        double lPreviousCdf = 0.0;
+        for (unsigned int d = 0; d < lLastDemand; ++d) {
+          lValue += (lCdfList[d] - lPreviousCdf)
+            * (lYield * d + lPreviousValueList[x - d]);
+          lPreviousCdf = lCdfList[d];
+        }
+        // All the seats for sale are sold when the demand exceeds them.
+        if (lNbOfSeatsForSale <= lMaxDemand + 1) {
+          lValue += (1.0 - lPreviousCdf)
+            * (lYield * lNbOfSeatsForSale
+               + lPreviousValueList[x - lNbOfSeatsForSale]);
+        }
+        lValueList[x] = lValue;
+      }
+
+      // The classes 0 to j are protected as long as the marginal value of
+      // a seat is greater than the yield of the next class.
+      if (j + 1 < iNbOfClasses) {
+        const double& lNextYield = iYieldList[j + 1];
+        lProtection = 0;
+        while (lProtection < iCapacity
+               && lValueList[lProtection + 1] - lValueList[lProtection]
+               > lNextYield) {
+          ++lProtection;
+        }
+        ioWorkspace._protectionList[j] = lProtection;
+      }
+      lPreviousValueList.swap (lValueList);
+    }
+
+    // The bid prices are the marginal values of the seats.
+    double* lBPV = ioWorkspace._bidPriceList.data();
+    for (unsigned int x = 1; x <= iCapacity; ++x) {
+      lBPV[x - 1] = lPreviousValueList[x] - lPreviousValueList[x - 1];
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::boundProtections (const unsigned int iNbOfClasses,
+                                       const unsigned int iCapacity,
+                                       LegOptimisationWorkspace& ioWorkspace) {
+    // The quantiles may be negative (the yield of the next class being
+    // close to the one of the protected classes), greater than the
+    // capacity, or lower than the protection of the higher classes.
+    double lPreviousProtection = 0.0;
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j) {
+      double& lProtection = ioWorkspace._protectionList[j];
+      lProtection = std::max (lProtection, lPreviousProtection);
+      lProtection = std::min (lProtection, static_cast<double> (iCapacity));
+      lPreviousProtection = lProtection;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void LegOptimiser::
+  computeBidPricesFromProtections (const unsigned int iNbOfClasses,
+                                   const double* iYieldList,
+                                   const unsigned int iCapacity,
+                                   LegOptimisationWorkspace& ioWorkspace) {
+    // With x remaining seats, the class j is available when x is greater
+    // than the protection of the classes 0 to j-1; the x-th seat is
+    // priced at the yield of the lowest available class.
+    double* lBPV = ioWorkspace._bidPriceList.data();
+    unsigned int j = 0;
+    for (unsigned int x = 1; x <= iCapacity; ++x) {
+      while (j + 1 < iNbOfClasses && x > ioWorkspace._protectionList[j]) {
+        ++j;
+      }
+      lBPV[x - 1] = iYieldList[j];
+    }
+  }
+}
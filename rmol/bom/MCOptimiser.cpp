@@ -180,16 +180,8 @@ namespace RMOL {
       ioLegCabin.getYieldLevelDemandMap();
     assert (!lYieldDemandMap.empty());
 
-    std::ostringstream oStr;
-    oStr << "Yield list ";
-    for (stdair::YieldLevelDemandMap_T::const_iterator itYD =
-           lYieldDemandMap.begin();
-         itYD != lYieldDemandMap.end(); ++itYD) {
-      const stdair::Yield_T& y = itYD->first;
-      oStr << y << " ";
-    }
-
-    STDAIR_LOG_DEBUG (oStr.str());
+    // Nothing is logged here, as the leg-cabins may be optimised
+    // concurrently and the logger is not thread-safe.
     ioLegCabin.emptyBidPriceVector();
     stdair::BidPriceVector_T& lBidPriceVector =
       ioLegCabin.getBidPriceVector();
@@ -300,19 +292,8 @@ namespace RMOL {
     ioLegCabin.updatePreviousBidPrice();
     ioLegCabin.setCurrentBidPrice (lBidPriceVector.back());
 
-    // Compute and display the bid price variation after optimisation
-    const stdair::BidPrice_T lPreviousBP = ioLegCabin.getPreviousBidPrice();
-    stdair::BidPrice_T lNewBP = ioLegCabin.getCurrentBidPrice();
     // Check
-    assert (lPreviousBP != 0);
-    stdair::BidPrice_T lBidPriceDelta = lNewBP - lPreviousBP;
-        
-    double lBidPriceVariation = 100*lBidPriceDelta/lPreviousBP;
-    
-    STDAIR_LOG_DEBUG ("Bid price: previous value " << lPreviousBP
-                      << ", new value " << lNewBP
-                      << ", variation " << lBidPriceVariation << " %"
-                      <<", BPV size " << lBidPriceVector.size());
+    assert (ioLegCabin.getPreviousBidPrice() != 0);
   }
   
 }
@@ -0,0 +1,66 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+// RMOL
+#include <rmol/bom/NetworkIterationReport.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkIterationReport::NetworkIterationReport () : _hasConverged (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkIterationReport::~NetworkIterationReport () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double NetworkIterationReport::getLastBidPriceVariation() const {
+    if (_bidPriceVariationList.empty() == true) {
+      return 0.0;
+    }
+    return _bidPriceVariationList.back();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int NetworkIterationReport::getNbOfOptimisedLegCabins() const {
+    unsigned int oNbOfOptimisedLegCabins = 0;
+    for (std::vector<unsigned int>::const_iterator itNb =
+           _nbOfOptimisedLegCabinsList.begin();
+         itNb != _nbOfOptimisedLegCabinsList.end(); ++itNb) {
+      oNbOfOptimisedLegCabins += *itNb;
+    }
+    return oNbOfOptimisedLegCabins;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkIterationReport::reset () {
+    _bidPriceVariationList.clear();
+    _nbOfOptimisedLegCabinsList.clear();
+    _hasConverged = false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkIterationReport::toStream (std::ostream& ioOut) const {
+    const unsigned short lNbOfIterations = getNbOfIterations();
+    for (unsigned short idx = 0; idx < lNbOfIterations; ++idx) {
+      ioOut << "Iteration " << idx + 1 << ": maximal bid price variation "
+            << _bidPriceVariationList[idx] << ", "
+            << _nbOfOptimisedLegCabinsList[idx]
+            << " optimised leg-cabin(s)" << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string NetworkIterationReport::describe() const {
+    std::ostringstream ostr;
+    ostr << "Network optimisation: " << getNbOfIterations()
+         << " iteration(s), " << getNbOfOptimisedLegCabins()
+         << " leg-cabin optimisation(s), last maximal bid price variation "
+         << getLastBidPriceVariation() << ", "
+         << ((_hasConverged == true) ? "converged" : "not converged") << ".";
+    return ostr.str();
+  }
+}
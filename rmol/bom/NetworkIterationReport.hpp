@@ -0,0 +1,101 @@
+#ifndef __RMOL_BOM_NETWORKITERATIONREPORT_HPP
+#define __RMOL_BOM_NETWORKITERATIONREPORT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Report of an iterative network optimisation, i.e., of the
+   * successive sweeps over the network, each one optimising all the
+   * leg-cabins before exchanging the bid prices between partners.
+   */
+  struct NetworkIterationReport : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of iterations (sweeps) performed. */
+    unsigned short getNbOfIterations() const {
+      return _bidPriceVariationList.size();
+    }
+
+    /** Get the maximal relative variation of the bid prices, for each
+        iteration. */
+    const std::vector<double>& getBidPriceVariationList() const {
+      return _bidPriceVariationList;
+    }
+
+    /** Get the number of leg-cabins (re-)optimised, for each
+        iteration. */
+    const std::vector<unsigned int>& getNbOfOptimisedLegCabinsList() const {
+      return _nbOfOptimisedLegCabinsList;
+    }
+
+    /** Get the total number of leg-cabin optimisations, over all the
+        iterations. */
+    unsigned int getNbOfOptimisedLegCabins() const;
+
+    /** Get the maximal relative variation of the bid prices at the last
+        iteration (0 when no iteration has been performed). */
+    double getLastBidPriceVariation() const;
+
+    /** State whether the bid prices converged, i.e., whether the last
+        variation went under the stopping criterion. */
+    bool hasConverged() const {
+      return _hasConverged;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /** Record an iteration, given its maximal bid price variation and
+        the number of leg-cabins it (re-)optimised. */
+    void addIteration (const double iBidPriceVariation,
+                       const unsigned int iNbOfOptimisedLegCabins) {
+      _bidPriceVariationList.push_back (iBidPriceVariation);
+      _nbOfOptimisedLegCabinsList.push_back (iNbOfOptimisedLegCabins);
+    }
+
+    /** Set whether the bid prices converged. */
+    void setConverged (const bool iHasConverged) {
+      _hasConverged = iHasConverged;
+    }
+
+    /** Clear the report. */
+    void reset();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    NetworkIterationReport ();
+
+    /** Destructor. */
+    virtual ~NetworkIterationReport();
+
+  private:
+    /** Maximal relative variation of the bid prices, per iteration. */
+    std::vector<double> _bidPriceVariationList;
+
+    /** Number of leg-cabins (re-)optimised, per iteration. */
+    std::vector<unsigned int> _nbOfOptimisedLegCabinsList;
+
+    /** Whether the bid prices converged. */
+    bool _hasConverged;
+  };
+}
+#endif // __RMOL_BOM_NETWORKITERATIONREPORT_HPP
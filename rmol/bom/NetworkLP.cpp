@@ -0,0 +1,166 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <algorithm>
+#include <map>
+// StdAir
+#include <stdair/basic/RandomGeneration.hpp>
+#include <stdair/bom/OnDDate.hpp>
+#include <stdair/bom/LegCabin.hpp>
+// RMOL
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+#include <rmol/bom/LegCabinImageTable.hpp>
+#include <rmol/bom/NetworkLP.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkLP::NetworkLP () {
+    _columnPointerList.push_back (0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkLP::~NetworkLP () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLP::build (const OnDIncidenceMatrix& iOnDIncidenceMatrix,
+                         const LegCabinImageTable& iLegCabinImageTable,
+                         const std::vector<stdair::OnDDate*>& iOnDDateList) {
+    clear();
+
+    // Rows of the leg-cabins, by column of the incidence matrix (the
+    // leg-cabins which are not travelled by any product get no row). An
+    // image shares the row of its real leg-cabin.
+    const unsigned int lNbOfLegCabins = iOnDIncidenceMatrix.getNbOfColumns();
+    std::vector<unsigned int> lRowIndexByLegCabin (lNbOfLegCabins,
+                                                   lNbOfLegCabins);
+    typedef std::map<const stdair::LegCabin*, unsigned int> RowIndexMap_T;
+    RowIndexMap_T lRowIndexMap;
+
+    for (std::vector<stdair::OnDDate*>::const_iterator itOD =
+           iOnDDateList.begin(); itOD != iOnDDateList.end(); ++itOD) {
+      const stdair::OnDDate* lOnDDate_ptr = *itOD;
+      assert (lOnDDate_ptr != NULL);
+      const stdair::NbOfSegments_T& lNbOfSegments =
+        lOnDDate_ptr->getNbOfSegments();
+      // Sanity check
+      assert (iOnDIncidenceMatrix.getNbOfSegments (*lOnDDate_ptr)
+              == lNbOfSegments);
+      const unsigned int lFirstSegmentIdx =
+        iOnDIncidenceMatrix.getFirstSegmentIndex (*lOnDDate_ptr);
+
+      // Each cabin-class path with some demand left makes a product.
+      const stdair::StringDemandStructMap_T& lStringDemandStructMap =
+        lOnDDate_ptr->getDemandInfoMap();
+      for (stdair::StringDemandStructMap_T::const_iterator itStrDS =
+             lStringDemandStructMap.begin();
+           itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
+        const std::string& lCabinClassPath = itStrDS->first;
+        const stdair::YieldDemandPair_T& lYieldDemandPair = itStrDS->second;
+        const stdair::Yield_T& lOnDYield = lYieldDemandPair.first;
+        const stdair::MeanStdDevPair_T& lMeanStdDevPair =
+          lYieldDemandPair.second;
+        if (lMeanStdDevPair.first <= 0.0) {
+          continue;
+        }
+        const stdair::CabinClassPairList_T& lCabinClassPairList =
+          lOnDDate_ptr->getCabinClassPairList (lCabinClassPath);
+        // Sanity check
+        assert (lCabinClassPairList.size() == lNbOfSegments);
+
+        // The product travels all the leg-cabins of its (operating)
+        // segment-cabins.
+        stdair::CabinClassPairList_T::const_iterator itCCP =
+          lCabinClassPairList.begin();
+        for (unsigned int idx = 0; idx < lNbOfSegments; ++idx, ++itCCP) {
+          const stdair::CabinCode_T& lCabinCode = itCCP->first;
+          const unsigned int lRowIdx =
+            iOnDIncidenceMatrix.getRowIndex (lFirstSegmentIdx + idx,
+                                             lCabinCode);
+          for (unsigned int lPos = iOnDIncidenceMatrix.getRowBegin (lRowIdx);
+               lPos < iOnDIncidenceMatrix.getRowEnd (lRowIdx); ++lPos) {
+            const unsigned int lColIdx =
+              iOnDIncidenceMatrix.getColumnIndex (lPos);
+            unsigned int& lLPRowIdx = lRowIndexByLegCabin[lColIdx];
+            if (lLPRowIdx == lNbOfLegCabins) {
+              stdair::LegCabin& lLegCabin = iLegCabinImageTable.
+                getRealLegCabin (iOnDIncidenceMatrix.getLegCabin (lColIdx));
+              const std::pair<RowIndexMap_T::iterator, bool> lInsertion =
+                lRowIndexMap.insert (RowIndexMap_T::
+                                     value_type (&lLegCabin,
+                                                 _legCabinList.size()));
+              if (lInsertion.second == true) {
+                _legCabinList.push_back (&lLegCabin);
+                const double lCapacity = lLegCabin.getAvailabilityPool();
+                _capacityList.push_back (std::max (0.0, lCapacity));
+              }
+              lLPRowIdx = lInsertion.first->second;
+            }
+            _rowIndexList.push_back (lLPRowIdx);
+          }
+        }
+        _columnPointerList.push_back (_rowIndexList.size());
+        _productKeyList.push_back (ProductKey_T (lOnDDate_ptr, lCabinClassPath));
+        _yieldList.push_back (lOnDYield);
+        _meanList.push_back (lMeanStdDevPair.first);
+        _stdDevList.push_back (lMeanStdDevPair.second);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLP::drawDemandList (stdair::RandomGeneration& ioGenerator,
+                                  std::vector<double>& oDemandList) const {
+    const unsigned int lNbOfColumns = getNbOfColumns();
+    oDemandList.resize (lNbOfColumns);
+    for (unsigned int lColIdx = 0; lColIdx < lNbOfColumns; ++lColIdx) {
+      const double& lMean = _meanList[lColIdx];
+      const double& lStdDev = _stdDevList[lColIdx];
+      double lDemand = lMean;
+      if (lStdDev > 0) {
+        lDemand = ioGenerator.generateNormal (lMean, lStdDev);
+      }
+      oDemandList[lColIdx] = std::max (0.0, lDemand);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLP::clear () {
+    _legCabinList.clear();
+    _capacityList.clear();
+    _productKeyList.clear();
+    _columnPointerList.assign (1, 0);
+    _rowIndexList.clear();
+    _yieldList.clear();
+    _meanList.clear();
+    _stdDevList.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLP::toStream (std::ostream& ioOut) const {
+    for (unsigned int lRowIdx = 0; lRowIdx < getNbOfRows(); ++lRowIdx) {
+      ioOut << getLegCabin (lRowIdx).getFullerKey() << ": capacity "
+            << _capacityList[lRowIdx] << std::endl;
+    }
+    for (unsigned int lColIdx = 0; lColIdx < getNbOfColumns(); ++lColIdx) {
+      ioOut << _productKeyList[lColIdx].second << ": yield "
+            << _yieldList[lColIdx] << ", demand " << _meanList[lColIdx]
+            << " (" << _stdDevList[lColIdx] << "), "
+            << _columnPointerList[lColIdx + 1] - _columnPointerList[lColIdx]
+            << " leg-cabin(s)" << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string NetworkLP::describe() const {
+    std::ostringstream ostr;
+    ostr << "Network LP (" << getNbOfRows() << " leg-cabins, "
+         << getNbOfColumns() << " products, " << _rowIndexList.size()
+         << " non-zeros).";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,180 @@
+#ifndef __RMOL_BOM_NETWORKLP_HPP
+#define __RMOL_BOM_NETWORKLP_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace stdair {
+  class OnDDate;
+  class LegCabin;
+  struct RandomGeneration;
+}
+
+namespace RMOL {
+
+  // Forward declarations
+  struct OnDIncidenceMatrix;
+  struct LegCabinImageTable;
+
+  /**
+   * @brief Deterministic linear program (DLP) of the network.
+   *
+   * Each column (product) stands for a cabin-class path of an O&D-date,
+   * and each row for a leg-cabin travelled by the products. The program
+   * is:
+   * max sum(j) y(j).x(j)
+   * subject to sum(j travelling l) x(j) <= C(l) for each leg-cabin l,
+   * and 0 <= x(j) <= d(j) for each product j,
+   * where y(j) is the O&D yield of the product, d(j) the mean of its
+   * (remaining) forecast demand and C(l) the availability pool of the
+   * leg-cabin. The shadow prices of the rows give the bid prices of the
+   * leg-cabins.
+   *
+   * The columns are stored in the compressed sparse column (CSC) format
+   * expected by the DualSimplex solver. The program is built, from the
+   * O&D incidence matrix, for the O&D-dates of an RM event.
+   *
+   * The code-share segments travel the images of the leg-cabins held by
+   * the marketing partners: each image is replaced by its real leg-cabin
+   * (see LegCabinImageTable), so that there is a single row, of the
+   * capacity of the real leg-cabin, by physical leg-cabin.
+   */
+  struct NetworkLP : public stdair::StructAbstract {
+
+  public:
+    /** Define the key of a product, i.e., its O&D-date and its cabin-class
+        path, which identifies it from one program to the next. */
+    typedef std::pair<const stdair::OnDDate*, std::string> ProductKey_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the number of rows (real leg-cabins). */
+    unsigned int getNbOfRows() const {
+      return _legCabinList.size();
+    }
+
+    /** Get the number of columns (products). */
+    unsigned int getNbOfColumns() const {
+      return _yieldList.size();
+    }
+
+    /** Get the leg-cabin of the given row. */
+    stdair::LegCabin& getLegCabin (const unsigned int iRowIndex) const {
+      assert (iRowIndex < _legCabinList.size());
+      assert (_legCabinList[iRowIndex] != NULL);
+      return *_legCabinList[iRowIndex];
+    }
+
+    /** Get the key of the product of the given column. */
+    const ProductKey_T& getProductKey (const unsigned int iColIndex) const {
+      assert (iColIndex < _productKeyList.size());
+      return _productKeyList[iColIndex];
+    }
+
+    /** Get the column pointers (see DualSimplex). */
+    const std::vector<unsigned int>& getColumnPointerList() const {
+      return _columnPointerList;
+    }
+
+    /** Get the row indices (see DualSimplex). */
+    const std::vector<unsigned int>& getRowIndexList() const {
+      return _rowIndexList;
+    }
+
+    /** Get the yields of the products, by column. */
+    const std::vector<double>& getYieldList() const {
+      return _yieldList;
+    }
+
+    /** Get the means of the demand of the products, by column. */
+    const std::vector<double>& getMeanList() const {
+      return _meanList;
+    }
+
+    /** Get the standard deviations of the demand of the products, by
+        column. */
+    const std::vector<double>& getStdDevList() const {
+      return _stdDevList;
+    }
+
+    /** Get the capacities (availability pools) of the leg-cabins, by
+        row. */
+    const std::vector<double>& getCapacityList() const {
+      return _capacityList;
+    }
+
+  public:
+    // ////// Business Methods //////
+    /** Build the program from the given O&D-dates, the leg-cabins of which
+        are given by the O&D incidence matrix, and those of the images by
+        the leg-cabin image table. */
+    void build (const OnDIncidenceMatrix&, const LegCabinImageTable&,
+                const std::vector<stdair::OnDDate*>&);
+
+    /** Draw a demand scenario of the products, from the (normal)
+        distributions of their forecast demand, the negative draws being
+        replaced by zero. The scenario is given by column, as the upper
+        bounds of a randomised linear program (RLP). */
+    void drawDemandList (stdair::RandomGeneration&, std::vector<double>&) const;
+
+    /** Clear the program. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    NetworkLP ();
+
+    /** Destructor. */
+    virtual ~NetworkLP();
+
+  private:
+    /** Leg-cabins, by row. */
+    std::vector<stdair::LegCabin*> _legCabinList;
+
+    /** Capacities of the leg-cabins, by row. */
+    std::vector<double> _capacityList;
+
+    /** Keys of the products, by column. */
+    std::vector<ProductKey_T> _productKeyList;
+
+    /** Rows of the columns: the rows of the column of index j are given
+        by the positions from _columnPointerList[j] (included) to
+        _columnPointerList[j+1] (excluded) of _rowIndexList. */
+    std::vector<unsigned int> _columnPointerList;
+
+    /** Row indices (see above). */
+    std::vector<unsigned int> _rowIndexList;
+
+    /** Yields of the products, by column. */
+    std::vector<double> _yieldList;
+
+    /** Means of the demand of the products, by column. */
+    std::vector<double> _meanList;
+
+    /** Standard deviations of the demand of the products, by column. */
+    std::vector<double> _stdDevList;
+  };
+}
+#endif // __RMOL_BOM_NETWORKLP_HPP
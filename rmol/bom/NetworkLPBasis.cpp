@@ -0,0 +1,85 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/LegCabin.hpp>
+// RMOL
+#include <rmol/bom/NetworkLPBasis.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkLPBasis::NetworkLPBasis () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkLPBasis::~NetworkLPBasis () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLPBasis::load (const NetworkLP& iNetworkLP,
+                             FlagVector_T& ioBasicFlagList) const {
+    const unsigned int lNbOfColumns = iNetworkLP.getNbOfColumns();
+    const unsigned int lNbOfRows = iNetworkLP.getNbOfRows();
+    ioBasicFlagList.assign (lNbOfColumns + lNbOfRows, false);
+
+    // The variables which were never part of a program are non-basic,
+    // apart from the slacks (cold start).
+    for (unsigned int lColIdx = 0; lColIdx < lNbOfColumns; ++lColIdx) {
+      ProductFlagMap_T::const_iterator itFlag =
+        _productFlagMap.find (iNetworkLP.getProductKey (lColIdx));
+      if (itFlag != _productFlagMap.end()) {
+        ioBasicFlagList[lColIdx] = itFlag->second;
+      }
+    }
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      LegCabinFlagMap_T::const_iterator itFlag =
+        _legCabinFlagMap.find (&iNetworkLP.getLegCabin (lRowIdx));
+      ioBasicFlagList[lNbOfColumns + lRowIdx] =
+        (itFlag == _legCabinFlagMap.end()) ? true : itFlag->second;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLPBasis::save (const NetworkLP& iNetworkLP,
+                             const FlagVector_T& iBasicFlagList) {
+    const unsigned int lNbOfColumns = iNetworkLP.getNbOfColumns();
+    const unsigned int lNbOfRows = iNetworkLP.getNbOfRows();
+    assert (iBasicFlagList.size() == lNbOfColumns + lNbOfRows);
+    for (unsigned int lColIdx = 0; lColIdx < lNbOfColumns; ++lColIdx) {
+      _productFlagMap[iNetworkLP.getProductKey (lColIdx)] =
+        iBasicFlagList[lColIdx];
+    }
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      _legCabinFlagMap[&iNetworkLP.getLegCabin (lRowIdx)] =
+        iBasicFlagList[lNbOfColumns + lRowIdx];
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLPBasis::clear () {
+    _productFlagMap.clear();
+    _legCabinFlagMap.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void NetworkLPBasis::toStream (std::ostream& ioOut) const {
+    for (LegCabinFlagMap_T::const_iterator itFlag = _legCabinFlagMap.begin();
+         itFlag != _legCabinFlagMap.end(); ++itFlag) {
+      assert (itFlag->first != NULL);
+      ioOut << itFlag->first->getFullerKey() << ": slack basic: "
+            << itFlag->second << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string NetworkLPBasis::describe() const {
+    std::ostringstream ostr;
+    ostr << "Network LP basis (" << _productFlagMap.size() << " products, "
+         << _legCabinFlagMap.size() << " leg-cabins).";
+    return ostr.str();
+  }
+}
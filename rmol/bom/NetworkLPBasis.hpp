@@ -0,0 +1,84 @@
+#ifndef __RMOL_BOM_NETWORKLPBASIS_HPP
+#define __RMOL_BOM_NETWORKLPBASIS_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <map>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/NetworkLP.hpp>
+
+// Forward declarations
+namespace stdair {
+  class LegCabin;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Optimal bases of the network linear programs, kept from one RM
+   * event to the next (warm start).
+   *
+   * The basis is recorded by product (O&D-date and cabin-class path) and
+   * by leg-cabin (slack of its row), so that it can be carried over to
+   * the program of a later RM event, even though that program does not
+   * hold the same O&D-dates: the variables which were basic the last time
+   * their product (resp. leg-cabin) was part of a program are given as
+   * the starting basis of the dual simplex.
+   *
+   * The basis must be cleared whenever O&D-dates or flight-dates are
+   * removed from the BOM tree.
+   */
+  struct NetworkLPBasis : public stdair::StructAbstract {
+
+  public:
+    // ////// Business Methods //////
+    /** Get the starting basis of the given program, i.e., whether each
+        variable (the columns followed by the slacks of the rows) is
+        basic. */
+    void load (const NetworkLP&, FlagVector_T&) const;
+
+    /** Record the (optimal) basis of the given program. */
+    void save (const NetworkLP&, const FlagVector_T&);
+
+    /** Clear the basis. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    NetworkLPBasis ();
+
+    /** Destructor. */
+    virtual ~NetworkLPBasis();
+
+  private:
+    /** Define the basis flags, by product. */
+    typedef std::map<NetworkLP::ProductKey_T, bool> ProductFlagMap_T;
+
+    /** Define the basis flags of the slacks, by leg-cabin. */
+    typedef std::map<const stdair::LegCabin*, bool> LegCabinFlagMap_T;
+
+  private:
+    /** Whether the products were basic. */
+    ProductFlagMap_T _productFlagMap;
+
+    /** Whether the slacks of the leg-cabins were basic. */
+    LegCabinFlagMap_T _legCabinFlagMap;
+  };
+}
+#endif // __RMOL_BOM_NETWORKLPBASIS_HPP
@@ -0,0 +1,105 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+// StdAir
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/ContinuousAttributeLite.hpp>
+// RMOL
+#include <rmol/bom/OnDForecastTable.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  OnDForecastTable::OnDForecastTable () : _isBuilt (false), _lowestDTD (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  OnDForecastTable::~OnDForecastTable () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDForecastTable::build () {
+    const stdair::DTDFratMap_T& lDTDFratMap = stdair::DEFAULT_DTD_FRAT5COEF_MAP;
+    assert (lDTDFratMap.empty() == false);
+    _lowestDTD = lDTDFratMap.begin()->first;
+    const stdair::DTD_T& lHighestDTD = lDTDFratMap.rbegin()->first;
+    const unsigned int lNbOfDTDs = lHighestDTD - _lowestDTD + 1;
+
+    _isDefinedList.assign (lNbOfDTDs, false);
+    _remainingProportionList.assign (lNbOfDTDs, 0.0);
+    _frat5CoefList.assign (lNbOfDTDs, 0.0);
+    _sellUpCoefList.assign (lNbOfDTDs, 0.0);
+
+    // The arrival pattern is given on the opposite of the DTDs.
+    const stdair::ContinuousAttributeLite<stdair::FloatDuration_T>
+      lArrivalPattern (stdair::DEFAULT_DTD_PROB_MAP);
+    for (stdair::DTDFratMap_T::const_iterator itDFC = lDTDFratMap.begin();
+         itDFC != lDTDFratMap.end(); ++itDFC) {
+      const stdair::DTD_T& lDTD = itDFC->first;
+      const stdair::RealNumber_T& lFrat5Coef = itDFC->second;
+      const unsigned int lIdx = lDTD - _lowestDTD;
+      _isDefinedList[lIdx] = true;
+      _remainingProportionList[lIdx] =
+        lArrivalPattern.getRemainingProportion (-float(lDTD));
+      _frat5CoefList[lIdx] = lFrat5Coef;
+      _sellUpCoefList[lIdx] = log(0.5)/(lFrat5Coef-1.0);
+    }
+    _isBuilt = true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDForecastTable::
+  computeProportionFactors (const stdair::DTD_T& iDTD,
+                            const stdair::WTP_T& iMinWTP,
+                            const YieldList_T& iYieldList,
+                            stdair::ProportionFactorList_T& ioFactorList)
+    const {
+    assert (hasDTD (iDTD) == true);
+    const unsigned int lNbOfYields = iYieldList.size();
+    ioFactorList.resize (lNbOfYields);
+    if (lNbOfYields == 0) {
+      return;
+    }
+
+    // Cumulative proportions. If the yield is smaller than the minimal
+    // WTP, the factor is greater than 1, and is put back to 1.
+    const double lRate = _sellUpCoefList[iDTD - _lowestDTD] / iMinWTP;
+    const stdair::Yield_T* lYield_ptr = iYieldList.data();
+    stdair::ProportionFactor_T* lFactor_ptr = ioFactorList.data();
+    for (unsigned int idx = 0; idx < lNbOfYields; ++idx) {
+      lFactor_ptr[idx] = std::min (exp ((lYield_ptr[idx] - iMinWTP) * lRate),
+                                   1.0);
+    }
+
+    // Increments from one rung to the next (from the highest rung down,
+    // so that the cumulative proportions can be overwritten in place).
+    for (unsigned int idx = lNbOfYields - 1; idx > 0; --idx) {
+      lFactor_ptr[idx] -= lFactor_ptr[idx - 1];
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDForecastTable::toStream (std::ostream& ioOut) const {
+    for (unsigned int lIdx = 0; lIdx < _isDefinedList.size(); ++lIdx) {
+      if (_isDefinedList[lIdx] == false) {
+        continue;
+      }
+      ioOut << "DTD " << _lowestDTD + lIdx << ": remaining proportion "
+            << _remainingProportionList[lIdx] << ", FRAT5 coef "
+            << _frat5CoefList[lIdx] << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string OnDForecastTable::describe() const {
+    std::ostringstream ostr;
+    ostr << "O&D forecast table (" << _isDefinedList.size() << " DTDs from "
+         << _lowestDTD << ").";
+    return ostr.str();
+  }
+}
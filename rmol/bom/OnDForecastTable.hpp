@@ -0,0 +1,119 @@
+#ifndef __RMOL_BOM_ONDFORECASTTABLE_HPP
+#define __RMOL_BOM_ONDFORECASTTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Table, by DTD (days to departure), of the parameters of the
+   * O&D forecast: the remaining proportion of the booking requests (out
+   * of the default arrival pattern) and the FRAT5 coefficient.
+   *
+   * The table is built once, from the default DTD maps of StdAir, and
+   * does not depend on the BOM tree. It spans the DTDs of the FRAT5 map,
+   * and its entries are contiguous in memory.
+   */
+  struct OnDForecastTable : public stdair::StructAbstract {
+
+  public:
+    /** Define the list of the yields of a yield ladder. */
+    typedef std::vector<stdair::Yield_T> YieldList_T;
+
+  public:
+    // ////// Getters //////
+    /** State whether the table has been built. */
+    bool isBuilt() const {
+      return _isBuilt;
+    }
+
+    /** State whether the given DTD has a FRAT5 coefficient. */
+    bool hasDTD (const stdair::DTD_T& iDTD) const {
+      const int lIdx = int (iDTD) - int (_lowestDTD);
+      return (lIdx >= 0 && lIdx < int (_isDefinedList.size())
+              && _isDefinedList[lIdx] == true);
+    }
+
+    /** Get the remaining proportion of the booking requests at the given
+        DTD, which must be part of the table. */
+    const stdair::Probability_T&
+    getRemainingProportion (const stdair::DTD_T& iDTD) const {
+      assert (hasDTD (iDTD) == true);
+      return _remainingProportionList[iDTD - _lowestDTD];
+    }
+
+    /** Get the FRAT5 coefficient of the given DTD, which must be part of
+        the table. */
+    const stdair::RealNumber_T& getFrat5Coef (const stdair::DTD_T& iDTD) const {
+      assert (hasDTD (iDTD) == true);
+      return _frat5CoefList[iDTD - _lowestDTD];
+    }
+
+  public:
+    // ////// Business Methods //////
+    /** Build the table from the default DTD maps. */
+    void build();
+
+    /**
+     * Compute the proportion of the demand to come, of the given minimal
+     * willingness-to-pay, going to each rung of the given yield ladder
+     * (given in decreasing order) at the given DTD, which must be part of
+     * the table.
+     *
+     * The proportion of the demand willing to pay the yield y is
+     * min (1, exp ((y - WTP) * ln(0.5) / (WTP * (FRAT5 - 1)))), and each
+     * rung gets the increase of that proportion from the previous one.
+     */
+    void computeProportionFactors (const stdair::DTD_T&, const stdair::WTP_T&,
+                                   const YieldList_T&,
+                                   stdair::ProportionFactorList_T&) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    OnDForecastTable ();
+
+    /** Destructor. */
+    virtual ~OnDForecastTable();
+
+  private:
+    /** Whether the table has been built. */
+    bool _isBuilt;
+
+    /** Lowest DTD of the table. */
+    stdair::DTD_T _lowestDTD;
+
+    /** Whether each DTD has a FRAT5 coefficient. */
+    FlagVector_T _isDefinedList;
+
+    /** Remaining proportions of the booking requests, by DTD. */
+    std::vector<stdair::Probability_T> _remainingProportionList;
+
+    /** FRAT5 coefficients, by DTD. */
+    std::vector<stdair::RealNumber_T> _frat5CoefList;
+
+    /** Sell-up coefficients, ln(0.5) / (FRAT5 - 1), by DTD. */
+    std::vector<double> _sellUpCoefList;
+  };
+}
+#endif // __RMOL_BOM_ONDFORECASTTABLE_HPP
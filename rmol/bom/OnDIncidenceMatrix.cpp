@@ -0,0 +1,226 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/OnDDate.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/LegCabin.hpp>
+// RMOL
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  OnDIncidenceMatrix::OnDIncidenceMatrix () : _isBuilt (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  OnDIncidenceMatrix::~OnDIncidenceMatrix () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int OnDIncidenceMatrix::
+  getOnDDateIndex (const stdair::OnDDate& iOnDDate) const {
+    assert (_isBuilt == true);
+    OnDDateIndexMap_T::const_iterator itOnDDateIndex =
+      _onDDateIndexMap.find (&iOnDDate);
+    assert (itOnDDateIndex != _onDDateIndexMap.end());
+    return itOnDDateIndex->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int OnDIncidenceMatrix::
+  getFirstSegmentIndex (const stdair::OnDDate& iOnDDate) const {
+    const unsigned int lOnDDateIndex = getOnDDateIndex (iOnDDate);
+    return _segmentPointerList[lOnDDateIndex];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int OnDIncidenceMatrix::
+  getNbOfSegments (const stdair::OnDDate& iOnDDate) const {
+    const unsigned int lOnDDateIndex = getOnDDateIndex (iOnDDate);
+    return (_segmentPointerList[lOnDDateIndex + 1]
+            - _segmentPointerList[lOnDDateIndex]);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int OnDIncidenceMatrix::
+  getRowIndex (const unsigned int iSegmentIndex,
+               const stdair::CabinCode_T& iCabinCode) const {
+    assert (iSegmentIndex + 1 < _cabinPointerList.size());
+    for (unsigned int lRowIdx = _cabinPointerList[iSegmentIndex];
+         lRowIdx < _cabinPointerList[iSegmentIndex + 1]; ++lRowIdx) {
+      if (_cabinCodeList[lRowIdx] == iCabinCode) {
+        return lRowIdx;
+      }
+    }
+    assert (false);
+    return getNbOfRows();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::SegmentCabin& OnDIncidenceMatrix::
+  getSegmentCabin (const unsigned int iRowIndex) const {
+    assert (iRowIndex < _segmentCabinList.size());
+    const stdair::SegmentCabin* lSegmentCabin_ptr =
+      _segmentCabinList[iRowIndex];
+    assert (lSegmentCabin_ptr != NULL);
+    return *lSegmentCabin_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDIncidenceMatrix::build (const stdair::BomRoot& iBomRoot) {
+    clear();
+    _isBuilt = true;
+    _segmentPointerList.push_back (0);
+    _cabinPointerList.push_back (0);
+    _rowPointerList.push_back (0);
+
+    typedef std::map<const stdair::LegCabin*, unsigned int> ColumnIndexMap_T;
+    ColumnIndexMap_T lColumnIndexMap;
+
+    const stdair::InventoryList_T& lInventoryList =
+      stdair::BomManager::getList<stdair::Inventory> (iBomRoot);
+    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+         itInv != lInventoryList.end(); ++itInv) {
+      const stdair::Inventory* lInventory_ptr = *itInv;
+      assert (lInventory_ptr != NULL);
+      const bool hasOnDDateList =
+        stdair::BomManager::hasList<stdair::OnDDate> (*lInventory_ptr);
+      if (hasOnDDateList == false) {
+        continue;
+      }
+      const stdair::OnDDateList_T& lOnDDateList =
+        stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
+      for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
+           itOD != lOnDDateList.end(); ++itOD) {
+        const stdair::OnDDate* lOnDDate_ptr = *itOD;
+        assert (lOnDDate_ptr != NULL);
+        _onDDateIndexMap.insert (OnDDateIndexMap_T::
+                                 value_type (lOnDDate_ptr,
+                                             _segmentPointerList.size() - 1));
+
+        const stdair::SegmentDateList_T& lOnDSegmentDateList =
+          stdair::BomManager::getList<stdair::SegmentDate> (*lOnDDate_ptr);
+        for (stdair::SegmentDateList_T::const_iterator itSD =
+               lOnDSegmentDateList.begin();
+             itSD != lOnDSegmentDateList.end(); ++itSD) {
+          // The operating segment-date holds the bid price information.
+          const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
+          assert (lSegmentDate_ptr != NULL);
+          const stdair::SegmentDate* lOperatingSegmentDate_ptr =
+            lSegmentDate_ptr->getOperatingSegmentDate();
+          const bool isOperated = (lOperatingSegmentDate_ptr == NULL);
+          if (isOperated == false) {
+            lSegmentDate_ptr = lOperatingSegmentDate_ptr;
+          }
+
+          // Register a row for each cabin of the segment.
+          const stdair::SegmentCabinList_T& lSegmentCabinList =
+            stdair::BomManager::getList<stdair::SegmentCabin> (*lSegmentDate_ptr);
+          for (stdair::SegmentCabinList_T::const_iterator itSC =
+                 lSegmentCabinList.begin();
+               itSC != lSegmentCabinList.end(); ++itSC) {
+            const stdair::SegmentCabin* lSegmentCabin_ptr = *itSC;
+            assert (lSegmentCabin_ptr != NULL);
+            _cabinCodeList.push_back (lSegmentCabin_ptr->getCabinCode());
+            _segmentCabinList.push_back (lSegmentCabin_ptr);
+            _operatedFlagList.push_back (isOperated);
+
+            const stdair::LegCabinList_T& lLegCabinList =
+              stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
+            assert (!lLegCabinList.empty());
+            for (stdair::LegCabinList_T::const_iterator itLC =
+                   lLegCabinList.begin(); itLC != lLegCabinList.end(); ++itLC) {
+              stdair::LegCabin* lLegCabin_ptr = *itLC;
+              assert (lLegCabin_ptr != NULL);
+              const std::pair<ColumnIndexMap_T::iterator, bool> lInsertion =
+                lColumnIndexMap.insert (ColumnIndexMap_T::
+                                        value_type (lLegCabin_ptr,
+                                                    _legCabinList.size()));
+              if (lInsertion.second == true) {
+                _legCabinList.push_back (lLegCabin_ptr);
+              }
+              _columnIndexList.push_back (lInsertion.first->second);
+            }
+            _rowPointerList.push_back (_columnIndexList.size());
+          }
+          _cabinPointerList.push_back (_cabinCodeList.size());
+        }
+        _segmentPointerList.push_back (_cabinPointerList.size() - 1);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDIncidenceMatrix::clear () {
+    _onDDateIndexMap.clear();
+    _segmentPointerList.clear();
+    _cabinPointerList.clear();
+    _cabinCodeList.clear();
+    _segmentCabinList.clear();
+    _operatedFlagList.clear();
+    _rowPointerList.clear();
+    _columnIndexList.clear();
+    _legCabinList.clear();
+    _isBuilt = false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDIncidenceMatrix::
+  getBidPriceList (std::vector<stdair::BidPrice_T>& ioBidPriceList) const {
+    const unsigned int lNbOfColumns = getNbOfColumns();
+    ioBidPriceList.resize (lNbOfColumns);
+    for (unsigned int lColIdx = 0; lColIdx < lNbOfColumns; ++lColIdx) {
+      ioBidPriceList[lColIdx] = getLegCabin (lColIdx).getCurrentBidPrice();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDIncidenceMatrix::
+  multiply (const std::vector<stdair::BidPrice_T>& iColumnValueList,
+            std::vector<stdair::BidPrice_T>& ioRowValueList) const {
+    assert (iColumnValueList.size() == getNbOfColumns());
+    const unsigned int lNbOfRows = getNbOfRows();
+    ioRowValueList.resize (lNbOfRows);
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      stdair::BidPrice_T lRowValue = 0;
+      for (unsigned int lPos = _rowPointerList[lRowIdx];
+           lPos < _rowPointerList[lRowIdx + 1]; ++lPos) {
+        lRowValue += iColumnValueList[_columnIndexList[lPos]];
+      }
+      ioRowValueList[lRowIdx] = lRowValue;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void OnDIncidenceMatrix::toStream (std::ostream& ioOut) const {
+    const unsigned int lNbOfRows = getNbOfRows();
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      ioOut << getSegmentCabin (lRowIdx).describeKey()
+            << ((isOperated (lRowIdx) == true) ? " (operated):" : ":");
+      for (unsigned int lPos = getRowBegin (lRowIdx);
+           lPos < getRowEnd (lRowIdx); ++lPos) {
+        ioOut << " " << getLegCabin (getColumnIndex (lPos)).getFullerKey();
+      }
+      ioOut << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string OnDIncidenceMatrix::describe() const {
+    std::ostringstream ostr;
+    ostr << "O&D incidence matrix (built: " << _isBuilt << ", "
+         << _onDDateIndexMap.size() << " O&D-dates, " << getNbOfRows()
+         << " segment-cabins x " << getNbOfColumns() << " leg-cabins, "
+         << _columnIndexList.size() << " non-zeros).";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,197 @@
+#ifndef __RMOL_BOM_ONDINCIDENCEMATRIX_HPP
+#define __RMOL_BOM_ONDINCIDENCEMATRIX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <map>
+// StdAir
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class OnDDate;
+  class SegmentCabin;
+  class LegCabin;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Sparse incidence matrix between the segment-cabins travelled
+   * by the O&D-dates and the leg-cabins.
+   *
+   * Each row stands for a cabin of a segment of an O&D-date, i.e., for
+   * the segment-cabin of the operating segment-date (which holds the bid
+   * prices), and each column for a leg-cabin. A row holds the leg-cabins
+   * of its segment-cabin, in the order of the BOM tree. The rows are
+   * stored in the compressed sparse row (CSR) format, O&D-date after
+   * O&D-date and segment after segment. The operating segment-date of a
+   * code-share segment is the image held by the marketing partner, so
+   * that its leg-cabins are images too (LegCabinImageTable gives their
+   * real leg-cabins).
+   *
+   * The matrix is built once from the BOM tree, so that the demand
+   * projections do not browse the BOM tree (nor look the segment-cabins
+   * up by their keys) for each O&D-date. It must be cleared whenever
+   * O&D-dates or flight-dates are added to (or removed from) the BOM tree.
+   */
+  struct OnDIncidenceMatrix : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** State whether the matrix has been built. */
+    bool isBuilt() const {
+      return _isBuilt;
+    }
+
+    /** Get the number of rows (segment-cabins of the O&D-dates). */
+    unsigned int getNbOfRows() const {
+      return _segmentCabinList.size();
+    }
+
+    /** Get the number of columns (leg-cabins). */
+    unsigned int getNbOfColumns() const {
+      return _legCabinList.size();
+    }
+
+    /** Get the index of the first segment of the given O&D-date. */
+    unsigned int getFirstSegmentIndex (const stdair::OnDDate&) const;
+
+    /** Get the number of segments of the given O&D-date. */
+    unsigned int getNbOfSegments (const stdair::OnDDate&) const;
+
+    /** Get the index of the row of the given segment (index) and cabin. */
+    unsigned int getRowIndex (const unsigned int iSegmentIndex,
+                              const stdair::CabinCode_T&) const;
+
+    /** State whether the segment of the given row is operated by the
+        O&D-date inventory (only those segments receive the demand). */
+    bool isOperated (const unsigned int iRowIndex) const {
+      assert (iRowIndex < _operatedFlagList.size());
+      return _operatedFlagList[iRowIndex];
+    }
+
+    /** Get the (operating) segment-cabin of the given row. */
+    const stdair::SegmentCabin& getSegmentCabin (const unsigned int) const;
+
+    /** Get the position, within the column index list, of the first
+        column of the given row. */
+    unsigned int getRowBegin (const unsigned int iRowIndex) const {
+      assert (iRowIndex + 1 < _rowPointerList.size());
+      return _rowPointerList[iRowIndex];
+    }
+
+    /** Get the position, within the column index list, following the last
+        column of the given row. */
+    unsigned int getRowEnd (const unsigned int iRowIndex) const {
+      assert (iRowIndex + 1 < _rowPointerList.size());
+      return _rowPointerList[iRowIndex + 1];
+    }
+
+    /** Get the column index at the given position. */
+    unsigned int getColumnIndex (const unsigned int iPosition) const {
+      assert (iPosition < _columnIndexList.size());
+      return _columnIndexList[iPosition];
+    }
+
+    /** Get the leg-cabin of the given column. */
+    stdair::LegCabin& getLegCabin (const unsigned int iColumnIndex) const {
+      assert (iColumnIndex < _legCabinList.size());
+      assert (_legCabinList[iColumnIndex] != NULL);
+      return *_legCabinList[iColumnIndex];
+    }
+
+  public:
+    // ////// Business Methods //////
+    /** Build the matrix from the O&D-dates of all the inventories of the
+        BOM tree. */
+    void build (const stdair::BomRoot&);
+
+    /** Clear the matrix. */
+    void clear();
+
+    /** Get the current bid prices of the leg-cabins, by column. */
+    void getBidPriceList (std::vector<stdair::BidPrice_T>&) const;
+
+    /**
+     * Multiply the matrix by the given vector (e.g., sum the bid prices of
+     * the leg-cabins of each segment-cabin).
+     *
+     * @param const std::vector<stdair::BidPrice_T>& Values, by column.
+     * @param std::vector<stdair::BidPrice_T>& Products, by row.
+     */
+    void multiply (const std::vector<stdair::BidPrice_T>&,
+                   std::vector<stdair::BidPrice_T>&) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    OnDIncidenceMatrix ();
+
+    /** Destructor. */
+    virtual ~OnDIncidenceMatrix();
+
+  private:
+    /** Define the map of the O&D-date indices. */
+    typedef std::map<const stdair::OnDDate*, unsigned int> OnDDateIndexMap_T;
+
+    /** Retrieve the index of the given O&D-date. */
+    unsigned int getOnDDateIndex (const stdair::OnDDate&) const;
+
+  private:
+    /** Whether the matrix has been built. */
+    bool _isBuilt;
+
+    /** Indices of the O&D-dates. */
+    OnDDateIndexMap_T _onDDateIndexMap;
+
+    /** Segments of the O&D-dates: the segments of the O&D-date of index
+        i have the indices from _segmentPointerList[i] (included) to
+        _segmentPointerList[i+1] (excluded). */
+    std::vector<unsigned int> _segmentPointerList;
+
+    /** Rows of the segments: the rows (cabins) of the segment of index j
+        have the indices from _cabinPointerList[j] (included) to
+        _cabinPointerList[j+1] (excluded). */
+    std::vector<unsigned int> _cabinPointerList;
+
+    /** Cabin codes, by row. */
+    std::vector<stdair::CabinCode_T> _cabinCodeList;
+
+    /** Operating segment-cabins, by row. */
+    std::vector<const stdair::SegmentCabin*> _segmentCabinList;
+
+    /** Whether the segments are operated, by row. */
+    FlagVector_T _operatedFlagList;
+
+    /** Columns of the rows: the columns of the row of index k are given by
+        the positions from _rowPointerList[k] (included) to
+        _rowPointerList[k+1] (excluded) of _columnIndexList. */
+    std::vector<unsigned int> _rowPointerList;
+
+    /** Column indices (see above). */
+    std::vector<unsigned int> _columnIndexList;
+
+    /** Leg-cabins, by column. */
+    std::vector<stdair::LegCabin*> _legCabinList;
+  };
+}
+#endif // __RMOL_BOM_ONDINCIDENCEMATRIX_HPP
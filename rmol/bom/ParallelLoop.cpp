@@ -0,0 +1,81 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <exception>
+// RMOL
+#include <rmol/bom/ParallelLoop.hpp>
+
+namespace RMOL {
+
+  namespace {
+    // //////////////////////////////////////////////////////////////////
+    void runBlock (const ParallelLoop::Task_T& iTask,
+                   const unsigned int iBegin, const unsigned int iEnd,
+                   std::exception_ptr& oException) {
+      try {
+        for (unsigned int idx = iBegin; idx < iEnd; ++idx) {
+          iTask (idx);
+        }
+      } catch (...) {
+        oException = std::current_exception();
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void ParallelLoop::run (const unsigned int iNbOfTasks, const Task_T& iTask,
+                          const unsigned int iNbOfThreads) {
+    // Serial execution
+    if (iNbOfThreads < 2 || iNbOfTasks < 2) {
+      for (unsigned int idx = 0; idx < iNbOfTasks; ++idx) {
+        iTask (idx);
+      }
+      return;
+    }
+
+    // Split the tasks into contiguous blocks of (almost) equal sizes.
+    const unsigned int lNbOfBlocks =
+      (iNbOfThreads < iNbOfTasks) ? iNbOfThreads : iNbOfTasks;
+    const unsigned int lBlockSize = iNbOfTasks / lNbOfBlocks;
+    const unsigned int lRemainder = iNbOfTasks % lNbOfBlocks;
+
+    std::vector<unsigned int> lBlockBoundaries (lNbOfBlocks + 1, 0);
+    for (unsigned int b = 0; b < lNbOfBlocks; ++b) {
+      const unsigned int lSize = lBlockSize + ((b < lRemainder) ? 1 : 0);
+      lBlockBoundaries[b+1] = lBlockBoundaries[b] + lSize;
+    }
+    assert (lBlockBoundaries[lNbOfBlocks] == iNbOfTasks);
+
+    // The first block is executed by the calling thread.
+    std::vector<std::exception_ptr> lExceptionList (lNbOfBlocks);
+    std::vector<std::thread> lThreadList;
+    lThreadList.reserve (lNbOfBlocks - 1);
+    for (unsigned int b = 1; b < lNbOfBlocks; ++b) {
+      lThreadList.push_back (std::thread (runBlock, std::cref (iTask),
+                                          lBlockBoundaries[b],
+                                          lBlockBoundaries[b+1],
+                                          std::ref (lExceptionList[b])));
+    }
+    runBlock (iTask, lBlockBoundaries[0], lBlockBoundaries[1],
+              lExceptionList[0]);
+
+    for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+         itThread != lThreadList.end(); ++itThread) {
+      itThread->join();
+    }
+
+    // Re-throw the first exception, if any.
+    for (std::vector<std::exception_ptr>::const_iterator itException =
+           lExceptionList.begin(); itException != lExceptionList.end();
+         ++itException) {
+      if (*itException) {
+        std::rethrow_exception (*itException);
+      }
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#ifndef __RMOL_BOM_PARALLELLOOP_HPP
+#define __RMOL_BOM_PARALLELLOOP_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/function.hpp>
+
+namespace RMOL {
+
+  /**
+   * Class running independent tasks on several threads.
+   *
+   * The tasks, indexed from 0 to N-1, are split into contiguous blocks,
+   * one block per thread. As each task is always executed exactly once,
+   * whatever the number of threads, the results do not depend on the
+   * number of threads, as long as the tasks do not write into the same
+   * objects.
+   */
+  class ParallelLoop {
+  public:
+    /** Task to be executed, given its index. */
+    typedef boost::function<void (const unsigned int)> Task_T;
+
+    /**
+     * Execute the given task for all the indices within [0, N).
+     *
+     * When the number of threads is lower than two, or when there is a
+     * single task, everything is executed serially on the calling thread.
+     * If some tasks throw an exception, the exception of the first
+     * block is re-thrown, once all the threads have been joined.
+     *
+     * @param const unsigned int Number of tasks (N).
+     * @param const Task_T& Task to be executed for each index.
+     * @param const unsigned int Maximal number of threads.
+     */
+    static void run (const unsigned int, const Task_T&, const unsigned int);
+  };
+}
+#endif // __RMOL_BOM_PARALLELLOOP_HPP
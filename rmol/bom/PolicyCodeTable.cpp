@@ -0,0 +1,129 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/FareFamily.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/Policy.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/PolicyCodeTable.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  PolicyCodeTable::PolicyCodeTable () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  PolicyCodeTable::~PolicyCodeTable () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const PolicyCodeTable::PolicyCode_T& PolicyCodeTable::
+  getPolicyCode (const stdair::Policy& iPolicy) const {
+    PolicyCodeMap_T::const_iterator itCode = _policyCodeMap.find (&iPolicy);
+    assert (itCode != _policyCodeMap.end());
+    return itCode->second;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyCodeTable::build (const stdair::SegmentCabin& iSegmentCabin) {
+    _classVectorList.clear();
+    _policyCodeMap.clear();
+
+    // Position of the booking classes, fare family by fare family.
+    ClassPositionMap_T lClassPositionMap;
+    const bool hasAListOfFF =
+      stdair::BomManager::hasList<stdair::FareFamily> (iSegmentCabin);
+    if (hasAListOfFF == true) {
+      const stdair::FareFamilyList_T& lFFList =
+        stdair::BomManager::getList<stdair::FareFamily> (iSegmentCabin);
+      _classVectorList.reserve (lFFList.size());
+      for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+           itFF != lFFList.end(); ++itFF) {
+        const stdair::FareFamily* lFF_ptr = *itFF;
+        assert (lFF_ptr != NULL);
+        ClassPosition lPosition;
+        lPosition._fareFamilyIndex = _classVectorList.size();
+        _classVectorList.push_back (ClassVector_T());
+        ClassVector_T& lClassVector = _classVectorList.back();
+        if (stdair::BomManager::hasList<stdair::BookingClass> (*lFF_ptr)) {
+          const stdair::BookingClassList_T& lBCList =
+            stdair::BomManager::getList<stdair::BookingClass> (*lFF_ptr);
+          lClassVector.assign (lBCList.begin(), lBCList.end());
+        }
+        for (lPosition._classIndex = 0;
+             lPosition._classIndex < lClassVector.size();
+             ++lPosition._classIndex) {
+          lClassPositionMap[lClassVector[lPosition._classIndex]] = lPosition;
+        }
+      }
+    }
+
+    // Encoding of the policies.
+    if (stdair::BomManager::hasList<stdair::Policy> (iSegmentCabin) == false) {
+      return;
+    }
+    const stdair::PolicyList_T& lPolicyList =
+      stdair::BomManager::getList<stdair::Policy> (iSegmentCabin);
+    for (stdair::PolicyList_T::const_iterator itPolicy = lPolicyList.begin();
+         itPolicy != lPolicyList.end(); ++itPolicy) {
+      const stdair::Policy* lPolicy_ptr = *itPolicy;
+      assert (lPolicy_ptr != NULL);
+      PolicyCode_T& lPolicyCode = _policyCodeMap[lPolicy_ptr];
+      if (stdair::BomManager::hasList<stdair::BookingClass> (*lPolicy_ptr)
+          == false) {
+        continue;
+      }
+      const stdair::BookingClassList_T& lBCList =
+        stdair::BomManager::getList<stdair::BookingClass> (*lPolicy_ptr);
+      lPolicyCode.reserve (lBCList.size());
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        ClassPositionMap_T::const_iterator itPosition =
+          lClassPositionMap.find (lBC_ptr);
+        if (itPosition == lClassPositionMap.end()) {
+          std::ostringstream ostr;
+          ostr << "The booking class " << lBC_ptr->describeKey()
+               << " of the policy " << lPolicy_ptr->describeKey()
+               << " is not in the fare families of the segment-cabin "
+               << iSegmentCabin.describeKey();
+          throw MissingBookingClassInFareFamilyException (ostr.str());
+        }
+        lPolicyCode.push_back (itPosition->second);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyCodeTable::toStream (std::ostream& ioOut) const {
+    for (PolicyCodeMap_T::const_iterator itCode = _policyCodeMap.begin();
+         itCode != _policyCodeMap.end(); ++itCode) {
+      assert (itCode->first != NULL);
+      ioOut << itCode->first->describeKey() << ":";
+      const PolicyCode_T& lPolicyCode = itCode->second;
+      for (PolicyCode_T::const_iterator itPosition = lPolicyCode.begin();
+           itPosition != lPolicyCode.end(); ++itPosition) {
+        ioOut << " " << itPosition->_fareFamilyIndex << "/"
+              << itPosition->_classIndex;
+      }
+      ioOut << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string PolicyCodeTable::describe() const {
+    std::ostringstream ostr;
+    ostr << "Policy code table (" << _classVectorList.size()
+         << " fare families, " << _policyCodeMap.size() << " policies).";
+    return ostr.str();
+  }
+}
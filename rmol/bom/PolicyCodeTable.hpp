@@ -0,0 +1,119 @@
+#ifndef __RMOL_BOM_POLICYCODETABLE_HPP
+#define __RMOL_BOM_POLICYCODETABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <map>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentCabin;
+  class Policy;
+  class BookingClass;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Integer encoding of the policies of a segment-cabin.
+   *
+   * Each booking class of the segment-cabin is given by its position, i.e.,
+   * the index of its fare family within the segment-cabin and its index
+   * within the fare family (the first class of the fare family having the
+   * index 0). A policy is encoded as the positions of its classes, in the
+   * order of the policy, so that the policies can be compared without
+   * comparing the keys of their classes.
+   *
+   * The table must be re-built whenever the policies or the fare families
+   * of the segment-cabin change.
+   */
+  struct PolicyCodeTable : public stdair::StructAbstract {
+
+  public:
+    /** Position of a booking class within the segment-cabin. */
+    struct ClassPosition {
+      /** Index of the fare family within the segment-cabin. */
+      unsigned short _fareFamilyIndex;
+
+      /** Index of the class within the fare family. */
+      unsigned short _classIndex;
+    };
+
+    /** Define the encoding of a policy. */
+    typedef std::vector<ClassPosition> PolicyCode_T;
+
+    /** Define the (ordered) list of the booking classes of a fare
+        family. */
+    typedef std::vector<stdair::BookingClass*> ClassVector_T;
+
+  public:
+    // ////// Getters //////
+    /** Get the number of fare families of the segment-cabin. */
+    unsigned short getNbOfFareFamilies() const {
+      return _classVectorList.size();
+    }
+
+    /** Get the booking classes of the given fare family. */
+    const ClassVector_T&
+    getClassVector (const unsigned short iFareFamilyIndex) const {
+      assert (iFareFamilyIndex < _classVectorList.size());
+      return _classVectorList[iFareFamilyIndex];
+    }
+
+    /** Get the encoding of the given policy, which must be a policy of the
+        segment-cabin. */
+    const PolicyCode_T& getPolicyCode (const stdair::Policy&) const;
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Build the table from the fare families and the policies of the given
+     * segment-cabin.
+     *
+     * @exception MissingBookingClassInFareFamilyException when a class of
+     *            a policy is not part of the fare families of the
+     *            segment-cabin.
+     */
+    void build (const stdair::SegmentCabin&);
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    PolicyCodeTable ();
+
+    /** Destructor. */
+    virtual ~PolicyCodeTable();
+
+  private:
+    /** Define the positions of the booking classes. */
+    typedef std::map<const stdair::BookingClass*,
+                     ClassPosition> ClassPositionMap_T;
+
+    /** Define the encodings of the policies. */
+    typedef std::map<const stdair::Policy*, PolicyCode_T> PolicyCodeMap_T;
+
+  private:
+    /** Booking classes, by fare family. */
+    std::vector<ClassVector_T> _classVectorList;
+
+    /** Encodings of the policies. */
+    PolicyCodeMap_T _policyCodeMap;
+  };
+}
+#endif // __RMOL_BOM_POLICYCODETABLE_HPP
@@ -0,0 +1,197 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+#include <cmath>
+// StdAir
+#include <stdair/bom/BookingClass.hpp>
+// RMOL
+#include <rmol/bom/PolicyGenerator.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  PolicyGenerator::PolicyGenerator ()
+    : _nbOfOpenFFs (0), _isStarted (false), _isExhausted (false) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  PolicyGenerator::~PolicyGenerator () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int PolicyGenerator::getNbOfPolicies() const {
+    // The empty policy, then the policies opening the first k fare
+    // families, for each k.
+    unsigned int oNbOfPolicies = 1;
+    unsigned int lNbOfPoliciesOpeningK = 1;
+    for (std::vector<ClassIndexList_T>::const_iterator itCandidate =
+           _candidateClassListList.begin();
+         itCandidate != _candidateClassListList.end(); ++itCandidate) {
+      lNbOfPoliciesOpeningK *= itCandidate->size();
+      oNbOfPolicies += lNbOfPoliciesOpeningK;
+    }
+    return oNbOfPolicies;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyGenerator::build (const PolicyCodeTable& iPolicyCodeTable,
+                               const bool iPruneDominatedClasses) {
+    const unsigned short lNbOfFFs = iPolicyCodeTable.getNbOfFareFamilies();
+    _candidateClassListList.assign (lNbOfFFs, ClassIndexList_T());
+    _meanListList.assign (lNbOfFFs, ClassValueList_T());
+    _varianceListList.assign (lNbOfFFs, ClassValueList_T());
+    _revenueListList.assign (lNbOfFFs, ClassValueList_T());
+
+    for (unsigned short lFFIdx = 0; lFFIdx < lNbOfFFs; ++lFFIdx) {
+      const PolicyCodeTable::ClassVector_T& lClassVector =
+        iPolicyCodeTable.getClassVector (lFFIdx);
+      const unsigned short lNbOfClasses = lClassVector.size();
+      ClassValueList_T& lMeanList = _meanListList[lFFIdx];
+      ClassValueList_T& lVarianceList = _varianceListList[lFFIdx];
+      ClassValueList_T& lRevenueList = _revenueListList[lFFIdx];
+      lMeanList.resize (lNbOfClasses);
+      lVarianceList.resize (lNbOfClasses);
+      lRevenueList.resize (lNbOfClasses);
+      for (unsigned short lClassIdx = 0; lClassIdx < lNbOfClasses;
+           ++lClassIdx) {
+        const stdair::BookingClass* lBC_ptr = lClassVector[lClassIdx];
+        assert (lBC_ptr != NULL);
+        const stdair::MeanValue_T& lMean = lBC_ptr->getCumuPriceDemMean();
+        const stdair::StdDevValue_T& lStdDev =
+          lBC_ptr->getCumuPriceDemStdDev();
+        lMeanList[lClassIdx] = lMean;
+        lVarianceList[lClassIdx] = lStdDev*lStdDev;
+        lRevenueList[lClassIdx] = lBC_ptr->getYield()*lMean;
+      }
+
+      // Keep the classes which are not dominated by another class of the
+      // fare family, i.e., by a class bringing at most as much demand and
+      // at least as much revenue (on a tie, the first class is kept).
+      ClassIndexList_T& lCandidateClassList = _candidateClassListList[lFFIdx];
+      for (unsigned short lClassIdx = 0; lClassIdx < lNbOfClasses;
+           ++lClassIdx) {
+        bool isDominated = false;
+        if (iPruneDominatedClasses == true) {
+          const double& lMean = lMeanList[lClassIdx];
+          const double& lRevenue = lRevenueList[lClassIdx];
+          for (unsigned short lOtherIdx = 0;
+               lOtherIdx < lNbOfClasses && isDominated == false; ++lOtherIdx) {
+            if (lOtherIdx == lClassIdx || lMeanList[lOtherIdx] > lMean
+                || lRevenueList[lOtherIdx] < lRevenue) {
+              continue;
+            }
+            const bool isTie = (lMeanList[lOtherIdx] == lMean
+                                && lRevenueList[lOtherIdx] == lRevenue);
+            isDominated = (isTie == false || lOtherIdx < lClassIdx);
+          }
+        }
+        if (isDominated == false) {
+          lCandidateClassList.push_back (lClassIdx);
+        }
+      }
+    }
+    reset();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyGenerator::reset () {
+    _nbOfOpenFFs = 0;
+    _rankList.clear();
+    _isStarted = false;
+    _isExhausted = false;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool PolicyGenerator::next (PolicyCodeTable::PolicyCode_T& oPolicyCode) {
+    if (_isExhausted == true) {
+      return false;
+    }
+
+    if (_isStarted == false) {
+      // The empty policy comes first.
+      _isStarted = true;
+
+    } else {
+      // Move on to the next class of the last open fare family, carrying
+      // over to the previous ones (odometer). When all the policies
+      // opening the current fare families have been generated, the next
+      // fare family is opened.
+      int lFFIdx = int (_nbOfOpenFFs) - 1;
+      for (; lFFIdx >= 0; --lFFIdx) {
+        ++_rankList[lFFIdx];
+        if (_rankList[lFFIdx] < _candidateClassListList[lFFIdx].size()) {
+          break;
+        }
+        _rankList[lFFIdx] = 0;
+      }
+      if (lFFIdx < 0) {
+        if (_nbOfOpenFFs == _candidateClassListList.size()
+            || _candidateClassListList[_nbOfOpenFFs].empty() == true) {
+          _isExhausted = true;
+          return false;
+        }
+        ++_nbOfOpenFFs;
+        _rankList.assign (_nbOfOpenFFs, 0);
+      }
+    }
+
+    oPolicyCode.resize (_nbOfOpenFFs);
+    for (unsigned short lFFIdx = 0; lFFIdx < _nbOfOpenFFs; ++lFFIdx) {
+      PolicyCodeTable::ClassPosition& lPosition = oPolicyCode[lFFIdx];
+      lPosition._fareFamilyIndex = lFFIdx;
+      lPosition._classIndex =
+        _candidateClassListList[lFFIdx][_rankList[lFFIdx]];
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyGenerator::
+  evaluate (const PolicyCodeTable::PolicyCode_T& iPolicyCode,
+            stdair::MeanValue_T& oDemand, stdair::StdDevValue_T& oStdDev,
+            double& oTotalRevenue) const {
+    double lVariance = 0.0;
+    oDemand = 0.0;
+    oTotalRevenue = 0.0;
+    for (PolicyCodeTable::PolicyCode_T::const_iterator itPosition =
+           iPolicyCode.begin(); itPosition != iPolicyCode.end();
+         ++itPosition) {
+      const unsigned short& lFFIdx = itPosition->_fareFamilyIndex;
+      const unsigned short& lClassIdx = itPosition->_classIndex;
+      assert (lFFIdx < _meanListList.size());
+      assert (lClassIdx < _meanListList[lFFIdx].size());
+      oDemand += _meanListList[lFFIdx][lClassIdx];
+      lVariance += _varianceListList[lFFIdx][lClassIdx];
+      oTotalRevenue += _revenueListList[lFFIdx][lClassIdx];
+    }
+    oStdDev = std::sqrt (lVariance);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyGenerator::toStream (std::ostream& ioOut) const {
+    for (unsigned short lFFIdx = 0; lFFIdx < _candidateClassListList.size();
+         ++lFFIdx) {
+      const ClassIndexList_T& lCandidateClassList =
+        _candidateClassListList[lFFIdx];
+      ioOut << "Fare family " << lFFIdx << ":";
+      for (ClassIndexList_T::const_iterator itClass =
+             lCandidateClassList.begin();
+           itClass != lCandidateClassList.end(); ++itClass) {
+        ioOut << " " << *itClass;
+      }
+      ioOut << " (out of " << _meanListList[lFFIdx].size() << " classes)"
+            << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string PolicyGenerator::describe() const {
+    std::ostringstream ostr;
+    ostr << "Policy generator (" << _candidateClassListList.size()
+         << " fare families, " << getNbOfPolicies() << " policies).";
+    return ostr.str();
+  }
+}
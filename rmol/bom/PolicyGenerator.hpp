@@ -0,0 +1,121 @@
+#ifndef __RMOL_BOM_POLICYGENERATOR_HPP
+#define __RMOL_BOM_POLICYGENERATOR_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// RMOL
+#include <rmol/bom/PolicyCodeTable.hpp>
+
+namespace RMOL {
+
+  /**
+   * @brief Lazy enumeration of the policies of a segment-cabin, out of
+   * its fare-family/class structure.
+   *
+   * A policy opens the first fare families of the segment-cabin (the
+   * last ones being closed), with one class open in each of them. The
+   * policies are generated one at a time, from the empty policy on, and
+   * their demand (mean and standard deviation) and total revenue are
+   * evaluated from the cumulated price-oriented demand forecasts of the
+   * classes, copied once into dense lists.
+   *
+   * As the demand and the revenue of a policy are the sums of those of
+   * its classes, a policy opening a dominated class of a fare family
+   * (another class of that fare family bringing at most as much demand
+   * and at least as much revenue) is dominated itself: it cannot be a
+   * point of the (increasing part of the) convex hull of the policies.
+   * When asked for, such classes are pruned, so that the dominated
+   * policies are never generated. The nested convex hull, which only
+   * moves from a policy to the ones nested under it, may however go
+   * through a dominated policy.
+   */
+  struct PolicyGenerator : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the number of policies to be generated. */
+    unsigned int getNbOfPolicies() const;
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Build the generator from the fare families of the given table, and
+     * from the demand forecasts of their classes. The enumeration starts
+     * again from the empty policy.
+     */
+    void build (const PolicyCodeTable&, const bool iPruneDominatedClasses);
+
+    /** Start the enumeration again from the empty policy. */
+    void reset();
+
+    /** Get the next policy, if any (false when all the policies have
+        been generated). */
+    bool next (PolicyCodeTable::PolicyCode_T&);
+
+    /** Evaluate the demand (mean and standard deviation) and the total
+        revenue of the given policy. */
+    void evaluate (const PolicyCodeTable::PolicyCode_T&,
+                   stdair::MeanValue_T& oDemand,
+                   stdair::StdDevValue_T& oStdDev,
+                   double& oTotalRevenue) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    PolicyGenerator ();
+
+    /** Destructor. */
+    virtual ~PolicyGenerator();
+
+  private:
+    /** Define a list of class indices. */
+    typedef std::vector<unsigned short> ClassIndexList_T;
+
+    /** Define a dense list of values, by class index. */
+    typedef std::vector<double> ClassValueList_T;
+
+  private:
+    /** Indices of the classes which may be opened, by fare family. */
+    std::vector<ClassIndexList_T> _candidateClassListList;
+
+    /** Demand means of the classes, by fare family. */
+    std::vector<ClassValueList_T> _meanListList;
+
+    /** Demand variances of the classes, by fare family. */
+    std::vector<ClassValueList_T> _varianceListList;
+
+    /** Revenues (yield times demand mean) of the classes, by fare
+        family. */
+    std::vector<ClassValueList_T> _revenueListList;
+
+    /** Number of fare families opened by the current policy. */
+    unsigned short _nbOfOpenFFs;
+
+    /** Rank, within the candidate classes, of the class opened in each of
+        the open fare families by the current policy. */
+    ClassIndexList_T _rankList;
+
+    /** Whether the empty policy has been generated. */
+    bool _isStarted;
+
+    /** Whether all the policies have been generated. */
+    bool _isExhausted;
+  };
+}
+#endif // __RMOL_BOM_POLICYGENERATOR_HPP
@@ -104,7 +104,6 @@ namespace RMOL {
       std::ostringstream ostr;
       ostr << "The booking class list of the fare family " 
            << iFareFamily.describeKey() << " is empty.";
-      STDAIR_LOG_DEBUG(ostr.str());
       throw EmptyBookingClassListException (ostr.str());
     }
     
@@ -123,7 +122,6 @@ namespace RMOL {
       std::ostringstream ostr;
       ostr << "The booking class " << iFirstPolicyClassCode 
            << "is not in the Fare Family " << iFareFamily.describeKey();
-      STDAIR_LOG_DEBUG(ostr.str());
       throw MissingBookingClassInFareFamilyException (ostr.str());
     }
     assert(ritBC != lFFBCList.rend());
@@ -280,4 +278,113 @@ namespace RMOL {
     isNested = true;
     return isNested;
   }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyHelper::
+  diffBetweenTwoPolicies (stdair::NestingNode& ioNode,
+                          const PolicyCodeTable::PolicyCode_T& iFirstCode,
+                          const PolicyCodeTable::PolicyCode_T& iSecondCode,
+                          const PolicyCodeTable& iPolicyCodeTable) {
+    // Browse the classes of the first policy
+    for (PolicyCodeTable::PolicyCode_T::const_iterator itFirst =
+           iFirstCode.begin(); itFirst != iFirstCode.end(); ++itFirst) {
+      const unsigned short& lFFIndex = itFirst->_fareFamilyIndex;
+      const int lFirstClassIndex = itFirst->_classIndex;
+
+      // Retrieve the (first) class of the second policy in the same fare
+      // family, if any.
+      int lSecondClassIndex = -1;
+      for (PolicyCodeTable::PolicyCode_T::const_iterator itSecond =
+             iSecondCode.begin(); itSecond != iSecondCode.end(); ++itSecond) {
+        if (itSecond->_fareFamilyIndex == lFFIndex
+            && (lSecondClassIndex < 0
+                || itSecond->_classIndex < lSecondClassIndex)) {
+          lSecondClassIndex = itSecond->_classIndex;
+        }
+      }
+      assert (lSecondClassIndex <= lFirstClassIndex);
+
+      // Add the classes from the class of the first policy up to (and
+      // excluding) the class of the second one.
+      const PolicyCodeTable::ClassVector_T& lClassVector =
+        iPolicyCodeTable.getClassVector (lFFIndex);
+      for (int lClassIndex = lFirstClassIndex;
+           lClassIndex > lSecondClassIndex; --lClassIndex) {
+        stdair::BookingClass* lBC_ptr = lClassVector[lClassIndex];
+        assert (lBC_ptr != NULL);
+        stdair::FacBomManager::addToList (ioNode, *lBC_ptr);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void PolicyHelper::
+  computeLastNode (stdair::NestingNode& ioNode,
+                   const PolicyCodeTable::PolicyCode_T& iPolicyCode,
+                   const PolicyCodeTable& iPolicyCodeTable) {
+    ioNode.setYield(stdair::DEFAULT_YIELD_VALUE);
+    const unsigned short lNbOfFFs = iPolicyCodeTable.getNbOfFareFamilies();
+    assert (lNbOfFFs >= iPolicyCode.size());
+
+    // All the classes of the closed fare families, i.e., the last ones.
+    const unsigned short lNbOfClosedFFs = lNbOfFFs - iPolicyCode.size();
+    for (unsigned short i = 0; i < lNbOfClosedFFs; ++i) {
+      const PolicyCodeTable::ClassVector_T& lClassVector =
+        iPolicyCodeTable.getClassVector (lNbOfFFs - 1 - i);
+      for (PolicyCodeTable::ClassVector_T::const_reverse_iterator itBC =
+             lClassVector.rbegin(); itBC != lClassVector.rend(); ++itBC) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        stdair::FacBomManager::addToList (ioNode, *lBC_ptr);
+      }
+    }
+
+    // The classes below the class of the policy, in the open fare families.
+    for (PolicyCodeTable::PolicyCode_T::const_reverse_iterator itPosition =
+           iPolicyCode.rbegin(); itPosition != iPolicyCode.rend();
+         ++itPosition) {
+      const PolicyCodeTable::ClassVector_T& lClassVector =
+        iPolicyCodeTable.getClassVector (itPosition->_fareFamilyIndex);
+      for (unsigned short lClassIndex = lClassVector.size();
+           lClassIndex > itPosition->_classIndex + 1; --lClassIndex) {
+        stdair::BookingClass* lBC_ptr = lClassVector[lClassIndex - 1];
+        assert (lBC_ptr != NULL);
+        stdair::FacBomManager::addToList (ioNode, *lBC_ptr);
+      }
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool PolicyHelper::
+  isNested (const PolicyCodeTable::PolicyCode_T& iFirstCode,
+            const PolicyCodeTable::PolicyCode_T& iSecondCode) {
+    // All policies are nested with the empty policy, and the number of
+    // classes in the first policy should be smaller or equal to the number
+    // of classes in the second one.
+    if (iFirstCode.empty() == true) {
+      return true;
+    }
+    if (iFirstCode.size() > iSecondCode.size()) {
+      return false;
+    }
+
+    // Browse the two policies and verify if the pairs of classes are in
+    // order, within their fare family.
+    PolicyCodeTable::PolicyCode_T::const_iterator itSecond =
+      iSecondCode.begin();
+    for (PolicyCodeTable::PolicyCode_T::const_iterator itFirst =
+           iFirstCode.begin(); itFirst != iFirstCode.end();
+         ++itFirst, ++itSecond) {
+      if (itFirst->_fareFamilyIndex != itSecond->_fareFamilyIndex) {
+        continue;
+      }
+      if (itFirst->_classIndex == itSecond->_classIndex) {
+        break;
+      }
+      if (itSecond->_classIndex < itFirst->_classIndex) {
+        return false;
+      }
+    }
+    return true;
+  }
 }
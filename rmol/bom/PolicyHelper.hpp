@@ -10,6 +10,7 @@
 #include <stdair/bom/FareFamilyTypes.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/PolicyCodeTable.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -47,6 +48,31 @@ namespace RMOL {
      * Check if the first policy is nested under the second policy.
      */
     static bool isNested (const stdair::Policy&, const stdair::Policy&);
+
+    /**
+     * Find the booking class list representing the difference
+     * between two encoded policies (first minus second).
+     */
+    static void
+    diffBetweenTwoPolicies (stdair::NestingNode&,
+                            const PolicyCodeTable::PolicyCode_T&,
+                            const PolicyCodeTable::PolicyCode_T&,
+                            const PolicyCodeTable&);
+
+    /**
+     * Compute the list of the booking class which is not in the node,
+     * from the encoded policy.
+     */
+    static void
+    computeLastNode (stdair::NestingNode&,
+                     const PolicyCodeTable::PolicyCode_T&,
+                     const PolicyCodeTable&);
+
+    /**
+     * Check if the first encoded policy is nested under the second one.
+     */
+    static bool isNested (const PolicyCodeTable::PolicyCode_T&,
+                          const PolicyCodeTable::PolicyCode_T&);
     
   
   private:
@@ -0,0 +1,192 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/FareFamily.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/Policy.hpp>
+// RMOL
+#include <rmol/bom/SegmentCabinForecast.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  SegmentCabinForecast::
+  SegmentCabinForecast (const stdair::Date_T& iEventDate,
+                        const SnapshotStamp_T& iSnapshotStamp,
+                        const stdair::ForecastingMethod& iForecastingMethod,
+                        const stdair::UnconstrainingMethod& iUnconstrainingMethod,
+                        const bool iIsForecasted)
+    : _eventDate (iEventDate), _snapshotStamp (iSnapshotStamp),
+      _forecastingMethod (iForecastingMethod.getMethod()),
+      _unconstrainingMethod (iUnconstrainingMethod.getMethod()),
+      _isForecasted (iIsForecasted) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  SegmentCabinForecast::~SegmentCabinForecast () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool SegmentCabinForecast::
+  isFor (const stdair::Date_T& iEventDate,
+         const SnapshotStamp_T& iSnapshotStamp,
+         const stdair::ForecastingMethod& iForecastingMethod,
+         const stdair::UnconstrainingMethod& iUnconstrainingMethod) const {
+    return (_eventDate == iEventDate && _snapshotStamp == iSnapshotStamp
+            && _forecastingMethod == iForecastingMethod.getMethod()
+            && _unconstrainingMethod == iUnconstrainingMethod.getMethod());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SegmentCabinForecast::save (const stdair::SegmentCabin& iSegmentCabin) {
+    _fareFamilyForecastList.clear();
+    _bookingClassForecastList.clear();
+    _policyForecastList.clear();
+    _policyYieldDemandList.clear();
+
+    // Browse the fare families and their booking classes.
+    const stdair::FareFamilyList_T& lFFList =
+      stdair::BomManager::getList<stdair::FareFamily> (iSegmentCabin);
+    for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+         itFF != lFFList.end(); ++itFF) {
+      const stdair::FareFamily* lFF_ptr = *itFF;
+      assert (lFF_ptr != NULL);
+      _fareFamilyForecastList.
+        push_back (stdair::MeanStdDevPair_T (lFF_ptr->getMean(),
+                                             lFF_ptr->getStdDev()));
+
+      const stdair::BookingClassList_T& lBCList =
+        stdair::BomManager::getList<stdair::BookingClass> (*lFF_ptr);
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        _bookingClassForecastList.
+          push_back (stdair::MeanStdDevPair_T (lBC_ptr->getMean(),
+                                               lBC_ptr->getStdDev()));
+        _bookingClassForecastList.
+          push_back (stdair::MeanStdDevPair_T (lBC_ptr->getPriceDemMean(),
+                                               lBC_ptr->getPriceDemStdDev()));
+        _bookingClassForecastList.
+          push_back (stdair::MeanStdDevPair_T (lBC_ptr->getProductDemMean(),
+                                               lBC_ptr->getProductDemStdDev()));
+        _bookingClassForecastList.
+          push_back (stdair::MeanStdDevPair_T (lBC_ptr->getCumuPriceDemMean(),
+                                               lBC_ptr->getCumuPriceDemStdDev()));
+      }
+    }
+
+    // Browse the policies (only the QFF methods forecast them).
+    if (stdair::BomManager::hasList<stdair::Policy> (iSegmentCabin) == false) {
+      return;
+    }
+    const stdair::PolicyList_T& lPolicyList =
+      stdair::BomManager::getList<stdair::Policy> (iSegmentCabin);
+    for (stdair::PolicyList_T::const_iterator itPolicy = lPolicyList.begin();
+         itPolicy != lPolicyList.end(); ++itPolicy) {
+      const stdair::Policy* lPolicy_ptr = *itPolicy;
+      assert (lPolicy_ptr != NULL);
+      _policyForecastList.
+        push_back (stdair::MeanStdDevPair_T (lPolicy_ptr->getDemand(),
+                                             lPolicy_ptr->getStdDev()));
+      _policyYieldDemandList.push_back (lPolicy_ptr->getYieldDemandMap());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SegmentCabinForecast::
+  restore (stdair::SegmentCabin& ioSegmentCabin) const {
+    // Browse the fare families and their booking classes.
+    std::vector<stdair::MeanStdDevPair_T>::const_iterator itFFForecast =
+      _fareFamilyForecastList.begin();
+    std::vector<stdair::MeanStdDevPair_T>::const_iterator itBCForecast =
+      _bookingClassForecastList.begin();
+    const stdair::FareFamilyList_T& lFFList =
+      stdair::BomManager::getList<stdair::FareFamily> (ioSegmentCabin);
+    for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+         itFF != lFFList.end(); ++itFF, ++itFFForecast) {
+      stdair::FareFamily* lFF_ptr = *itFF;
+      assert (lFF_ptr != NULL);
+      assert (itFFForecast != _fareFamilyForecastList.end());
+      lFF_ptr->setMean (itFFForecast->first);
+      lFF_ptr->setStdDev (itFFForecast->second);
+
+      const stdair::BookingClassList_T& lBCList =
+        stdair::BomManager::getList<stdair::BookingClass> (*lFF_ptr);
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        assert (itBCForecast != _bookingClassForecastList.end());
+        lBC_ptr->setMean (itBCForecast->first);
+        lBC_ptr->setStdDev (itBCForecast->second);
+        ++itBCForecast;
+        lBC_ptr->setPriceDemMean (itBCForecast->first);
+        lBC_ptr->setPriceDemStdDev (itBCForecast->second);
+        ++itBCForecast;
+        lBC_ptr->setProductDemMean (itBCForecast->first);
+        lBC_ptr->setProductDemStdDev (itBCForecast->second);
+        ++itBCForecast;
+        lBC_ptr->setCumuPriceDemMean (itBCForecast->first);
+        lBC_ptr->setCumuPriceDemStdDev (itBCForecast->second);
+        ++itBCForecast;
+      }
+    }
+    assert (itFFForecast == _fareFamilyForecastList.end());
+    assert (itBCForecast == _bookingClassForecastList.end());
+
+    // Browse the policies.
+    if (_policyForecastList.empty() == true) {
+      return;
+    }
+    const stdair::PolicyList_T& lPolicyList =
+      stdair::BomManager::getList<stdair::Policy> (ioSegmentCabin);
+    assert (lPolicyList.size() == _policyForecastList.size());
+    unsigned int lPolicyIdx = 0;
+    for (stdair::PolicyList_T::const_iterator itPolicy = lPolicyList.begin();
+         itPolicy != lPolicyList.end(); ++itPolicy, ++lPolicyIdx) {
+      stdair::Policy* lPolicy_ptr = *itPolicy;
+      assert (lPolicy_ptr != NULL);
+      lPolicy_ptr->resetDemandForecast();
+
+      const stdair::YieldDemandMap_T& lYieldDemandMap =
+        _policyYieldDemandList.at (lPolicyIdx);
+      for (stdair::YieldDemandMap_T::const_iterator itYD =
+             lYieldDemandMap.begin(); itYD != lYieldDemandMap.end(); ++itYD) {
+        lPolicy_ptr->addYieldDemand (itYD->first, itYD->second);
+      }
+
+      const stdair::MeanStdDevPair_T& lPolicyForecast =
+        _policyForecastList.at (lPolicyIdx);
+      lPolicy_ptr->setDemand (lPolicyForecast.first);
+      lPolicy_ptr->setStdDev (lPolicyForecast.second);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void SegmentCabinForecast::toStream (std::ostream& ioOut) const {
+    ioOut << describe() << std::endl;
+    for (std::vector<stdair::MeanStdDevPair_T>::const_iterator itFFForecast =
+           _fareFamilyForecastList.begin();
+         itFFForecast != _fareFamilyForecastList.end(); ++itFFForecast) {
+      ioOut << "Fare family: " << itFFForecast->first << ", "
+            << itFFForecast->second << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string SegmentCabinForecast::describe() const {
+    std::ostringstream ostr;
+    ostr << "Forecast of " << _eventDate << ", on the snapshots "
+         << _snapshotStamp << " (forecasted: " << _isForecasted
+         << ", " << _fareFamilyForecastList.size() << " fare families, "
+         << _policyForecastList.size() << " policies).";
+    return ostr.str();
+  }
+}
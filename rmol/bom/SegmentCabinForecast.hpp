@@ -0,0 +1,126 @@
+#ifndef __RMOL_BOM_SEGMENTCABINFORECAST_HPP
+#define __RMOL_BOM_SEGMENTCABINFORECAST_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/stdair_rm_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/basic/ForecastingMethod.hpp>
+#include <stdair/basic/UnconstrainingMethod.hpp>
+#include <stdair/bom/Policy.hpp>
+// RMOL
+#include <rmol/RMOL_Types.hpp>
+
+// Forward declarations
+namespace stdair {
+  class SegmentCabin;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Copy of the demand forecast of a segment-cabin, i.e., of the
+   * forecast stored within its fare families, booking classes and
+   * policies, along with the parameters of that forecast (event date,
+   * snapshot stamp, forecasting and unconstraining methods).
+   */
+  struct SegmentCabinForecast : public stdair::StructAbstract {
+
+  public:
+    // ////// Getters //////
+    /** Get the date of the RM event for which the forecast was made. */
+    const stdair::Date_T& getEventDate() const {
+      return _eventDate;
+    }
+
+    /** State whether the segment-cabin could be forecasted. */
+    bool isForecasted() const {
+      return _isForecasted;
+    }
+
+    /** Get the stamp of the snapshots from which the forecast was made. */
+    const SnapshotStamp_T& getSnapshotStamp() const {
+      return _snapshotStamp;
+    }
+
+    /** State whether the forecast was made for the given parameters. */
+    bool isFor (const stdair::Date_T&, const SnapshotStamp_T&,
+                const stdair::ForecastingMethod&,
+                const stdair::UnconstrainingMethod&) const;
+
+  public:
+    // ////// Business Methods //////
+    /** Copy the demand forecast stored within the segment-cabin. */
+    void save (const stdair::SegmentCabin&);
+
+    /** Set back the demand forecast into the segment-cabin, which must
+        have the same fare families, classes and policies as when it was
+        saved. */
+    void restore (stdair::SegmentCabin&) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    SegmentCabinForecast (const stdair::Date_T&, const SnapshotStamp_T&,
+                          const stdair::ForecastingMethod&,
+                          const stdair::UnconstrainingMethod&,
+                          const bool iIsForecasted);
+
+    /** Destructor. */
+    virtual ~SegmentCabinForecast();
+
+  private:
+    /** Default constructor (not implemented). */
+    SegmentCabinForecast ();
+
+  private:
+    /** Date of the RM event. */
+    const stdair::Date_T _eventDate;
+
+    /** Stamp of the snapshots. */
+    const SnapshotStamp_T _snapshotStamp;
+
+    /** Forecasting method. */
+    const stdair::ForecastingMethod::EN_ForecastingMethod _forecastingMethod;
+
+    /** Unconstraining method. */
+    const stdair::UnconstrainingMethod::EN_UnconstrainingMethod
+    _unconstrainingMethod;
+
+    /** Whether the segment-cabin could be forecasted. */
+    const bool _isForecasted;
+
+    /** Demand forecast (mean and standard deviation) of the fare
+        families, in the order of the BOM tree. */
+    std::vector<stdair::MeanStdDevPair_T> _fareFamilyForecastList;
+
+    /** Demand forecasts of the booking classes (total, price-oriented,
+        product-oriented and cumulative price-oriented), in the order of
+        the BOM tree. */
+    std::vector<stdair::MeanStdDevPair_T> _bookingClassForecastList;
+
+    /** Demand forecast of the policies, in the order of the BOM tree. */
+    std::vector<stdair::MeanStdDevPair_T> _policyForecastList;
+
+    /** Demand forecast of the policies, per yield. */
+    std::vector<stdair::YieldDemandMap_T> _policyYieldDemandList;
+  };
+}
+#endif // __RMOL_BOM_SEGMENTCABINFORECAST_HPP
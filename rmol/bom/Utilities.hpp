@@ -15,6 +15,8 @@ namespace stdair {
 }
 
 namespace RMOL {
+  /** Forward declaration. */
+  struct ClassCurveMatrix;
 
   /** Class holding helper methods. */
   class Utilities {
@@ -24,16 +26,6 @@ namespace RMOL {
                                                stdair::MeanValue_T&,
                                                stdair::StdDevValue_T&);
     
-    /**
-     * Build the list of remaining DCP's for the segment-date.
-     */
-    static stdair::DCPList_T buildRemainingDCPList (const stdair::DTD_T&);
-
-    /**
-     * Build the list of past DCP's for the segment-date.
-     */
-    static stdair::DCPList_T buildPastDCPList (const stdair::DTD_T&);
-
     /**
      * Retrieve the number of departed similar segments.
      */
@@ -42,36 +34,34 @@ namespace RMOL {
                                     const stdair::Date_T&);
     
     /**
-     * Precompute the sell-up factors for each class and each DCP.
-     */
-    static stdair::BookingClassSellUpCurveMap_T 
-    computeSellUpFactorCurves (const stdair::FRAT5Curve_T&,
-                               const stdair::BookingClassList_T&);
-
-    /**
-     * Precompute the dispatching factors for each class and each DCP.
+     * Dispatch the demand forecast of the given DCP to all the classes of
+     * the curve matrix: the given factors of each class are applied to
+     * the mean and to the variance, which are added to the given dense
+     * per-class mean and variance lists.
      */
-    static stdair::BookingClassDispatchingCurveMap_T 
-    computeDispatchingFactorCurves (const stdair::FRAT5Curve_T&,
-                                    const stdair::BookingClassList_T&);
+    static void dispatchDemandForecast (const ClassCurveMatrix&,
+                                        const stdair::MeanValue_T&,
+                                        const stdair::StdDevValue_T&,
+                                        const DCPIndex_T&,
+                                        ClassFactorVector_T& ioMeanList,
+                                        ClassFactorVector_T& ioVarianceList);
 
     /**
-     * Dispatching the demand forecast to all classes.
+     * Add the dispatched demand forecast (mean and variance lists) to the
+     * price-oriented demand forecast of the classes of the curve matrix.
      */
-    static void 
-    dispatchDemandForecast (const stdair::BookingClassDispatchingCurveMap_T&,
-                            const stdair::MeanValue_T&,
-                            const stdair::StdDevValue_T&,
-                            const stdair::DTD_T&);
+    static void addPriceDemandForecast (const ClassCurveMatrix&,
+                                        const ClassFactorVector_T&,
+                                        const ClassFactorVector_T&);
 
     /**
-     * Dispatching the demand forecast to all classes for FA.
+     * Add the dispatched demand forecast (mean and variance lists) to the
+     * cumulative price-oriented demand forecast (used by FA and MRT) of
+     * the classes of the curve matrix.
      */
-    static void 
-    dispatchDemandForecastForFA (const stdair::BookingClassSellUpCurveMap_T&,
-                                 const stdair::MeanValue_T&,
-                                 const stdair::StdDevValue_T&,
-                                 const stdair::DTD_T&);
+    static void addCumuPriceDemandForecast (const ClassCurveMatrix&,
+                                            const ClassFactorVector_T&,
+                                            const ClassFactorVector_T&);
   };
     
 }
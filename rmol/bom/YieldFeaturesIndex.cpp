@@ -0,0 +1,194 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <cassert>
+// StdAir
+#include <stdair/basic/BasConst_Request.hpp>
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/OnDDate.hpp>
+#include <stdair/bom/AirportPair.hpp>
+#include <stdair/bom/PosChannel.hpp>
+#include <stdair/bom/DatePeriod.hpp>
+#include <stdair/bom/TimePeriod.hpp>
+#include <stdair/bom/YieldFeatures.hpp>
+#include <stdair/service/Logger.hpp>
+// RMOL
+#include <rmol/bom/YieldFeaturesIndex.hpp>
+
+namespace RMOL {
+
+  // ////////////////////////////////////////////////////////////////////
+  YieldFeaturesIndex::YieldFeaturesIndex () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  YieldFeaturesIndex::~YieldFeaturesIndex () {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::YieldFeatures* YieldFeaturesIndex::
+  getYieldFeatures (const stdair::OnDDate& iOnDDate,
+                    const stdair::CabinCode_T& iCabinCode,
+                    stdair::BomRoot& iBomRoot) {
+    const stdair::AirportCode_T& lOrigin = iOnDDate.getOrigin();
+    const stdair::AirportCode_T& lDestination = iOnDDate.getDestination();
+    const stdair::Date_T& lDepartureDate = iOnDDate.getDate();
+
+    // Memoised result, if any.
+    const MemoKey_T lMemoKey (lOrigin, lDestination, lDepartureDate,
+                              iCabinCode);
+    MemoMap_T::const_iterator itMemo = _memoMap.find (lMemoKey);
+    if (itMemo != _memoMap.end()) {
+      return itMemo->second;
+    }
+
+    // Browse the date periods valid for the departure date.
+    stdair::YieldFeatures* oYieldFeatures_ptr = NULL;
+    DatePeriodEntryList_T& lDatePeriodEntryList =
+      getDatePeriodEntryList (AirportPairKey_T (lOrigin, lDestination),
+                              iBomRoot);
+    for (DatePeriodEntryList_T::iterator itEntry =
+           lDatePeriodEntryList.begin();
+         itEntry != lDatePeriodEntryList.end(); ++itEntry) {
+      DatePeriodEntry& lDatePeriodEntry = *itEntry;
+      assert (lDatePeriodEntry._datePeriod != NULL);
+      const bool isDepartureDateValid =
+        lDatePeriodEntry._datePeriod->isDepartureDateValid (lDepartureDate);
+      if (isDepartureDateValid == false) {
+        continue;
+      }
+      oYieldFeatures_ptr = getYieldFeatures (lDatePeriodEntry, iCabinCode);
+      if (oYieldFeatures_ptr != NULL) {
+        break;
+      }
+    }
+
+    _memoMap.insert (MemoMap_T::value_type (lMemoKey, oYieldFeatures_ptr));
+    return oYieldFeatures_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  YieldFeaturesIndex::DatePeriodEntryList_T& YieldFeaturesIndex::
+  getDatePeriodEntryList (const AirportPairKey_T& iAirportPairKey,
+                          stdair::BomRoot& iBomRoot) {
+    AirportPairMap_T::iterator itAirportPair =
+      _airportPairMap.find (iAirportPairKey);
+    if (itAirportPair != _airportPairMap.end()) {
+      return itAirportPair->second;
+    }
+    DatePeriodEntryList_T& oDatePeriodEntryList =
+      _airportPairMap[iAirportPairKey];
+
+    // Build the airport pair key out of O&D and get the airport pair object
+    const stdair::AirportPairKey lAirportPairKey (iAirportPairKey.first,
+                                                  iAirportPairKey.second);
+    stdair::AirportPair* lAirportPair_ptr = stdair::BomManager::
+      getObjectPtr<stdair::AirportPair> (iBomRoot,
+                                         lAirportPairKey.toString());
+    if (lAirportPair_ptr == NULL) {
+      STDAIR_LOG_ERROR ("Cannot find yield corresponding to the airport "
+                        << "pair: " << lAirportPairKey.toString());
+      assert (false);
+      return oDatePeriodEntryList;
+    }
+
+    // Record the date periods, in the order of the BOM tree.
+    const stdair::DatePeriodList_T& lDatePeriodList =
+      stdair::BomManager::getList<stdair::DatePeriod> (*lAirportPair_ptr);
+    oDatePeriodEntryList.reserve (lDatePeriodList.size());
+    for (stdair::DatePeriodList_T::const_iterator itDatePeriod =
+           lDatePeriodList.begin();
+         itDatePeriod != lDatePeriodList.end(); ++itDatePeriod) {
+      const stdair::DatePeriod* lDatePeriod_ptr = *itDatePeriod;
+      assert (lDatePeriod_ptr != NULL);
+      DatePeriodEntry lDatePeriodEntry;
+      lDatePeriodEntry._datePeriod = lDatePeriod_ptr;
+      lDatePeriodEntry._isResolved = false;
+      oDatePeriodEntryList.push_back (lDatePeriodEntry);
+    }
+    return oDatePeriodEntryList;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::YieldFeatures* YieldFeaturesIndex::
+  getYieldFeatures (DatePeriodEntry& ioDatePeriodEntry,
+                    const stdair::CabinCode_T& iCabinCode) {
+    CabinYieldFeaturesMap_T::const_iterator itYieldFeatures =
+      ioDatePeriodEntry._yieldFeaturesMap.find (iCabinCode);
+    if (itYieldFeatures != ioDatePeriodEntry._yieldFeaturesMap.end()) {
+      return itYieldFeatures->second;
+    }
+
+    // Retrieve the time periods of the PoS-Channel, once.
+    if (ioDatePeriodEntry._isResolved == false) {
+      ioDatePeriodEntry._isResolved = true;
+      // TODO: Use POS and Channel from demand instead of default
+      const stdair::PosChannelKey lPosChannelKey (stdair::DEFAULT_POS,
+                                                  stdair::DEFAULT_CHANNEL);
+      assert (ioDatePeriodEntry._datePeriod != NULL);
+      stdair::PosChannel* lPosChannel_ptr = stdair::BomManager::
+        getObjectPtr<stdair::PosChannel> (*ioDatePeriodEntry._datePeriod,
+                                          lPosChannelKey.toString());
+      if (lPosChannel_ptr == NULL) {
+        STDAIR_LOG_ERROR ("Cannot find yield corresponding to the PoS-"
+                          << "Channel: " << lPosChannelKey.toString());
+        assert (false);
+      } else {
+        const stdair::TimePeriodList_T& lTimePeriodList = stdair::
+          BomManager::getList<stdair::TimePeriod> (*lPosChannel_ptr);
+        ioDatePeriodEntry._timePeriodList.assign (lTimePeriodList.begin(),
+                                                  lTimePeriodList.end());
+      }
+    }
+
+    // Retrieve the yield features from the first time period holding them.
+    // TODO: Use trip type from demand instead of default value.
+    stdair::YieldFeatures* oYieldFeatures_ptr = NULL;
+    const stdair::YieldFeaturesKey lYieldFeaturesKey (stdair::TRIP_TYPE_ONE_WAY,
+                                                      iCabinCode);
+    const std::string lYieldFeaturesKeyStr = lYieldFeaturesKey.toString();
+    for (std::vector<const stdair::TimePeriod*>::const_iterator itTimePeriod =
+           ioDatePeriodEntry._timePeriodList.begin();
+         itTimePeriod != ioDatePeriodEntry._timePeriodList.end();
+         ++itTimePeriod) {
+      const stdair::TimePeriod* lTimePeriod_ptr = *itTimePeriod;
+      assert (lTimePeriod_ptr != NULL);
+      oYieldFeatures_ptr = stdair::BomManager::
+        getObjectPtr<stdair::YieldFeatures> (*lTimePeriod_ptr,
+                                             lYieldFeaturesKeyStr);
+      if (oYieldFeatures_ptr != NULL) {
+        break;
+      }
+    }
+    ioDatePeriodEntry._yieldFeaturesMap[iCabinCode] = oYieldFeatures_ptr;
+    return oYieldFeatures_ptr;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void YieldFeaturesIndex::clear () {
+    _airportPairMap.clear();
+    _memoMap.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void YieldFeaturesIndex::toStream (std::ostream& ioOut) const {
+    for (AirportPairMap_T::const_iterator itAirportPair =
+           _airportPairMap.begin();
+         itAirportPair != _airportPairMap.end(); ++itAirportPair) {
+      const AirportPairKey_T& lAirportPairKey = itAirportPair->first;
+      ioOut << lAirportPairKey.first << "-" << lAirportPairKey.second << ": "
+            << itAirportPair->second.size() << " date periods" << std::endl;
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string YieldFeaturesIndex::describe() const {
+    std::ostringstream ostr;
+    ostr << "Yield features index (" << _airportPairMap.size()
+         << " airport pairs, " << _memoMap.size() << " memoised lookups).";
+    return ostr.str();
+  }
+}
@@ -0,0 +1,138 @@
+#ifndef __RMOL_BOM_YIELDFEATURESINDEX_HPP
+#define __RMOL_BOM_YIELDFEATURESINDEX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <vector>
+#include <map>
+#include <tuple>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/stdair_inventory_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace stdair {
+  class BomRoot;
+  class OnDDate;
+  class DatePeriod;
+  class TimePeriod;
+  class YieldFeatures;
+}
+
+namespace RMOL {
+
+  /**
+   * @brief Index of the yield features of the O&D-dates.
+   *
+   * The yield features of an O&D-date and cabin are found under the
+   * airport pair of the O&D, within the first date period which is valid
+   * for its departure date and holds them, under the default PoS-channel,
+   * within the first time period which holds them (for the one-way trip
+   * type).
+   *
+   * The index resolves each step once: the date periods of an airport
+   * pair are retrieved once, along with their time periods (PoS-channel
+   * already resolved), and the yield features of a date period and cabin
+   * are looked up (by key) once. The result of each (origin, destination,
+   * departure date, cabin) is memoised, so that the O&D-dates sharing
+   * them (e.g., in the inventories of partners), and the later RM events,
+   * get them directly.
+   *
+   * The index must be cleared whenever the yield structure (or the
+   * O&D-dates) of the BOM tree is re-built.
+   */
+  struct YieldFeaturesIndex : public stdair::StructAbstract {
+
+  public:
+    // ////// Business Methods //////
+    /**
+     * Get the yield features of the given O&D-date and cabin (NULL if
+     * there are none), resolving them from the given BOM tree when
+     * needed.
+     */
+    stdair::YieldFeatures* getYieldFeatures (const stdair::OnDDate&,
+                                             const stdair::CabinCode_T&,
+                                             stdair::BomRoot&);
+
+    /** Clear the index. */
+    void clear();
+
+  public:
+    // ///////// Display Methods //////////
+    /** Dump a Business Object into an output stream.
+        @param ostream& the output stream
+        @return ostream& the output stream. */
+    void toStream (std::ostream& ioOut) const;
+
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+  public:
+    /** Constructor. */
+    YieldFeaturesIndex ();
+
+    /** Destructor. */
+    virtual ~YieldFeaturesIndex();
+
+  private:
+    /** Define the map of the yield features, by cabin. */
+    typedef std::map<stdair::CabinCode_T,
+                     stdair::YieldFeatures*> CabinYieldFeaturesMap_T;
+
+    /** Date period of an airport pair, with its resolved lookups. */
+    struct DatePeriodEntry {
+      /** Date period. */
+      const stdair::DatePeriod* _datePeriod;
+
+      /** Whether the time periods have been retrieved. */
+      bool _isResolved;
+
+      /** Time periods of the default PoS-channel. */
+      std::vector<const stdair::TimePeriod*> _timePeriodList;
+
+      /** Yield features (NULL when none) of the cabins looked up so far. */
+      CabinYieldFeaturesMap_T _yieldFeaturesMap;
+    };
+
+    /** Define the list of the date periods of an airport pair. */
+    typedef std::vector<DatePeriodEntry> DatePeriodEntryList_T;
+
+    /** Define the key of an airport pair (origin and destination). */
+    typedef std::pair<stdair::AirportCode_T,
+                      stdair::AirportCode_T> AirportPairKey_T;
+
+    /** Define the map of the date periods, by airport pair. */
+    typedef std::map<AirportPairKey_T,
+                     DatePeriodEntryList_T> AirportPairMap_T;
+
+    /** Define the key of a memoised result, i.e., the airport pair, the
+        departure date and the cabin. */
+    typedef std::tuple<stdair::AirportCode_T, stdair::AirportCode_T,
+                       stdair::Date_T, stdair::CabinCode_T> MemoKey_T;
+
+    /** Define the map of the memoised results. */
+    typedef std::map<MemoKey_T, stdair::YieldFeatures*> MemoMap_T;
+
+    /** Retrieve the date periods of the given airport pair. */
+    DatePeriodEntryList_T& getDatePeriodEntryList (const AirportPairKey_T&,
+                                                   stdair::BomRoot&);
+
+    /** Retrieve the yield features of the given cabin within the given
+        date period (NULL if there are none). */
+    stdair::YieldFeatures* getYieldFeatures (DatePeriodEntry&,
+                                             const stdair::CabinCode_T&);
+
+  private:
+    /** Date periods, by airport pair. */
+    AirportPairMap_T _airportPairMap;
+
+    /** Memoised results. */
+    MemoMap_T _memoMap;
+  };
+}
+#endif // __RMOL_BOM_YIELDFEATURESINDEX_HPP
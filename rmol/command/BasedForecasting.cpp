@@ -19,8 +19,12 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/Utilities.hpp>
+#include <rmol/bom/DCPCalendar.hpp>
 #include <rmol/bom/SegmentSnapshotTableHelper.hpp>
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
+#include <rmol/bom/ClassBookingMatrix.hpp>
 #include <rmol/bom/HistoricalBooking.hpp>
 #include <rmol/command/BasedForecasting.hpp>
 #include <rmol/command/Detruncator.hpp>
@@ -32,7 +36,9 @@ namespace RMOL {
             const stdair::Date_T& iCurrentDate,
             const stdair::DTD_T& iCurrentDTD,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
-            const stdair::NbOfSegments_T& iNbOfDepartedSegments) {
+            const stdair::NbOfSegments_T& iNbOfDepartedSegments,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            const unsigned int iNbOfThreads) {
 
     // Retrieve the snapshot table.
     const stdair::SegmentSnapshotTable& lSegmentSnapshotTable =
@@ -42,132 +48,99 @@ namespace RMOL {
     const stdair::BookingClassList_T& lBCList =
       stdair::BomManager::getList<stdair::BookingClass>(ioSegmentCabin);      
 
-    // Browse all remaining DCP's and do unconstraining and forecasting for
-    // all demand.
-    const stdair::DCPList_T lWholeDCPList = stdair::DEFAULT_DCP_LIST;
-    stdair::DCPList_T::const_iterator itDCP = lWholeDCPList.begin();
-    stdair::DCPList_T::const_iterator itNextDCP = itDCP; ++itNextDCP;
-    for (; itNextDCP != lWholeDCPList.end(); ++itDCP, ++itNextDCP) {
-      const stdair::DCP_T& lCurrentDCP = *itDCP;
-      const stdair::DCP_T& lNextDCP = *itNextDCP;
+    // Browse all remaining DCP's and gather the historical bookings of
+    // each class and each DCP interval, so that they can be unconstrained
+    // all at once.
+    HistoricalBookingMatrix lHBMatrix;
+    stdair::BookingClassList_T lForecastedBCList;
+    const DCPIndex_T lFirstIntervalIdx =
+      DCPCalendar::getIntervalIndex (iCurrentDTD);
+    for (DCPIndex_T lIntervalIdx = lFirstIntervalIdx;
+         lIntervalIdx < DCPCalendar::getNbOfIntervals(); ++lIntervalIdx) {
+      const stdair::DCP_T& lCurrentDCP =
+        DCPCalendar::getIntervalBegin (lIntervalIdx);
+      const stdair::DCP_T& lNextDCP =
+        DCPCalendar::getIntervalEnd (lIntervalIdx);
 
-      // The end of the interval is after the current DTD.
-      if (lNextDCP < iCurrentDTD) {
-        // Get the number of similar segments which has already passed the
-        // (lNextDCP+1)
-        const stdair::NbOfSegments_T& lNbOfUsableSegments =
-          SegmentSnapshotTableHelper::
-          getNbOfSegmentAlreadyPassedThisDTD (lSegmentSnapshotTable,
-                                              lNextDCP+1,
-                                              iCurrentDate);
-        stdair::NbOfSegments_T lSegmentBegin = 0;
-        const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
-        if (iNbOfDepartedSegments > 52) {
-          lSegmentBegin = iNbOfDepartedSegments - 52;
-        }
-
-        // Browse the list of booking classes and forecast the product-oriented
-        // demand for each class.
-        for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
-             itBC != lBCList.end(); ++itBC) {
-          stdair::BookingClass* lBC_ptr = *itBC;
-          assert (lBC_ptr != NULL);
-          
-          // Retrieve the historical product-oriented bookings for the
-          // given class.
-          HistoricalBookingHolder lHBHolder;
-          prepareHistoricalBooking (ioSegmentCabin, *lBC_ptr,
-                                    lSegmentSnapshotTable,
-                                    lHBHolder,
-                                    lCurrentDCP, lNextDCP,
-                                    lSegmentBegin, lSegmentEnd);
-          
-          // Unconstrain the historical bookings.
-          Detruncator::unconstrain (lHBHolder, iUnconstrainingMethod);
-
-          // Retrieve the historical unconstrained demand and perform the
-          // forecasting.
-          stdair::UncDemVector_T lUncDemVector;
-          const short lNbOfHistoricalFlights = lHBHolder.getNbOfFlights();
-          for (short i = 0; i < lNbOfHistoricalFlights; ++i) {
-            const stdair::NbOfBookings_T& lUncDemand =
-              lHBHolder.getUnconstrainedDemand (i);
-            lUncDemVector.push_back (lUncDemand);
-          }
-          stdair::MeanValue_T lMean = 0.0;
-          stdair::StdDevValue_T lStdDev = 0.0;
-          Utilities::computeDistributionParameters (lUncDemVector,
-                                                    lMean, lStdDev);
-
-          // Add the demand forecast to the booking class.
-          const stdair::MeanValue_T& lCurrentMean = lBC_ptr->getProductDemMean();
-          const stdair::StdDevValue_T& lCurrentStdDev = 
-            lBC_ptr->getProductDemStdDev();
+      // Get the number of similar segments which has already passed the
+      // (lNextDCP+1)
+      const stdair::NbOfSegments_T& lNbOfUsableSegments =
+        SegmentSnapshotTableHelper::
+        getNbOfSegmentAlreadyPassedThisDTD (lSegmentSnapshotTable,
+                                            lNextDCP+1,
+                                            iCurrentDate);
+      stdair::NbOfSegments_T lSegmentBegin = 0;
+      const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
+      const stdair::NbOfSegments_T lWindowSize =
+        ioHBWindowHolder.getWindowSize();
+      if (iNbOfDepartedSegments > lWindowSize) {
+        lSegmentBegin = iNbOfDepartedSegments - lWindowSize;
+      }
 
-          const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
-          const stdair::StdDevValue_T lNewStdDev = 
-            std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
+      // The booking and availability snapshots of the DCP interval are
+      // read only once for all the classes, when the first window needs
+      // new similar segments.
+      ClassBookingMatrix lClassBookingMatrix;
 
-          lBC_ptr->setProductDemMean (lNewMean);
-          lBC_ptr->setProductDemStdDev (lNewStdDev);
-        }
+      // Browse the list of booking classes and gather the historical
+      // bookings of each class.
+      unsigned int lClassRow = 0;
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC, ++lClassRow) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        
+        // Retrieve the historical bookings for the given class.
+        HistoricalBookingHolder lHBHolder;
+        ioHBWindowHolder.
+          prepareHistoricalBooking (ioSegmentCabin,
+                                    "Based " + lBC_ptr->describeKey(), "",
+                                    lCurrentDCP, lSegmentBegin, lSegmentEnd,
+                                    [&] (HistoricalBookingHolder& ioHBHolder,
+                                         const stdair::NbOfSegments_T& iBegin,
+                                         const stdair::NbOfSegments_T& iEnd) {
+                                      lClassBookingMatrix.
+                                        gather (lSegmentSnapshotTable,
+                                                lBCList, lCurrentDCP,
+                                                lNextDCP, iBegin, iEnd,
+                                                true);
+                                      lClassBookingMatrix.
+                                        fillHistoricalBookingHolder
+                                        (lClassRow, ioHBHolder);
+                                    },
+                                    lHBHolder);
+        lHBMatrix.addSeries (lHBHolder);
+        lForecastedBCList.push_back (lBC_ptr);
       }
     }
-    return true;
-  }
-  
-  // ////////////////////////////////////////////////////////////////////
-  void BasedForecasting::prepareHistoricalBooking
-    (const stdair::SegmentCabin& iSegmentCabin,
-     const stdair::BookingClass& iBookingClass,
-     const stdair::SegmentSnapshotTable& iSegmentSnapshotTable,
-     HistoricalBookingHolder& ioHBHolder,
-     const stdair::DCP_T& iDCPBegin, const stdair::DCP_T& iDCPEnd,
-     const stdair::NbOfSegments_T& iSegmentBegin,
-     const stdair::NbOfSegments_T& iSegmentEnd) {
 
-    // Retrieve the booking class index within the snapshot table
-    const stdair::ClassIndex_T& lClassIdx = 
-      iSegmentSnapshotTable.getClassIndex (iBookingClass.describeKey());
+    // Unconstrain the historical bookings of all the classes and all the
+    // DCP intervals.
+    Detruncator::unconstrain (lHBMatrix, iUnconstrainingMethod,
+                              iNbOfThreads);
 
-    // Retrieve the gross daily booking and availability snapshots.
-    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lPriceBookingView =
-      iSegmentSnapshotTable.getConstSegmentCabinDTDRangePriceOrientedGrossBookingSnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
-    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lProductBookingView =
-      iSegmentSnapshotTable.getConstSegmentCabinDTDRangeProductOrientedGrossBookingSnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
-    const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lAvlView =
-      iSegmentSnapshotTable.getConstSegmentCabinDTDRangeAvailabilitySnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
-    
-    // Browse the list of segments and build the historical booking holder.
-    const stdair::ClassIndexMap_T& lVTIdxMap =
-      iSegmentSnapshotTable.getClassIndexMap();
-    const stdair::NbOfClasses_T lNbOfClasses = lVTIdxMap.size();
+    // Add the demand forecast of each DCP interval to the booking classes.
+    SeriesIndex_T lSeries = 0;
+    for (stdair::BookingClassList_T::const_iterator itBC =
+           lForecastedBCList.begin(); itBC != lForecastedBCList.end();
+         ++itBC, ++lSeries) {
+      stdair::BookingClass* lBC_ptr = *itBC;
+      assert (lBC_ptr != NULL);
+      const stdair::MeanValue_T& lMean = lHBMatrix.getDemandMean (lSeries);
+      const stdair::StdDevValue_T& lStdDev =
+        lHBMatrix.getStandardDeviation (lSeries);
 
-    for (short i = 0; i <= iSegmentEnd-iSegmentBegin; ++i) {
-      stdair::Flag_T lCensorshipFlag = false;
-      const short lNbOfDTDs = iDCPBegin - iDCPEnd + 1;
-      const stdair::UnsignedIndex_T lIdx = i*lNbOfClasses + lClassIdx;
+      const stdair::MeanValue_T& lCurrentMean = lBC_ptr->getProductDemMean();
+      const stdair::StdDevValue_T& lCurrentStdDev = 
+        lBC_ptr->getProductDemStdDev();
 
-      // Parse the DTDs during the period and compute the censorship flag
-      for (short j = 0; j < lNbOfDTDs; ++j) {
-        // Check if the data has been censored during this day.
-        // STDAIR_LOG_DEBUG ("i: " << i << ", NbOfClasses: " << lNbOfClasses
-        //                   << ", ClassIdx: " << iClassIdx << ", j: " << j);
-        if (lAvlView[lIdx][j] < 1.0) {
-          lCensorshipFlag = true;
-          break;
-        }
-      }
+      const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
+      const stdair::StdDevValue_T lNewStdDev = 
+        std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
 
-      // Retrieve the historical bookings
-      stdair::NbOfBookings_T lNbOfHistoricalBkgs = 0.0;
-      for (short j = 0; j < lNbOfDTDs; ++j) {
-        lNbOfHistoricalBkgs += 
-          lPriceBookingView[lIdx][j] + lProductBookingView[lIdx][j];
-      }              
-      HistoricalBooking lHistoricalBkg (lNbOfHistoricalBkgs, lCensorshipFlag);
-      ioHBHolder.addHistoricalBooking (lHistoricalBkg);
+      lBC_ptr->setProductDemMean (lNewMean);
+      lBC_ptr->setProductDemStdDev (lNewStdDev);
     }
+    return true;
   }
-  
 }
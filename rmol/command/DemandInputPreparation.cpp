@@ -32,21 +32,30 @@ namespace RMOL {
       stdair::BookingClass* lBC_ptr = *itBC;
       assert (lBC_ptr != NULL);
 
-      const stdair::MeanValue_T& lPriceDemMean = lBC_ptr->getPriceDemMean();
-      const stdair::StdDevValue_T& lPriceStdDev = lBC_ptr->getPriceDemStdDev();
-      const stdair::MeanValue_T& lProductDemMean = lBC_ptr->getProductDemMean();
-      const stdair::StdDevValue_T& lProductStdDev = 
-        lBC_ptr->getProductDemStdDev();
-
-      const stdair::MeanValue_T lNewMeanValue = lPriceDemMean + lProductDemMean;
-      const stdair::StdDevValue_T lNewStdDev =
-        std::sqrt(lPriceStdDev*lPriceStdDev + lProductStdDev*lProductStdDev);
-
-      lBC_ptr->setMean (lNewMeanValue);
-      lBC_ptr->setStdDev (lNewStdDev);
+      prepareDemandInput (*lBC_ptr);
     }
 
     return isSucceeded;
   }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandInputPreparation::
+  prepareDemandInput (stdair::BookingClass& ioBookingClass) {
+    const stdair::MeanValue_T& lPriceDemMean =
+      ioBookingClass.getPriceDemMean();
+    const stdair::StdDevValue_T& lPriceStdDev =
+      ioBookingClass.getPriceDemStdDev();
+    const stdair::MeanValue_T& lProductDemMean =
+      ioBookingClass.getProductDemMean();
+    const stdair::StdDevValue_T& lProductStdDev = 
+      ioBookingClass.getProductDemStdDev();
+
+    const stdair::MeanValue_T lNewMeanValue = lPriceDemMean + lProductDemMean;
+    const stdair::StdDevValue_T lNewStdDev =
+      std::sqrt(lPriceStdDev*lPriceStdDev + lProductStdDev*lProductStdDev);
+
+    ioBookingClass.setMean (lNewMeanValue);
+    ioBookingClass.setStdDev (lNewStdDev);
+  }
   
 }
@@ -14,6 +14,7 @@
 // Forward declarations
 namespace stdair {
   class SegmentCabin;
+  class BookingClass;
 }
 
 namespace RMOL {
@@ -24,6 +25,13 @@ namespace RMOL {
      * Prepare the demand input for the optimser.
      */
     static bool prepareDemandInput (const stdair::SegmentCabin&);  
+
+    /**
+     * Prepare the demand input of the given booking class, i.e., set its
+     * demand to the sum of its price-oriented and product-oriented demand
+     * forecasts.
+     */
+    static void prepareDemandInput (stdair::BookingClass&);
   };
 }
 #endif // __RMOL_COMMAND_DEMANDINPUTPREPARATION_HPP
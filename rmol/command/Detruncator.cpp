@@ -8,6 +8,7 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
 #include <rmol/bom/EMDetruncator.hpp>
 #include <rmol/command/Detruncator.hpp>
 
@@ -29,5 +30,23 @@ namespace RMOL {
     }
     }
   }
+
+  // ////////////////////////////////////////////////////////////////////
+  void Detruncator::
+  unconstrain (HistoricalBookingMatrix& ioHBMatrix,
+               const stdair::UnconstrainingMethod& iMethod,
+               const unsigned int iNbOfThreads) {
+    const stdair::UnconstrainingMethod::EN_UnconstrainingMethod& lUnconstrainingMethod =
+      iMethod.getMethod();
+    switch (lUnconstrainingMethod) {
+    case stdair::UnconstrainingMethod::EM: {
+      EMDetruncator::unconstrain (ioHBMatrix, iNbOfThreads);
+      break;
+    }
+    default: {
+      assert (false);
+      break;
+    }
+    }
+  }
 }
-  
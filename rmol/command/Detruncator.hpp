@@ -9,11 +9,13 @@
 #include <stdair/basic/UnconstrainingMethod.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 
 namespace RMOL {
   // Forward declarations.
   struct HistoricalBookingHolder;
+  struct HistoricalBookingMatrix;
   
   /** Class wrapping the principal unconstraining algorithms and 
       some accessory algorithms. */
@@ -24,6 +26,20 @@ namespace RMOL {
      */
     static void unconstrain (HistoricalBookingHolder&,
                  const stdair::UnconstrainingMethod&);
+
+    /**
+     * Unconstrain, in one go, several series of booking figures (e.g., for
+     * all the DCP intervals and/or all the classes of a segment-cabin),
+     * and compute the distribution parameters of each series.
+     *
+     * @param HistoricalBookingMatrix& Series of historical bookings.
+     * @param const stdair::UnconstrainingMethod& Unconstraining method.
+     * @param const unsigned int Number of threads.
+     */
+    static void unconstrain (HistoricalBookingMatrix&,
+                             const stdair::UnconstrainingMethod&,
+                             const unsigned int iNbOfThreads =
+                             DEFAULT_NUMBER_OF_THREADS);
     
   };
 }
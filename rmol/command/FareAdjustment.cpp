@@ -5,23 +5,126 @@
 #include <cassert>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Inventory.hpp>
 #include <stdair/bom/BomManager.hpp>
 #include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/FareFamily.hpp>
 #include <stdair/bom/BookingClass.hpp>
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/Utilities.hpp>
+#include <rmol/command/DemandInputPreparation.hpp>
 #include <rmol/command/FareAdjustment.hpp>
 
 namespace RMOL {
 
+  namespace {
+
+    /** Define a dense list of values, by class. */
+    typedef std::vector<double> ClassValueList_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Turn, in place, the yields of a list of classes sorted by
+     * decreasing yield into their fare-adjusted yields, given the
+     * cumulated price-oriented demand means (Q) of the classes.
+     *
+     * The fare-adjusted yield of a class c is its marginal revenue,
+     * (y_c.Q_c - y_{c-1}.Q_{c-1}) / (Q_c - Q_{c-1}), i.e., its yield
+     * minus the sell-up cost, Q_{c-1}.(y_{c-1} - y_c), shared over the
+     * incremental cumulated price-oriented demand, Q_c - Q_{c-1}.
+     */
+    void computeAdjustedYields (const unsigned int iNbOfClasses,
+                                const double* iCumuPriceDemMeanList,
+                                double* ioYieldList) {
+      // From the lowest class up, so that the yield of the class just
+      // above is still the unadjusted one.
+      for (unsigned int c = iNbOfClasses; c-- > 1; ) {
+        const double lSellUpCost = iCumuPriceDemMeanList[c-1]
+          * (ioYieldList[c-1] - ioYieldList[c]);
+        if (lSellUpCost <= 0.0) {
+          continue;
+        }
+        const double lIncrementalDemMean =
+          iCumuPriceDemMeanList[c] - iCumuPriceDemMeanList[c-1];
+        double lAdjustedYield = 0.0;
+        if (lIncrementalDemMean > 0.0) {
+          lAdjustedYield = ioYieldList[c] - lSellUpCost / lIncrementalDemMean;
+        }
+        ioYieldList[c] = std::max (lAdjustedYield, 0.0);
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Prepare the demand input, and adjust the yields, of the given list
+     * of classes, sorted by decreasing yield. The lists are work areas,
+     * re-used from one list of classes to the next.
+     */
+    void adjustYieldOfClassList (const stdair::BookingClassList_T& iBCList,
+                                 ClassValueList_T& ioCumuPriceDemMeanList,
+                                 ClassValueList_T& ioYieldList) {
+      ioCumuPriceDemMeanList.clear();
+      ioYieldList.clear();
+      for (stdair::BookingClassList_T::const_iterator itBC = iBCList.begin();
+           itBC != iBCList.end(); ++itBC) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        DemandInputPreparation::prepareDemandInput (*lBC_ptr);
+        ioCumuPriceDemMeanList.push_back (lBC_ptr->getCumuPriceDemMean());
+        ioYieldList.push_back (lBC_ptr->getYield());
+      }
+
+      computeAdjustedYields (ioYieldList.size(), ioCumuPriceDemMeanList.data(),
+                             ioYieldList.data());
+
+      ClassValueList_T::const_iterator itYield = ioYieldList.begin();
+      for (stdair::BookingClassList_T::const_iterator itBC = iBCList.begin();
+           itBC != iBCList.end(); ++itBC, ++itYield) {
+        stdair::BookingClass* lBC_ptr = *itBC;
+        lBC_ptr->setAdjustedYield (*itYield);
+      }
+    }
+  }
+
   // ////////////////////////////////////////////////////////////////////
   bool FareAdjustment::
   adjustYield (const stdair::SegmentCabin& iSegmentCabin) {
-    return false;
+    bool isSucceeded = true;
+
+    ClassValueList_T lCumuPriceDemMeanList;
+    ClassValueList_T lYieldList;
+
+    // The price-oriented demand sells up within a fare family.
+    const bool hasAListOfFF =
+      stdair::BomManager::hasList<stdair::FareFamily> (iSegmentCabin);
+    if (hasAListOfFF == false) {
+      const stdair::BookingClassList_T& lBCList =
+        stdair::BomManager::getList<stdair::BookingClass> (iSegmentCabin);
+      adjustYieldOfClassList (lBCList, lCumuPriceDemMeanList, lYieldList);
+      return isSucceeded;
+    }
+
+    const stdair::FareFamilyList_T& lFFList =
+      stdair::BomManager::getList<stdair::FareFamily> (iSegmentCabin);
+    for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+         itFF != lFFList.end(); ++itFF) {
+      const stdair::FareFamily* lFF_ptr = *itFF;
+      assert (lFF_ptr != NULL);
+      if (stdair::BomManager::hasList<stdair::BookingClass> (*lFF_ptr)
+          == false) {
+        continue;
+      }
+      const stdair::BookingClassList_T& lBCList =
+        stdair::BomManager::getList<stdair::BookingClass> (*lFF_ptr);
+      adjustYieldOfClassList (lBCList, lCumuPriceDemMeanList, lYieldList);
+    }
+
+    return isSucceeded;
   }
   
 }
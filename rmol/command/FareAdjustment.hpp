@@ -21,7 +21,19 @@ namespace RMOL {
   class FareAdjustment {    
   public:
     /**
-     * Prepare the demand input for the optimser.
+     * Prepare the demand input for the optimser, and adjust the yields of
+     * the classes for the sell-up of the price-oriented demand.
+     *
+     * Within each fare family (or within the cabin, when it has no fare
+     * family), the classes are sorted by decreasing yield, and the
+     * cumulated price-oriented demand of a class is the one sold when it
+     * is the lowest open class. Opening a class makes the cumulated
+     * price-oriented demand of the class just above it pay the yield of
+     * the class instead; that loss, shared over the cumulated
+     * price-oriented demand the class adds to the one of the class just
+     * above it, is taken off its yield (i.e., the adjusted yield is the
+     * marginal revenue of the class). The adjusted yield is never
+     * negative.
      */
     static bool adjustYield (const stdair::SegmentCabin&);  
   };
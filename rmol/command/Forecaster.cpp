@@ -5,10 +5,12 @@
 #include <cassert>
 #include <sstream>
 #include <cmath>
+#include <vector>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Inventory.hpp>
 #include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/Inventory.hpp>
 #include <stdair/bom/FlightDate.hpp>
 #include <stdair/bom/SegmentDate.hpp>
 #include <stdair/bom/SegmentCabin.hpp>
@@ -21,6 +23,8 @@
 #include <rmol/bom/SegmentSnapshotTableHelper.hpp>
 #include <rmol/bom/HistoricalBookingHolder.hpp>
 #include <rmol/bom/HistoricalBooking.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
+#include <rmol/bom/ForecastCache.hpp>
 #include <rmol/command/BasedForecasting.hpp>
 #include <rmol/command/Forecaster.hpp>
 #include <rmol/command/QForecasting.hpp>
@@ -35,12 +39,21 @@ namespace RMOL {
   forecast (stdair::FlightDate& ioFlightDate,
             const stdair::DateTime_T& iEventTime,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
-            const stdair::ForecastingMethod& iForecastingMethod) {
+            const stdair::ForecastingMethod& iForecastingMethod,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            ForecastCache& ioForecastCache,
+            const unsigned int iNbOfThreads) {
     // Build the offset dates.
     const stdair::Date_T& lEventDate = iEventTime.date();
     
-    // 
-    bool isSucceeded = true;
+    // Gather the segment-cabins of all the segment-dates, in the order
+    // of the BOM tree, along with their keys within the whole BOM tree.
+    const stdair::Inventory& lInventory =
+      stdair::BomManager::getParent<stdair::Inventory> (ioFlightDate);
+    const std::string lFDKeyStr =
+      lInventory.describeKey() + ", " + ioFlightDate.describeKey();
+    std::vector<stdair::SegmentCabin*> lSegmentCabinList;
+    std::vector<std::string> lSegmentCabinKeyList;
     const stdair::SegmentDateList_T& lSDList =
       stdair::BomManager::getList<stdair::SegmentDate> (ioFlightDate);
     for (stdair::SegmentDateList_T::const_iterator itSD = lSDList.begin();
@@ -62,16 +75,65 @@ namespace RMOL {
            itSC != lSCList.end(); ++itSC) {
         stdair::SegmentCabin* lSC_ptr = *itSC;
         assert (lSC_ptr != NULL);
+        lSegmentCabinList.push_back (lSC_ptr);
+        const std::string lSCKeyStr = lFDKeyStr + ", "
+          + lSD_ptr->describeKey() + ", " + lSC_ptr->describeKey();
+        lSegmentCabinKeyList.push_back (lSCKeyStr);
+      }
+    }
 
-        //
-        // STDAIR_LOG_NOTIFICATION (ioFlightDate.getDepartureDate()
-        //                          << ";" << lSegmentDTD);
-        bool isForecasted = forecast (*lSC_ptr, lEventDate,
-                                      iUnconstrainingMethod,
-                                      iForecastingMethod);
-        if (isForecasted == false) {
-          isSucceeded = false;
-        }
+    // When there are less segment-cabins than threads, the remaining
+    // threads are shared among the segment-cabins (for instance, for
+    // the fare families with the new QFF method).
+    const unsigned int lNbOfSegmentCabins = lSegmentCabinList.size();
+    unsigned int lNbOfThreadsPerCabin = 1;
+    if (lNbOfSegmentCabins > 0 && iNbOfThreads > lNbOfSegmentCabins) {
+      lNbOfThreadsPerCabin = iNbOfThreads / lNbOfSegmentCabins;
+    }
+
+    // The forecasts are cached for the current state of the snapshots.
+    const SnapshotStamp_T lSnapshotStamp = ioForecastCache.getSnapshotStamp();
+
+    // Forecast the segment-cabins. Each task writes only its own status.
+    std::vector<char> lForecastStatusList (lNbOfSegmentCabins, 0);
+    ParallelLoop::run (lNbOfSegmentCabins,
+                       [&] (const unsigned int iSCIdx) {
+                         stdair::SegmentCabin* lSC_ptr =
+                           lSegmentCabinList[iSCIdx];
+                         assert (lSC_ptr != NULL);
+                         const std::string& lSCKeyStr =
+                           lSegmentCabinKeyList[iSCIdx];
+
+                         bool isForecasted = false;
+                         const bool isCached =
+                           ioForecastCache.restore (*lSC_ptr, lSCKeyStr,
+                                                    lEventDate,
+                                                    iForecastingMethod,
+                                                    iUnconstrainingMethod,
+                                                    isForecasted);
+                         if (isCached == false) {
+                           isForecasted =
+                             forecast (*lSC_ptr, lEventDate,
+                                       iUnconstrainingMethod,
+                                       iForecastingMethod, ioHBWindowHolder,
+                                       lNbOfThreadsPerCabin);
+                           ioForecastCache.save (*lSC_ptr, lSCKeyStr,
+                                                 lEventDate, lSnapshotStamp,
+                                                 iForecastingMethod,
+                                                 iUnconstrainingMethod,
+                                                 isForecasted);
+                         }
+                         lForecastStatusList[iSCIdx] = isForecasted;
+                       },
+                       iNbOfThreads);
+
+    //
+    bool isSucceeded = true;
+    for (std::vector<char>::const_iterator itStatus =
+           lForecastStatusList.begin();
+         itStatus != lForecastStatusList.end(); ++itStatus) {
+      if (*itStatus == false) {
+        isSucceeded = false;
       }
     }
 
@@ -83,7 +145,9 @@ namespace RMOL {
   forecast (stdair::SegmentCabin& ioSegmentCabin,
             const stdair::Date_T& iEventDate,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
-            const stdair::ForecastingMethod& iForecastingMethod) {
+            const stdair::ForecastingMethod& iForecastingMethod,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            const unsigned int iNbOfThreads) {
     // Retrieve the number of departed similar segments.
     stdair::NbOfSegments_T lNbOfDepartedSegments =
       Utilities::getNbOfDepartedSimilarSegments (ioSegmentCabin, iEventDate);
@@ -114,13 +178,15 @@ namespace RMOL {
         return QForecasting::forecast (ioSegmentCabin, iEventDate,
                                        lDaysBeforeDeparture,
                                        iUnconstrainingMethod,
-                                       lNbOfDepartedSegments);
+                                       lNbOfDepartedSegments,
+                                       ioHBWindowHolder, iNbOfThreads);
       }
       case stdair::ForecastingMethod::HYBRID_FORECASTING: {
         return HybridForecasting::forecast (ioSegmentCabin, iEventDate,
                                             lDaysBeforeDeparture,
                                             iUnconstrainingMethod,
-                                            lNbOfDepartedSegments);
+                                            lNbOfDepartedSegments,
+                                            ioHBWindowHolder, iNbOfThreads);
       }
       case stdair::ForecastingMethod::NEW_QFF: {
         if (ioSegmentCabin.getFareFamilyStatus()==false) {
@@ -128,11 +194,13 @@ namespace RMOL {
           return HybridForecasting::forecast (ioSegmentCabin, iEventDate,
                                               lDaysBeforeDeparture,
                                               iUnconstrainingMethod,
-                                              lNbOfDepartedSegments);
+                                              lNbOfDepartedSegments,
+                                              ioHBWindowHolder, iNbOfThreads);
         } else {
           return NewQFF::forecast (ioSegmentCabin, iEventDate,
                                    lDaysBeforeDeparture, iUnconstrainingMethod,
-                                   lNbOfDepartedSegments);
+                                   lNbOfDepartedSegments, ioHBWindowHolder,
+                                   iNbOfThreads);
         }
       }
       case stdair::ForecastingMethod::OLD_QFF: {
@@ -141,18 +209,21 @@ namespace RMOL {
           return HybridForecasting::forecast (ioSegmentCabin, iEventDate,
                                               lDaysBeforeDeparture,
                                               iUnconstrainingMethod,
-                                              lNbOfDepartedSegments);
+                                              lNbOfDepartedSegments,
+                                              ioHBWindowHolder, iNbOfThreads);
         } else {
           return OldQFF::forecast (ioSegmentCabin, iEventDate,
                                    lDaysBeforeDeparture, iUnconstrainingMethod,
-                                   lNbOfDepartedSegments);
+                                   lNbOfDepartedSegments, ioHBWindowHolder,
+                                   iNbOfThreads);
         }
       }
       case stdair::ForecastingMethod::BASED_FORECASTING: {
         return BasedForecasting::forecast (ioSegmentCabin, iEventDate,
                                             lDaysBeforeDeparture,
                                             iUnconstrainingMethod,
-                                            lNbOfDepartedSegments);
+                                            lNbOfDepartedSegments,
+                                            ioHBWindowHolder, iNbOfThreads);
       }
       default:{
         assert (false);
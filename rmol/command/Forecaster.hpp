@@ -10,6 +10,7 @@
 #include <stdair/stdair_inventory_types.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -18,15 +19,41 @@ namespace stdair {
 }
 
 namespace RMOL {
+  // Forward declarations
+  struct HistoricalBookingWindowHolder;
+  struct ForecastCache;
+
   /** Class wrapping the forecasting algorithms. */
   class Forecaster {    
   public:
     /**
      * Forecast demand for a flight-date.
+     *
+     * When a segment-cabin has already been forecasted for the same
+     * day and with the same methods, the cached forecast is set back
+     * into the segment-cabin instead of being re-computed.
+     *
+     * The segment-cabins are forecasted independently from each other,
+     * as each forecast writes only into the fare families, booking
+     * classes and policies of its own segment-cabin. When more than one
+     * thread is given, they are thus forecasted in parallel; the results
+     * do not depend on the number of threads.
+     *
+     * @param stdair::FlightDate& Flight-date to be forecasted.
+     * @param const stdair::DateTime_T& Date-time of the RM event.
+     * @param const stdair::UnconstrainingMethod& Unconstraining method.
+     * @param const stdair::ForecastingMethod& Forecasting method.
+     * @param HistoricalBookingWindowHolder& Sliding windows of the
+     *        historical bookings, kept from one forecast to the next.
+     * @param ForecastCache& Cache of the segment-cabin forecasts.
+     * @param const unsigned int Number of threads.
     */
     static bool forecast (stdair::FlightDate&, const stdair::DateTime_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::ForecastingMethod&);
+                          const stdair::ForecastingMethod&,
+                          HistoricalBookingWindowHolder&, ForecastCache&,
+                          const unsigned int iNbOfThreads =
+                          DEFAULT_NUMBER_OF_THREADS);
 
   private:
     /**
@@ -34,7 +61,9 @@ namespace RMOL {
      */
     static bool forecast (stdair::SegmentCabin&, const stdair::Date_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::ForecastingMethod&);
+                          const stdair::ForecastingMethod&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int);
 
     /**
      * Set the demand forecasts to zero.
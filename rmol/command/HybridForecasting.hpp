@@ -8,6 +8,7 @@
 #include <stdair/stdair_inventory_types.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -17,6 +18,9 @@ namespace stdair {
 }
 
 namespace RMOL {
+  // Forward declarations
+  struct HistoricalBookingWindowHolder;
+
   /** Class wrapping the forecasting algorithms. */
   class HybridForecasting {    
   public:
@@ -28,25 +32,18 @@ namespace RMOL {
      * @param const stdair::DTD_T& Current DTD 
      * @param const stdair::UnconstrainingMethod& Method used for the unconstraining
      * @param const stdair::NbOfSegments_T& Number of usable historical segments
+     * @param HistoricalBookingWindowHolder& Sliding windows of the
+     *        historical bookings, kept from one forecast to the next
+     * @param const unsigned int Number of threads on which the historical
+     *        bookings are unconstrained
     */
     static bool forecast (stdair::SegmentCabin&, const stdair::Date_T&,
                           const stdair::DTD_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::NbOfSegments_T&);
-    
-    /**
-     * Prepare the historical product-oriented booking figures for a given cabin
-     *
-     * @param const stdair::DCP_T& DCP range start
-     * @param const stdair::DCP_T& DCP range end
-     * @param const stdair::NbOfSegments_T& Segment range start index
-     * @param const stdair::NbOfSegments_T& Segment range end index 
-     */
-    static void prepareProductOrientedHistoricalBooking
-    (const stdair::SegmentCabin&, const stdair::BookingClass&,
-     const stdair::SegmentSnapshotTable&, HistoricalBookingHolder&,
-     const stdair::DCP_T&, const stdair::DCP_T&,
-     const stdair::NbOfSegments_T&, const stdair::NbOfSegments_T&);
+                          const stdair::NbOfSegments_T&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int iNbOfThreads =
+                          DEFAULT_NUMBER_OF_THREADS);
   };
 }
 #endif // __RMOL_COMMAND_HYBRIDFORECASTING_HPP
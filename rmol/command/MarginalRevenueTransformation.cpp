@@ -5,6 +5,8 @@
 #include <cassert>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Inventory.hpp>
@@ -17,193 +19,338 @@
 #include <stdair/factory/FacBomManager.hpp>
 #include <stdair/service/Logger.hpp>
 // RMOL
+#include <rmol/bom/PolicyCodeTable.hpp>
 #include <rmol/bom/PolicyHelper.hpp>
+#include <rmol/bom/PolicyGenerator.hpp>
 #include <rmol/bom/Utilities.hpp>
 #include <rmol/command/MarginalRevenueTransformation.hpp>
 
 namespace RMOL {
 
+  namespace {
+
+    /** Define a list of policy points, by address. */
+    typedef std::vector<const MarginalRevenueTransformation::PolicyPoint*>
+    PolicyPointVector_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /** Order the policy points by increasing demand. */
+    struct PolicyPointDemandLess {
+      typedef MarginalRevenueTransformation::PolicyPoint PolicyPoint_T;
+      bool operator() (const PolicyPoint_T* iFirst_ptr,
+                       const PolicyPoint_T* iSecond_ptr) const {
+        return iFirst_ptr->_demand < iSecond_ptr->_demand;
+      }
+    };
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Get the given policy points sorted by increasing demand, the points
+     * with the same demand being kept in the order of the list.
+     */
+    void sortPolicyPointsByDemand (const MarginalRevenueTransformation::
+                                   PolicyPointList_T& iPolicyPointList,
+                                   PolicyPointVector_T& oPointVector) {
+      oPointVector.clear();
+      oPointVector.reserve (iPolicyPointList.size());
+      for (MarginalRevenueTransformation::PolicyPointList_T::const_iterator
+             itPoint = iPolicyPointList.begin();
+           itPoint != iPolicyPointList.end(); ++itPoint) {
+        oPointVector.push_back (&*itPoint);
+      }
+      std::stable_sort (oPointVector.begin(), oPointVector.end(),
+                        PolicyPointDemandLess());
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Get the nesting node at the given position of the yield-based
+     * nesting structure, and move the position to the next node.
+     *
+     * The nodes of the structure make up the pool of nodes of the
+     * segment-cabin: they are reset in place, and never removed, from
+     * one pre-optimisation to the next. A node is therefore created only
+     * when all the nodes of the pool are in use, with a code unique
+     * within the structure, and is kept for the next pre-optimisations.
+     */
+    stdair::NestingNode&
+    getPooledNestingNode (stdair::SimpleNestingStructure& ioNestingStructure,
+                          stdair::NestingNodeList_T::const_iterator& ioNode) {
+      const stdair::NestingNodeList_T& lNodeList =
+        stdair::BomManager::getList<stdair::NestingNode> (ioNestingStructure);
+      if (ioNode != lNodeList.end()) {
+        stdair::NestingNode* lNode_ptr = *ioNode;
+        assert (lNode_ptr != NULL);
+        ++ioNode;
+        return *lNode_ptr;
+      }
+
+      // The pool is exhausted: create a node. The position stays at the
+      // end of the list.
+      std::ostringstream lNodeCodeStr;
+      lNodeCodeStr << "MRT" << lNodeList.size();
+      const stdair::NestingNodeKey lNodeKey (lNodeCodeStr.str());
+      stdair::NestingNode& lNestingNode =
+        stdair::FacBom<stdair::NestingNode>::instance().create (lNodeKey);
+      stdair::FacBomManager::addToList (ioNestingStructure, lNestingNode);
+      stdair::FacBomManager::linkWithParent (ioNestingStructure, lNestingNode);
+      return lNestingNode;
+    }
+  }
+
   // ////////////////////////////////////////////////////////////////////
   bool MarginalRevenueTransformation::
   prepareDemandInput (stdair::SegmentCabin& ioSegmentCabin) {
     // Build the convex hull, then adjust the yield and demand of all
-    // classes based on the hull.
-  
-    buildNestedConvexHull (ioSegmentCabin);
-    bool isSucceeded = adjustYieldAndDemand (ioSegmentCabin);
+    // classes based on the hull. The policies are compared through their
+    // integer encoding.
+    PolicyCodeTable lPolicyCodeTable;
+    lPolicyCodeTable.build (ioSegmentCabin);
+
+    PolicyPointList_T lPolicyPointList;
+    getPolicyPointList (ioSegmentCabin, lPolicyCodeTable, lPolicyPointList);
+    PolicyPointList_T lConvexHull;
+    buildNestedConvexHull (lPolicyPointList, lConvexHull);
+
+    // Record the (materialised) policies of the convex hull.
+    ioSegmentCabin.resetConvexHull();
+    for (PolicyPointList_T::const_iterator itPoint = lConvexHull.begin();
+         itPoint != lConvexHull.end(); ++itPoint) {
+      if (itPoint->_policy != NULL) {
+        ioSegmentCabin.addPolicy (*itPoint->_policy);
+      }
+    }
+
+    bool isSucceeded = adjustYieldAndDemand (ioSegmentCabin, lConvexHull,
+                                             lPolicyCodeTable);
 
     return isSucceeded;
   }
 
   // ////////////////////////////////////////////////////////////////////
   void MarginalRevenueTransformation::
-  buildConvexHull (stdair::SegmentCabin& ioSegmentCabin) {
-    // Reset the convex hull of the segment.
-    ioSegmentCabin.resetConvexHull();
-    
-    // The first (from the left side) point of the convex hull is the "empty"
-    // policy, i.e. the one with all fare families closed.
-    const stdair::PolicyList_T& lPolicyList =
-      stdair::BomManager::getList<stdair::Policy> (ioSegmentCabin);
-
-    // By construction, the empty policy is the first one on the list of
-    // eligible policies.
-    stdair::PolicyList_T::const_iterator itPolicy=lPolicyList.begin();
-    stdair::Policy* lEmptyPolicy_ptr = *itPolicy;
-    assert (lEmptyPolicy_ptr != NULL);
-    ioSegmentCabin.addPolicy (*lEmptyPolicy_ptr);
-
-    // Pointer on the current policy of the convex hull.
-    stdair::Policy* lCurrentPolicy_ptr = lEmptyPolicy_ptr;
-    bool lEndOfHull = false;
+  getPolicyPointList (const stdair::SegmentCabin& iSegmentCabin,
+                      const PolicyCodeTable& iPolicyCodeTable,
+                      PolicyPointList_T& oPolicyPointList) {
+    oPolicyPointList.clear();
 
-    // The end of hull is reached when from the current policy, we cannot
-    // find an other one with greater demand and total revenue.
-    while (lEndOfHull == false) {
-      // Demand and total revenue of the current policy.
-      const double& lCurrentDem = lCurrentPolicy_ptr->getDemand();
-      const double lCurrentTR = lCurrentPolicy_ptr->getTotalRevenue();
-      
-      // Search for the next policy.
-      double lGradient = 0.0;
-      stdair::Policy* lNextPolicy_ptr = NULL;
-      for (stdair::PolicyList_T::const_iterator itPol = lPolicyList.begin();
-           itPol != lPolicyList.end(); ++itPol) {
-        stdair::Policy* lPolicy_ptr = *itPol;
+    // The policies built by the inventory, if any. By construction, the
+    // empty policy is the first one on the list of eligible policies.
+    if (stdair::BomManager::hasList<stdair::Policy> (iSegmentCabin) == true) {
+      const stdair::PolicyList_T& lPolicyList =
+        stdair::BomManager::getList<stdair::Policy> (iSegmentCabin);
+      oPolicyPointList.reserve (lPolicyList.size());
+      for (stdair::PolicyList_T::const_iterator itPolicy =
+             lPolicyList.begin(); itPolicy != lPolicyList.end(); ++itPolicy) {
+        stdair::Policy* lPolicy_ptr = *itPolicy;
         assert (lPolicy_ptr != NULL);
+        PolicyPoint lPolicyPoint;
+        lPolicyPoint._policyCode =
+          iPolicyCodeTable.getPolicyCode (*lPolicy_ptr);
+        lPolicyPoint._policy = lPolicy_ptr;
+        lPolicyPoint._demand = lPolicy_ptr->getDemand();
+        lPolicyPoint._stdDev = lPolicy_ptr->getStdDev();
+        lPolicyPoint._totalRevenue = lPolicy_ptr->getTotalRevenue();
+        oPolicyPointList.push_back (lPolicyPoint);
+      }
+      return;
+    }
 
-        const double& lDem = lPolicy_ptr->getDemand();
-        const double lTR = lPolicy_ptr->getTotalRevenue();
-        if (lDem > lCurrentDem && lTR > lCurrentTR) {
-          const double lNewGradient = (lTR-lCurrentTR)/(lDem-lCurrentDem);
-          if (lNewGradient > lGradient) {
-            lGradient = lNewGradient;
-            lNextPolicy_ptr = lPolicy_ptr;
-          }
+    // Otherwise, all the policies the inventory would have built are
+    // generated out of the fare families, the empty policy first. The
+    // dominated classes are not pruned: through the nesting constraint,
+    // the nested convex hull may go through a dominated policy.
+    PolicyGenerator lPolicyGenerator;
+    lPolicyGenerator.build (iPolicyCodeTable, false);
+    oPolicyPointList.reserve (lPolicyGenerator.getNbOfPolicies());
+    PolicyPoint lPolicyPoint;
+    lPolicyPoint._policy = NULL;
+    while (lPolicyGenerator.next (lPolicyPoint._policyCode) == true) {
+      lPolicyGenerator.evaluate (lPolicyPoint._policyCode,
+                                 lPolicyPoint._demand, lPolicyPoint._stdDev,
+                                 lPolicyPoint._totalRevenue);
+      oPolicyPointList.push_back (lPolicyPoint);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void MarginalRevenueTransformation::
+  buildConvexHull (const PolicyPointList_T& iPolicyPointList,
+                   PolicyPointList_T& oConvexHull) {
+    oConvexHull.clear();
+
+    // The first (from the left side) point of the convex hull is the "empty"
+    // policy, i.e. the one with all fare families closed, which is the
+    // first one on the list.
+    assert (iPolicyPointList.empty() == false);
+    const PolicyPoint* lEmptyPoint_ptr = &iPolicyPointList.front();
+    const double& lEmptyDem = lEmptyPoint_ptr->_demand;
+    const double& lEmptyTR = lEmptyPoint_ptr->_totalRevenue;
+
+    // Upper hull, by increasing demand (monotone chain), of the policies
+    // with greater demand and total revenue than the empty policy. For a
+    // given demand, only the policy with the greatest total revenue may
+    // be part of the hull (the first one on the list, in case of a tie).
+    PolicyPointVector_T lPointVector;
+    sortPolicyPointsByDemand (iPolicyPointList, lPointVector);
+    PolicyPointVector_T lHull (1, lEmptyPoint_ptr);
+    for (PolicyPointVector_T::const_iterator itPoint = lPointVector.begin();
+         itPoint != lPointVector.end(); ++itPoint) {
+      const PolicyPoint* lPoint_ptr = *itPoint;
+      assert (lPoint_ptr != NULL);
+      const double& lDem = lPoint_ptr->_demand;
+      const double& lTR = lPoint_ptr->_totalRevenue;
+      if (lDem <= lEmptyDem || lTR <= lEmptyTR) {
+        continue;
+      }
+      const PolicyPoint* lLast_ptr = lHull.back();
+      if (lLast_ptr != lEmptyPoint_ptr && lLast_ptr->_demand == lDem) {
+        if (lLast_ptr->_totalRevenue >= lTR) {
+          continue;
         }
+        lHull.pop_back();
       }
 
-      // Check if we have found the next policy
-      if (lNextPolicy_ptr == NULL) {
-        lEndOfHull = true;
-      } else {
-        ioSegmentCabin.addPolicy (*lNextPolicy_ptr);
-        lCurrentPolicy_ptr = lNextPolicy_ptr;
+      // Drop the last points of the hull which are strictly below the
+      // segment going from the point before them to the new one. The
+      // points lying on that segment are kept, as the greedy walk from
+      // one hull point to the next, over the policies sorted by demand,
+      // goes through each of them.
+      while (lHull.size() >= 2) {
+        const PolicyPoint& lPrevious = *lHull[lHull.size() - 2];
+        const PolicyPoint& lLast = *lHull.back();
+        const double lPreviousDem = lPrevious._demand;
+        const double lLastDem = lLast._demand;
+        const double lPreviousTR = lPrevious._totalRevenue;
+        const double lLastTR = lLast._totalRevenue;
+        if ((lLastTR - lPreviousTR) * (lDem - lLastDem)
+            >= (lTR - lLastTR) * (lLastDem - lPreviousDem)) {
+          break;
+        }
+        lHull.pop_back();
       }
+      lHull.push_back (lPoint_ptr);
+    }
+
+    // Only the increasing part of the upper hull is kept.
+    while (lHull.size() >= 2 && lHull.back()->_totalRevenue
+           <= lHull[lHull.size() - 2]->_totalRevenue) {
+      lHull.pop_back();
+    }
+    oConvexHull.reserve (lHull.size());
+    for (PolicyPointVector_T::const_iterator itPoint = lHull.begin();
+         itPoint != lHull.end(); ++itPoint) {
+      oConvexHull.push_back (**itPoint);
     }
   }
 
   // ////////////////////////////////////////////////////////////////////
   void MarginalRevenueTransformation::
-  buildNestedConvexHull (stdair::SegmentCabin& ioSegmentCabin) {
-    // Reset the convex hull of the segment.
-    ioSegmentCabin.resetConvexHull();
-    
+  buildNestedConvexHull (const PolicyPointList_T& iPolicyPointList,
+                         PolicyPointList_T& oConvexHull) {
+    oConvexHull.clear();
+
     // The first (from the left side) point of the convex hull is the "empty"
-    // policy, i.e. the one with all fare families closed.
-    const stdair::PolicyList_T& lPolicyList =
-      stdair::BomManager::getList<stdair::Policy> (ioSegmentCabin);
-
-    // By construction, the empty policy is the first one on the list of
-    // eligible policies.
-    stdair::PolicyList_T::const_iterator itPolicy=lPolicyList.begin();
-    stdair::Policy* lEmptyPolicy_ptr = *itPolicy;
-    assert (lEmptyPolicy_ptr != NULL);
-    ioSegmentCabin.addPolicy (*lEmptyPolicy_ptr);
-
-    // Pointer on the current policy of the convex hull.
-    stdair::Policy* lCurrentPolicy_ptr = lEmptyPolicy_ptr;
+    // policy, i.e. the one with all fare families closed, which is the
+    // first one on the list.
+    assert (iPolicyPointList.empty() == false);
+    const PolicyPoint* lCurrentPoint_ptr = &iPolicyPointList.front();
+    oConvexHull.push_back (*lCurrentPoint_ptr);
+
+    // The policies, by increasing demand: the candidates following the
+    // current policy of the hull are found after it on that list.
+    PolicyPointVector_T lPointVector;
+    sortPolicyPointsByDemand (iPolicyPointList, lPointVector);
+    PolicyPointVector_T::const_iterator itFirstCandidate =
+      lPointVector.begin();
+
     bool lEndOfHull = false;
 
     // The end of hull is reached when from the current policy, we cannot
     // find an other one with greater demand and total revenue.
     while (lEndOfHull == false) {
       // Demand and total revenue of the current policy.
-      const double& lCurrentDem = lCurrentPolicy_ptr->getDemand();
-      const double lCurrentTR = lCurrentPolicy_ptr->getTotalRevenue();
+      const double& lCurrentDem = lCurrentPoint_ptr->_demand;
+      const double& lCurrentTR = lCurrentPoint_ptr->_totalRevenue;
+      while (itFirstCandidate != lPointVector.end()
+             && (*itFirstCandidate)->_demand <= lCurrentDem) {
+        ++itFirstCandidate;
+      }
 
-      // Search for the next policy.
+      // Search for the next policy. The nesting check is only made on the
+      // policies which would improve the gradient. Among the policies
+      // giving the same gradient, the one with the lowest demand is taken.
       double lGradient = 0.0;
-      stdair::Policy* lNextPolicy_ptr = NULL;
-      for (stdair::PolicyList_T::const_iterator itPol = lPolicyList.begin();
-           itPol != lPolicyList.end(); ++itPol) {
-        stdair::Policy* lPolicy_ptr = *itPol;
-        assert (lPolicy_ptr != NULL);
+      const PolicyPoint* lNextPoint_ptr = NULL;
+      for (PolicyPointVector_T::const_iterator itPoint = itFirstCandidate;
+           itPoint != lPointVector.end(); ++itPoint) {
+        const PolicyPoint* lPoint_ptr = *itPoint;
+        assert (lPoint_ptr != NULL);
 
-        const double& lDem = lPolicy_ptr->getDemand();
-        const double lTR = lPolicy_ptr->getTotalRevenue();
-        if (lDem > lCurrentDem && lTR > lCurrentTR
-            && PolicyHelper::isNested (*lCurrentPolicy_ptr, *lPolicy_ptr)) {
+        const double& lDem = lPoint_ptr->_demand;
+        const double& lTR = lPoint_ptr->_totalRevenue;
+        if (lTR > lCurrentTR) {
           const double lNewGradient = (lTR-lCurrentTR)/(lDem-lCurrentDem);
-          if (lNewGradient > lGradient) {
+          if (lNewGradient > lGradient
+              && PolicyHelper::isNested (lCurrentPoint_ptr->_policyCode,
+                                         lPoint_ptr->_policyCode)) {
             lGradient = lNewGradient;
-            lNextPolicy_ptr = lPolicy_ptr;
+            lNextPoint_ptr = lPoint_ptr;
           }
         }
       }
 
       // Check if we have found the next policy
-      if (lNextPolicy_ptr == NULL) {
+      if (lNextPoint_ptr == NULL) {
         lEndOfHull = true;
       } else {
-        ioSegmentCabin.addPolicy (*lNextPolicy_ptr);
-        lCurrentPolicy_ptr = lNextPolicy_ptr;
+        oConvexHull.push_back (*lNextPoint_ptr);
+        lCurrentPoint_ptr = lNextPoint_ptr;
       }
     }
   }
 
   // ////////////////////////////////////////////////////////////////////
   bool MarginalRevenueTransformation::
-  adjustYieldAndDemand (stdair::SegmentCabin& ioSegmentCabin) {
+  adjustYieldAndDemand (stdair::SegmentCabin& ioSegmentCabin,
+                        const PolicyPointList_T& iConvexHull,
+                        const PolicyCodeTable& iPolicyCodeTable) {
     bool isSucceeded = false;
     stdair::NbOfClasses_T lBookingClassCounter = 0;
     // Browse the list of policies on the convex hull, compute the differences
     // between pairs of consecutive policies.
-    const stdair::PolicyList_T& lConvexHull = ioSegmentCabin.getConvexHull();
-    stdair::PolicyList_T::const_iterator itCurrentPolicy = lConvexHull.begin();
-    assert (itCurrentPolicy != lConvexHull.end());
-    stdair::PolicyList_T::const_iterator itNextPolicy = itCurrentPolicy;
+    PolicyPointList_T::const_iterator itCurrentPolicy = iConvexHull.begin();
+    assert (itCurrentPolicy != iConvexHull.end());
+    PolicyPointList_T::const_iterator itNextPolicy = itCurrentPolicy;
     ++itNextPolicy;
     // If the nesting has only one element (the empty policy),
     // there is no optimisation and no pre-optimisation.
-    if (itNextPolicy == lConvexHull.end()) {
+    if (itNextPolicy == iConvexHull.end()) {
       return isSucceeded;
     }
 
-    // Reset the yield-based nesting structure
+    // Reset the yield-based nesting structure, the nodes of which are
+    // reused in place.
     stdair::FacBomManager::resetYieldBasedNestingStructure (ioSegmentCabin);
 
     // Retrieve the yield-based nesting structure.
     stdair::SimpleNestingStructure& lYieldBasedNS =
       stdair::BomManager::getObject<stdair::SimpleNestingStructure> (ioSegmentCabin, stdair::YIELD_BASED_NESTING_STRUCTURE_CODE);
-    const stdair::NestingNodeList_T& lNodeList =
-      stdair::BomManager::getList<stdair::NestingNode> (lYieldBasedNS);
-    stdair::NestingNodeList_T::const_iterator itNode = lNodeList.begin();
-
-    for (; itNextPolicy != lConvexHull.end();
-         ++itCurrentPolicy, ++itNextPolicy, ++itNode){
-      const stdair::Policy* lCurrentPolicy_ptr = *itCurrentPolicy;
-      assert (lCurrentPolicy_ptr != NULL);
-      const stdair::Policy* lNextPolicy_ptr = *itNextPolicy;
-      assert (lNextPolicy_ptr != NULL);
-
-      // Retrieve the node. If there isn't any node left, create new one.
-      stdair::NestingNode* lNode_ptr = NULL;
-      if (itNode == lNodeList.end()) {
-        // Create a nesting node
-        stdair::NestingNodeCode_T lNodeCode ("XXX");
-        stdair::NestingNodeKey lNodeKey (lNodeCode);
-        stdair::NestingNode& lNestingNode =
-          stdair::FacBom<stdair::NestingNode>::instance().create (lNodeKey);
-        stdair::FacBomManager::addToList (lYieldBasedNS, lNestingNode);
-        stdair::FacBomManager::linkWithParent (lYieldBasedNS, lNestingNode);
-        lNode_ptr = &lNestingNode;
-      } else {
-        lNode_ptr = *itNode;
-      }
-      assert (lNode_ptr != NULL);
-      PolicyHelper::diffBetweenTwoPolicies (*lNode_ptr, *lNextPolicy_ptr,
-                                            *lCurrentPolicy_ptr);
+    stdair::NestingNodeList_T::const_iterator itNode =
+      stdair::BomManager::getList<stdair::NestingNode> (lYieldBasedNS).begin();
+
+    for (; itNextPolicy != iConvexHull.end();
+         ++itCurrentPolicy, ++itNextPolicy){
+      const PolicyPoint& lCurrentPolicy = *itCurrentPolicy;
+      const PolicyPoint& lNextPolicy = *itNextPolicy;
+
+      // Retrieve the next node of the pool.
+      stdair::NestingNode* lNode_ptr =
+        &getPooledNestingNode (lYieldBasedNS, itNode);
+      PolicyHelper::diffBetweenTwoPolicies (*lNode_ptr,
+                                            lNextPolicy._policyCode,
+                                            lCurrentPolicy._policyCode,
+                                            iPolicyCodeTable);
 
       // Compute the adjusted yield, demand mean and demand standard deviation.
       // Note: because of the nature of the convex hull, in the adjusted
@@ -211,23 +358,23 @@ namespace RMOL {
       // the squares of the standard deviations of the two policies instead of
       // the sum of the squares.
       const stdair::MeanValue_T lAdjustedDemMean =
-        lNextPolicy_ptr->getDemand()-lCurrentPolicy_ptr->getDemand();
+        lNextPolicy._demand-lCurrentPolicy._demand;
       assert (lAdjustedDemMean > 0.0);
-      const stdair::StdDevValue_T& lCurrentStdDev = 
-        lCurrentPolicy_ptr->getStdDev();
-      const stdair::StdDevValue_T& lNextStdDev = lNextPolicy_ptr->getStdDev();
+      const stdair::StdDevValue_T& lCurrentStdDev = lCurrentPolicy._stdDev;
+      const stdair::StdDevValue_T& lNextStdDev = lNextPolicy._stdDev;
       assert (lNextStdDev > lCurrentStdDev);
       const stdair::StdDevValue_T lAdjustedDemStdDev =
         std::sqrt (lNextStdDev*lNextStdDev - lCurrentStdDev*lCurrentStdDev);
       const stdair::Yield_T lAdjustedYield =
-        (lNextPolicy_ptr->getTotalRevenue()-lCurrentPolicy_ptr->getTotalRevenue())/(lAdjustedDemMean);
+        (lNextPolicy._totalRevenue-lCurrentPolicy._totalRevenue)
+        /(lAdjustedDemMean);
       assert (lAdjustedYield > 0.0);
       lNode_ptr->setYield (lAdjustedYield);
 
       // Browse the list of booking classes in the node. Set the adjusted yield
       // for each class. However, the adjusted demand forecast will be
       // distributed only to the first class of the list.
-      const stdair::BookingClassList_T lBCList =
+      const stdair::BookingClassList_T& lBCList =
         stdair::BomManager::getList<stdair::BookingClass> (*lNode_ptr);
       stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
       assert (itBC != lBCList.end());
@@ -251,27 +398,13 @@ namespace RMOL {
       // At the last node. All the classes which haven't been added to the
       // nesting structure will be added to the next nesting node, with
       // an adjusted yield of zero.
-      // Retrieve the node. If there isn't any node left, create new one.
-      stdair::NestingNode* lLastNode_ptr = NULL;
-      if (itNode == lNodeList.end()) {
-        // Create a nesting node
-        stdair::NestingNodeCode_T lNodeCode ("XXX");
-        stdair::NestingNodeKey lNodeKey (lNodeCode);
-        stdair::NestingNode& lNestingNode =
-          stdair::FacBom<stdair::NestingNode>::instance().create (lNodeKey);
-        stdair::FacBomManager::addToList (lYieldBasedNS, lNestingNode);
-        stdair::FacBomManager::linkWithParent (lYieldBasedNS, lNestingNode);
-        lLastNode_ptr = 
-          stdair::BomManager::getObjectPtr<stdair::NestingNode>(lYieldBasedNS, 
-                                                           lNodeKey.toString());
-      } else {
-        lLastNode_ptr = *itNode;
-      }
+      // Retrieve the next node of the pool.
+      stdair::NestingNode* lLastNode_ptr =
+        &getPooledNestingNode (lYieldBasedNS, itNode);
       assert (lLastNode_ptr != NULL);
-      const stdair::Policy* lLastPolicy_ptr = *itCurrentPolicy;
-      assert (lLastPolicy_ptr != NULL);
-      PolicyHelper::computeLastNode (*lLastNode_ptr, *lLastPolicy_ptr,
-                                     ioSegmentCabin);
+      const PolicyPoint& lLastPolicy = *itCurrentPolicy;
+      PolicyHelper::computeLastNode (*lLastNode_ptr, lLastPolicy._policyCode,
+                                     iPolicyCodeTable);
     }
 
     isSucceeded = true;
@@ -6,40 +6,86 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <map>
+#include <vector>
 // StdAir
 #include <stdair/stdair_inventory_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/PolicyCodeTable.hpp>
 
 // Forward declarations
 namespace stdair {
   class SegmentCabin;
+  class Policy;
 }
 
 namespace RMOL {
   /** Class wrapping the pre-optimisation algorithms. */
   class MarginalRevenueTransformation {    
+  public:
+    /**
+     * Policy considered for the convex hull, given by its encoding, along
+     * with its demand and total revenue.
+     */
+    struct PolicyPoint {
+      /** Encoding of the policy. */
+      PolicyCodeTable::PolicyCode_T _policyCode;
+
+      /** Policy built by the inventory (NULL for a generated policy). */
+      stdair::Policy* _policy;
+
+      /** Demand mean. */
+      stdair::MeanValue_T _demand;
+
+      /** Demand standard deviation. */
+      stdair::StdDevValue_T _stdDev;
+
+      /** Total revenue. */
+      double _totalRevenue;
+    };
+
+    /** Define the list of policy points. */
+    typedef std::vector<PolicyPoint> PolicyPointList_T;
+
   public:
     /**
      * Prepare the demand input for the optimser.
      */
     static bool prepareDemandInput (stdair::SegmentCabin&);
-    
-  private:
+
     /**
-     * Build the nested convex hull
+     * Build the convex hull of the given policies, the first one being
+     * the empty policy: the increasing part of their upper hull, from
+     * the empty policy on. The policies lying on a segment of the hull
+     * are part of it.
      */
-    static void buildNestedConvexHull (stdair::SegmentCabin&);
-    
+    static void buildConvexHull (const PolicyPointList_T&,
+                                 PolicyPointList_T&);
+
     /**
-     * Build the convex hull
+     * Build the nested convex hull of the given policies, the first one
+     * being the empty policy.
      */
-    static void buildConvexHull (stdair::SegmentCabin&);
+    static void buildNestedConvexHull (const PolicyPointList_T&,
+                                       PolicyPointList_T&);
     
+  private:
+    /**
+     * Get the policies of the segment-cabin, the empty policy first: the
+     * policies built by the inventory if any, otherwise the (non
+     * dominated) policies generated out of its fare families.
+     */
+    static void getPolicyPointList (const stdair::SegmentCabin&,
+                                    const PolicyCodeTable&,
+                                    PolicyPointList_T&);
+
     /**
      * Adjust yield and demand of all classes.
      */
-    static bool adjustYieldAndDemand (stdair::SegmentCabin&);  
+    static bool adjustYieldAndDemand (stdair::SegmentCabin&,
+                                      const PolicyPointList_T&,
+                                      const PolicyCodeTable&);
   };
 }
 #endif // __RMOL_COMMAND_MARGINALREVENUETRANSFORMATION_HPP
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <sstream>
 #include <cmath>
+#include <vector>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Inventory.hpp>
@@ -18,10 +19,15 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/Utilities.hpp>
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/ClassCurveMatrix.hpp>
 #include <rmol/bom/SegmentSnapshotTableHelper.hpp>
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
 #include <rmol/bom/HistoricalBooking.hpp>
 #include <rmol/bom/EMDetruncator.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
 #include <rmol/command/NewQFF.hpp>
 #include <rmol/command/Detruncator.hpp>
 
@@ -32,27 +38,45 @@ namespace RMOL {
             const stdair::Date_T& iCurrentDate,
             const stdair::DTD_T& iCurrentDTD,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
-            const stdair::NbOfSegments_T& iNbOfDepartedSegments) {
+            const stdair::NbOfSegments_T& iNbOfDepartedSegments,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            const unsigned int iNbOfThreads) {
     // Retrieve the snapshot table.
     const stdair::SegmentSnapshotTable& lSegmentSnapshotTable =
       ioSegmentCabin.getSegmentSnapshotTable();
 
     // Browse the list of fare families and execute "Q-forecasting" within
-    // each fare family.
+    // each fare family. The fare families are independent from each other
+    // (each forecast writes only into the fare family and its classes),
+    // so that they may be forecasted in parallel.
     const stdair::FareFamilyList_T& lFFList =
       stdair::BomManager::getList<stdair::FareFamily>(ioSegmentCabin);
-    for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
-         itFF != lFFList.end(); ++itFF) {
-      stdair::FareFamily* lFF_ptr = *itFF;
-      assert (lFF_ptr != NULL);
-
-      forecast (*lFF_ptr,
-                iCurrentDate,
-                iCurrentDTD,
-                iUnconstrainingMethod,
-                iNbOfDepartedSegments,
-                lSegmentSnapshotTable);
+    const std::vector<stdair::FareFamily*> lFFVector (lFFList.begin(),
+                                                     lFFList.end());
+
+    // When there are less fare families than threads, the remaining
+    // threads are shared among the fare families, for the unconstraining
+    // of their historical bookings.
+    const unsigned int lNbOfFareFamilies = lFFVector.size();
+    unsigned int lNbOfThreadsPerFamily = 1;
+    if (lNbOfFareFamilies > 0 && iNbOfThreads > lNbOfFareFamilies) {
+      lNbOfThreadsPerFamily = iNbOfThreads / lNbOfFareFamilies;
     }
+    ParallelLoop::run (lNbOfFareFamilies,
+                       [&] (const unsigned int iFFIdx) {
+                         stdair::FareFamily* lFF_ptr = lFFVector[iFFIdx];
+                         assert (lFF_ptr != NULL);
+
+                         forecast (*lFF_ptr,
+                                   iCurrentDate,
+                                   iCurrentDTD,
+                                   iUnconstrainingMethod,
+                                   iNbOfDepartedSegments,
+                                   lSegmentSnapshotTable,
+                                   ioHBWindowHolder,
+                                   lNbOfThreadsPerFamily);
+                       },
+                       iNbOfThreads);
 
     // Dispatch the demand forecast to the policies.
     dispatchDemandForecastToPolicies (ioSegmentCabin);
@@ -67,7 +91,9 @@ namespace RMOL {
             const stdair::DTD_T& iCurrentDTD,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
             const stdair::NbOfSegments_T& iNbOfDepartedSegments,
-            const stdair::SegmentSnapshotTable& iSegmentSnapshotTable) {
+            const stdair::SegmentSnapshotTable& iSegmentSnapshotTable,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            const unsigned int iNbOfThreads) {
     // Retrieve the FRAT5Curve.
     const stdair::FRAT5Curve_T& lFRAT5Curve = ioFareFamily.getFrat5Curve();
 
@@ -75,86 +101,116 @@ namespace RMOL {
     // and the dispatching curves.
     const stdair::BookingClassList_T& lBCList =
       stdair::BomManager::getList<stdair::BookingClass>(ioFareFamily);
-    const stdair::BookingClassSellUpCurveMap_T lBCSellUpCurveMap =
-      Utilities::computeSellUpFactorCurves (lFRAT5Curve, lBCList);
-    const stdair::BookingClassDispatchingCurveMap_T lBCDispatchingCurveMap =
-      Utilities::computeDispatchingFactorCurves (lFRAT5Curve, lBCList);
+    ClassCurveMatrix lSellUpCurves;
+    lSellUpCurves.buildSellUpCurves (lFRAT5Curve, lBCList);
+    ClassCurveMatrix lDispatchingCurves;
+    lDispatchingCurves.buildDispatchingCurves (lFRAT5Curve, lBCList);
+
+    // Build the key of the fare family within the snapshot table. The
+    // Q-equivalent bookings held by the windows depend on the sell-up
+    // curves, which version them.
+    const stdair::SegmentCabin& lSegmentCabin =
+      stdair::BomManager::getParent<stdair::SegmentCabin> (ioFareFamily);
+    const std::string lSeriesKey =
+      "QFF " + lSegmentCabin.describeKey() + " " + ioFareFamily.describeKey();
+    const std::string lSeriesVersion = lSellUpCurves.describeFactors();
     
-    // Browse all remaining DCP's and do unconstraining, forecasting
-    // and dispatching.
-    const stdair::DCPList_T lWholeDCPList = stdair::DEFAULT_DCP_LIST;
-    stdair::DCPList_T::const_iterator itDCP = lWholeDCPList.begin();
-    stdair::DCPList_T::const_iterator itNextDCP = itDCP; ++itNextDCP;
-    for (; itNextDCP != lWholeDCPList.end(); ++itDCP, ++itNextDCP) {
-      const stdair::DCP_T& lCurrentDCP = *itDCP;
-      const stdair::DCP_T& lNextDCP = *itNextDCP;
-
-      // The end of the interval is after the current DTD.
-      if (lNextDCP < iCurrentDTD) {
-        // Get the number of similar segments which has already passed the
-        // (lNextDCP+1)
-        const stdair::NbOfSegments_T& lNbOfUsableSegments =
-          SegmentSnapshotTableHelper::
-          getNbOfSegmentAlreadyPassedThisDTD (iSegmentSnapshotTable,
-                                              lNextDCP+1,
-                                              iCurrentDate);
-        stdair::NbOfSegments_T lSegmentBegin = 0;
-        const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
-        if (iNbOfDepartedSegments > 52) {
-          lSegmentBegin = iNbOfDepartedSegments - 52;
-        }
-      
-        // Retrieve the historical bookings and convert them to
-        // Q-equivalent bookings.
-        HistoricalBookingHolder lHBHolder;
-        preparePriceOrientedHistoricalBooking (ioFareFamily,
-                                               iSegmentSnapshotTable,
-                                               lHBHolder,
-                                               lCurrentDCP, lNextDCP,
-                                               lSegmentBegin, lSegmentEnd,
-                                               lBCSellUpCurveMap);
-
-        // Unconstrain the historical bookings.
-        Detruncator::unconstrain (lHBHolder, iUnconstrainingMethod);
-
-        // Retrieve the historical unconstrained demand and perform the
-        // forecasting.
-        stdair::UncDemVector_T lUncDemVector;
-        // Be careful, the getter returns the vector size,
-        // so there is no reference.
-        const short lNbOfHistoricalFlights = lHBHolder.getNbOfFlights();
-        for (short i = 0; i < lNbOfHistoricalFlights; ++i) {
-          const stdair::NbOfBookings_T& lUncDemand =
-            lHBHolder.getUnconstrainedDemand (i);
-          lUncDemVector.push_back (lUncDemand);
-        }
-        stdair::MeanValue_T lMean = 0.0;
-        stdair::StdDevValue_T lStdDev = 0.0;
-        Utilities::computeDistributionParameters (lUncDemVector,
-                                                  lMean, lStdDev);
-
-        // Dispatch the forecast to all the classes.
-        Utilities::dispatchDemandForecast (lBCDispatchingCurveMap,
-                                           lMean, lStdDev, lCurrentDCP);
-
-        // Dispatch the forecast to all classes for Fare Adjustment or MRT.
-        // The sell-up probability will be used in this case.
-        Utilities::dispatchDemandForecastForFA (lBCSellUpCurveMap,
-                                                lMean, lStdDev, lCurrentDCP);
-
-        // Add the demand forecast to the fare family.
-        const stdair::MeanValue_T& lCurrentMean = ioFareFamily.getMean();
-        const stdair::StdDevValue_T& lCurrentStdDev = ioFareFamily.getStdDev();
-
-        const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
-        const stdair::StdDevValue_T lNewStdDev = 
-          std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
-
-        ioFareFamily.setMean (lNewMean);
-        ioFareFamily.setStdDev (lNewStdDev);
+    // Browse all remaining DCP's and gather the historical bookings of
+    // each DCP interval, so that they can be unconstrained all at once.
+    HistoricalBookingMatrix lHBMatrix;
+    const DCPIndex_T lFirstIntervalIdx =
+      DCPCalendar::getIntervalIndex (iCurrentDTD);
+    for (DCPIndex_T lIntervalIdx = lFirstIntervalIdx;
+         lIntervalIdx < DCPCalendar::getNbOfIntervals(); ++lIntervalIdx) {
+      const stdair::DCP_T& lCurrentDCP =
+        DCPCalendar::getIntervalBegin (lIntervalIdx);
+      const stdair::DCP_T& lNextDCP =
+        DCPCalendar::getIntervalEnd (lIntervalIdx);
+
+      // Get the number of similar segments which has already passed the
+      // (lNextDCP+1)
+      const stdair::NbOfSegments_T& lNbOfUsableSegments =
+        SegmentSnapshotTableHelper::
+        getNbOfSegmentAlreadyPassedThisDTD (iSegmentSnapshotTable,
+                                            lNextDCP+1,
+                                            iCurrentDate);
+      stdair::NbOfSegments_T lSegmentBegin = 0;
+      const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
+      const stdair::NbOfSegments_T lWindowSize =
+        ioHBWindowHolder.getWindowSize();
+      if (iNbOfDepartedSegments > lWindowSize) {
+        lSegmentBegin = iNbOfDepartedSegments - lWindowSize;
       }
+    
+      // Retrieve the historical bookings and convert them to
+      // Q-equivalent bookings. Only the similar segments which have
+      // passed the DCP interval since the previous forecast are read
+      // from the snapshot table.
+      HistoricalBookingHolder lHBHolder;
+      ioHBWindowHolder.
+        prepareHistoricalBooking (lSegmentCabin, lSeriesKey, lSeriesVersion,
+                                  lCurrentDCP, lSegmentBegin, lSegmentEnd,
+                                  [&] (HistoricalBookingHolder& ioHBHolder,
+                                       const stdair::NbOfSegments_T& iBegin,
+                                       const stdair::NbOfSegments_T& iEnd) {
+                                    preparePriceOrientedHistoricalBooking
+                                      (ioFareFamily, iSegmentSnapshotTable,
+                                       ioHBHolder, lCurrentDCP, lNextDCP,
+                                       iBegin, iEnd, lSellUpCurves);
+                                  },
+                                  lHBHolder);
+
+      lHBMatrix.addSeries (lHBHolder);
     }
 
+    // Unconstrain the historical bookings of all the DCP intervals.
+    Detruncator::unconstrain (lHBMatrix, iUnconstrainingMethod,
+                              iNbOfThreads);
+
+    // Browse the DCP intervals and do the forecasting and dispatching.
+    const unsigned int lNbOfClasses = lSellUpCurves.getNbOfClasses();
+    ClassFactorVector_T lPriceDemMeanList (lNbOfClasses, 0.0);
+    ClassFactorVector_T lPriceDemVarianceList (lNbOfClasses, 0.0);
+    ClassFactorVector_T lCumuPriceDemMeanList (lNbOfClasses, 0.0);
+    ClassFactorVector_T lCumuPriceDemVarianceList (lNbOfClasses, 0.0);
+    for (SeriesIndex_T lSeries = 0; lSeries < lHBMatrix.getNbOfSeries();
+         ++lSeries) {
+      const DCPIndex_T lCurrentDCPIndex = lFirstIntervalIdx + lSeries;
+      const stdair::MeanValue_T& lMean = lHBMatrix.getDemandMean (lSeries);
+      const stdair::StdDevValue_T& lStdDev =
+        lHBMatrix.getStandardDeviation (lSeries);
+
+      // Dispatch the forecast to all the classes.
+      Utilities::dispatchDemandForecast (lDispatchingCurves, lMean, lStdDev,
+                                         lCurrentDCPIndex, lPriceDemMeanList,
+                                         lPriceDemVarianceList);
+
+      // Dispatch the forecast to all classes for Fare Adjustment or MRT.
+      // The sell-up probability will be used in this case.
+      Utilities::dispatchDemandForecast (lSellUpCurves, lMean, lStdDev,
+                                         lCurrentDCPIndex,
+                                         lCumuPriceDemMeanList,
+                                         lCumuPriceDemVarianceList);
+
+      // Add the demand forecast to the fare family.
+      const stdair::MeanValue_T& lCurrentMean = ioFareFamily.getMean();
+      const stdair::StdDevValue_T& lCurrentStdDev = ioFareFamily.getStdDev();
+
+      const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
+      const stdair::StdDevValue_T lNewStdDev = 
+        std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
+
+      ioFareFamily.setMean (lNewMean);
+      ioFareFamily.setStdDev (lNewStdDev);
+    }
+
+    // Add the dispatched forecast to the classes.
+    Utilities::addPriceDemandForecast (lDispatchingCurves, lPriceDemMeanList,
+                                       lPriceDemVarianceList);
+    Utilities::addCumuPriceDemandForecast (lSellUpCurves,
+                                           lCumuPriceDemMeanList,
+                                           lCumuPriceDemVarianceList);
+
   }
   
   // ////////////////////////////////////////////////////////////////////
@@ -165,7 +221,7 @@ namespace RMOL {
      const stdair::DCP_T& iDCPBegin, const stdair::DCP_T& iDCPEnd,
      const stdair::NbOfSegments_T& iSegmentBegin,
      const stdair::NbOfSegments_T& iSegmentEnd,
-     const stdair::BookingClassSellUpCurveMap_T& iBCSellUpCurveMap) {
+     const ClassCurveMatrix& iSellUpCurves) {
 
     // Retrieve the gross daily booking and availability snapshots.
     const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lPriceBookingView =
@@ -175,6 +231,20 @@ namespace RMOL {
     const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lAvlView =
       iSegmentSnapshotTable.getConstSegmentCabinDTDRangeAvailabilitySnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
     
+    // Retrieve the sell-up factors of the DCP interval, and the indices
+    // of the booking classes within the snapshot table.
+    const DCPIndex_T lDCPIndex = DCPCalendar::getDCPIndex (iDCPBegin);
+    const double* lSellUpList = iSellUpCurves.getFactorList (lDCPIndex);
+    const unsigned int lNbOfBCs = iSellUpCurves.getNbOfClasses();
+    std::vector<stdair::ClassIndex_T> lClassIdxList;
+    lClassIdxList.reserve (lNbOfBCs);
+    for (unsigned int c = 0; c < lNbOfBCs; ++c) {
+      const stdair::BookingClass& lBookingClass =
+        iSellUpCurves.getBookingClass (c);
+      lClassIdxList.push_back (iSegmentSnapshotTable.
+                               getClassIndex (lBookingClass.describeKey()));
+    }
+
     // Browse the list of segments and build the historical booking holder.
     const stdair::ClassIndexMap_T& lVTIdxMap =
       iSegmentSnapshotTable.getClassIndexMap();
@@ -190,13 +260,8 @@ namespace RMOL {
         // STDAIR_LOG_DEBUG ("i: " << i << ", NbOfClasses: " << lNbOfClasses
         //                   << ", ClassIdx: " << iClassIdx << ", j: " << j);
         bool tempCensorship = true;
-        for (stdair::BookingClassSellUpCurveMap_T::const_iterator itBCSUC =
-             iBCSellUpCurveMap.begin();
-           itBCSUC != iBCSellUpCurveMap.end(); ++itBCSUC) {
-          const stdair::BookingClass* lBookingClass_ptr = itBCSUC->first;
-          assert (lBookingClass_ptr != NULL);
-          const stdair::ClassIndex_T& lClassIdx =
-            iSegmentSnapshotTable.getClassIndex(lBookingClass_ptr->describeKey());
+        for (unsigned int c = 0; c < lNbOfBCs; ++c) {
+          const stdair::ClassIndex_T& lClassIdx = lClassIdxList[c];
           const stdair::UnsignedIndex_T lAvlIdx = i*lNbOfClasses + lClassIdx;
           if (lAvlView[lAvlIdx][j] >= 1.0) {
             tempCensorship = false;
@@ -211,21 +276,12 @@ namespace RMOL {
 
       // Compute the Q-equivalent bookings
       stdair::NbOfBookings_T lNbOfHistoricalBkgs = 0.0;
-      for (stdair::BookingClassSellUpCurveMap_T::const_iterator itBCSUC =
-             iBCSellUpCurveMap.begin();
-           itBCSUC != iBCSellUpCurveMap.end(); ++itBCSUC) {
-        const stdair::BookingClass* lBookingClass_ptr = itBCSUC->first;
-        assert (lBookingClass_ptr != NULL);
-        const stdair::SellUpCurve_T& lSellUpCurve = itBCSUC->second;
-        stdair::SellUpCurve_T::const_iterator itSellUp =
-          lSellUpCurve.find (iDCPBegin);
-        assert (itSellUp != lSellUpCurve.end());
-        const stdair::SellupProbability_T& lSellUp = itSellUp->second;
+      for (unsigned int c = 0; c < lNbOfBCs; ++c) {
+        const stdair::SellupProbability_T& lSellUp = lSellUpList[c];
         assert (lSellUp != 0);
 
         // Retrieve the number of bookings
-        const stdair::ClassIndex_T& lClassIdx =
-          iSegmentSnapshotTable.getClassIndex(lBookingClass_ptr->describeKey());
+        const stdair::ClassIndex_T& lClassIdx = lClassIdxList[c];
         const stdair::UnsignedIndex_T lIdx = i*lNbOfClasses + lClassIdx;
 
         stdair::NbOfBookings_T lNbOfBookings = 0.0;
@@ -246,6 +302,12 @@ namespace RMOL {
   // ////////////////////////////////////////////////////////////////////
   void NewQFF::
   dispatchDemandForecastToPolicies (const stdair::SegmentCabin& iSegmentCabin){
+    // The policies may not have been built by the inventory, in which
+    // case they are generated when needed (see PolicyGenerator).
+    if (stdair::BomManager::hasList<stdair::Policy> (iSegmentCabin) == false) {
+      return;
+    }
+
     // Retrieve the list of policies.
     const stdair::PolicyList_T& lPolicyList =
       stdair::BomManager::getList<stdair::Policy> (iSegmentCabin);
@@ -10,6 +10,7 @@
 #include <stdair/stdair_inventory_types.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -19,6 +20,10 @@ namespace stdair {
 }
 
 namespace RMOL {
+  // Forward declarations
+  struct HistoricalBookingWindowHolder;
+  struct ClassCurveMatrix;
+
   /** Class wrapping the forecasting algorithms. */
   class NewQFF {
   public:
@@ -30,22 +35,33 @@ namespace RMOL {
      * @param const stdair::DTD_T& Current DTD 
      * @param const stdair::UnconstrainingMethod& Method used for the unconstraining
      * @param const stdair::NbOfSegments_T& Number of usable historical segments
+     * @param HistoricalBookingWindowHolder& Sliding windows of the
+     *        historical bookings, kept from one forecast to the next
+     * @param const unsigned int Number of threads on which the fare
+     *        families are forecasted, and their historical bookings
+     *        unconstrained
     */
     static bool forecast (stdair::SegmentCabin&, const stdair::Date_T&,
                           const stdair::DTD_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::NbOfSegments_T&);
+                          const stdair::NbOfSegments_T&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int iNbOfThreads =
+                          DEFAULT_NUMBER_OF_THREADS);
     
   private:
     /**
-     * Forecast demand for a fare family
+     * Forecast demand for a fare family, the historical bookings being
+     * unconstrained on the given number of threads.
      */
     static void forecast (stdair::FareFamily&,
                           const stdair::Date_T&,
                           const stdair::DTD_T&,
                           const stdair::UnconstrainingMethod&,
                           const stdair::NbOfSegments_T&,
-                          const stdair::SegmentSnapshotTable&);
+                          const stdair::SegmentSnapshotTable&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int);
 
     /**
      * Prepare the historical price-oriented booking figures for a given cabin
@@ -59,7 +75,7 @@ namespace RMOL {
     (const stdair::FareFamily&, const stdair::SegmentSnapshotTable&,
      HistoricalBookingHolder&, const stdair::DCP_T&, const stdair::DCP_T&,
      const stdair::NbOfSegments_T&, const stdair::NbOfSegments_T&,
-     const stdair::BookingClassSellUpCurveMap_T&); 
+     const ClassCurveMatrix&);
 
     /**
      * Dispatch the demand forecast to the policies.
@@ -3,6 +3,7 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <vector>
 #include <sstream>
 #include <cmath>
 // StdAir
@@ -18,8 +19,12 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/bom/Utilities.hpp>
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/ClassCurveMatrix.hpp>
 #include <rmol/bom/SegmentSnapshotTableHelper.hpp>
 #include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
 #include <rmol/bom/HistoricalBooking.hpp>
 #include <rmol/bom/EMDetruncator.hpp>
 #include <rmol/command/OldQFF.hpp>
@@ -32,7 +37,9 @@ namespace RMOL {
             const stdair::Date_T& iCurrentDate,
             const stdair::DTD_T& iCurrentDTD,
             const stdair::UnconstrainingMethod& iUnconstrainingMethod,
-            const stdair::NbOfSegments_T& iNbOfDepartedSegments) {
+            const stdair::NbOfSegments_T& iNbOfDepartedSegments,
+            HistoricalBookingWindowHolder& ioHBWindowHolder,
+            const unsigned int iNbOfThreads) {
     // Retrieve the snapshot table.
     const stdair::SegmentSnapshotTable& lSegmentSnapshotTable =
       ioSegmentCabin.getSegmentSnapshotTable();
@@ -50,8 +57,13 @@ namespace RMOL {
     // and the dispatching curves.
     const stdair::BookingClassList_T& lBCList =
       stdair::BomManager::getList<stdair::BookingClass>(ioSegmentCabin);
-    const stdair::BookingClassSellUpCurveMap_T lBCSellUpCurveMap =
-      Utilities::computeSellUpFactorCurves (lFRAT5Curve, lBCList);
+    ClassCurveMatrix lSellUpCurves;
+    lSellUpCurves.buildSellUpCurves (lFRAT5Curve, lBCList);
+
+    // The Q-equivalent bookings held by the windows depend on the sell-up
+    // curves, which version them.
+    const std::string lSeriesKey = "Old QFF " + ioSegmentCabin.describeKey();
+    const std::string lSeriesVersion = lSellUpCurves.describeFactors();
 
     // Retrieve the list of all policies and reset the demand forecast
     // for each one.
@@ -64,70 +76,81 @@ namespace RMOL {
       lPolicy_ptr->resetDemandForecast();
     }
 
-    // Browse all remaining DCP's and do unconstraining, forecasting
-    // and dispatching.
-    const stdair::DCPList_T lWholeDCPList = stdair::DEFAULT_DCP_LIST;
-    stdair::DCPList_T::const_iterator itDCP = lWholeDCPList.begin();
-    stdair::DCPList_T::const_iterator itNextDCP = itDCP; ++itNextDCP;
-    for (; itNextDCP != lWholeDCPList.end(); ++itDCP, ++itNextDCP) {
-      const stdair::DCP_T& lCurrentDCP = *itDCP;
-      const stdair::DCP_T& lNextDCP = *itNextDCP;
+    // Browse all remaining DCP's and gather the historical bookings of
+    // each DCP interval, so that they can be unconstrained all at once.
+    HistoricalBookingMatrix lHBMatrix;
+    const DCPIndex_T lFirstIntervalIdx =
+      DCPCalendar::getIntervalIndex (iCurrentDTD);
+    for (DCPIndex_T lIntervalIdx = lFirstIntervalIdx;
+         lIntervalIdx < DCPCalendar::getNbOfIntervals(); ++lIntervalIdx) {
+      const stdair::DCP_T& lCurrentDCP =
+        DCPCalendar::getIntervalBegin (lIntervalIdx);
+      const stdair::DCP_T& lNextDCP =
+        DCPCalendar::getIntervalEnd (lIntervalIdx);
 
-      // The end of the interval is after the current DTD.
-      if (lNextDCP < iCurrentDTD) {
-        // Get the number of similar segments which has already passed the
-        // (lNextDCP+1)
-        const stdair::NbOfSegments_T& lNbOfUsableSegments =
-          SegmentSnapshotTableHelper::
-          getNbOfSegmentAlreadyPassedThisDTD (lSegmentSnapshotTable,
-                                              lNextDCP+1,
-                                              iCurrentDate);
-        stdair::NbOfSegments_T lSegmentBegin = 0;
-        const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
-        if (iNbOfDepartedSegments > 52) {
-          lSegmentBegin = iNbOfDepartedSegments - 52;
-        }
-        
-        // Retrieve the historical bookings and convert them to
-        // Q-equivalent bookings.
-        HistoricalBookingHolder lHBHolder;
-        prepareHistoricalBooking (ioSegmentCabin, lSegmentSnapshotTable,
-                                  lHBHolder, lCurrentDCP, lNextDCP,
-                                  lSegmentBegin, lSegmentEnd,
-                                  lBCSellUpCurveMap);
+      // Get the number of similar segments which has already passed the
+      // (lNextDCP+1)
+      const stdair::NbOfSegments_T& lNbOfUsableSegments =
+        SegmentSnapshotTableHelper::
+        getNbOfSegmentAlreadyPassedThisDTD (lSegmentSnapshotTable,
+                                            lNextDCP+1,
+                                            iCurrentDate);
+      stdair::NbOfSegments_T lSegmentBegin = 0;
+      const stdair::NbOfSegments_T lSegmentEnd = lNbOfUsableSegments-1;
+      const stdair::NbOfSegments_T lWindowSize =
+        ioHBWindowHolder.getWindowSize();
+      if (iNbOfDepartedSegments > lWindowSize) {
+        lSegmentBegin = iNbOfDepartedSegments - lWindowSize;
+      }
+      
+      // Retrieve the historical bookings and convert them to
+      // Q-equivalent bookings. Only the similar segments which have
+      // passed the DCP interval since the previous forecast are read
+      // from the snapshot table.
+      HistoricalBookingHolder lHBHolder;
+      ioHBWindowHolder.
+        prepareHistoricalBooking (ioSegmentCabin, lSeriesKey, lSeriesVersion,
+                                  lCurrentDCP, lSegmentBegin, lSegmentEnd,
+                                  [&] (HistoricalBookingHolder& ioHBHolder,
+                                       const stdair::NbOfSegments_T& iBegin,
+                                       const stdair::NbOfSegments_T& iEnd) {
+                                    prepareHistoricalBooking
+                                      (ioSegmentCabin, lSegmentSnapshotTable,
+                                       ioHBHolder, lCurrentDCP, lNextDCP,
+                                       iBegin, iEnd, lSellUpCurves);
+                                  },
+                                  lHBHolder);
 
-        // Unconstrain the historical bookings.
-        Detruncator::unconstrain (lHBHolder, iUnconstrainingMethod);
+      lHBMatrix.addSeries (lHBHolder);
+    }
 
-        // Retrieve the historical unconstrained demand and perform the
-        // forecasting.
-        stdair::UncDemVector_T lUncDemVector;
-        const short lNbOfHistoricalFlights = lHBHolder.getNbOfFlights();
-        for (short i = 0; i < lNbOfHistoricalFlights; ++i) {
-          const stdair::NbOfBookings_T& lUncDemand =
-            lHBHolder.getUnconstrainedDemand (i);
-          lUncDemVector.push_back (lUncDemand);
-        }
-        stdair::MeanValue_T lMean = 0.0;
-        stdair::StdDevValue_T lStdDev = 0.0;
-        Utilities::computeDistributionParameters (lUncDemVector,
-                                                  lMean, lStdDev);
+    // Unconstrain the historical bookings of all the DCP intervals.
+    Detruncator::unconstrain (lHBMatrix, iUnconstrainingMethod,
+                              iNbOfThreads);
 
-        // Add the demand forecast to the fare family.
-        const stdair::MeanValue_T& lCurrentMean = lFF_ptr->getMean();
-        const stdair::StdDevValue_T& lCurrentStdDev = lFF_ptr->getStdDev();
+    // Browse the DCP intervals and do the forecasting and dispatching.
+    for (SeriesIndex_T lSeries = 0; lSeries < lHBMatrix.getNbOfSeries();
+         ++lSeries) {
+      const stdair::DCP_T& lCurrentDCP =
+        DCPCalendar::getIntervalBegin (lFirstIntervalIdx + lSeries);
+      const stdair::MeanValue_T& lMean = lHBMatrix.getDemandMean (lSeries);
+      const stdair::StdDevValue_T& lStdDev =
+        lHBMatrix.getStandardDeviation (lSeries);
 
-        const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
-        const stdair::StdDevValue_T lNewStdDev = 
-          std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
+      // Add the demand forecast to the fare family.
+      const stdair::MeanValue_T& lCurrentMean = lFF_ptr->getMean();
+      const stdair::StdDevValue_T& lCurrentStdDev = lFF_ptr->getStdDev();
 
-        lFF_ptr->setMean (lNewMean);
-        lFF_ptr->setStdDev (lNewStdDev);
+      const stdair::MeanValue_T lNewMean = lCurrentMean + lMean;
+      const stdair::StdDevValue_T lNewStdDev = 
+        std::sqrt (lCurrentStdDev * lCurrentStdDev + lStdDev * lStdDev);
+
+      lFF_ptr->setMean (lNewMean);
+      lFF_ptr->setStdDev (lNewStdDev);
  
-        // Dispatch the demand forecast to the policies.
-        dispatchDemandForecastToPolicies (lPolicyList, lCurrentDCP, lMean,
-                                          lStdDev, lBCSellUpCurveMap);
-      }
+      // Dispatch the demand forecast to the policies.
+      dispatchDemandForecastToPolicies (lPolicyList, lCurrentDCP, lMean,
+                                        lStdDev, lSellUpCurves);
     }
 
     return true;
@@ -141,7 +164,7 @@ namespace RMOL {
    const stdair::DCP_T& iDCPBegin, const stdair::DCP_T& iDCPEnd,
    const stdair::NbOfSegments_T& iSegmentBegin,
    const stdair::NbOfSegments_T& iSegmentEnd,
-   const stdair::BookingClassSellUpCurveMap_T& iBCSellUpCurveMap) {
+   const ClassCurveMatrix& iSellUpCurves) {
     
     // Retrieve the segment-cabin index within the snapshot table
     std::ostringstream lSCMapKey;
@@ -158,6 +181,20 @@ namespace RMOL {
     const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lAvlView =
       iSegmentSnapshotTable.getConstSegmentCabinDTDRangeAvailabilitySnapshotView (iSegmentBegin, iSegmentEnd, iDCPEnd, iDCPBegin);
     
+    // Retrieve the sell-up factors of the DCP interval, and the indices
+    // of the booking classes within the snapshot table.
+    const DCPIndex_T lDCPIndex = DCPCalendar::getDCPIndex (iDCPBegin);
+    const double* lSellUpList = iSellUpCurves.getFactorList (lDCPIndex);
+    const unsigned int lNbOfBCs = iSellUpCurves.getNbOfClasses();
+    std::vector<stdair::ClassIndex_T> lClassIdxList;
+    lClassIdxList.reserve (lNbOfBCs);
+    for (unsigned int c = 0; c < lNbOfBCs; ++c) {
+      const stdair::BookingClass& lBookingClass =
+        iSellUpCurves.getBookingClass (c);
+      lClassIdxList.push_back (iSegmentSnapshotTable.
+                               getClassIndex (lBookingClass.describeKey()));
+    }
+
     // Browse the list of segments and build the historical booking holder.
     const stdair::ClassIndexMap_T& lVTIdxMap =
       iSegmentSnapshotTable.getClassIndexMap();
@@ -181,41 +218,28 @@ namespace RMOL {
 
       // Compute the Q-equivalent bookings
       stdair::NbOfBookings_T lNbOfHistoricalBkgs = 0.0;
-      const stdair::BookingClassList_T& lBCList =
-        stdair::BomManager::getList<stdair::BookingClass> (iSegmentCabin);
       for (short j = 0; j < lNbOfDTDs; ++j) {
-        stdair::BookingClass* lLowestBC_ptr = NULL;
+        unsigned int lLowestBCIdx = lNbOfBCs;
         stdair::NbOfBookings_T lNbOfBksOfTheDay = 0.0;
-        for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
-             itBC != lBCList.end(); ++itBC) {
-          stdair::BookingClass* lBC_ptr = *itBC;
-          assert (lBC_ptr != NULL);
-          
+        for (unsigned int c = 0; c < lNbOfBCs; ++c) {
           // Retrieve the number of bookings
-          const stdair::ClassIndex_T& lClassIdx =
-            iSegmentSnapshotTable.getClassIndex(lBC_ptr->describeKey());
+          const stdair::ClassIndex_T& lClassIdx = lClassIdxList[c];
           const stdair::UnsignedIndex_T lIdx = i*lNbOfClasses + lClassIdx;
           const stdair::NbOfBookings_T lNbOfBookings =
             lPriceBookingView[lIdx][j] + lProductBookingView[lIdx][j];
           lNbOfBksOfTheDay += lNbOfBookings;
 
           if (lAvlView[lIdx][j] >= 1.0) {
-            lLowestBC_ptr = lBC_ptr;
+            lLowestBCIdx = c;
           }
         }
 
         // Convert the number of bookings of the day to Q-equivalent
         // bookings using the sell-up probability of the lowest class
         // available of the day.
-        if (lLowestBC_ptr != NULL) {
-          stdair::BookingClassSellUpCurveMap_T::const_iterator itBCSUC =
-             iBCSellUpCurveMap.find (lLowestBC_ptr);
-          assert (itBCSUC != iBCSellUpCurveMap.end());
-          const stdair::SellUpCurve_T& lSellUpCurve = itBCSUC->second;
-          stdair::SellUpCurve_T::const_iterator itSellUp =
-            lSellUpCurve.find (iDCPBegin);
-          assert (itSellUp != lSellUpCurve.end());
-          const stdair::SellupProbability_T& lSellUp = itSellUp->second;
+        if (lLowestBCIdx < lNbOfBCs) {
+          const stdair::SellupProbability_T& lSellUp =
+            lSellUpList[lLowestBCIdx];
           assert (lSellUp != 0);
           
           lNbOfHistoricalBkgs += lNbOfBksOfTheDay/lSellUp;          
@@ -233,7 +257,7 @@ namespace RMOL {
                                     const stdair::DCP_T& iCurrentDCP,
                                     const stdair::MeanValue_T& iMean,
                                     const stdair::StdDevValue_T& iStdDev,
-                                    const stdair::BookingClassSellUpCurveMap_T& iBCSellUpCurveMap) {
+                                    const ClassCurveMatrix& iSellUpCurves) {
     for (stdair::PolicyList_T::const_iterator itPolicy = iPolicyList.begin();
          itPolicy != iPolicyList.end(); ++itPolicy) {
       stdair::Policy* lPolicy_ptr = *itPolicy;
@@ -242,7 +266,7 @@ namespace RMOL {
                                       iCurrentDCP,
                                       iMean,
                                       iStdDev,
-                                      iBCSellUpCurveMap);
+                                      iSellUpCurves);
     }
   }
  
@@ -252,7 +276,7 @@ namespace RMOL {
                                   const stdair::DCP_T& iCurrentDCP,
                                   const stdair::MeanValue_T& iMean,
                                   const stdair::StdDevValue_T& iStdDev,
-                                  const stdair::BookingClassSellUpCurveMap_T& iBCSellUpCurveMap) {
+                                  const ClassCurveMatrix& iSellUpCurves) {
     const stdair::MeanValue_T& lPolicyDemand = ioPolicy.getDemand();
     const stdair::StdDevValue_T& lPolicyStdDev = ioPolicy.getStdDev();
 
@@ -270,14 +294,11 @@ namespace RMOL {
       assert (lLowestBC_ptr != NULL);
       const stdair::Yield_T& lLowestBCYield = lLowestBC_ptr->getYield();
       // Retrieve the sell-up factor for the lowest class.
-      stdair::BookingClassSellUpCurveMap_T::const_iterator itBCSU =
-        iBCSellUpCurveMap.find (lLowestBC_ptr);
-      assert (itBCSU != iBCSellUpCurveMap.end());
-      const stdair::SellUpCurve_T& lSellUpCurve = itBCSU->second;
-      stdair::SellUpCurve_T::const_iterator itSellUpFactor =
-        lSellUpCurve.find (iCurrentDCP);
-      assert (itSellUpFactor != lSellUpCurve.end());
-      const stdair::SellupProbability_T& lSUToLowestClass = itSellUpFactor->second;
+      const DCPIndex_T lCurrentDCPIndex =
+        DCPCalendar::getDCPIndex (iCurrentDCP);
+      const stdair::SellupProbability_T& lSUToLowestClass =
+        iSellUpCurves.getFactor (iSellUpCurves.getClassIndex (*lLowestBC_ptr),
+                                 lCurrentDCPIndex);
       
       const stdair::MeanValue_T lAdditinalPolicyDemandMean = 
         iMean * lSUToLowestClass;
@@ -316,14 +337,9 @@ namespace RMOL {
         const double& lDU = itDU->second;
         
         // Retrieve the sell-up factor for the next class.
-        stdair::BookingClassSellUpCurveMap_T::const_iterator itBCSUN =
-          iBCSellUpCurveMap.find (lNextBC_ptr);
-        assert (itBCSUN != iBCSellUpCurveMap.end());
-        const stdair::SellUpCurve_T& lSellUpCurveN = itBCSUN->second;
-        stdair::SellUpCurve_T::const_iterator itSellUpFactorN =
-          lSellUpCurveN.find (iCurrentDCP);
-        assert (itSellUpFactorN != lSellUpCurveN.end());
-        const stdair::SellupProbability_T& lSUToNextClass = itSellUpFactorN->second;
+        const stdair::SellupProbability_T& lSUToNextClass =
+          iSellUpCurves.getFactor (iSellUpCurves.getClassIndex (*lNextBC_ptr),
+                                   lCurrentDCPIndex);
         assert (lSUToNextClass > 0.0);
         assert(lSUToNextClass < lSUToLowestClass);
 
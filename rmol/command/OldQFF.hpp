@@ -11,6 +11,7 @@
 #include <stdair/bom/PolicyTypes.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -19,6 +20,10 @@ namespace stdair {
 }
 
 namespace RMOL {
+  // Forward declarations
+  struct HistoricalBookingWindowHolder;
+  struct ClassCurveMatrix;
+
   /** Class wrapping the forecasting algorithms. */
   class OldQFF {    
   public: 
@@ -30,11 +35,18 @@ namespace RMOL {
      * @param const stdair::DTD_T& Current DTD 
      * @param const stdair::UnconstrainingMethod& Method used for the unconstraining
      * @param const stdair::NbOfSegments_T& Number of usable historical segments
+     * @param HistoricalBookingWindowHolder& Sliding windows of the
+     *        historical bookings, kept from one forecast to the next
+     * @param const unsigned int Number of threads on which the historical
+     *        bookings are unconstrained
     */
     static bool forecast (stdair::SegmentCabin&, const stdair::Date_T&,
                           const stdair::DTD_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::NbOfSegments_T&);
+                          const stdair::NbOfSegments_T&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int iNbOfThreads =
+                          DEFAULT_NUMBER_OF_THREADS);
 
   private:
     /**
@@ -52,7 +64,7 @@ namespace RMOL {
                                           const stdair::DCP_T&,
                                           const stdair::NbOfSegments_T&,
                                           const stdair::NbOfSegments_T&,
-                                          const stdair::BookingClassSellUpCurveMap_T&);
+                                          const ClassCurveMatrix&);
 
     /**
      * Dispatch the demand forecast to the policies.
@@ -62,7 +74,7 @@ namespace RMOL {
                                       const stdair::DCP_T&,
                                       const stdair::MeanValue_T&, 
                                       const stdair::StdDevValue_T&,
-                                      const stdair::BookingClassSellUpCurveMap_T&);
+                                      const ClassCurveMatrix&);
 
     /**
      * Dispatch the demand forecast to the policy.
@@ -72,7 +84,7 @@ namespace RMOL {
                                     const stdair::DCP_T&,
                                     const stdair::MeanValue_T&,
                                     const stdair::StdDevValue_T&,
-                                    const stdair::BookingClassSellUpCurveMap_T&);
+                                    const ClassCurveMatrix&);
   };
 }
 #endif // __RMOL_COMMAND_OLDQFF_HPP
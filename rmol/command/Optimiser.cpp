@@ -4,6 +4,9 @@
 // STL
 #include <cassert>
 #include <sstream>
+#include <cmath>
+#include <map>
+#include <atomic>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/RandomGeneration.hpp>
@@ -17,10 +20,16 @@
 #include <stdair/bom/BookingClass.hpp>
 #include <stdair/service/Logger.hpp>
 // RMOL
+#include <rmol/OptimisationControl.hpp>
 #include <rmol/basic/BasConst_General.hpp>
 #include <rmol/bom/MCOptimiser.hpp>
 #include <rmol/bom/Emsr.hpp>
 #include <rmol/bom/DPOptimiser.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+#include <rmol/bom/NetworkLP.hpp>
+#include <rmol/bom/NetworkLPBasis.hpp>
+#include <rmol/bom/DualSimplex.hpp>
 #include <rmol/command/Optimiser.hpp>
 
 namespace RMOL {
@@ -82,7 +91,8 @@ namespace RMOL {
 
   // ////////////////////////////////////////////////////////////////////
   bool Optimiser::optimise (stdair::FlightDate& ioFlightDate,
-                            const stdair::OptimisationMethod& iOptimisationMethod) {
+                            const stdair::OptimisationMethod& iOptimisationMethod,
+                            OptimisationControl* ioControl_ptr) {
     bool optimiseSucceeded = false;
     // Browse the leg-cabin list and build the virtual class list for
     // each cabin.
@@ -92,7 +102,8 @@ namespace RMOL {
          itLD != lLDList.end(); ++itLD) {
       stdair::LegDate* lLD_ptr = *itLD;
       assert (lLD_ptr != NULL);
-      const bool isSucceeded = optimise(*lLD_ptr, iOptimisationMethod);
+      const bool isSucceeded =
+        optimise (*lLD_ptr, iOptimisationMethod, ioControl_ptr);
       // If at least one leg date is optimised, the optimisation is succeeded.
       if (isSucceeded == true) {
         optimiseSucceeded = true;
@@ -105,7 +116,8 @@ namespace RMOL {
   // ////////////////////////////////////////////////////////////////////
   bool Optimiser::
   optimise (stdair::LegDate& ioLegDate,
-            const stdair::OptimisationMethod& iOptimisationMethod) {
+            const stdair::OptimisationMethod& iOptimisationMethod,
+            OptimisationControl* ioControl_ptr) {
     bool optimiseSucceeded = false;
     // Browse the leg-cabin list 
     const stdair::LegCabinList_T& lLCList =
@@ -114,6 +126,12 @@ namespace RMOL {
          itLC != lLCList.end(); ++itLC) {
       stdair::LegCabin* lLC_ptr = *itLC;
       assert (lLC_ptr != NULL);
+      // Once a stop is requested, the remaining leg-cabins keep the
+      // result of their previous optimisation.
+      if (ioControl_ptr != NULL && ioControl_ptr->isStopRequested() == true) {
+        ioControl_ptr->setInterrupted();
+        break;
+      }
       const bool isSucceeded = optimise(*lLC_ptr, iOptimisationMethod);
       // If at least one leg cabin is optimised, the optimisation is succeeded.
       if (isSucceeded == true) {
@@ -268,14 +286,7 @@ namespace RMOL {
              itLC != lLCList.end(); ++itLC) {
           stdair::LegCabin* lLC_ptr = *itLC;
           assert (lLC_ptr != NULL);
-          MCOptimiser::optimisationByMCIntegration (*lLC_ptr);
-          const stdair::BidPrice_T& lCurrentBidPrice =
-            lLC_ptr->getCurrentBidPrice();
-          const stdair::BidPrice_T& lPreviousBidPrice =
-            lLC_ptr->getPreviousBidPrice();
-          assert (lPreviousBidPrice != 0);
-          const double lBPVariation =
-            std::abs((lCurrentBidPrice - lPreviousBidPrice)/lPreviousBidPrice);
+          const double lBPVariation = optimiseUsingOnDForecast (*lLC_ptr);
           lMaxBPVariation = std::max(lMaxBPVariation, lBPVariation);
         }
       }
@@ -283,4 +294,239 @@ namespace RMOL {
     return lMaxBPVariation;
   }
 
+  // ////////////////////////////////////////////////////////////////////
+  double Optimiser::
+  optimiseUsingOnDForecast (const std::vector<stdair::LegCabin*>& iLCList,
+                            const FlagVector_T& iActiveFlagList,
+                            const unsigned int iNbOfThreads) {
+    // Optimise the leg-cabins. Each task writes only its own variation.
+    const unsigned int lNbOfLegCabins = iLCList.size();
+    assert (iActiveFlagList.size() == lNbOfLegCabins);
+    std::vector<double> lBPVariationList (lNbOfLegCabins, 0.0);
+    ParallelLoop::run (lNbOfLegCabins,
+                       [&] (const unsigned int iLCIdx) {
+                         stdair::LegCabin* lLC_ptr = iLCList[iLCIdx];
+                         assert (lLC_ptr != NULL);
+                         lBPVariationList[iLCIdx] =
+                           (iActiveFlagList[iLCIdx] == true)
+                           ? optimiseUsingOnDForecast (*lLC_ptr)
+                           : reuseOptimisationUsingOnDForecast (*lLC_ptr);
+                       },
+                       iNbOfThreads);
+
+    double lMaxBPVariation = 0.0;
+    for (std::vector<double>::const_iterator itVariation =
+           lBPVariationList.begin();
+         itVariation != lBPVariationList.end(); ++itVariation) {
+      lMaxBPVariation = std::max (lMaxBPVariation, *itVariation);
+    }
+    return lMaxBPVariation;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double Optimiser::optimiseUsingOnDForecast (stdair::LegCabin& ioLegCabin) {
+    MCOptimiser::optimisationByMCIntegration (ioLegCabin);
+    return getBidPriceVariation (ioLegCabin);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double Optimiser::
+  reuseOptimisationUsingOnDForecast (stdair::LegCabin& ioLegCabin) {
+    // The Monte Carlo optimisation being deterministic, it would give the
+    // very same bid price vector: only update the bid prices.
+    const stdair::BidPriceVector_T& lBPV = ioLegCabin.getBidPriceVector();
+    assert (lBPV.empty() == false);
+    ioLegCabin.updatePreviousBidPrice();
+    ioLegCabin.setCurrentBidPrice (lBPV.back());
+    return getBidPriceVariation (ioLegCabin);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double Optimiser::getBidPriceVariation (const stdair::LegCabin& iLegCabin) {
+    const stdair::BidPrice_T& lCurrentBidPrice =
+      iLegCabin.getCurrentBidPrice();
+    const stdair::BidPrice_T& lPreviousBidPrice =
+      iLegCabin.getPreviousBidPrice();
+    assert (lPreviousBidPrice != 0);
+    return std::abs ((lCurrentBidPrice - lPreviousBidPrice)/lPreviousBidPrice);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool Optimiser::
+  optimiseUsingNetworkLP (const OnDIncidenceMatrix& iOnDIncidenceMatrix,
+                          const LegCabinImageTable& iLegCabinImageTable,
+                          const std::vector<stdair::OnDDate*>& iOnDDateList,
+                          const std::vector<stdair::FlightDate*>& iFDList,
+                          const stdair::NbOfSamples_T& iNbOfScenarios,
+                          const unsigned int iNbOfThreads,
+                          NetworkLPBasis& ioNetworkLPBasis,
+                          OptimisationControl* ioControl_ptr) {
+    // Build the deterministic linear program of the O&D-dates.
+    NetworkLP lNetworkLP;
+    lNetworkLP.build (iOnDIncidenceMatrix, iLegCabinImageTable, iOnDDateList);
+    const unsigned int lNbOfRows = lNetworkLP.getNbOfRows();
+
+    // Solve it, starting from the basis of the former programs.
+    FlagVector_T lBasicFlagList;
+    ioNetworkLPBasis.load (lNetworkLP, lBasicFlagList);
+    DualSimplex lDualSimplex;
+    const bool isOptimal =
+      lDualSimplex.solve (lNbOfRows,
+                          lNetworkLP.getColumnPointerList(),
+                          lNetworkLP.getRowIndexList(),
+                          lNetworkLP.getYieldList(),
+                          lNetworkLP.getMeanList(),
+                          lNetworkLP.getCapacityList(),
+                          lBasicFlagList, ioControl_ptr);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lNetworkLP.describe() << " " << lDualSimplex.describe());
+
+    if (lDualSimplex.isInterrupted() == true) {
+      assert (ioControl_ptr != NULL);
+      ioControl_ptr->setInterrupted();
+      return false;
+    }
+    if (isOptimal == false) {
+      return false;
+    }
+    ioNetworkLPBasis.save (lNetworkLP, lBasicFlagList);
+    std::vector<double> lDualList (lDualSimplex.getDualList());
+
+    // Randomised linear program: the shadow prices are averaged over the
+    // programs of the demand scenarios, each one being solved from the
+    // optimal basis of the deterministic program.
+    if (iNbOfScenarios > 0) {
+      // The scenarios are drawn serially, so that they do not depend on
+      // the number of threads.
+      const stdair::NbOfSamples_T& K = iNbOfScenarios;
+      std::vector<std::vector<double> > lDemandLists (K);
+      stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+      for (unsigned int k = 0; k < K; ++k) {
+        lNetworkLP.drawDemandList (lGenerator, lDemandLists[k]);
+      }
+
+      // Solve the programs of the scenarios. Each task writes only the
+      // shadow prices of its own scenario, which are left empty when the
+      // program could not be solved. Once a stop is requested, the
+      // remaining scenarios are skipped, and the average is given up (it
+      // would depend on the scenarios reached).
+      std::vector<std::vector<double> > lScenarioDualLists (K);
+      std::atomic<bool> lIsInterrupted (false);
+      ParallelLoop::run (K,
+                         [&] (const unsigned int k) {
+                           if (ioControl_ptr != NULL
+                               && ioControl_ptr->isStopRequested() == true) {
+                             lIsInterrupted.store (true);
+                             return;
+                           }
+                           FlagVector_T lScenarioBasicFlagList (lBasicFlagList);
+                           DualSimplex lScenarioDualSimplex;
+                           const bool isScenarioOptimal = lScenarioDualSimplex.
+                             solve (lNbOfRows, lNetworkLP.getColumnPointerList(),
+                                    lNetworkLP.getRowIndexList(),
+                                    lNetworkLP.getYieldList(), lDemandLists[k],
+                                    lNetworkLP.getCapacityList(),
+                                    lScenarioBasicFlagList, ioControl_ptr);
+                           if (lScenarioDualSimplex.isInterrupted() == true) {
+                             lIsInterrupted.store (true);
+                           } else if (isScenarioOptimal == true) {
+                             lScenarioDualLists[k] =
+                               lScenarioDualSimplex.getDualList();
+                           }
+                         },
+                         iNbOfThreads);
+      if (lIsInterrupted.load() == true) {
+        assert (ioControl_ptr != NULL);
+        ioControl_ptr->setInterrupted();
+        return false;
+      }
+
+      // Average the shadow prices, in the order of the scenarios.
+      std::vector<double> lDualSumList (lNbOfRows, 0.0);
+      unsigned int lNbOfSolvedScenarios = 0;
+      for (unsigned int k = 0; k < K; ++k) {
+        const std::vector<double>& lScenarioDualList = lScenarioDualLists[k];
+        if (lScenarioDualList.empty() == true && lNbOfRows > 0) {
+          continue;
+        }
+        ++lNbOfSolvedScenarios;
+        for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+          lDualSumList[lRowIdx] += lScenarioDualList[lRowIdx];
+        }
+      }
+
+      // DEBUG
+      STDAIR_LOG_DEBUG ("Randomised LP: " << lNbOfSolvedScenarios << " out of "
+                        << K << " scenarios solved");
+
+      if (lNbOfSolvedScenarios == 0) {
+        return false;
+      }
+      for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+        lDualList[lRowIdx] = lDualSumList[lRowIdx] / lNbOfSolvedScenarios;
+      }
+    }
+
+    // Shadow prices of the leg-cabin capacities.
+    typedef std::map<const stdair::LegCabin*, double> LegCabinDualMap_T;
+    LegCabinDualMap_T lLegCabinDualMap;
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      lLegCabinDualMap[&lNetworkLP.getLegCabin (lRowIdx)] = lDualList[lRowIdx];
+    }
+
+    // Set the bid prices of the leg-cabins of the flight-dates. The
+    // minimal bid price is 1.0 (just to avoid problems of division by
+    // zero), as with the Monte Carlo optimisation.
+    const stdair::BidPrice_T lMinBP = 1.0;
+    for (std::vector<stdair::FlightDate*>::const_iterator itFD =
+           iFDList.begin(); itFD != iFDList.end(); ++itFD) {
+      const stdair::FlightDate* lFD_ptr = *itFD;
+      assert (lFD_ptr != NULL);
+      const bool hasLegDateList =
+        stdair::BomManager::hasList<stdair::LegDate> (*lFD_ptr);
+      if (hasLegDateList == false) {
+        continue;
+      }
+      const stdair::LegDateList_T& lLDList =
+        stdair::BomManager::getList<stdair::LegDate> (*lFD_ptr);
+      for (stdair::LegDateList_T::const_iterator itLD = lLDList.begin();
+           itLD != lLDList.end(); ++itLD) {
+        const stdair::LegDate* lLD_ptr = *itLD;
+        assert (lLD_ptr != NULL);
+        const stdair::LegCabinList_T& lLCList =
+          stdair::BomManager::getList<stdair::LegCabin> (*lLD_ptr);
+        for (stdair::LegCabinList_T::const_iterator itLC = lLCList.begin();
+             itLC != lLCList.end(); ++itLC) {
+          stdair::LegCabin* lLC_ptr = *itLC;
+          assert (lLC_ptr != NULL);
+          stdair::BidPrice_T lBidPrice = lMinBP;
+          LegCabinDualMap_T::const_iterator itDual =
+            lLegCabinDualMap.find (lLC_ptr);
+          if (itDual != lLegCabinDualMap.end()) {
+            lBidPrice = std::max (lMinBP, itDual->second);
+          }
+          setBidPrice (*lLC_ptr, lBidPrice);
+        }
+      }
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void Optimiser::setBidPrice (stdair::LegCabin& ioLegCabin,
+                               const stdair::BidPrice_T& iBidPrice) {
+    // The bid price vector holds (at least) one bid price by available
+    // seat, as with the Monte Carlo optimisation.
+    const stdair::Availability_T& lAvailabilityPool =
+      ioLegCabin.getAvailabilityPool();
+    const unsigned int lNbOfSeats =
+      std::max (1.0, std::floor (lAvailabilityPool));
+    ioLegCabin.emptyBidPriceVector();
+    stdair::BidPriceVector_T& lBPV = ioLegCabin.getBidPriceVector();
+    lBPV.assign (lNbOfSeats, iBidPrice);
+    ioLegCabin.updatePreviousBidPrice();
+    ioLegCabin.setCurrentBidPrice (iBidPrice);
+  }
+
 }
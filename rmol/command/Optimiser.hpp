@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
 // STDAIR
 #include <stdair/basic/OptimisationMethod.hpp>
 // RMOL
@@ -13,9 +15,17 @@
 namespace stdair {
   class FlightDate;
   class LegCabin;
+  class OnDDate;
 }
 
 namespace RMOL {
+
+  // Forward declarations
+  struct OnDIncidenceMatrix;
+  struct LegCabinImageTable;
+  struct NetworkLPBasis;
+  class OptimisationControl;
+
   /** Class wrapping the optimisation algorithms. */
   class Optimiser {
   public:
@@ -56,9 +66,12 @@ namespace RMOL {
 
     /**
        Optimise a flight-date using leg-based Monte Carlo Integration.
+       <br>When a control is given, it is checked before each leg-cabin:
+       once a stop is requested, the remaining leg-cabins are left as is.
     */
     static bool optimise (stdair::FlightDate&,
-                          const stdair::OptimisationMethod&);
+                          const stdair::OptimisationMethod&,
+                          OptimisationControl* ioControl_ptr = NULL);
 
     /**
      * Build the virtual class list for the given leg-cabin.
@@ -69,18 +82,107 @@ namespace RMOL {
     static double optimiseUsingOnDForecast (stdair::FlightDate&,
                                             const bool& iReduceFluctuations = false);
 
+    /**
+     * Optimise the given leg-cabins, using the O&D forecast projected on
+     * them, and return the maximal relative variation of their bid prices.
+     *
+     * Only the active leg-cabins (see BidPriceActiveSet) are optimised
+     * again: the demand of the other ones did not change since their last
+     * optimisation, so that their bid price vector is kept as is, and only
+     * their bid prices are updated.
+     *
+     * The leg-cabins are optimised concurrently: each one only reads its
+     * own demand (projected from the bid prices of the previous network
+     * iteration) and writes its own bid prices, so that the result does
+     * not depend on the number of threads.
+     *
+     * The sweep is not interrupted once started, so that the bid prices
+     * of the leg-cabins all come from the same network iteration: a
+     * control, if any, is to be checked between the sweeps.
+     */
+    static double
+    optimiseUsingOnDForecast (const std::vector<stdair::LegCabin*>&,
+                              const FlagVector_T& iActiveFlagList,
+                              const unsigned int iNbOfThreads);
+
+    /**
+     * Optimise the network using the deterministic linear program (see
+     * NetworkLP) of the given O&D-dates, and return whether it was solved
+     * to optimality.
+     *
+     * The program is solved by the dual simplex (see DualSimplex),
+     * starting from the basis of the former programs (warm start), which
+     * is then updated. The leg-cabins of the given flight-dates get the
+     * shadow prices of their capacities as bid prices, over their whole
+     * bid price vector; those which are not travelled by any product get
+     * the minimal bid price. The code-share products travel the real
+     * leg-cabins of the images (see NetworkLP), the bid prices of which
+     * are then to be sent to the partners. The bid prices are left
+     * untouched when the program could not be solved.
+     *
+     * With demand scenarios, the shadow prices are the averages of those
+     * of the programs of the scenarios (randomised linear program). The
+     * scenarios are drawn from the O&D forecasts, and their programs are
+     * solved concurrently, from the optimal basis of the deterministic
+     * program, so that the result does not depend on the number of
+     * threads.
+     *
+     * When a control is given, it is checked within the dual simplex and
+     * before each scenario: once a stop is requested, the bid prices are
+     * left untouched, and the control records the interruption.
+     *
+     * @param const stdair::NbOfSamples_T& Number of demand scenarios (none
+     *        for the deterministic linear program).
+     * @param const unsigned int Number of threads.
+     */
+    static bool
+    optimiseUsingNetworkLP (const OnDIncidenceMatrix&,
+                            const LegCabinImageTable&,
+                            const std::vector<stdair::OnDDate*>&,
+                            const std::vector<stdair::FlightDate*>&,
+                            const stdair::NbOfSamples_T& iNbOfScenarios,
+                            const unsigned int iNbOfThreads,
+                            NetworkLPBasis&,
+                            OptimisationControl* ioControl_ptr = NULL);
+
   private:
     /**
        Optimise a leg-date using leg-based Monte Carlo Integration.
     */
     static bool optimise (stdair::LegDate&,
-                          const stdair::OptimisationMethod&);
+                          const stdair::OptimisationMethod&,
+                          OptimisationControl* ioControl_ptr);
     /**
        Optimise a leg-cabin using leg-based Monte Carlo Integration.
     */
     static bool optimise (stdair::LegCabin&,
                           const stdair::OptimisationMethod&);
 
+    /**
+       Optimise a leg-cabin using the O&D forecast projected on it, and
+       return the relative variation of its bid price.
+    */
+    static double optimiseUsingOnDForecast (stdair::LegCabin&);
+
+    /**
+       Update the bid prices of a leg-cabin the demand of which did not
+       change since its last optimisation, as that optimisation would, and
+       return the relative variation of its bid price.
+    */
+    static double reuseOptimisationUsingOnDForecast (stdair::LegCabin&);
+
+    /**
+       Get the relative variation between the previous and the current
+       bid prices of a leg-cabin.
+    */
+    static double getBidPriceVariation (const stdair::LegCabin&);
+
+    /**
+       Set the given bid price over the whole bid price vector of a
+       leg-cabin, and make it its current bid price.
+    */
+    static void setBidPrice (stdair::LegCabin&, const stdair::BidPrice_T&);
+
 
   };
 }
@@ -8,6 +8,7 @@
 #include <stdair/stdair_inventory_types.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/basic/BasConst_General.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -18,6 +19,8 @@ namespace stdair {
 namespace RMOL {
   // Forward declarations
   struct HistoricalBookingHolder;
+  struct HistoricalBookingWindowHolder;
+  struct ClassCurveMatrix;
   
   /** Class wrapping the optimisation algorithms. */
   class QForecasting {    
@@ -27,11 +30,18 @@ namespace RMOL {
      *
      * @param const stdair::Date_T& Current Date
      * @param const stdair::NbOfSegments_T& Number of usable historical segments
+     * @param HistoricalBookingWindowHolder& Sliding windows of the
+     *        historical bookings, kept from one forecast to the next
+     * @param const unsigned int Number of threads on which the historical
+     *        bookings are unconstrained
     */
     static bool forecast (stdair::SegmentCabin&,
                           const stdair::Date_T&, const stdair::DTD_T&,
                           const stdair::UnconstrainingMethod&,
-                          const stdair::NbOfSegments_T&);
+                          const stdair::NbOfSegments_T&,
+                          HistoricalBookingWindowHolder&,
+                          const unsigned int iNbOfThreads =
+                          DEFAULT_NUMBER_OF_THREADS);
     
     /**
      * Prepare the historical price-oriented booking figures for a given cabin
@@ -45,7 +55,7 @@ namespace RMOL {
     (const stdair::SegmentCabin&, const stdair::SegmentSnapshotTable&,
      HistoricalBookingHolder&, const stdair::DCP_T&, const stdair::DCP_T&,
      const stdair::NbOfSegments_T&, const stdair::NbOfSegments_T&,
-     const stdair::BookingClassSellUpCurveMap_T&);
+     const ClassCurveMatrix&);
   };
 }
 #endif // __RMOL_COMMAND_QFORECASTING_HPP
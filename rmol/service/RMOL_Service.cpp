@@ -3,12 +3,15 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <future>
 // Boost
 #include <boost/make_shared.hpp>
 // StdAir
 #include <stdair/stdair_inventory_types.hpp>
 #include <stdair/basic/BasChronometer.hpp>
-#include <stdair/basic/ContinuousAttributeLite.hpp>
 #include <stdair/bom/BomManager.hpp>
 #include <stdair/bom/BomRetriever.hpp>
 #include <stdair/bom/BomRoot.hpp>
@@ -35,7 +38,18 @@
 #include <stdair/service/Logger.hpp>
 #include <stdair/STDAIR_Service.hpp>
 // RMOL
+#include <rmol/basic/BasConst_General.hpp>
 #include <rmol/basic/BasConst_RMOL_Service.hpp>
+#include <rmol/bom/DCPEventIndex.hpp>
+#include <rmol/bom/BidPriceActiveSet.hpp>
+#include <rmol/bom/BidPriceAccelerator.hpp>
+#include <rmol/bom/LegCabinImageTable.hpp>
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+#include <rmol/bom/NetworkIterationReport.hpp>
+#include <rmol/bom/NetworkLPBasis.hpp>
+#include <rmol/bom/YieldFeaturesIndex.hpp>
+#include <rmol/bom/OnDForecastTable.hpp>
+#include <rmol/bom/ParallelLoop.hpp>
 #include <rmol/factory/FacRmolServiceContext.hpp>
 #include <rmol/command/InventoryParser.hpp>
 #include <rmol/command/Optimiser.hpp>
@@ -43,27 +57,339 @@
 #include <rmol/command/Forecaster.hpp>
 #include <rmol/service/RMOL_ServiceContext.hpp>
 #include <rmol/RMOL_Service.hpp>
+#include <rmol/LegOptimiser.hpp>
+#include <rmol/OptimisationControl.hpp>
 
 namespace RMOL {
 
+  namespace {
+
+    /**
+     * Lock serialising the accesses to the shared state of the service
+     * (see the documentation of RMOL_Service).
+     */
+    typedef std::lock_guard<std::recursive_mutex> ServiceLock_T;
+
+    /**
+     * Demand of an O&D-date prorated onto a leg-cabin.
+     */
+    struct LegCabinDemand {
+      /** Leg-cabin receiving the demand. */
+      stdair::LegCabin* _legCabin;
+
+      /** Prorated yield. */
+      stdair::Yield_T _yield;
+
+      /** Mean of the demand. */
+      stdair::MeanValue_T _mean;
+
+      /** Standard deviation of the demand. */
+      stdair::StdDevValue_T _stdDev;
+    };
+
+    /** List of prorated demands. */
+    typedef std::vector<LegCabinDemand> LegCabinDemandList_T;
+
+    /**
+     * Methods projecting the O&D demand onto the leg-cabins.
+     */
+    typedef enum {
+      /** Yield of the booking class, equally distributed over the legs. */
+      PROJECTION_AGGREGATED = 0,
+      /** O&D yield, equally distributed over the segments and legs. */
+      PROJECTION_YP,
+      /** Displacement-adjusted yield (O&D yield minus the bid prices of
+          the other segments). */
+      PROJECTION_DA,
+      /** O&D yield, prorated with the bid prices of the legs. */
+      PROJECTION_DYP
+    } DemandProjectionMethod_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Prorate the demand of the given O&D-date onto the operated
+     * leg-cabins, with the given method. The bid prices are given by
+     * leg-cabin (column) and by segment-cabin (row) of the incidence
+     * matrix, so that several O&D-dates can be prorated concurrently.
+     */
+    void prorateOnDDemand (const OnDIncidenceMatrix& iOnDIncidenceMatrix,
+                           const DemandProjectionMethod_T& iMethod,
+                           const std::vector<stdair::BidPrice_T>& iBidPriceList,
+                           const std::vector<stdair::BidPrice_T>& iRowBidPriceList,
+                           const stdair::OnDDate& iOnDDate,
+                           LegCabinDemandList_T& ioLegCabinDemandList) {
+      const stdair::NbOfSegments_T& lNbOfSegments = iOnDDate.getNbOfSegments();
+      // Sanity check
+      assert (iOnDIncidenceMatrix.getNbOfSegments (iOnDDate) == lNbOfSegments);
+      const unsigned int lFirstSegmentIdx =
+        iOnDIncidenceMatrix.getFirstSegmentIndex (iOnDDate);
+      std::vector<unsigned int> lRowIndexList (lNbOfSegments);
+
+      // Browse the demand info map.
+      const stdair::StringDemandStructMap_T& lStringDemandStructMap =
+        iOnDDate.getDemandInfoMap ();
+      for (stdair::StringDemandStructMap_T::const_iterator itStrDS = lStringDemandStructMap.begin();
+           itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
+        const std::string& lCabinClassPath = itStrDS->first;
+        const stdair::YieldDemandPair_T& lYieldDemandPair = itStrDS->second;
+        const stdair::CabinClassPairList_T& lCabinClassPairList =
+          iOnDDate.getCabinClassPairList(lCabinClassPath);
+        // Sanity check
+        assert (lCabinClassPairList.size() == lNbOfSegments);
+        const stdair::Yield_T& lOnDYield = lYieldDemandPair.first;
+        const stdair::MeanStdDevPair_T& lMeanStdDevPair =
+          lYieldDemandPair.second;
+        const stdair::MeanValue_T& lMeanValue = lMeanStdDevPair.first;
+        const stdair::StdDevValue_T& lStdDevValue = lMeanStdDevPair.second;
+
+        // Retrieve the (operating) segment-cabins of the path, along with
+        // the sum of their bid prices.
+        stdair::BidPrice_T lTotalBidPrice = 0;
+        stdair::CabinClassPairList_T::const_iterator itCCP =
+          lCabinClassPairList.begin();
+        for (unsigned int idx = 0; idx < lNbOfSegments; ++idx, ++itCCP) {
+          const stdair::CabinCode_T& lCabinCode = itCCP->first;
+          const unsigned int lRowIdx =
+            iOnDIncidenceMatrix.getRowIndex (lFirstSegmentIdx + idx,
+                                             lCabinCode);
+          lRowIndexList[idx] = lRowIdx;
+          if (iMethod == PROJECTION_DA) {
+            lTotalBidPrice += iRowBidPriceList[lRowIdx];
+          } else if (iMethod == PROJECTION_DYP) {
+            for (unsigned int lPos = iOnDIncidenceMatrix.getRowBegin (lRowIdx);
+                 lPos < iOnDIncidenceMatrix.getRowEnd (lRowIdx); ++lPos) {
+              lTotalBidPrice +=
+                iBidPriceList[iOnDIncidenceMatrix.getColumnIndex (lPos)];
+            }
+          }
+        }
+
+        // Only operated legs receive the demand information.
+        itCCP = lCabinClassPairList.begin();
+        for (unsigned int idx = 0; idx < lNbOfSegments; ++idx, ++itCCP) {
+          const unsigned int lRowIdx = lRowIndexList[idx];
+          if (iOnDIncidenceMatrix.isOperated (lRowIdx) == false) {
+            continue;
+          }
+          const unsigned int lRowBegin = iOnDIncidenceMatrix.getRowBegin (lRowIdx);
+          const unsigned int lRowEnd = iOnDIncidenceMatrix.getRowEnd (lRowIdx);
+          const int lNbOfLegs = lRowEnd - lRowBegin;
+          assert (lNbOfLegs > 0);
+
+          // Determine the yield of the segment-cabin (not used by the
+          // dynamic yield proration, which prorates it by leg).
+          stdair::Yield_T lYield = 0.0;
+          switch (iMethod) {
+          case PROJECTION_AGGREGATED: {
+            // Retrieve the booking class (level of aggregation of demand).
+            // The yield of the class is assigned to all types of demand for it.
+            const stdair::ClassCode_T& lClassCode = itCCP->second;
+            const stdair::SegmentCabin& lSegmentCabin =
+              iOnDIncidenceMatrix.getSegmentCabin (lRowIdx);
+            const stdair::BookingClass* lBookingClass_ptr =
+              stdair::BomManager::getObjectPtr<stdair::BookingClass> (lSegmentCabin,
+                                                                      lClassCode);
+            assert (lBookingClass_ptr != NULL);
+            // Determine the yield (equally distributed over legs).
+            lYield = lBookingClass_ptr->getYield()/lNbOfLegs;
+            break;
+          }
+          case PROJECTION_YP: {
+            // Determine the yield (equally distributed over segments and then legs).
+            lYield = lOnDYield/(lNbOfLegs*lNbOfSegments);
+            break;
+          }
+          case PROJECTION_DA: {
+            // Determine the displacement-adjusted yield.
+            // It is set to 100 (positive small value), if the computed value is negative.
+            const stdair::BidPrice_T lComplementaryBidPrice =
+              lTotalBidPrice - iRowBidPriceList[lRowIdx];
+            lYield = std::max(100., lOnDYield - lComplementaryBidPrice);
+            break;
+          }
+          case PROJECTION_DYP:
+            break;
+          default:
+            assert (false);
+            break;
+          }
+
+          for (unsigned int lPos = lRowBegin; lPos < lRowEnd; ++lPos) {
+            const unsigned int lColIdx =
+              iOnDIncidenceMatrix.getColumnIndex (lPos);
+            if (iMethod == PROJECTION_DYP) {
+              const stdair::BidPrice_T& lBidPrice = iBidPriceList[lColIdx];
+              const stdair::RealNumber_T lDynamicYieldProrationFactor = lBidPrice / lTotalBidPrice;
+              lYield = lDynamicYieldProrationFactor*lOnDYield;
+            }
+            const LegCabinDemand lLegCabinDemand =
+              { &iOnDIncidenceMatrix.getLegCabin (lColIdx), lYield,
+                lMeanValue, lStdDevValue };
+            ioLegCabinDemandList.push_back (lLegCabinDemand);
+          }
+        }
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Project the demand of the given O&D-dates onto the leg-cabins, with
+     * the given method. The bid prices of the leg-cabins are gathered,
+     * and summed by segment-cabin, once; the prorated demands are then
+     * computed concurrently, and added to the leg-cabins in the order of
+     * the O&D-dates.
+     */
+    void projectOnDDemand (const OnDIncidenceMatrix& iOnDIncidenceMatrix,
+                           const DemandProjectionMethod_T& iMethod,
+                           const std::vector<stdair::OnDDate*>& iOnDDateList,
+                           const unsigned int iNbOfThreads) {
+      std::vector<stdair::BidPrice_T> lBidPriceList;
+      std::vector<stdair::BidPrice_T> lRowBidPriceList;
+      if (iMethod == PROJECTION_DA || iMethod == PROJECTION_DYP) {
+        iOnDIncidenceMatrix.getBidPriceList (lBidPriceList);
+        iOnDIncidenceMatrix.multiply (lBidPriceList, lRowBidPriceList);
+      }
+
+      // Prorate the demand of the O&D-dates. Each task writes only its
+      // own list of prorated demands.
+      const unsigned int lNbOfOnDDates = iOnDDateList.size();
+      std::vector<LegCabinDemandList_T> lLegCabinDemandLists (lNbOfOnDDates);
+      ParallelLoop::run (lNbOfOnDDates,
+                         [&] (const unsigned int iODIdx) {
+                           const stdair::OnDDate* lOnDDate_ptr =
+                             iOnDDateList[iODIdx];
+                           assert (lOnDDate_ptr != NULL);
+                           prorateOnDDemand (iOnDIncidenceMatrix, iMethod,
+                                             lBidPriceList, lRowBidPriceList,
+                                             *lOnDDate_ptr,
+                                             lLegCabinDemandLists[iODIdx]);
+                         },
+                         iNbOfThreads);
+
+      // Add the prorated demands to the leg-cabins, in the order of the
+      // O&D-dates.
+      for (std::vector<LegCabinDemandList_T>::const_iterator itList =
+             lLegCabinDemandLists.begin();
+           itList != lLegCabinDemandLists.end(); ++itList) {
+        const LegCabinDemandList_T& lLegCabinDemandList = *itList;
+        for (LegCabinDemandList_T::const_iterator itDemand =
+               lLegCabinDemandList.begin();
+             itDemand != lLegCabinDemandList.end(); ++itDemand) {
+          const LegCabinDemand& lLegCabinDemand = *itDemand;
+          stdair::LegCabin* lLegCabin_ptr = lLegCabinDemand._legCabin;
+          assert (lLegCabin_ptr != NULL);
+          lLegCabin_ptr->addDemandInformation (lLegCabinDemand._yield,
+                                               lLegCabinDemand._mean,
+                                               lLegCabinDemand._stdDev);
+        }
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Retrieve the leg-cabins of the given flight-dates, flight-date
+     * after flight-date.
+     */
+    void getLegCabinList (const std::vector<stdair::FlightDate*>& iFDList,
+                          std::vector<stdair::LegCabin*>& ioLegCabinList) {
+      for (std::vector<stdair::FlightDate*>::const_iterator itFD =
+             iFDList.begin(); itFD != iFDList.end(); ++itFD) {
+        const stdair::FlightDate* lFD_ptr = *itFD;
+        assert (lFD_ptr != NULL);
+        const bool hasLegDateList =
+          stdair::BomManager::hasList<stdair::LegDate> (*lFD_ptr);
+        if (hasLegDateList == false) {
+          continue;
+        }
+        const stdair::LegDateList_T& lLDList =
+          stdair::BomManager::getList<stdair::LegDate> (*lFD_ptr);
+        for (stdair::LegDateList_T::const_iterator itLD = lLDList.begin();
+             itLD != lLDList.end(); ++itLD) {
+          const stdair::LegDate* lLD_ptr = *itLD;
+          assert (lLD_ptr != NULL);
+          const stdair::LegCabinList_T& lLCList =
+            stdair::BomManager::getList<stdair::LegCabin> (*lLD_ptr);
+          ioLegCabinList.insert (ioLegCabinList.end(),
+                                 lLCList.begin(), lLCList.end());
+        }
+      }
+    }
+
+    /** Define the list of links between leg-cabins and their images. */
+    typedef LegCabinImageTable::LegCabinImageList_T LegCabinImageList_T;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Update the current bid prices of the given (real) leg-cabins, from
+     * their bid price vectors.
+     */
+    void updateLegCabinBidPrices (const LegCabinImageList_T& iLegCabinImageList) {
+      for (LegCabinImageList_T::const_iterator itLCImage =
+             iLegCabinImageList.begin();
+           itLCImage != iLegCabinImageList.end(); ++itLCImage) {
+        stdair::LegCabin* lLC_ptr = itLCImage->_legCabin;
+        assert (lLC_ptr != NULL);
+        lLC_ptr->updateCurrentBidPrice();
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Send the current bid prices of the given (real) leg-cabins to their
+     * images.
+     */
+    void sendLegCabinBidPrices (const LegCabinImageList_T& iLegCabinImageList) {
+      for (LegCabinImageList_T::const_iterator itLCImage =
+             iLegCabinImageList.begin();
+           itLCImage != iLegCabinImageList.end(); ++itLCImage) {
+        const stdair::LegCabin* lLC_ptr = itLCImage->_legCabin;
+        assert (lLC_ptr != NULL);
+        stdair::LegCabin* lOptLC_ptr = itLCImage->_image;
+        assert (lOptLC_ptr != NULL);
+        // Update the previous bid price (store the current).
+        lOptLC_ptr->updatePreviousBidPrice();
+        // Update the current bid price.
+        lOptLC_ptr->setCurrentBidPrice (lLC_ptr->getCurrentBidPrice());
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Log the bid prices sent to the images of the given leg-cabins.
+     * As the logger is not thread-safe, it is called serially, once the
+     * bid prices of all the flight-dates have been sent.
+     */
+    void logLegCabinBidPrices (const LegCabinImageList_T& iLegCabinImageList) {
+      for (LegCabinImageList_T::const_iterator itLCImage =
+             iLegCabinImageList.begin();
+           itLCImage != iLegCabinImageList.end(); ++itLCImage) {
+        const stdair::LegCabin* lLC_ptr = itLCImage->_legCabin;
+        assert (lLC_ptr != NULL);
+        const stdair::LegCabin* lOptLC_ptr = itLCImage->_image;
+        assert (lOptLC_ptr != NULL);
+
+        STDAIR_LOG_DEBUG ("Update bid price of " << lLC_ptr->getFullerKey()
+                          << " : " << lOptLC_ptr->getCurrentBidPrice()
+                          << " Availability pool " << lLC_ptr->getAvailabilityPool());
+      }
+    }
+  }
+
   // ////////////////////////////////////////////////////////////////////
   RMOL_Service::RMOL_Service()
-  : _rmolServiceContext (NULL),
-    _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
+  : _rmolServiceContext (NULL) {
     assert (false);
   }
 
   // ////////////////////////////////////////////////////////////////////
   RMOL_Service::RMOL_Service (const RMOL_Service& iService) :
-    _rmolServiceContext (NULL),
-    _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
+    _rmolServiceContext (NULL) {
     assert (false);
   }
 
   // ////////////////////////////////////////////////////////////////////
   RMOL_Service::RMOL_Service (const stdair::BasLogParams& iLogParams) :
-    _rmolServiceContext (NULL),
-    _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
+    _rmolServiceContext (NULL) {
 
     // Initialise the STDAIR service handler
     stdair::STDAIR_ServicePtr_T lSTDAIR_Service_ptr =
@@ -84,8 +410,7 @@ namespace RMOL {
   // ////////////////////////////////////////////////////////////////////
   RMOL_Service::RMOL_Service (const stdair::BasLogParams& iLogParams,
                               const stdair::BasDBParams& iDBParams) :
-    _rmolServiceContext (NULL),
-    _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
+    _rmolServiceContext (NULL) {
 
     // Initialise the STDAIR service handler
     stdair::STDAIR_ServicePtr_T lSTDAIR_Service_ptr =
@@ -105,8 +430,7 @@ namespace RMOL {
 
   // ////////////////////////////////////////////////////////////////////
   RMOL_Service::RMOL_Service (stdair::STDAIR_ServicePtr_T ioSTDAIRServicePtr)
-    : _rmolServiceContext (NULL),
-      _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
+    : _rmolServiceContext (NULL) {
     
     // Initialise the context
     initServiceContext();
@@ -208,6 +532,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext; 
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     const bool doesOwnStdairService =
       lRMOL_ServiceContext.getOwnStdairServiceFlag();
 
@@ -256,6 +581,211 @@ namespace RMOL {
     }
   }
   
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::setNbOfThreads (const unsigned int iNbOfThreads) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    // Zero means one thread per hardware core (when that number is known).
+    unsigned int lNbOfThreads = iNbOfThreads;
+    if (lNbOfThreads == 0) {
+      lNbOfThreads = std::thread::hardware_concurrency();
+    }
+    if (lNbOfThreads == 0) {
+      lNbOfThreads = DEFAULT_NUMBER_OF_THREADS;
+    }
+    lRMOL_ServiceContext.setNbOfThreads (lNbOfThreads);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  unsigned int RMOL_Service::getNbOfThreads() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getNbOfThreads();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::resetForecastState() {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    HistoricalBookingWindowHolder& lHBWindowHolder =
+      lRMOL_ServiceContext.getHistoricalBookingWindowHolder();
+    lHBWindowHolder.clear();
+
+    ForecastCache& lForecastCache = lRMOL_ServiceContext.getForecastCache();
+    lForecastCache.clear();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::notifySnapshotUpdate() {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    // The forecast cache is thread-safe, so that no lock is taken.
+    ForecastCache& lForecastCache = lRMOL_ServiceContext.getForecastCache();
+    lForecastCache.notifySnapshotUpdate();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const NetworkIterationReport& RMOL_Service::
+  getNetworkIterationReport() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getNetworkIterationReport();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  setBidPriceAcceleration (const BidPriceAccelerationMethod_T& iMethod,
+                           const double iDampingFactor) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    if (iDampingFactor <= 0.0 || iDampingFactor > 1.0) {
+      std::ostringstream oStr;
+      oStr << "The damping factor of the bid price iterations ("
+           << iDampingFactor << ") must be within ]0, 1]";
+      throw OptimisationException (oStr.str());
+    }
+    lRMOL_ServiceContext.setBidPriceAcceleration (iMethod, iDampingFactor);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  BidPriceAccelerationMethod_T RMOL_Service::
+  getBidPriceAccelerationMethod() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getBidPriceAccelerationMethod();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  double RMOL_Service::getBidPriceDampingFactor() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getBidPriceDampingFactor();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  setNetworkOptimisationMethod (const NetworkOptimisationMethod_T& iMethod) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    lRMOL_ServiceContext.setNetworkOptimisationMethod (iMethod);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  NetworkOptimisationMethod_T RMOL_Service::
+  getNetworkOptimisationMethod() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getNetworkOptimisationMethod();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  setNbOfRLPScenarios (const stdair::NbOfSamples_T& iNbOfScenarios) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    if (iNbOfScenarios == 0) {
+      throw OptimisationException ("The randomised linear program needs at "
+                                   "least one demand scenario");
+    }
+    lRMOL_ServiceContext.setNbOfRLPScenarios (iNbOfScenarios);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::NbOfSamples_T RMOL_Service::getNbOfRLPScenarios() const {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    return lRMOL_ServiceContext.getNbOfRLPScenarios();
+  }
+
   // ////////////////////////////////////////////////////////////////////
   void RMOL_Service::buildSampleBom() {
 
@@ -269,6 +799,7 @@ namespace RMOL {
     // Retrieve the RMOL service context and whether it owns the Stdair
     // service
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     const bool doesOwnStdairService =
       lRMOL_ServiceContext.getOwnStdairServiceFlag();
 
@@ -328,6 +859,7 @@ namespace RMOL {
     // Retrieve the RMOL service context and whether it owns the Stdair
     // service
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     const bool doesOwnStdairService =
       lRMOL_ServiceContext.getOwnStdairServiceFlag();
 
@@ -366,6 +898,7 @@ namespace RMOL {
     // Retrieve the RMOL service context and whether it owns the Stdair
     // service
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the StdAir service object from the (RMOL) service context
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -376,62 +909,190 @@ namespace RMOL {
      * cabin.
      */
     lSTDAIR_Service.buildDummyLegSegmentAccesses (ioBomRoot);
+
+    /**
+     * The snapshot tables and the flight-dates may have been re-built: the
+     * sliding windows of historical bookings, the cached forecasts and the
+     * DCP event index, the leg-cabin image table, the O&D incidence
+     * matrix and the bases of the network linear programs are no longer
+     * valid.
+     */
+    HistoricalBookingWindowHolder& lHBWindowHolder =
+      lRMOL_ServiceContext.getHistoricalBookingWindowHolder();
+    lHBWindowHolder.clear();
+
+    ForecastCache& lForecastCache = lRMOL_ServiceContext.getForecastCache();
+    lForecastCache.clear();
+
+    DCPEventIndex& lDCPEventIndex = lRMOL_ServiceContext.getDCPEventIndex();
+    lDCPEventIndex.clear();
+
+    LegCabinImageTable& lLegCabinImageTable =
+      lRMOL_ServiceContext.getLegCabinImageTable();
+    lLegCabinImageTable.clear();
+
+    OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      lRMOL_ServiceContext.getOnDIncidenceMatrix();
+    lOnDIncidenceMatrix.clear();
+
+    NetworkLPBasis& lNetworkLPBasis = lRMOL_ServiceContext.getNetworkLPBasis();
+    lNetworkLPBasis.clear();
+
+    YieldFeaturesIndex& lYieldFeaturesIndex =
+      lRMOL_ServiceContext.getYieldFeaturesIndex();
+    lYieldFeaturesIndex.clear();
   }   
 
+  // ////////////////////////////////////////////////////////////////////
+  const DCPEventIndex& RMOL_Service::
+  getDCPEventIndex (const stdair::BomRoot& iBomRoot) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    DCPEventIndex& lDCPEventIndex = lRMOL_ServiceContext.getDCPEventIndex();
+    if (lDCPEventIndex.isBuilt() == false) {
+      lDCPEventIndex.build (iBomRoot);
+
+      // DEBUG
+      STDAIR_LOG_DEBUG (lDCPEventIndex.describe());
+    }
+    return lDCPEventIndex;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const LegCabinImageTable& RMOL_Service::
+  getLegCabinImageTable (const stdair::BomRoot& iBomRoot) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    LegCabinImageTable& lLegCabinImageTable =
+      lRMOL_ServiceContext.getLegCabinImageTable();
+    if (lLegCabinImageTable.isBuilt() == false) {
+      lLegCabinImageTable.build (iBomRoot);
+
+      // DEBUG
+      STDAIR_LOG_DEBUG (lLegCabinImageTable.describe());
+    }
+    return lLegCabinImageTable;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const OnDIncidenceMatrix& RMOL_Service::
+  getOnDIncidenceMatrix (const stdair::BomRoot& iBomRoot) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      lRMOL_ServiceContext.getOnDIncidenceMatrix();
+    if (lOnDIncidenceMatrix.isBuilt() == false) {
+      lOnDIncidenceMatrix.build (iBomRoot);
+
+      // DEBUG
+      STDAIR_LOG_DEBUG (lOnDIncidenceMatrix.describe());
+    }
+    return lOnDIncidenceMatrix;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const OnDForecastTable& RMOL_Service::getOnDForecastTable () {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    OnDForecastTable& lOnDForecastTable =
+      lRMOL_ServiceContext.getOnDForecastTable();
+    if (lOnDForecastTable.isBuilt() == false) {
+      lOnDForecastTable.build();
+
+      // DEBUG
+      STDAIR_LOG_DEBUG (lOnDForecastTable.describe());
+    }
+    return lOnDForecastTable;
+  }
+
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::OPT_MC> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::OPT_MC>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using the Monte Carlo algorithm.
      */
-    optimalOptimisationByMCIntegration (iDraws);
+    optimalOptimisationByMCIntegration (iDraws, ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::OPT_DP> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::OPT_DP>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using dynamic programming.
      */
-    optimalOptimisationByDP();
+    optimalOptimisationByDP (ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_EMSR> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_EMSR>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using EMSR heuristic.
      */
-    heuristicOptimisationByEmsr();
+    heuristicOptimisationByEmsr (ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_EMSRA> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_EMSRA>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using EMSR-a heuristic.
      */
-    heuristicOptimisationByEmsrA();
+    heuristicOptimisationByEmsrA (ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_EMSRB> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_EMSRB>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using EMSR-b heuristic.
      */
-    heuristicOptimisationByEmsrB();
+    heuristicOptimisationByEmsrB (ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_MC_4_QFF>(const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_MC_4_QFF>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using the Monte Carlo algorithm
      * for QFF method.
@@ -442,7 +1103,8 @@ namespace RMOL {
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_EMSRB_4_QFF>(const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_EMSRB_4_QFF>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource optimization using EMSR-b heuristic for QFF method.
      */
@@ -452,7 +1114,8 @@ namespace RMOL {
   // ////////////////////////////////////////////////////////////////////
   template<>
   void RMOL_Service::
-  optimize<OptimizationType::HEUR_MRT_QFF> (const stdair::NbOfSamples_T iDraws) {
+  optimize<OptimizationType::HEUR_MRT_QFF>
+  (stdair::LegCabin& ioLegCabin, const stdair::NbOfSamples_T iDraws) const {
     /**
      * Single resource pre-optimization using
      * Marginal Revenue Transformation (MRT) for QFF method.
@@ -461,146 +1124,139 @@ namespace RMOL {
   }
 
   // ////////////////////////////////////////////////////////////////////
-  void RMOL_Service::
-  optimalOptimisationByMCIntegration (const stdair::NbOfSamples_T& iDraws) {
+  template <unsigned int I>
+  void RMOL_Service::optimize (const stdair::NbOfSamples_T iDraws) {
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
     assert (_rmolServiceContext != NULL);
-    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
 
-    // Retrieve the StdAir service
-    stdair::STDAIR_Service& lSTDAIR_Service =
-      lRMOL_ServiceContext.getSTDAIR_Service();   
-    // TODO: gsabatier
-    // Replace the getPersistentBomRoot method by the getBomRoot method,
-    // in order to work on the cloned Bom root instead of the persistent one.
-    // Does not work for now because virtual classes are not cloned.
-    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getPersistentBomRoot();
-
-    //
-    stdair::LegCabin& lLegCabin =
-      stdair::BomRetriever::retrieveDummyLegCabin (lBomRoot);
+    // The dummy leg-cabin is shared by all the callers.
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
+    stdair::LegCabin& lLegCabin = retrieveDummyLegCabin();
 
     stdair::BasChronometer lOptimisationChronometer;
     lOptimisationChronometer.start();
 
-    Optimiser::optimalOptimisationByMCIntegration (iDraws, lLegCabin);
+    optimize<I> (lLegCabin, iDraws);
 
     const double lOptimisationMeasure = lOptimisationChronometer.elapsed();
-    
-    // DEBUG
-    STDAIR_LOG_DEBUG ("Optimisation by Monte-Carlo performed in "
-                      << lOptimisationMeasure);
-    STDAIR_LOG_DEBUG ("Result: " << lLegCabin.displayVirtualClassList());
-
-    std::ostringstream logStream;
-    stdair::BidPriceVector_T lBidPriceVector = lLegCabin.getBidPriceVector();
-    logStream << "Bid-Price Vector (BPV): ";
-    const unsigned int size = lBidPriceVector.size();
-    
-    for (unsigned int i = 0; i < size - 1; ++i) {
-      const double bidPrice = lBidPriceVector.at(i);
-      logStream << std::fixed << std::setprecision (2) << bidPrice << ", ";
-    }
-    const double bidPrice = lBidPriceVector.at(size -1);
-    logStream << std::fixed << std::setprecision (2) << bidPrice;
-    STDAIR_LOG_DEBUG (logStream.str());
-  }
-
-  // ////////////////////////////////////////////////////////////////////
-  void RMOL_Service::optimalOptimisationByDP() {
-  }
-  
-  // ////////////////////////////////////////////////////////////////////
-  void RMOL_Service::heuristicOptimisationByEmsr() {
-    assert (_rmolServiceContext != NULL);
-    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
-
-    // Retrieve the StdAir service
-    stdair::STDAIR_Service& lSTDAIR_Service =
-      lRMOL_ServiceContext.getSTDAIR_Service();    
-    // TODO: gsabatier
-    // Replace the getPersistentBomRoot method by the getBomRoot method,
-    // in order to work on the clone Bom root instead of the persistent one.
-    // Does not work for now because virtual classes are not cloned.
-    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getPersistentBomRoot();
-
-    //
-    stdair::LegCabin& lLegCabin =
-      stdair::BomRetriever::retrieveDummyLegCabin (lBomRoot);
 
-    stdair::BasChronometer lOptimisationChronometer;
-    lOptimisationChronometer.start();
-    
-    Optimiser::heuristicOptimisationByEmsr (lLegCabin);
-    
-    const double lOptimisationMeasure = lOptimisationChronometer.elapsed();
-    // DEBUG
-    STDAIR_LOG_DEBUG ("Optimisation EMSR performed in "
-                      << lOptimisationMeasure);
+    // DEBUG (the leg-cabin optimisation, being reentrant, does not log)
+    const OptimizationType::EN_OptimizationType lOptimizationType =
+      static_cast<OptimizationType::EN_OptimizationType> (I);
+    STDAIR_LOG_DEBUG ("Optimisation ("
+                      << OptimizationType::getLabel (lOptimizationType)
+                      << ") performed in " << lOptimisationMeasure);
     STDAIR_LOG_DEBUG ("Result: " << lLegCabin.displayVirtualClassList());
 
-    stdair::BidPriceVector_T lBidPriceVector = lLegCabin.getBidPriceVector();
+    const stdair::BidPriceVector_T& lBidPriceVector =
+      lLegCabin.getBidPriceVector();
     std::ostringstream logStream;
     logStream << "Bid-Price Vector (BPV): ";
-    stdair::UnsignedIndex_T idx = 0;
-    for (stdair::BidPriceVector_T::const_iterator itBP = lBidPriceVector.begin();
-         itBP != lBidPriceVector.end(); ++itBP) {
-      if (idx != 0) {
+    for (stdair::BidPriceVector_T::const_iterator itBP =
+           lBidPriceVector.begin(); itBP != lBidPriceVector.end(); ++itBP) {
+      if (itBP != lBidPriceVector.begin()) {
         logStream << ", ";
       }
       const stdair::BidPrice_T& lBidPrice = *itBP;
       logStream << std::fixed << std::setprecision (2) << lBidPrice;
     }
-    // DEBUG
     STDAIR_LOG_DEBUG (logStream.str());
   }
 
-  // ////////////////////////////////////////////////////////////////////
-  void RMOL_Service::heuristicOptimisationByEmsrA() {
-    assert (_rmolServiceContext != NULL);
-    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+  // Instantiations of the optimisation of the dummy leg-cabin
+  template void RMOL_Service::
+  optimize<OptimizationType::OPT_MC> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::OPT_DP> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_EMSR> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_EMSRA> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_EMSRB> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_MC_4_QFF> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_EMSRB_4_QFF> (const stdair::NbOfSamples_T);
+  template void RMOL_Service::
+  optimize<OptimizationType::HEUR_MRT_QFF> (const stdair::NbOfSamples_T);
 
-    // Retrieve the StdAir service
-    stdair::STDAIR_Service& lSTDAIR_Service =
-      lRMOL_ServiceContext.getSTDAIR_Service();     
-    // TODO: gsabatier
-    // Replace the getPersistentBomRoot method by the getBomRoot method,
-    // in order to work on the clone Bom root instead of the persistent one.
-    // Does not work for now because virtual classes are not cloned. 
-    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getPersistentBomRoot();
-
-    //
-    stdair::LegCabin& lLegCabin =
-      stdair::BomRetriever::retrieveDummyLegCabin (lBomRoot);
-
-    Optimiser::heuristicOptimisationByEmsrA (lLegCabin);
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  optimiseBatch (const LegOptimisationBatch& iBatch,
+                 const OptimizationType::EN_OptimizationType& iOptimizationType,
+                 const stdair::NbOfSamples_T iDraws,
+                 const unsigned int iMaxCapacity,
+                 double* oProtectionList, double* oBidPriceMatrix) const {
 
-    // DEBUG
-    STDAIR_LOG_DEBUG ("Result: " << lLegCabin.displayVirtualClassList());
-    
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    // No logging, as the StdAir logger is not synchronised (reentrant
+    // method).
+    LegOptimiser::optimiseBatch (iBatch, iOptimizationType, iDraws,
+                                 iMaxCapacity,
+                                 lRMOL_ServiceContext.getNbOfThreads(),
+                                 oProtectionList, oBidPriceMatrix);
   }
 
   // ////////////////////////////////////////////////////////////////////
-  void RMOL_Service::heuristicOptimisationByEmsrB() {
+  stdair::LegCabin& RMOL_Service::retrieveDummyLegCabin() {
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
 
     // Retrieve the StdAir service
     stdair::STDAIR_Service& lSTDAIR_Service =
-      lRMOL_ServiceContext.getSTDAIR_Service();    
+      lRMOL_ServiceContext.getSTDAIR_Service();
     // TODO: gsabatier
     // Replace the getPersistentBomRoot method by the getBomRoot method,
-    // in order to work on the clone Bom root instead of the persistent one.
+    // in order to work on the cloned Bom root instead of the persistent one.
     // Does not work for now because virtual classes are not cloned.
     stdair::BomRoot& lBomRoot = lSTDAIR_Service.getPersistentBomRoot();
 
     //
     stdair::LegCabin& lLegCabin =
       stdair::BomRetriever::retrieveDummyLegCabin (lBomRoot);
+    return lLegCabin;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  optimalOptimisationByMCIntegration (const stdair::NbOfSamples_T& iDraws,
+                                      stdair::LegCabin& ioLegCabin) const {
+    Optimiser::optimalOptimisationByMCIntegration (iDraws, ioLegCabin);
+  }
 
-    Optimiser::heuristicOptimisationByEmsrB (lLegCabin);
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  optimalOptimisationByDP (stdair::LegCabin& ioLegCabin) const {
+  }
+  
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  heuristicOptimisationByEmsr (stdair::LegCabin& ioLegCabin) const {
+    Optimiser::heuristicOptimisationByEmsr (ioLegCabin);
+  }
 
-    // DEBUG
-    STDAIR_LOG_DEBUG ("Result: " << lLegCabin.displayVirtualClassList());
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  heuristicOptimisationByEmsrA (stdair::LegCabin& ioLegCabin) const {
+    Optimiser::heuristicOptimisationByEmsrA (ioLegCabin);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  heuristicOptimisationByEmsrB (stdair::LegCabin& ioLegCabin) const {
+    Optimiser::heuristicOptimisationByEmsrB (ioLegCabin);
   }
 
   // ////////////////////////////////////////////////////////////////////
@@ -634,45 +1290,106 @@ namespace RMOL {
             const stdair::PreOptimisationMethod& iPreOptimisationMethod,
             const stdair::OptimisationMethod& iOptimisationMethod,
             const stdair::PartnershipTechnique& iPartnershipTechnique) {
+    return optimise (ioFlightDate, iRMEventTime, iUnconstrainingMethod,
+                     iForecastingMethod, iPreOptimisationMethod,
+                     iOptimisationMethod, iPartnershipTechnique, NULL);
+  }
 
-    
-    STDAIR_LOG_DEBUG ("Forecast & Optimisation");
+  // ////////////////////////////////////////////////////////////////////
+  std::future<bool> RMOL_Service::
+  optimiseAsync (stdair::FlightDate& ioFlightDate,
+                 const stdair::DateTime_T& iRMEventTime,
+                 const stdair::UnconstrainingMethod& iUnconstrainingMethod,
+                 const stdair::ForecastingMethod& iForecastingMethod,
+                 const stdair::PreOptimisationMethod& iPreOptimisationMethod,
+                 const stdair::OptimisationMethod& iOptimisationMethod,
+                 const stdair::PartnershipTechnique& iPartnershipTechnique,
+                 OptimisationControl& ioControl) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+
+    // The methods are copied, as the caller may not keep them alive.
+    const stdair::DateTime_T lRMEventTime (iRMEventTime);
+    const stdair::UnconstrainingMethod lUnconstrainingMethod
+      (iUnconstrainingMethod);
+    const stdair::ForecastingMethod lForecastingMethod (iForecastingMethod);
+    const stdair::PreOptimisationMethod lPreOptimisationMethod
+      (iPreOptimisationMethod);
+    const stdair::OptimisationMethod lOptimisationMethod (iOptimisationMethod);
+    const stdair::PartnershipTechnique lPartnershipTechnique
+      (iPartnershipTechnique);
+    return std::async (std::launch::async,
+                       [=, &ioFlightDate, &ioControl] () {
+                         return optimise (ioFlightDate, lRMEventTime,
+                                          lUnconstrainingMethod,
+                                          lForecastingMethod,
+                                          lPreOptimisationMethod,
+                                          lOptimisationMethod,
+                                          lPartnershipTechnique, &ioControl);
+                       });
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool RMOL_Service::
+  optimise (stdair::FlightDate& ioFlightDate,
+            const stdair::DateTime_T& iRMEventTime,
+            const stdair::UnconstrainingMethod& iUnconstrainingMethod,
+            const stdair::ForecastingMethod& iForecastingMethod, 
+            const stdair::PreOptimisationMethod& iPreOptimisationMethod,
+            const stdair::OptimisationMethod& iOptimisationMethod,
+            const stdair::PartnershipTechnique& iPartnershipTechnique,
+            OptimisationControl* ioControl_ptr) {
+
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
     
     const stdair::PartnershipTechnique::EN_PartnershipTechnique& lPartnershipTechnique =
       iPartnershipTechnique.getTechnique();
     
     switch (lPartnershipTechnique) {      
     case stdair::PartnershipTechnique::NONE:{
-      // DEBUG
-      STDAIR_LOG_DEBUG ("Forecast");
-      
+      // Only the flight-date is written (the forecast state being
+      // thread-safe), so that no lock is taken. For the same reason,
+      // nothing is logged, the StdAir logger not being synchronised.
+
+      // Once a stop is requested, not even the forecast is updated.
+      if (ioControl_ptr != NULL && ioControl_ptr->isStopRequested() == true) {
+        ioControl_ptr->setInterrupted();
+        return false;
+      }
+
       // 1. Forecasting
+      assert (_rmolServiceContext != NULL);
+      const unsigned int& lNbOfThreads =
+        _rmolServiceContext->getNbOfThreads();
+      HistoricalBookingWindowHolder& lHBWindowHolder =
+        _rmolServiceContext->getHistoricalBookingWindowHolder();
+      ForecastCache& lForecastCache = _rmolServiceContext->getForecastCache();
       const bool isForecasted = Forecaster::forecast (ioFlightDate,
                                                       iRMEventTime,
                                                       iUnconstrainingMethod,
-                                                      iForecastingMethod);
-      // DEBUG
-      STDAIR_LOG_DEBUG ("Forecast successful: " << isForecasted);
-
+                                                      iForecastingMethod,
+                                                      lHBWindowHolder,
+                                                      lForecastCache,
+                                                      lNbOfThreads);
       if (isForecasted == true) {
         // 2a. MRT or FA
-        // DEBUG
-        STDAIR_LOG_DEBUG ("Pre-optimise");
-        
         const bool isPreOptimised =
           PreOptimiser::preOptimise (ioFlightDate, iPreOptimisationMethod);
-        
-        // DEBUG
-        STDAIR_LOG_DEBUG ("Pre-Optimise successful: " << isPreOptimised);
-
         if (isPreOptimised == true) {
           // 2b. Optimisation
-          // DEBUG
-          STDAIR_LOG_DEBUG ("Optimise");
           const bool optimiseSucceeded = 
-            Optimiser::optimise (ioFlightDate, iOptimisationMethod);
-          // DEBUG
-          STDAIR_LOG_DEBUG ("Optimise successful: " << optimiseSucceeded);
+            Optimiser::optimise (ioFlightDate, iOptimisationMethod,
+                                 ioControl_ptr);
           return optimiseSucceeded ;
         }
       }
@@ -680,42 +1397,65 @@ namespace RMOL {
     }
     case stdair::PartnershipTechnique::RAE_DA:
     case stdair::PartnershipTechnique::IBP_DA:{
-      if (_previousForecastDate < iRMEventTime.date()) {
+      // The O&D forecast and optimisation work on the whole network.
+      ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+      if (lRMOL_ServiceContext.getPreviousForecastDate()
+          < iRMEventTime.date()) {
         forecastOnD (iRMEventTime);
         resetDemandInformation (iRMEventTime);
         projectAggregatedDemandOnLegCabins (iRMEventTime);
-        optimiseOnD (iRMEventTime);
+        optimiseOnD (iRMEventTime, ioControl_ptr);
       }
       break;
     }
     case stdair::PartnershipTechnique::RAE_YP:
     case stdair::PartnershipTechnique::IBP_YP:
     case stdair::PartnershipTechnique::IBP_YP_U:{
-      if (_previousForecastDate < iRMEventTime.date()) {
+      ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+      if (lRMOL_ServiceContext.getPreviousForecastDate()
+          < iRMEventTime.date()) {
         forecastOnD (iRMEventTime);
         resetDemandInformation (iRMEventTime);
         projectOnDDemandOnLegCabinsUsingYP (iRMEventTime);
-        optimiseOnD (iRMEventTime);
+        optimiseOnD (iRMEventTime, ioControl_ptr);
       }
       break;
     }
     case stdair::PartnershipTechnique::RMC:{
-      if (_previousForecastDate < iRMEventTime.date()) {
+      ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+      if (lRMOL_ServiceContext.getPreviousForecastDate()
+          < iRMEventTime.date()) {
         forecastOnD (iRMEventTime);
         resetDemandInformation (iRMEventTime);        
         updateBidPrice (iRMEventTime);
         projectOnDDemandOnLegCabinsUsingDYP (iRMEventTime);
-        optimiseOnDUsingRMCooperation (iRMEventTime);
+        optimiseOnDUsingRMCooperation (iRMEventTime, ioControl_ptr);
       }
       break;
     }
     case stdair::PartnershipTechnique::A_RMC:{
-      if (_previousForecastDate < iRMEventTime.date()) {
+      ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+      if (lRMOL_ServiceContext.getPreviousForecastDate()
+          < iRMEventTime.date()) {
         forecastOnD (iRMEventTime);
+        // The (deterministic or randomised) linear program of the network,
+        // when chosen, gives the bid prices in a single resolution. The
+        // iterations of leg optimisations remain the fallback, but not
+        // when the resolution was interrupted.
+        assert (_rmolServiceContext != NULL);
+        const NetworkOptimisationMethod_T& lNetworkOptimisationMethod =
+          _rmolServiceContext->getNetworkOptimisationMethod();
+        if (lNetworkOptimisationMethod != NETWORK_OPTIMISATION_ITERATIVE
+            && (optimiseOnDUsingNetworkLP (iRMEventTime, ioControl_ptr)
+                == true
+                || (ioControl_ptr != NULL
+                    && ioControl_ptr->isInterrupted() == true))) {
+          break;
+        }
         resetDemandInformation (iRMEventTime);        
         updateBidPrice (iRMEventTime);
         projectOnDDemandOnLegCabinsUsingDYP (iRMEventTime);
-        optimiseOnDUsingAdvancedRMCooperation (iRMEventTime);
+        optimiseOnDUsingAdvancedRMCooperation (iRMEventTime, ioControl_ptr);
       }
       break;
     }
@@ -736,6 +1476,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -745,7 +1486,10 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
-    _previousForecastDate = lDate;
+    lRMOL_ServiceContext.setPreviousForecastDate (lDate);
+
+    // Retrieve the O&D-dates hitting a DCP on that date
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
 
     const stdair::InventoryList_T& lInventoryList =
       stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
@@ -754,48 +1498,37 @@ namespace RMOL {
          itInv != lInventoryList.end(); ++itInv) {
       const stdair::Inventory* lInventory_ptr = *itInv;
       assert (lInventory_ptr != NULL);
-      const bool hasOnDDateList =
-        stdair::BomManager::hasList<stdair::OnDDate> (*lInventory_ptr);
-      if (hasOnDDateList == true) {
-        const stdair::OnDDateList_T lOnDDateList =
-          stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
-
-        for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
-             itOD != lOnDDateList.end(); ++itOD) {
-          stdair::OnDDate* lOnDDate_ptr = *itOD;
-          assert (lOnDDate_ptr != NULL);
-          
-          const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
-          stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-          stdair::DTD_T lDTD = short (lDateOffset.days());
-          
-          stdair::DCPList_T::const_iterator itDCP =
-            std::find (stdair::DEFAULT_DCP_LIST.begin(),
-                       stdair::DEFAULT_DCP_LIST.end(), lDTD);
-          // Check if the forecast for this O&D date needs to be forecasted.
-          if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-            // Retrieve the total forecast map.
-            const stdair::CabinForecastMap_T& lTotalForecastMap =
-              lOnDDate_ptr->getTotalForecastMap();
-            
-            // Browse the map and make a forecast for every cabin.
-            for (stdair::CabinForecastMap_T::const_iterator itCF =
-                   lTotalForecastMap.begin();
-                 itCF != lTotalForecastMap.end(); ++itCF) {
-              const stdair::CabinCode_T lCabinCode = itCF->first;
-              stdair::YieldFeatures* lYieldFeatures_ptr =
-                getYieldFeatures(*lOnDDate_ptr, lCabinCode, lBomRoot);
-              if (lYieldFeatures_ptr == NULL) {
-                STDAIR_LOG_ERROR ("Cannot find yield corresponding to "
-                                  << "the O&D date"
-                                  << lOnDDate_ptr->toString()
-                                  << " Cabin " << lCabinCode);
-                assert (false);
-              }
-              forecastOnD (*lYieldFeatures_ptr, *lOnDDate_ptr, lCabinCode, lDTD,
-                           lBomRoot);
-            }
+      const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+        lDCPEventIndex.getDueOnDDateList (lDate, *lInventory_ptr);
+      for (DCPEventIndex::DueOnDDateList_T::const_iterator itOD =
+             lOnDDateList.begin(); itOD != lOnDDateList.end(); ++itOD) {
+        stdair::OnDDate* lOnDDate_ptr = *itOD;
+        assert (lOnDDate_ptr != NULL);
+        
+        const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
+        stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
+        stdair::DTD_T lDTD = short (lDateOffset.days());
+        
+        // Retrieve the total forecast map.
+        const stdair::CabinForecastMap_T& lTotalForecastMap =
+          lOnDDate_ptr->getTotalForecastMap();
+        
+        // Browse the map and make a forecast for every cabin.
+        for (stdair::CabinForecastMap_T::const_iterator itCF =
+               lTotalForecastMap.begin();
+             itCF != lTotalForecastMap.end(); ++itCF) {
+          const stdair::CabinCode_T lCabinCode = itCF->first;
+          stdair::YieldFeatures* lYieldFeatures_ptr =
+            getYieldFeatures(*lOnDDate_ptr, lCabinCode, lBomRoot);
+          if (lYieldFeatures_ptr == NULL) {
+            STDAIR_LOG_ERROR ("Cannot find yield corresponding to "
+                              << "the O&D date"
+                              << lOnDDate_ptr->toString()
+                              << " Cabin " << lCabinCode);
+            assert (false);
           }
+          forecastOnD (*lYieldFeatures_ptr, *lOnDDate_ptr, lCabinCode, lDTD,
+                       lBomRoot);
         }
       }
     }    
@@ -807,70 +1540,21 @@ namespace RMOL {
                    const stdair::CabinCode_T& iCabinCode,
                    stdair::BomRoot& iBomRoot) {
 
-    const stdair::AirportCode_T& lOrigin = iOnDDate.getOrigin();
-    const stdair::AirportCode_T& lDestination = iOnDDate.getDestination();
-
-    const stdair::Date_T& lDepartureDate = iOnDDate.getDate();
-    
-    // Build the airport pair key out of O&D and get the airport pair object
-    const stdair::AirportPairKey lAirportPairKey(lOrigin, lDestination);
-    stdair::AirportPair* lAirportPair_ptr = stdair::BomManager::
-      getObjectPtr<stdair::AirportPair> (iBomRoot,
-                                         lAirportPairKey.toString());
-    if (lAirportPair_ptr == NULL) {
-      STDAIR_LOG_ERROR ("Cannot find yield corresponding to the airport "
-                        << "pair: " << lAirportPairKey.toString());
-      assert (false);
-    }  
-
-    // Retrieve the corresponding date period to lDepartureDate.
-    const stdair::DatePeriodList_T lDatePeriodList =
-      stdair::BomManager::getList<stdair::DatePeriod> (*lAirportPair_ptr);
-    for (stdair::DatePeriodList_T::const_iterator itDatePeriod =
-           lDatePeriodList.begin();
-         itDatePeriod != lDatePeriodList.end(); ++itDatePeriod) {
-      const stdair::DatePeriod* lDatePeriod_ptr = *itDatePeriod;
-      assert (lDatePeriod_ptr != NULL);
-      
-      const bool isDepartureDateValid =
-        lDatePeriod_ptr->isDepartureDateValid (lDepartureDate);
-      
-      if (isDepartureDateValid == true) {
-        // Retrieve the PoS-Channel.
-        // TODO: Use POS and Channel from demand instead of default
-        const stdair::PosChannelKey lPosChannelKey (stdair::DEFAULT_POS,
-                                                    stdair::DEFAULT_CHANNEL);
-        stdair::PosChannel* lPosChannel_ptr = stdair::BomManager::
-          getObjectPtr<stdair::PosChannel> (*lDatePeriod_ptr,
-                                            lPosChannelKey.toString());
-        if (lPosChannel_ptr == NULL) {
-          STDAIR_LOG_ERROR ("Cannot find yield corresponding to the PoS-"
-                            << "Channel: " << lPosChannelKey.toString());
-          assert (false);
-        }
-        // Retrieve the yield features.
-        const stdair::TimePeriodList_T lTimePeriodList = stdair::
-          BomManager::getList<stdair::TimePeriod> (*lPosChannel_ptr);
-        for (stdair::TimePeriodList_T::const_iterator itTimePeriod =
-               lTimePeriodList.begin();
-             itTimePeriod != lTimePeriodList.end(); ++itTimePeriod) {
-          const stdair::TimePeriod* lTimePeriod_ptr = *itTimePeriod;
-          assert (lTimePeriod_ptr != NULL);
-          
-          // TODO: Use trip type from demand instead of default value.
-          const stdair::YieldFeaturesKey lYieldFeaturesKey (stdair::TRIP_TYPE_ONE_WAY,
-                                                            iCabinCode);
-          stdair::YieldFeatures* oYieldFeatures_ptr = stdair::BomManager::
-            getObjectPtr<stdair::YieldFeatures>(*lTimePeriod_ptr,
-                                                lYieldFeaturesKey.toString());
-          if (oYieldFeatures_ptr != NULL) {
-            return oYieldFeatures_ptr;
-          }
-        }
-      }
+    // Retrieve the RMOL service context
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The RMOL service has not"
+                                                    " been initialised");
     }
-    return NULL;
-    
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    // The airport pair, date period and time period look-ups are resolved
+    // once, and the result is memoised by O&D, departure date and cabin.
+    YieldFeaturesIndex& lYieldFeaturesIndex =
+      lRMOL_ServiceContext.getYieldFeaturesIndex();
+    return lYieldFeaturesIndex.getYieldFeatures (iOnDDate, iCabinCode,
+                                                 iBomRoot);
   }
 
   
@@ -881,45 +1565,45 @@ namespace RMOL {
                const stdair::CabinCode_T& iCabinCode,
                const stdair::DTD_T& iDTD,
                stdair::BomRoot& iBomRoot) {
+    assert (_rmolServiceContext != NULL);
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
 
-    const stdair::AirlineClassListList_T lAirlineClassListList =
+    const stdair::AirlineClassListList_T& lAirlineClassListList =
       stdair::BomManager::getList<stdair::AirlineClassList> (iYieldFeatures);
     assert (lAirlineClassListList.begin() != lAirlineClassListList.end());
 
-    // Yield order check
-    stdair::AirlineClassListList_T::const_iterator  itACL =
+    // Yield ladder, with the yield order check
+    OnDForecastTable::YieldList_T lYieldList;
+    lYieldList.reserve (lAirlineClassListList.size());
+    stdair::AirlineClassListList_T::const_iterator itACL =
       lAirlineClassListList.begin();
-    stdair::Yield_T lPreviousYield((*itACL)->getYield());
-    ++itACL;
     for (; itACL != lAirlineClassListList.end(); ++itACL) {
-      const stdair::AirlineClassList* lAirlineClassList = *itACL;
-      const stdair::Yield_T& lYield = lAirlineClassList->getYield();
-      if (lYield <= lPreviousYield) {
-        lPreviousYield = lYield;
-      }
-      else{
+      const stdair::AirlineClassList* lAirlineClassList_ptr = *itACL;
+      assert (lAirlineClassList_ptr != NULL);
+      const stdair::Yield_T& lYield = lAirlineClassList_ptr->getYield();
+      if (lYieldList.empty() == false && lYield > lYieldList.back()) {
         STDAIR_LOG_ERROR ("Yields should be given in a descendant order"
                           << " in the yield input file") ;
         assert (false);
       }
+      lYieldList.push_back (lYield);
     }
-    // Proportion factor list initialisation
-    // Each element corresponds to a yield rule
-    stdair::ProportionFactorList_T lProportionFactorList;
-    stdair::ProportionFactor_T lPreviousProportionFactor = 0;
+
+    // Retrieve the remaining percentage of booking requests and the frat5
+    // coef corresponding to the input dtd
+    const OnDForecastTable& lOnDForecastTable = getOnDForecastTable();
+    if (lOnDForecastTable.hasDTD (iDTD) == false) {
+      STDAIR_LOG_ERROR ("Cannot find frat5 coef for DTD = " << iDTD );
+      assert (false);
+      return;
+    }
+    const stdair::Probability_T& lRemainingProportion =
+      lOnDForecastTable.getRemainingProportion (iDTD);
 
     // Retrieve the minimal willingness to pay associated to the demand
     const stdair::WTPDemandPair_T& lTotalForecast =
       iOnDDate.getTotalForecast (iCabinCode);
     const stdair::WTP_T& lMinWTP = lTotalForecast.first;
-   
-    // Retrieve the remaining percentage of booking requests
-    const stdair::ContinuousAttributeLite<stdair::FloatDuration_T>
-      lArrivalPattern (stdair::DEFAULT_DTD_PROB_MAP);
-     
-    STDAIR_LOG_DEBUG (lArrivalPattern.displayCumulativeDistribution());
-    const stdair::Probability_T lRemainingProportion =
-      lArrivalPattern.getRemainingProportion(-float(iDTD));
 
     // Compute the characteristics (mean and std dev) of the total
     // forecast demand to come
@@ -930,42 +1614,21 @@ namespace RMOL {
     const stdair::MeanValue_T& lRemainingMeanValue =
       lRemainingProportion*lMeanValue;
     const stdair::StdDevValue_T& lStdDevValue =
-      lForecatsMeanStdDevPair.second;
-    const stdair::StdDevValue_T& lRemainingStdDevValue =
-      lRemainingProportion*lStdDevValue;
-
-    // Retrieve the frat5 coef corresponding to the input dtd
-    stdair::DTDFratMap_T::const_iterator itDFC =
-      stdair::DEFAULT_DTD_FRAT5COEF_MAP.find(iDTD);
-    if (itDFC == stdair::DEFAULT_DTD_FRAT5COEF_MAP.end()) {
-      STDAIR_LOG_ERROR ("Cannot find frat5 coef for DTD = " << iDTD );
-      assert (false);
-    }
-    stdair::RealNumber_T lFrat5Coef =
-      stdair::DEFAULT_DTD_FRAT5COEF_MAP.at(iDTD);
+      lForecatsMeanStdDevPair.second;
+    const stdair::StdDevValue_T& lRemainingStdDevValue =
+      lRemainingProportion*lStdDevValue;
 
     STDAIR_LOG_DEBUG ("Remaining proportion " << lRemainingProportion
                       << " Total " << lMeanValue
                       << " StdDev " << lStdDevValue
-                      << "Frat5 Coef " << lFrat5Coef);
-
-    std::ostringstream oStr;
-    // Compute the "forecast demand to come" proportion by class
-    itACL = lAirlineClassListList.begin();
-    for (; itACL != lAirlineClassListList.end(); ++itACL) {
-      const stdair::AirlineClassList* lAirlineClassList_ptr = *itACL;
-      const stdair::Yield_T& lYield = lAirlineClassList_ptr->getYield();
-      stdair::ProportionFactor_T lProportionFactor =
-        exp ((lYield - lMinWTP)*log(0.5)/(lMinWTP*(lFrat5Coef-1.0)));
-      // If the yield is smaller than minimal WTP, the factor is greater than 1.
-      // In that case it should be modified and put to 1.
-      lProportionFactor = std::min (lProportionFactor, 1.0);
-      lProportionFactorList.push_back(lProportionFactor - lPreviousProportionFactor);      
-      lPreviousProportionFactor = lProportionFactor;
-      oStr << lAirlineClassList_ptr->toString() << lProportionFactor << " ";
-    }
+                      << "Frat5 Coef "
+                      << lOnDForecastTable.getFrat5Coef (iDTD));
 
-    STDAIR_LOG_DEBUG (oStr.str());
+    // Compute the "forecast demand to come" proportion by class, each
+    // element corresponding to a yield rule
+    stdair::ProportionFactorList_T lProportionFactorList;
+    lOnDForecastTable.computeProportionFactors (iDTD, lMinWTP, lYieldList,
+                                                lProportionFactorList);
 
     // Sanity check
     assert (lAirlineClassListList.size() == lProportionFactorList.size());
@@ -997,6 +1660,8 @@ namespace RMOL {
                   stdair::OnDDate& iOnDDate,
                   const stdair::CabinCode_T& iCabinCode,
                   stdair::BomRoot& iBomRoot) {
+    assert (_rmolServiceContext != NULL);
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
     
     const stdair::AirportCode_T& lOrigin = iOnDDate.getOrigin();
     const stdair::AirportCode_T& lDestination = iOnDDate.getDestination();
@@ -1060,6 +1725,8 @@ namespace RMOL {
                   const stdair::StdDevValue_T& iStdDevValue,
                   const stdair::Yield_T& iYield,
                   stdair::BomRoot& iBomRoot) {
+    assert (_rmolServiceContext != NULL);
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
     stdair::Inventory* lInventory_ptr = iBomRoot.getInventory(iAirlineCode);
     if (lInventory_ptr == NULL) {
       STDAIR_LOG_ERROR ("Cannot find the inventory corresponding"
@@ -1125,6 +1792,8 @@ namespace RMOL {
                   const stdair::StdDevValue_T& iStdDevValue,
                   const stdair::Yield_T& iYield,
                   stdair::BomRoot& iBomRoot) {    
+    assert (_rmolServiceContext != NULL);
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
     stdair::Inventory* lInventory_ptr = iBomRoot.getInventory(iAirlineCode);
     if (lInventory_ptr == NULL) {
       STDAIR_LOG_ERROR ("Cannot find the inventory corresponding"
@@ -1238,6 +1907,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1259,47 +1929,52 @@ namespace RMOL {
   void RMOL_Service::
   resetDemandInformation (const stdair::DateTime_T& iRMEventTime,
                           const stdair::Inventory& iInventory) {
-    
-    const stdair::FlightDateList_T lFlightDateList =
-      stdair::BomManager::getList<stdair::FlightDate> (iInventory);
-    assert (!lFlightDateList.empty());
-    for (stdair::FlightDateList_T::const_iterator itFD = lFlightDateList.begin();
-         itFD != lFlightDateList.end(); ++itFD) {
+
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    // Retrieve the bom root
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lRMOL_ServiceContext.getSTDAIR_Service();
+    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Retrieve the date from the RM event
+    const stdair::Date_T lDate = iRMEventTime.date();
+
+    // Retrieve the flight-dates hitting a DCP on that date
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+      lDCPEventIndex.getDueFlightDateList (lDate, iInventory);
+    for (DCPEventIndex::DueFlightDateList_T::const_iterator itFD =
+           lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
       const stdair::FlightDate* lFlightDate_ptr = *itFD;
       assert (lFlightDate_ptr != NULL);
       
-      // Retrieve the date from the RM event
-      const stdair::Date_T lDate = iRMEventTime.date();
-      
-      const stdair::Date_T& lDepartureDate = lFlightDate_ptr->getDepartureDate();
-      stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-      stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-      stdair::DCPList_T::const_iterator itDCP =
-        std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-      // Check if the demand forecast info corresponding to this flight date needs to be reset.
-      if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-        // Check if the flight date holds a list of leg dates.
-        // If so, find all leg cabin and reset the forecast they are holding.
-        const bool hasLegDateList =
-          stdair::BomManager::hasList<stdair::LegDate> (*lFlightDate_ptr);
-        if (hasLegDateList == true) {
-          const stdair::LegDateList_T lLegDateList =
-            stdair::BomManager::getList<stdair::LegDate> (*lFlightDate_ptr);
-          assert (!lLegDateList.empty());
-          for (stdair::LegDateList_T::const_iterator itLD = lLegDateList.begin();
-               itLD != lLegDateList.end(); ++itLD) {
-            const stdair::LegDate* lLegDate_ptr = *itLD;
-            assert (lLegDate_ptr != NULL);
-            const stdair::LegCabinList_T lLegCabinList =
-              stdair::BomManager::getList<stdair::LegCabin> (*lLegDate_ptr);
-            assert (!lLegCabinList.empty());
-            for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                 itLC != lLegCabinList.end(); ++itLC) {
-              stdair::LegCabin* lLegCabin_ptr = *itLC;
-              assert (lLegCabin_ptr != NULL);
-              lLegCabin_ptr->emptyYieldLevelDemandMap();
-            }
+      // Check if the flight date holds a list of leg dates.
+      // If so, find all leg cabin and reset the forecast they are holding.
+      const bool hasLegDateList =
+        stdair::BomManager::hasList<stdair::LegDate> (*lFlightDate_ptr);
+      if (hasLegDateList == true) {
+        const stdair::LegDateList_T lLegDateList =
+          stdair::BomManager::getList<stdair::LegDate> (*lFlightDate_ptr);
+        assert (!lLegDateList.empty());
+        for (stdair::LegDateList_T::const_iterator itLD = lLegDateList.begin();
+             itLD != lLegDateList.end(); ++itLD) {
+          const stdair::LegDate* lLegDate_ptr = *itLD;
+          assert (lLegDate_ptr != NULL);
+          const stdair::LegCabinList_T lLegCabinList =
+            stdair::BomManager::getList<stdair::LegCabin> (*lLegDate_ptr);
+          assert (!lLegCabinList.empty());
+          for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
+               itLC != lLegCabinList.end(); ++itLC) {
+            stdair::LegCabin* lLegCabin_ptr = *itLC;
+            assert (lLegCabin_ptr != NULL);
+            lLegCabin_ptr->emptyYieldLevelDemandMap();
           }
         }
       }
@@ -1315,6 +1990,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1324,91 +2000,17 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
-    const stdair::InventoryList_T lInventoryList =
-      stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
-    assert (!lInventoryList.empty());
-    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
-         itInv != lInventoryList.end(); ++itInv) {
-      const stdair::Inventory* lInventory_ptr = *itInv;
-      assert (lInventory_ptr != NULL);
-      const stdair::OnDDateList_T lOnDDateList =
-        stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
-      assert (!lOnDDateList.empty());
-      for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
-           itOD != lOnDDateList.end(); ++itOD) {
-        stdair::OnDDate* lOnDDate_ptr = *itOD;
-        assert (lOnDDate_ptr != NULL);
-
-        const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
-        stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-        stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-        stdair::DCPList_T::const_iterator itDCP =
-          std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-        // Check if the forecast for this O&D date needs to be projected.
-        if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-
-          // Browse the demand info map.
-          const stdair::StringDemandStructMap_T& lStringDemandStructMap =
-            lOnDDate_ptr->getDemandInfoMap ();
-          for (stdair::StringDemandStructMap_T::const_iterator itStrDS = lStringDemandStructMap.begin();
-               itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
-            std::string lCabinClassPath = itStrDS->first;
-            const stdair::YieldDemandPair_T& lYieldDemandPair =
-              itStrDS->second;
-            const stdair::CabinClassPairList_T& lCabinClassPairList =
-              lOnDDate_ptr->getCabinClassPairList(lCabinClassPath);
-            const stdair::NbOfSegments_T& lNbOfSegments = lOnDDate_ptr->getNbOfSegments();
-            // Sanity check
-            assert (lCabinClassPairList.size() == lNbOfSegments);
-            
-            const stdair::SegmentDateList_T lOnDSegmentDateList =
-              stdair::BomManager::getList<stdair::SegmentDate> (*lOnDDate_ptr);
-            // Sanity check
-            assert (lOnDSegmentDateList.size() == lNbOfSegments);
-            stdair::CabinClassPairList_T::const_iterator itCCP = lCabinClassPairList.begin();
-            stdair::SegmentDateList_T::const_iterator itSD = lOnDSegmentDateList.begin();
-            for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
-              const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-              const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-                lSegmentDate_ptr->getOperatingSegmentDate ();
-              assert (lSegmentDate_ptr != NULL);
-              // Only operated legs receive the demand information.
-              if (lOperatingSegmentDate_ptr == NULL) {
-                const stdair::CabinCode_T lCabinCode = itCCP->first;
-                const stdair::ClassCode_T lClassCode = itCCP->second;
-                const stdair::SegmentCabin* lSegmentCabin_ptr =
-                  stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                          lCabinCode);
-                assert (lSegmentCabin_ptr != NULL);
-                // Retrieve the booking class (level of aggregation of demand).
-                // The yield of the class is assigned to all types of demand for it.
-                const stdair::BookingClass* lBookingClass_ptr =
-                  stdair::BomManager::getObjectPtr<stdair::BookingClass> (*lSegmentCabin_ptr,
-                                                                          lClassCode);
-                assert (lBookingClass_ptr != NULL);
-                const stdair::LegCabinList_T lLegCabinList =
-                  stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
-                assert (!lLegCabinList.empty());
-                const int lNbOfLegs = lLegCabinList.size();
-                // Determine the yield (equally distributed over legs).
-                const stdair::Yield_T& lYield = lBookingClass_ptr->getYield()/lNbOfLegs;
-                const stdair::MeanStdDevPair_T& lMeanStdDevPair =
-                  lYieldDemandPair.second;
-                const stdair::MeanValue_T& lMeanValue = lMeanStdDevPair.first;
-                const stdair::StdDevValue_T& lStdDevValue = lMeanStdDevPair.second;
-                for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                     itLC != lLegCabinList.end(); ++itLC) {
-                  stdair::LegCabin* lLegCabin_ptr = *itLC;
-                  assert (lLegCabin_ptr != NULL);
-                  lLegCabin_ptr->addDemandInformation (lYield, lMeanValue, lStdDevValue);
-                }
-              }
-            }
-          }
-        }
-      }
-    }
+    // Retrieve the O&D-dates of the whole network hitting a DCP on that
+    // date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+
+    const OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      getOnDIncidenceMatrix (lBomRoot);
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+    projectOnDDemand (lOnDIncidenceMatrix, PROJECTION_AGGREGATED, lOnDDateList,
+                      lNbOfThreads);
   }
 
   // ///////////////////////////////////////////////////////////////////
@@ -1420,6 +2022,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1429,89 +2032,22 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
-    const stdair::InventoryList_T lInventoryList =
-      stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
-    assert (!lInventoryList.empty());
-    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
-         itInv != lInventoryList.end(); ++itInv) {
-      const stdair::Inventory* lInventory_ptr = *itInv;
-      assert (lInventory_ptr != NULL);
-      const stdair::OnDDateList_T lOnDDateList =
-        stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
-      assert (!lOnDDateList.empty());
-      for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
-           itOD != lOnDDateList.end(); ++itOD) {
-        stdair::OnDDate* lOnDDate_ptr = *itOD;
-        assert (lOnDDate_ptr != NULL);
-
-        const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
-        stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-        stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-        stdair::DCPList_T::const_iterator itDCP =
-          std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-        // Check if the forecast for this O&D date needs to be projected.
-        if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-
-          // Browse the demand info map.
-          const stdair::StringDemandStructMap_T& lStringDemandStructMap =
-            lOnDDate_ptr->getDemandInfoMap ();
-          for (stdair::StringDemandStructMap_T::const_iterator itStrDS = lStringDemandStructMap.begin();
-               itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
-            std::string lCabinClassPath = itStrDS->first;
-            const stdair::YieldDemandPair_T& lYieldDemandPair =
-              itStrDS->second;
-            const stdair::CabinClassPairList_T& lCabinClassPairList =
-              lOnDDate_ptr->getCabinClassPairList(lCabinClassPath);
-            const stdair::NbOfSegments_T& lNbOfSegments = lOnDDate_ptr->getNbOfSegments();
-            // Sanity check
-            assert (lCabinClassPairList.size() == lNbOfSegments);
-            
-            const stdair::SegmentDateList_T lOnDSegmentDateList =
-              stdair::BomManager::getList<stdair::SegmentDate> (*lOnDDate_ptr);
-            // Sanity check
-            assert (lOnDSegmentDateList.size() == lNbOfSegments);
-            stdair::CabinClassPairList_T::const_iterator itCCP = lCabinClassPairList.begin();
-            stdair::SegmentDateList_T::const_iterator itSD = lOnDSegmentDateList.begin();
-            for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
-              const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-              assert (lSegmentDate_ptr != NULL);
-              const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-                lSegmentDate_ptr->getOperatingSegmentDate ();
-              // Only operated legs receive the demand information.
-              if (lOperatingSegmentDate_ptr == NULL) {
-                const stdair::CabinCode_T lCabinCode = itCCP->first;
-                const stdair::ClassCode_T lClassCode = itCCP->second;
-                const stdair::SegmentCabin* lSegmentCabin_ptr =
-                  stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                          lCabinCode);
-                assert (lSegmentCabin_ptr != NULL);
-                const stdair::LegCabinList_T lLegCabinList =
-                  stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
-                assert (!lLegCabinList.empty());
-                const int lNbOfLegs = lLegCabinList.size();
-                // Determine the yield (equally distributed over segments and then legs).
-                const stdair::MeanStdDevPair_T& lMeanStdDevPair =
-                  lYieldDemandPair.second;
-                const stdair::Yield_T& lYield = lYieldDemandPair.first/(lNbOfLegs*lNbOfSegments);
-                const stdair::MeanValue_T& lMeanValue = lMeanStdDevPair.first;
-                const stdair::StdDevValue_T& lStdDevValue = lMeanStdDevPair.second;
-                for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                     itLC != lLegCabinList.end(); ++itLC) {
-                  stdair::LegCabin* lLegCabin_ptr = *itLC;
-                  assert (lLegCabin_ptr != NULL);
-                  lLegCabin_ptr->addDemandInformation (lYield, lMeanValue, lStdDevValue);
-                }
-              }
-            }
-          }
-        }
-      }
-    }
+    // Retrieve the O&D-dates of the whole network hitting a DCP on that
+    // date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+
+    const OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      getOnDIncidenceMatrix (lBomRoot);
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+    projectOnDDemand (lOnDIncidenceMatrix, PROJECTION_YP, lOnDDateList,
+                      lNbOfThreads);
   }
 
   // ///////////////////////////////////////////////////////////////////
-  void RMOL_Service::optimiseOnD (const stdair::DateTime_T& iRMEventTime) {
+  void RMOL_Service::optimiseOnD (const stdair::DateTime_T& iRMEventTime,
+                                  OptimisationControl* ioControl_ptr) {
 
     if (_rmolServiceContext == NULL) {
       throw stdair::NonInitialisedServiceException ("The Rmol service "
@@ -1519,6 +2055,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1528,6 +2065,9 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
+    // Retrieve the flight-dates hitting a DCP on that date
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+
     const stdair::InventoryList_T& lInvList =
       stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
     for (stdair::InventoryList_T::const_iterator itInv = lInvList.begin();
@@ -1535,26 +2075,29 @@ namespace RMOL {
       stdair::Inventory* lCurrentInv_ptr = *itInv;
       assert (lCurrentInv_ptr != NULL);
 
-      const stdair::FlightDateList_T& lFlightDateList =
-	stdair::BomManager::getList<stdair::FlightDate> (*lCurrentInv_ptr);
-      for (stdair::FlightDateList_T::const_iterator itFlightDate =
+      const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+        lDCPEventIndex.getDueFlightDateList (lDate, *lCurrentInv_ptr);
+      for (DCPEventIndex::DueFlightDateList_T::const_iterator itFlightDate =
 	     lFlightDateList.begin();
 	   itFlightDate != lFlightDateList.end(); ++itFlightDate) {
 	stdair::FlightDate* lCurrentFlightDate_ptr = *itFlightDate;
 	assert (lCurrentFlightDate_ptr != NULL);
 
+        // Once a stop is requested, the remaining flight-dates keep the
+        // result of their previous optimisation.
+        if (ioControl_ptr != NULL
+            && ioControl_ptr->isStopRequested() == true) {
+          ioControl_ptr->setInterrupted();
+          return;
+        }
+
         const stdair::Date_T& lCurrentDepartureDate = lCurrentFlightDate_ptr->getDepartureDate();
         stdair::DateOffset_T lDateOffset = lCurrentDepartureDate - lDate;
         stdair::DTD_T lDTD = short (lDateOffset.days());
       
-        stdair::DCPList_T::const_iterator itDCP =
-          std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-        // Check if the optimisation is needed.
-        if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-          STDAIR_LOG_DEBUG ("Optimisation using O&D forecast: " << lCurrentInv_ptr->getAirlineCode()
-                            << " Departure " << lCurrentDepartureDate << " DTD " << lDTD);
-          Optimiser::optimiseUsingOnDForecast (*lCurrentFlightDate_ptr);
-        }
+        STDAIR_LOG_DEBUG ("Optimisation using O&D forecast: " << lCurrentInv_ptr->getAirlineCode()
+                          << " Departure " << lCurrentDepartureDate << " DTD " << lDTD);
+        Optimiser::optimiseUsingOnDForecast (*lCurrentFlightDate_ptr);
       }
     }    
   }
@@ -1568,6 +2111,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1577,115 +2121,146 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
-    const stdair::InventoryList_T& lInvList =
-      stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
+    // Retrieve the flight-dates of the whole network hitting a DCP on
+    // that date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+      lDCPEventIndex.getDueFlightDateList (lDate);
+    updateBidPrice (lFlightDateList, lBomRoot);
+  }
 
-    for (stdair::InventoryList_T::const_iterator itInv = lInvList.begin();
-         itInv != lInvList.end(); ++itInv) {
-      stdair::Inventory* lCurrentInv_ptr = *itInv;
-      assert (lCurrentInv_ptr != NULL);
-      
-      const stdair::FlightDateList_T& lFlightDateList =
-	stdair::BomManager::getList<stdair::FlightDate> (*lCurrentInv_ptr);
-      for (stdair::FlightDateList_T::const_iterator itFlightDate =
-	     lFlightDateList.begin();
-	   itFlightDate != lFlightDateList.end(); ++itFlightDate) {
-	stdair::FlightDate* lCurrentFlightDate_ptr = *itFlightDate;
-	assert (lCurrentFlightDate_ptr != NULL);
+  // ///////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  updateBidPrice (const std::vector<stdair::FlightDate*>& iFlightDateList,
+                  stdair::BomRoot& iBomRoot,
+                  BidPriceAccelerator& ioBidPriceAccelerator) {
 
-        const stdair::Date_T& lCurrentDepartureDate = lCurrentFlightDate_ptr->getDepartureDate();
-        stdair::DateOffset_T lDateOffset = lCurrentDepartureDate - lDate;
-        stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-        stdair::DCPList_T::const_iterator itDCP =
-          std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-        // Check if the operation is needed.
-        if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-          updateBidPrice (*lCurrentFlightDate_ptr, lBomRoot);
-        }
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const unsigned int& lNbOfThreads = _rmolServiceContext->getNbOfThreads();
+
+    // Retrieve the images of the leg-cabins of each flight-date.
+    const LegCabinImageTable& lLegCabinImageTable =
+      getLegCabinImageTable (iBomRoot);
+    const unsigned int lNbOfFlightDates = iFlightDateList.size();
+    std::vector<const LegCabinImageList_T*> lLegCabinImageLists;
+    lLegCabinImageLists.reserve (lNbOfFlightDates);
+    for (std::vector<stdair::FlightDate*>::const_iterator itFD =
+           iFlightDateList.begin(); itFD != iFlightDateList.end(); ++itFD) {
+      const stdair::FlightDate* lFlightDate_ptr = *itFD;
+      assert (lFlightDate_ptr != NULL);
+      lLegCabinImageLists.push_back
+        (&lLegCabinImageTable.getLegCabinImageList (*lFlightDate_ptr));
+    }
+
+    // Update the bid prices of the real leg-cabins. Each flight-date
+    // writes only into its own leg-cabins.
+    ParallelLoop::run (lNbOfFlightDates,
+                       [&] (const unsigned int iFDIdx) {
+                         updateLegCabinBidPrices (*lLegCabinImageLists[iFDIdx]);
+                       },
+                       lNbOfThreads);
+
+    // Accelerate the convergence of the bid prices of all the leg-cabins
+    // of the flight-dates. The bid prices x(k) given to the last
+    // optimisation are their previous bid prices (recorded by the
+    // optimisation of each leg-cabin, even when it is skipped), and the
+    // bid prices G(x(k)) given back are the current ones. The accelerated
+    // bid prices replace the current ones, so that they are read by the
+    // next projection of the demand, sent to the partners and given back
+    // as x(k+1) by the next optimisation.
+    if (ioBidPriceAccelerator.getMethod() != BP_ACCELERATION_NONE) {
+      std::vector<stdair::LegCabin*> lLegCabinList;
+      getLegCabinList (iFlightDateList, lLegCabinList);
+      const unsigned int lNbOfLegCabins = lLegCabinList.size();
+      std::vector<double> lBidPriceList (lNbOfLegCabins);
+      std::vector<double> lNewBidPriceList (lNbOfLegCabins);
+      for (unsigned int idx = 0; idx < lNbOfLegCabins; ++idx) {
+        lBidPriceList[idx] = lLegCabinList[idx]->getPreviousBidPrice();
+        lNewBidPriceList[idx] = lLegCabinList[idx]->getCurrentBidPrice();
       }
+      ioBidPriceAccelerator.accelerate (lBidPriceList, lNewBidPriceList);
+      for (unsigned int idx = 0; idx < lNbOfLegCabins; ++idx) {
+        lLegCabinList[idx]->setCurrentBidPrice (lNewBidPriceList[idx]);
+      }
+    }
+
+    // Send the bid prices to the partners. Each flight-date writes only
+    // into the images of its own leg-cabins.
+    ParallelLoop::run (lNbOfFlightDates,
+                       [&] (const unsigned int iFDIdx) {
+                         sendLegCabinBidPrices (*lLegCabinImageLists[iFDIdx]);
+                       },
+                       lNbOfThreads);
+
+    // DEBUG
+    for (std::vector<const LegCabinImageList_T*>::const_iterator
+           itLCImageList = lLegCabinImageLists.begin();
+         itLCImageList != lLegCabinImageLists.end(); ++itLCImageList) {
+      logLegCabinBidPrices (**itLCImageList);
+    }
+  }
+
+  // ///////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  updateBidPrice (const std::vector<stdair::FlightDate*>& iFlightDateList,
+                  stdair::BomRoot& iBomRoot) {
+
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    const unsigned int& lNbOfThreads = _rmolServiceContext->getNbOfThreads();
+
+    // The table is built (when needed) before the flight-dates are
+    // processed concurrently.
+    const LegCabinImageTable& lLegCabinImageTable =
+      getLegCabinImageTable (iBomRoot);
+
+    // Each flight-date writes only into its own leg-cabins and into the
+    // images of those leg-cabins held by the marketing partners.
+    ParallelLoop::run (iFlightDateList.size(),
+                       [&] (const unsigned int iFDIdx) {
+                         const stdair::FlightDate* lFlightDate_ptr =
+                           iFlightDateList[iFDIdx];
+                         assert (lFlightDate_ptr != NULL);
+                         const LegCabinImageList_T& lLegCabinImageList =
+                           lLegCabinImageTable.
+                           getLegCabinImageList (*lFlightDate_ptr);
+                         updateLegCabinBidPrices (lLegCabinImageList);
+                         sendLegCabinBidPrices (lLegCabinImageList);
+                       },
+                       lNbOfThreads);
+
+    // DEBUG
+    for (std::vector<stdair::FlightDate*>::const_iterator itFD =
+           iFlightDateList.begin(); itFD != iFlightDateList.end(); ++itFD) {
+      const stdair::FlightDate* lFlightDate_ptr = *itFD;
+      assert (lFlightDate_ptr != NULL);
+      logLegCabinBidPrices (lLegCabinImageTable.
+                            getLegCabinImageList (*lFlightDate_ptr));
     }
   }
 
   // ///////////////////////////////////////////////////////////////////
   void RMOL_Service::updateBidPrice (const stdair::FlightDate& iFlightDate,
                                           stdair::BomRoot& iBomRoot) {
-    const stdair::SegmentDateList_T& lSegmentDateList =
-      stdair::BomManager::getList<stdair::SegmentDate> (iFlightDate);
-    const stdair::AirlineCode_T& lOptAC = iFlightDate.getAirlineCode();
-    const std::string lFDKeyStr = iFlightDate.describeKey();
-    
-    for (stdair::SegmentDateList_T::const_iterator itSegmentDate = lSegmentDateList.begin();
-         itSegmentDate != lSegmentDateList.end(); ++itSegmentDate) {
-      stdair::SegmentDate* lSegmentDate_ptr = *itSegmentDate;
-      assert (lSegmentDate_ptr != NULL);
-      const bool hasSegmentDateList =
-        stdair::BomManager::hasList<stdair::SegmentDate>(*lSegmentDate_ptr);
-      if (hasSegmentDateList == true) {
-        const stdair::LegDateList_T& lLegDateList =
-          stdair::BomManager::getList<stdair::LegDate>(*lSegmentDate_ptr);
-        // Get the list of marketing carriers segments.
-        // These are part of maketing partners inventories images held by the operating airline.
-        const stdair::SegmentDateList_T& lMktSegmentDateList =
-          stdair::BomManager::getList<stdair::SegmentDate>(*lSegmentDate_ptr);
-        for (stdair::SegmentDateList_T::const_iterator itMktSD = lMktSegmentDateList.begin();
-             itMktSD != lMktSegmentDateList.end(); ++itMktSD) {
-          // Get the marketing airline code.
-          stdair::SegmentDate* lMktSD_ptr = *itMktSD;
-          assert (lMktSD_ptr != NULL);
-          stdair::FlightDate* lMktFD_ptr =
-            stdair::BomManager::getParentPtr<stdair::FlightDate>(*lMktSD_ptr);
-          assert (lMktFD_ptr != NULL);
-          const stdair::AirlineCode_T& lMktAC = lMktFD_ptr->getAirlineCode();
-          // Get the (real) marketer inventory.
-          const stdair::Inventory* lMktInv_ptr =
-            stdair::BomManager::getObjectPtr<stdair::Inventory>(iBomRoot,lMktAC);
-          assert (lMktInv_ptr != NULL);
-          // Get the image of the operating airline inventory held by the marketer.
-          const stdair::Inventory* lOptInv_ptr =
-            stdair::BomManager::getObjectPtr<stdair::Inventory>(*lMktInv_ptr,lOptAC);
-          assert (lOptInv_ptr != NULL);
-          // Find the image of the concerned flight date.
-          const stdair::FlightDate* lOptFD_ptr =
-            stdair::BomManager::getObjectPtr<stdair::FlightDate>(*lOptInv_ptr,lFDKeyStr);
-          assert (lOptFD_ptr != NULL);
-          // Browse the list of leg dates in the real operating inventory.
-          // Retrieve the image of each leg date.
-          for (stdair::LegDateList_T::const_iterator itLD = lLegDateList.begin();
-               itLD != lLegDateList.end(); ++itLD) {
-            const stdair::LegDate* lLD_ptr = *itLD;
-            assert (lLD_ptr != NULL);
-            const std::string lLDKeyStr = lLD_ptr->describeKey();
-            stdair::LegDate* lOptLD_ptr =
-              stdair::BomManager::getObjectPtr<stdair::LegDate>(*lOptFD_ptr,lLDKeyStr);
-            assert (lOptLD_ptr != NULL);
-            const stdair::LegCabinList_T& lLegCabinList_T =
-              stdair::BomManager::getList<stdair::LegCabin>(*lLD_ptr);
-            // Browse the list of leg cabins in the real operating inventory.
-            // Retrieve the image of each leg cabin and update the bid price of the real and send it to the image.
-            for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList_T.begin();
-                 itLC != lLegCabinList_T.end(); ++itLC) {
-              stdair::LegCabin* lLC_ptr = *itLC;
-              assert (lLC_ptr != NULL);
-              const std::string lLCKeyStr = lLC_ptr->describeKey();
-              stdair::LegCabin* lOptLC_ptr =
-                stdair::BomManager::getObjectPtr<stdair::LegCabin>(*lOptLD_ptr, lLCKeyStr);
-              assert (lOptLC_ptr != NULL);
-              // Update the current bid price of the real leg.
-              lLC_ptr->updateCurrentBidPrice();
-              // Update the previous bid price (store the current).
-              lOptLC_ptr->updatePreviousBidPrice();
-              // Update the current bid price.
-              lOptLC_ptr->setCurrentBidPrice (lLC_ptr->getCurrentBidPrice());
-
-              STDAIR_LOG_DEBUG ("Update bid price of " << lLC_ptr->getFullerKey()
-                                << " : " << lOptLC_ptr->getCurrentBidPrice()
-                                << " Availability pool " << lLC_ptr->getAvailabilityPool());
-            }
-          }
-        }
-      }
-    }
+    assert (_rmolServiceContext != NULL);
+    ServiceLock_T lLock (_rmolServiceContext->getMutex());
+
+    // Update the bid price of each real leg-cabin and send it to its
+    // images.
+    const LegCabinImageTable& lLegCabinImageTable =
+      getLegCabinImageTable (iBomRoot);
+    const LegCabinImageList_T& lLegCabinImageList =
+      lLegCabinImageTable.getLegCabinImageList (iFlightDate);
+    updateLegCabinBidPrices (lLegCabinImageList);
+    sendLegCabinBidPrices (lLegCabinImageList);
+    logLegCabinBidPrices (lLegCabinImageList);
   }
 
   // ///////////////////////////////////////////////////////////////////
@@ -1697,6 +2272,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -1706,142 +2282,17 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
-    const stdair::InventoryList_T lInventoryList =
-      stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
-    assert (!lInventoryList.empty());
-    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
-         itInv != lInventoryList.end(); ++itInv) {
-      const stdair::Inventory* lInventory_ptr = *itInv;
-      assert (lInventory_ptr != NULL);
-      const stdair::OnDDateList_T lOnDDateList =
-        stdair::BomManager::getList<stdair::OnDDate> (*lInventory_ptr);
-      assert (!lOnDDateList.empty());
-      for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
-           itOD != lOnDDateList.end(); ++itOD) {
-        stdair::OnDDate* lOnDDate_ptr = *itOD;
-        assert (lOnDDate_ptr != NULL);
-
-        const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
-        stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-        stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-        stdair::DCPList_T::const_iterator itDCP =
-          std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-        // Check if the forecast for this O&D date needs to be projected.
-        if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-
-          // Browse the demand info map.
-          const stdair::StringDemandStructMap_T& lStringDemandStructMap =
-            lOnDDate_ptr->getDemandInfoMap ();
-          for (stdair::StringDemandStructMap_T::const_iterator itStrDS = lStringDemandStructMap.begin();
-               itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
-            std::string lCabinClassPath = itStrDS->first;
-            const stdair::YieldDemandPair_T& lYieldDemandPair = itStrDS->second;
-            const stdair::CabinClassPairList_T& lCabinClassPairList =
-              lOnDDate_ptr->getCabinClassPairList(lCabinClassPath);
-            const stdair::NbOfSegments_T& lNbOfSegments = lOnDDate_ptr->getNbOfSegments();
-            // Sanity check
-            assert (lCabinClassPairList.size() == lNbOfSegments);
-
-            //
-            const stdair::SegmentDateList_T lOnDSegmentDateList =
-              stdair::BomManager::getList<stdair::SegmentDate> (*lOnDDate_ptr);
-            // Sanity check
-            assert (lOnDSegmentDateList.size() == lNbOfSegments);
-            stdair::CabinClassPairList_T::const_iterator itCCP = lCabinClassPairList.begin();
-            stdair::SegmentDateList_T::const_iterator itSD = lOnDSegmentDateList.begin();
-            // List of bid prices that will be used to easily compute displacement-ajusted yields.
-            std::list<stdair::BidPrice_T> lBidPriceList;
-            // The sum of bid prices that will be stored in the list above.
-            stdair::BidPrice_T lTotalBidPrice = 0;
-            // Retrieve the bid prices
-            for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
-              // Get the operating segment cabin (it holds the bid price information).
-              const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-              assert (lSegmentDate_ptr != NULL);
-              // Get the operating airline code and check if it is the airline we are looking for.
-              const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-                lSegmentDate_ptr->getOperatingSegmentDate ();
-              if (lOperatingSegmentDate_ptr != NULL) {
-                lSegmentDate_ptr = lOperatingSegmentDate_ptr;
-              }
-              const stdair::CabinCode_T lCabinCode = itCCP->first;
-              const stdair::SegmentCabin* lSegmentCabin_ptr =
-                stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                        lCabinCode);
-              assert (lSegmentCabin_ptr != NULL);
-              stdair::BidPrice_T lBidPrice = 0;
-              const stdair::LegCabinList_T lLegCabinList =
-                stdair::BomManager::getList<stdair::LegCabin>(*lSegmentCabin_ptr);
-              for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                   itLC != lLegCabinList.end(); ++itLC) {
-                const stdair::LegCabin* lLegCabin_ptr = *itLC;
-                assert (lLegCabin_ptr != NULL);
-                lBidPrice += lLegCabin_ptr->getCurrentBidPrice();
-              }
-              lBidPriceList.push_back (lBidPrice);
-              lTotalBidPrice += lBidPrice;
-            }            
-            
-            
-            itCCP = lCabinClassPairList.begin();
-            itSD = lOnDSegmentDateList.begin();
-            std::list<stdair::BidPrice_T>::const_iterator itBP = lBidPriceList.begin();
-            for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD, ++itBP) {
-              stdair::BidPrice_T lBidPrice = *itBP;
-              stdair::BidPrice_T lComplementaryBidPrice = lTotalBidPrice - lBidPrice;
-              const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-              assert (lSegmentDate_ptr != NULL);
-              const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-                lSegmentDate_ptr->getOperatingSegmentDate ();
-              // Only operated legs receive the demand information.
-              if (lOperatingSegmentDate_ptr == NULL) {
-                const stdair::CabinCode_T lCabinCode = itCCP->first;
-                const stdair::ClassCode_T lClassCode = itCCP->second;
-                const stdair::SegmentCabin* lSegmentCabin_ptr =
-                  stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                          lCabinCode);
-                assert (lSegmentCabin_ptr != NULL);
-                const stdair::LegCabinList_T lLegCabinList =
-                  stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
-                assert (!lLegCabinList.empty());                
-                // Determine the displacement-adjusted yield.
-                // It is set to 100 (positive small value), if the computed value is negative.                
-                const stdair::Yield_T& lDAYield =
-                  std::max(100., lYieldDemandPair.first - lComplementaryBidPrice);
-                
-                                
-                stdair::Yield_T lYield = lDAYield;
-                // In order to be protected against important variations of partners' bid price,
-                // the displacement adjusted yield is noy allowed to get out of a certain range.
-                // This range is here chosen to be from 80% to 100% of the (static rule) prorated yield.
-                /*
-                const int lNbOfLegs = lLegCabinList.size();
-                const stdair::Yield_T& lStaticProrationYield =
-                  lDemandStruct.getYield()/(lNbOfLegs*lNbOfSegments); 
-                if (lDAYield < 0.8*lStaticProrationYield){
-                  lYield = 0.8*lStaticProrationYield;
-                }
-                if (lDAYield > lStaticProrationYield) {
-                  lYield = lStaticProrationYield;
-                }
-                */
-                const stdair::MeanStdDevPair_T& lMeanStdDevPair =
-                  lYieldDemandPair.second;
-                const stdair::MeanValue_T& lMeanValue = lMeanStdDevPair.first;
-                const stdair::StdDevValue_T& lStdDevValue = lMeanStdDevPair.second;
-                for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                     itLC != lLegCabinList.end(); ++itLC) {
-                  stdair::LegCabin* lLegCabin_ptr = *itLC;
-                  assert (lLegCabin_ptr != NULL);
-                  lLegCabin_ptr->addDemandInformation (lYield, lMeanValue, lStdDevValue);
-                }
-              }
-            }
-          }
-        }
-      }
-    }
+    // Retrieve the O&D-dates of the whole network hitting a DCP on that
+    // date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+
+    const OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      getOnDIncidenceMatrix (lBomRoot);
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+    projectOnDDemand (lOnDIncidenceMatrix, PROJECTION_DA, lOnDDateList,
+                      lNbOfThreads);
   }
 
   // ///////////////////////////////////////////////////////////////////
@@ -1853,141 +2304,78 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
     
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
       lRMOL_ServiceContext.getSTDAIR_Service();
     stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
-    
-    const stdair::InventoryList_T lInventoryList =
-      stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
-    assert (!lInventoryList.empty());
-    for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
-         itInv != lInventoryList.end(); ++itInv) {
-      const stdair::Inventory* lInventory_ptr = *itInv;
-      assert (lInventory_ptr != NULL);
-      projectOnDDemandOnLegCabinsUsingDYP (iRMEventTime, *lInventory_ptr);
-    }
+
+    // Retrieve the date from the RM event
+    const stdair::Date_T lDate = iRMEventTime.date();
+
+    // Retrieve the O&D-dates of the whole network hitting a DCP on that
+    // date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+    projectOnDDemandOnLegCabinsUsingDYP (lOnDDateList);
   }
 
   // ///////////////////////////////////////////////////////////////////
   void RMOL_Service::projectOnDDemandOnLegCabinsUsingDYP(const stdair::DateTime_T& iRMEventTime,
                                                          const stdair::Inventory& iInventory) {
-    
-    const stdair::OnDDateList_T lOnDDateList =
-      stdair::BomManager::getList<stdair::OnDDate> (iInventory);
-    assert (!lOnDDateList.empty());
-    for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
-         itOD != lOnDDateList.end(); ++itOD) {
-      stdair::OnDDate* lOnDDate_ptr = *itOD;
-      assert (lOnDDate_ptr != NULL);
-      
-      // Retrieve the date from the RM event
-      const stdair::Date_T lDate = iRMEventTime.date();
 
-      const stdair::Date_T& lDepartureDate = lOnDDate_ptr->getDate();
-      stdair::DateOffset_T lDateOffset = lDepartureDate - lDate;
-      stdair::DTD_T lDTD = short (lDateOffset.days());
-      
-      stdair::DCPList_T::const_iterator itDCP =
-        std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-      // Check if the forecast for this O&D date needs to be projected.
-      if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-        
-        // Browse the demand info map.
-        const stdair::StringDemandStructMap_T& lStringDemandStructMap =
-          lOnDDate_ptr->getDemandInfoMap ();
-        for (stdair::StringDemandStructMap_T::const_iterator itStrDS = lStringDemandStructMap.begin();
-             itStrDS != lStringDemandStructMap.end(); ++itStrDS) {
-          std::string lCabinClassPath = itStrDS->first;
-          const stdair::YieldDemandPair_T& lYieldDemandPair = itStrDS->second;
-          const stdair::CabinClassPairList_T& lCabinClassPairList =
-            lOnDDate_ptr->getCabinClassPairList(lCabinClassPath);
-          const stdair::NbOfSegments_T& lNbOfSegments = lOnDDate_ptr->getNbOfSegments();
-          // Sanity check
-          assert (lCabinClassPairList.size() == lNbOfSegments);
-          
-          //
-          const stdair::SegmentDateList_T lOnDSegmentDateList =
-              stdair::BomManager::getList<stdair::SegmentDate> (*lOnDDate_ptr);
-          // Sanity check
-          assert (lOnDSegmentDateList.size() == lNbOfSegments);
-          stdair::CabinClassPairList_T::const_iterator itCCP = lCabinClassPairList.begin();
-          stdair::SegmentDateList_T::const_iterator itSD = lOnDSegmentDateList.begin();
-          // The sum of bid prices of all cabins.
-          stdair::BidPrice_T lTotalBidPrice = 0;
-          for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
-            // Get the operating segment cabin (it holds the bid price information).
-            const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-            assert (lSegmentDate_ptr != NULL);
-            // Get the operating airline code and check if it is the airline we are looking for.
-            const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-              lSegmentDate_ptr->getOperatingSegmentDate ();
-            if (lOperatingSegmentDate_ptr != NULL) {
-              lSegmentDate_ptr = lOperatingSegmentDate_ptr;
-            }
-            const stdair::CabinCode_T lCabinCode = itCCP->first;
-            const stdair::SegmentCabin* lSegmentCabin_ptr =
-              stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                      lCabinCode);
-            assert (lSegmentCabin_ptr != NULL);
-            const stdair::LegCabinList_T lLegCabinList =
-              stdair::BomManager::getList<stdair::LegCabin>(*lSegmentCabin_ptr);
-            for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                 itLC != lLegCabinList.end(); ++itLC) {
-              const stdair::LegCabin* lLegCabin_ptr = *itLC;
-              assert (lLegCabin_ptr != NULL);
-              lTotalBidPrice += lLegCabin_ptr->getCurrentBidPrice();
-            }
-          }            
-          
-          
-          itCCP = lCabinClassPairList.begin();
-          itSD = lOnDSegmentDateList.begin();
-          for (; itSD != lOnDSegmentDateList.end(); ++itCCP, ++itSD) {
-            const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
-            assert (lSegmentDate_ptr != NULL);
-            const stdair::SegmentDate* lOperatingSegmentDate_ptr =
-              lSegmentDate_ptr->getOperatingSegmentDate ();
-            // Only operated legs receive the demand information.
-            if (lOperatingSegmentDate_ptr == NULL) {
-              const stdair::CabinCode_T lCabinCode = itCCP->first;
-              const stdair::ClassCode_T lClassCode = itCCP->second;
-              const stdair::SegmentCabin* lSegmentCabin_ptr =
-                stdair::BomManager::getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr,
-                                                                        lCabinCode);
-              assert (lSegmentCabin_ptr != NULL);
-              const stdair::LegCabinList_T lLegCabinList =
-                stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
-              assert (!lLegCabinList.empty());
-              const stdair::Yield_T& lYield = lYieldDemandPair.first;            
-              const stdair::MeanStdDevPair_T& lMeanStdDevPair =
-                lYieldDemandPair.second;
-              const stdair::MeanValue_T& lMeanValue = lMeanStdDevPair.first;
-              const stdair::StdDevValue_T& lStdDevValue = lMeanStdDevPair.second;
-              for (stdair::LegCabinList_T::const_iterator itLC = lLegCabinList.begin();
-                   itLC != lLegCabinList.end(); ++itLC) {
-                stdair::LegCabin* lLegCabin_ptr = *itLC;
-                assert (lLegCabin_ptr != NULL);
-                const stdair::BidPrice_T& lBidPrice = lLegCabin_ptr->getCurrentBidPrice();
-                const stdair::RealNumber_T lDynamicYieldProrationFactor = lBidPrice / lTotalBidPrice;
-                const stdair::Yield_T lProratedYield = lDynamicYieldProrationFactor*lYield;
-                lLegCabin_ptr->addDemandInformation (lProratedYield, lMeanValue, lStdDevValue);
-                
-                // STDAIR_LOG_DEBUG ("Addding demand information to leg-cabin " << lLegCabin_ptr->getFullerKey()
-                //                   << " Total yield " << lYield << " Proration factor "
-                //                   << lDynamicYieldProrationFactor << " Prorated yield " << lProratedYield
-                //                   << " Mean demand " << lMeanValue << " StdDev " << lStdDevValue);
-              }
-            }
-          }
-        }
-      }
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    // Retrieve the bom root
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lRMOL_ServiceContext.getSTDAIR_Service();
+    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Retrieve the date from the RM event
+    const stdair::Date_T lDate = iRMEventTime.date();
+
+    // Retrieve the O&D-dates hitting a DCP on that date
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate, iInventory);
+    projectOnDDemandOnLegCabinsUsingDYP (lOnDDateList);
+  }
+
+  // ///////////////////////////////////////////////////////////////////
+  void RMOL_Service::
+  projectOnDDemandOnLegCabinsUsingDYP (const std::vector<stdair::OnDDate*>& iOnDDateList) {
+
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
     }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+
+    // Retrieve the bom root
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lRMOL_ServiceContext.getSTDAIR_Service();
+    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    const OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      getOnDIncidenceMatrix (lBomRoot);
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+    projectOnDDemand (lOnDIncidenceMatrix, PROJECTION_DYP, iOnDDateList,
+                      lNbOfThreads);
   }
 
   // ///////////////////////////////////////////////////////////////////
-  void RMOL_Service::optimiseOnDUsingRMCooperation (const stdair::DateTime_T& iRMEventTime) {
+  void RMOL_Service::
+  optimiseOnDUsingRMCooperation (const stdair::DateTime_T& iRMEventTime,
+                                 OptimisationControl* ioControl_ptr) {
 
     if (_rmolServiceContext == NULL) {
       throw stdair::NonInitialisedServiceException ("The Rmol service "
@@ -1995,6 +2383,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -2004,6 +2393,11 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
+    // Retrieve the flight-dates hitting a DCP on that date
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+
     // Browse the list of inventories and optimise within each one independently.
     const stdair::InventoryList_T& lInvList =
       stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
@@ -2012,32 +2406,33 @@ namespace RMOL {
       stdair::Inventory* lCurrentInv_ptr = *itInv;
       assert (lCurrentInv_ptr != NULL);
       
+      // Only the leg-cabins the demand of which changed since the
+      // previous iteration are optimised again.
+      const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+        lDCPEventIndex.getDueFlightDateList (lDate, *lCurrentInv_ptr);
+      const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+        lDCPEventIndex.getDueOnDDateList (lDate, *lCurrentInv_ptr);
+      BidPriceActiveSet lBidPriceActiveSet;
+      lBidPriceActiveSet.build (lFlightDateList, lOnDDateList);
+
       double lMaxBPVariation = 1.0;
-      short lIterationCounter = 0;
+      unsigned short lIterationCounter = 0;
       // Iterate until the variation is under the wanted level or the maximal number of iterations is reached.
-      while (lMaxBPVariation > 0.01 && lIterationCounter < 10) {
-        lMaxBPVariation = 0.0;
-        lIterationCounter++;
-        const stdair::FlightDateList_T& lFlightDateList =
-          stdair::BomManager::getList<stdair::FlightDate> (*lCurrentInv_ptr);
-        for (stdair::FlightDateList_T::const_iterator itFlightDate =
-               lFlightDateList.begin();
-             itFlightDate != lFlightDateList.end(); ++itFlightDate) {
-          stdair::FlightDate* lCurrentFlightDate_ptr = *itFlightDate;
-          assert (lCurrentFlightDate_ptr != NULL);
-          
-          const stdair::Date_T& lCurrentDepartureDate = lCurrentFlightDate_ptr->getDepartureDate();
-          stdair::DateOffset_T lDateOffset = lCurrentDepartureDate - lDate;
-          stdair::DTD_T lDTD = short (lDateOffset.days());
-          
-          stdair::DCPList_T::const_iterator itDCP =
-            std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-          // Check if the optimisation is needed.
-          if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-            const double lBPVariation = Optimiser::optimiseUsingOnDForecast (*lCurrentFlightDate_ptr);
-            lMaxBPVariation = std::max(lMaxBPVariation, lBPVariation);
-          }
+      while (lMaxBPVariation > DEFAULT_STOPPING_CRITERION
+             && lIterationCounter < DEFAULT_MAX_NB_OF_RMC_ITERATIONS) {
+        // Once a stop is requested, the bid prices of the last complete
+        // iteration are kept.
+        if (ioControl_ptr != NULL
+            && ioControl_ptr->isStopRequested() == true) {
+          ioControl_ptr->setInterrupted();
+          return;
         }
+        lIterationCounter++;
+        lBidPriceActiveSet.update();
+        lMaxBPVariation = Optimiser::
+          optimiseUsingOnDForecast (lBidPriceActiveSet.getLegCabinList(),
+                                    lBidPriceActiveSet.getActiveFlagList(),
+                                    lNbOfThreads);
         // Update the prorated yields for the current inventory.
         resetDemandInformation (iRMEventTime, *lCurrentInv_ptr);
         projectOnDDemandOnLegCabinsUsingDYP (iRMEventTime, *lCurrentInv_ptr);
@@ -2047,7 +2442,9 @@ namespace RMOL {
 
    
   // ///////////////////////////////////////////////////////////////////
-  void RMOL_Service::optimiseOnDUsingAdvancedRMCooperation (const stdair::DateTime_T& iRMEventTime) {
+  void RMOL_Service::
+  optimiseOnDUsingAdvancedRMCooperation (const stdair::DateTime_T& iRMEventTime,
+                                         OptimisationControl* ioControl_ptr) {
 
     if (_rmolServiceContext == NULL) {
       throw stdair::NonInitialisedServiceException ("The Rmol service "
@@ -2055,6 +2452,7 @@ namespace RMOL {
     }
     assert (_rmolServiceContext != NULL);
     RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
 
     // Retrieve the bom root
     stdair::STDAIR_Service& lSTDAIR_Service =
@@ -2064,46 +2462,144 @@ namespace RMOL {
     // Retrieve the date from the RM event
     const stdair::Date_T lDate = iRMEventTime.date();
 
+    // Retrieve the flight-dates and O&D-dates of the whole network hitting
+    // a DCP on that date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+      lDCPEventIndex.getDueFlightDateList (lDate);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+    NetworkIterationReport& lNetworkIterationReport =
+      lRMOL_ServiceContext.getNetworkIterationReport();
+    lNetworkIterationReport.reset();
+
+    // Only the leg-cabins the demand of which changed since the previous
+    // iteration are optimised again.
+    BidPriceActiveSet lBidPriceActiveSet;
+    lBidPriceActiveSet.build (lFlightDateList, lOnDDateList);
+
+    // Acceleration of the iterations on the exchanged bid prices.
+    BidPriceAccelerator lBidPriceAccelerator
+      (lRMOL_ServiceContext.getBidPriceAccelerationMethod(),
+       lRMOL_ServiceContext.getBidPriceDampingFactor());
+
     double lMaxBPVariation = 1.0;
-    short lIterationCounter = 0;
     // Iterate until the variation is under the wanted level or the maximal number of iterations is reached.
-    // Every iteration corresponds to the optimisation of the whole network. Bid prices are communicated
-    // between partners at the end of each iteration.
-    while (lMaxBPVariation > 0.01 && lIterationCounter < 50) {
-      lMaxBPVariation = 0.0;
-      lIterationCounter++;
-
-      const stdair::InventoryList_T& lInvList =
-        stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
-      for (stdair::InventoryList_T::const_iterator itInv = lInvList.begin();
-           itInv != lInvList.end(); ++itInv) {
-        stdair::Inventory* lCurrentInv_ptr = *itInv;
-        assert (lCurrentInv_ptr != NULL);
-        const stdair::FlightDateList_T& lFlightDateList =
-          stdair::BomManager::getList<stdair::FlightDate> (*lCurrentInv_ptr);
-        for (stdair::FlightDateList_T::const_iterator itFlightDate =
-               lFlightDateList.begin();
-             itFlightDate != lFlightDateList.end(); ++itFlightDate) {
-          stdair::FlightDate* lCurrentFlightDate_ptr = *itFlightDate;
-          assert (lCurrentFlightDate_ptr != NULL);
-          
-          const stdair::Date_T& lCurrentDepartureDate = lCurrentFlightDate_ptr->getDepartureDate();
-          stdair::DateOffset_T lDateOffset = lCurrentDepartureDate - lDate;
-          stdair::DTD_T lDTD = short (lDateOffset.days());
-          
-          stdair::DCPList_T::const_iterator itDCP =
-            std::find (stdair::DEFAULT_DCP_LIST.begin(), stdair::DEFAULT_DCP_LIST.end(), lDTD);
-          if (itDCP != stdair::DEFAULT_DCP_LIST.end()) {
-            const double lBPVariation = Optimiser::optimiseUsingOnDForecast (*lCurrentFlightDate_ptr);
-            lMaxBPVariation = std::max(lMaxBPVariation, lBPVariation);
-          }
-        }
+    // Every iteration corresponds to the optimisation of the whole network (Jacobi sweep): all the
+    // leg-cabins are optimised concurrently from the demand projected with the bid prices of the
+    // previous iteration. Bid prices are communicated between partners at the end of each iteration.
+    // The control is only checked between the iterations, so that a stop
+    // keeps the bid prices of the last complete iteration on the whole
+    // network.
+    while (lMaxBPVariation > DEFAULT_STOPPING_CRITERION
+           && lNetworkIterationReport.getNbOfIterations()
+           < DEFAULT_MAX_NB_OF_NETWORK_ITERATIONS) {
+      if (ioControl_ptr != NULL && ioControl_ptr->isStopRequested() == true) {
+        ioControl_ptr->setInterrupted();
+        break;
       }
-      // At the end of each iteration, communicate bid prices and compute displacement adjusted yields.
-      updateBidPrice (iRMEventTime);
+      lBidPriceActiveSet.update();
+      const unsigned int lNbOfActiveLegCabins =
+        lBidPriceActiveSet.getNbOfActiveLegCabins();
+      lMaxBPVariation = Optimiser::
+        optimiseUsingOnDForecast (lBidPriceActiveSet.getLegCabinList(),
+                                  lBidPriceActiveSet.getActiveFlagList(),
+                                  lNbOfThreads);
+      lNetworkIterationReport.addIteration (lMaxBPVariation,
+                                            lNbOfActiveLegCabins);
+
+      // DEBUG
+      STDAIR_LOG_DEBUG ("Network iteration "
+                        << lNetworkIterationReport.getNbOfIterations()
+                        << ": maximal bid price variation " << lMaxBPVariation
+                        << ", " << lNbOfActiveLegCabins
+                        << " optimised leg-cabin(s)");
+
+      // At the end of each iteration, communicate (accelerated) bid prices and compute displacement adjusted yields.
+      updateBidPrice (lFlightDateList, lBomRoot, lBidPriceAccelerator);
       resetDemandInformation (iRMEventTime);
-      projectOnDDemandOnLegCabinsUsingDYP (iRMEventTime);
-    }    
+      projectOnDDemandOnLegCabinsUsingDYP (lOnDDateList);
+    }
+    const bool isInterrupted =
+      (ioControl_ptr != NULL && ioControl_ptr->isInterrupted() == true);
+    lNetworkIterationReport.setConverged (isInterrupted == false
+                                          && lMaxBPVariation
+                                          <= DEFAULT_STOPPING_CRITERION);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lNetworkIterationReport.describe());
+  }
+
+  // ///////////////////////////////////////////////////////////////////
+  bool RMOL_Service::
+  optimiseOnDUsingNetworkLP (const stdair::DateTime_T& iRMEventTime,
+                             OptimisationControl* ioControl_ptr) {
+
+    if (_rmolServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The Rmol service "
+                                                    "has not been initialised");
+    }
+    assert (_rmolServiceContext != NULL);
+    RMOL_ServiceContext& lRMOL_ServiceContext = *_rmolServiceContext;
+    ServiceLock_T lLock (lRMOL_ServiceContext.getMutex());
+
+    // Retrieve the bom root
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lRMOL_ServiceContext.getSTDAIR_Service();
+    stdair::BomRoot& lBomRoot = lSTDAIR_Service.getBomRoot();
+
+    // Retrieve the date from the RM event
+    const stdair::Date_T lDate = iRMEventTime.date();
+
+    // Retrieve the flight-dates and O&D-dates of the whole network hitting
+    // a DCP on that date (inventory after inventory)
+    const DCPEventIndex& lDCPEventIndex = getDCPEventIndex (lBomRoot);
+    const DCPEventIndex::DueFlightDateList_T& lFlightDateList =
+      lDCPEventIndex.getDueFlightDateList (lDate);
+    const DCPEventIndex::DueOnDDateList_T& lOnDDateList =
+      lDCPEventIndex.getDueOnDDateList (lDate);
+
+    const OnDIncidenceMatrix& lOnDIncidenceMatrix =
+      getOnDIncidenceMatrix (lBomRoot);
+    const LegCabinImageTable& lLegCabinImageTable =
+      getLegCabinImageTable (lBomRoot);
+    NetworkLPBasis& lNetworkLPBasis = lRMOL_ServiceContext.getNetworkLPBasis();
+    const unsigned int& lNbOfThreads = lRMOL_ServiceContext.getNbOfThreads();
+
+    // The randomised linear program averages the shadow prices over the
+    // demand scenarios.
+    stdair::NbOfSamples_T lNbOfScenarios = 0;
+    if (lRMOL_ServiceContext.getNetworkOptimisationMethod()
+        == NETWORK_OPTIMISATION_RLP) {
+      lNbOfScenarios = lRMOL_ServiceContext.getNbOfRLPScenarios();
+    }
+
+    // A single resolution: the report holds no iteration.
+    NetworkIterationReport& lNetworkIterationReport =
+      lRMOL_ServiceContext.getNetworkIterationReport();
+    lNetworkIterationReport.reset();
+
+    const bool isOptimal =
+      Optimiser::optimiseUsingNetworkLP (lOnDIncidenceMatrix,
+                                         lLegCabinImageTable, lOnDDateList,
+                                         lFlightDateList, lNbOfScenarios,
+                                         lNbOfThreads, lNetworkLPBasis,
+                                         ioControl_ptr);
+    lNetworkIterationReport.setConverged (isOptimal);
+    if (isOptimal == false) {
+      // DEBUG
+      STDAIR_LOG_DEBUG ("The network LP could not be solved on " << lDate
+                        << " (interrupted: "
+                        << (ioControl_ptr != NULL
+                            && ioControl_ptr->isInterrupted()) << ")");
+      return false;
+    }
+
+    // Communicate the bid prices to the partners.
+    updateBidPrice (lFlightDateList, lBomRoot);
+    return true;
   }
 
 }
@@ -7,13 +7,20 @@
 // StdAir
 #include <stdair/STDAIR_Service.hpp>
 // RMOL
+#include <rmol/basic/BasConst_General.hpp>
 #include <rmol/basic/BasConst_RMOL_Service.hpp>
 #include <rmol/service/RMOL_ServiceContext.hpp>
 
 namespace RMOL {
 
   // ////////////////////////////////////////////////////////////////////
-  RMOL_ServiceContext::RMOL_ServiceContext() : _ownStdairService (false) {
+  RMOL_ServiceContext::RMOL_ServiceContext()
+    : _ownStdairService (false), _nbOfThreads (DEFAULT_NUMBER_OF_THREADS),
+      _bidPriceAccelerationMethod (DEFAULT_BID_PRICE_ACCELERATION_METHOD),
+      _bidPriceDampingFactor (DEFAULT_BID_PRICE_DAMPING_FACTOR),
+      _networkOptimisationMethod (DEFAULT_NETWORK_OPTIMISATION_METHOD),
+      _nbOfRLPScenarios (DEFAULT_NB_OF_RLP_SCENARIOS),
+      _previousForecastDate (stdair::Date_T (2000, 1, 1)) {
   }
   
   // ////////////////////////////////////////////////////////////////////
@@ -34,7 +41,10 @@ namespace RMOL {
   // //////////////////////////////////////////////////////////////////////
   const std::string RMOL_ServiceContext::shortDisplay() const {
     std::ostringstream oStr;
-    oStr << "RMOL_ServiceContext -- Owns StdAir service: " << _ownStdairService;
+    oStr << "RMOL_ServiceContext -- Owns StdAir service: " << _ownStdairService
+         << ", number of threads: " << _nbOfThreads
+         << ", " << _historicalBookingWindowHolder.describe()
+         << ", " << _forecastCache.describe();
     return oStr.str();
   }
 
@@ -6,14 +6,25 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <string>
+#include <mutex>
 // StdAir
 #include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
 #include <stdair/stdair_inventory_types.hpp>
 #include <stdair/stdair_maths_types.hpp>
 #include <stdair/stdair_service_types.hpp>
 #include <stdair/service/ServiceAbstract.hpp>
 // RMOL
 #include <rmol/RMOL_Types.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
+#include <rmol/bom/ForecastCache.hpp>
+#include <rmol/bom/DCPEventIndex.hpp>
+#include <rmol/bom/LegCabinImageTable.hpp>
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+#include <rmol/bom/NetworkIterationReport.hpp>
+#include <rmol/bom/NetworkLPBasis.hpp>
+#include <rmol/bom/YieldFeaturesIndex.hpp>
+#include <rmol/bom/OnDForecastTable.hpp>
 
 /// Forward declarations
 namespace stdair {
@@ -56,6 +67,133 @@ namespace RMOL {
       return _ownStdairService;
     }
 
+    /**
+     * Get the number of threads used by the parallel algorithms.
+     */
+    const unsigned int& getNbOfThreads() const {
+      return _nbOfThreads;
+    }
+
+    /**
+     * Get the sliding windows of historical bookings (forecast state).
+     */
+    HistoricalBookingWindowHolder& getHistoricalBookingWindowHolder() {
+      return _historicalBookingWindowHolder;
+    }
+
+    /**
+     * Get the cache of the segment-cabin forecasts.
+     */
+    ForecastCache& getForecastCache() {
+      return _forecastCache;
+    }
+
+    /**
+     * Get the calendar index of the flight-dates and O&D-dates, by the
+     * dates of their DCPs.
+     */
+    DCPEventIndex& getDCPEventIndex() {
+      return _dcpEventIndex;
+    }
+
+    /**
+     * Get the table linking the leg-cabins to their images held by the
+     * marketing partners.
+     */
+    LegCabinImageTable& getLegCabinImageTable() {
+      return _legCabinImageTable;
+    }
+
+    /**
+     * Get the incidence matrix between the segment-cabins of the
+     * O&D-dates and the leg-cabins.
+     */
+    OnDIncidenceMatrix& getOnDIncidenceMatrix() {
+      return _onDIncidenceMatrix;
+    }
+
+    /**
+     * Get the report of the last network optimisation.
+     */
+    NetworkIterationReport& getNetworkIterationReport() {
+      return _networkIterationReport;
+    }
+
+    /**
+     * Get the report of the last network optimisation.
+     */
+    const NetworkIterationReport& getNetworkIterationReport() const {
+      return _networkIterationReport;
+    }
+
+    /**
+     * Get the acceleration method of the iterations on the bid prices
+     * of the network.
+     */
+    const BidPriceAccelerationMethod_T& getBidPriceAccelerationMethod() const {
+      return _bidPriceAccelerationMethod;
+    }
+
+    /**
+     * Get the damping factor of the accelerated iterations on the bid
+     * prices of the network.
+     */
+    const double& getBidPriceDampingFactor() const {
+      return _bidPriceDampingFactor;
+    }
+
+    /**
+     * Get the method of the network optimisation with advanced RM
+     * cooperation.
+     */
+    const NetworkOptimisationMethod_T& getNetworkOptimisationMethod() const {
+      return _networkOptimisationMethod;
+    }
+
+    /**
+     * Get the number of demand scenarios of the randomised linear program
+     * of the network.
+     */
+    const stdair::NbOfSamples_T& getNbOfRLPScenarios() const {
+      return _nbOfRLPScenarios;
+    }
+
+    /**
+     * Get the bases of the network linear programs (warm start).
+     */
+    NetworkLPBasis& getNetworkLPBasis() {
+      return _networkLPBasis;
+    }
+
+    /**
+     * Get the index of the yield features of the O&D-dates.
+     */
+    YieldFeaturesIndex& getYieldFeaturesIndex() {
+      return _yieldFeaturesIndex;
+    }
+
+    /**
+     * Get the table of the O&D forecast parameters, by DTD.
+     */
+    OnDForecastTable& getOnDForecastTable() {
+      return _onDForecastTable;
+    }
+
+    /**
+     * Get the date of the last O&D forecast.
+     */
+    const stdair::Date_T& getPreviousForecastDate() const {
+      return _previousForecastDate;
+    }
+
+    /**
+     * Get the mutex serialising the accesses to the shared state of the
+     * service, i.e., to the context and to the BOM tree as a whole.
+     */
+    std::recursive_mutex& getMutex() {
+      return _mutex;
+    }
+
 
   private:    
     // ///////// Setters //////////
@@ -68,6 +206,46 @@ namespace RMOL {
       _ownStdairService = iOwnStdairService;
     }
 
+    /**
+     * Set the number of threads used by the parallel algorithms.
+     */
+    void setNbOfThreads (const unsigned int iNbOfThreads) {
+      _nbOfThreads = iNbOfThreads;
+    }
+
+    /**
+     * Set the acceleration of the iterations on the bid prices of the
+     * network.
+     */
+    void setBidPriceAcceleration (const BidPriceAccelerationMethod_T& iMethod,
+                                  const double iDampingFactor) {
+      _bidPriceAccelerationMethod = iMethod;
+      _bidPriceDampingFactor = iDampingFactor;
+    }
+
+    /**
+     * Set the method of the network optimisation with advanced RM
+     * cooperation.
+     */
+    void setNetworkOptimisationMethod (const NetworkOptimisationMethod_T& iMethod) {
+      _networkOptimisationMethod = iMethod;
+    }
+
+    /**
+     * Set the number of demand scenarios of the randomised linear program
+     * of the network.
+     */
+    void setNbOfRLPScenarios (const stdair::NbOfSamples_T& iNbOfScenarios) {
+      _nbOfRLPScenarios = iNbOfScenarios;
+    }
+
+    /**
+     * Set the date of the last O&D forecast.
+     */
+    void setPreviousForecastDate (const stdair::Date_T& iDate) {
+      _previousForecastDate = iDate;
+    }
+
     /**
      * Clear the context (cabin capacity, bucket holder).
      */
@@ -120,6 +298,100 @@ namespace RMOL {
      * State whether or not RMOL owns the STDAIR service resources.
      */
     bool _ownStdairService;
+
+    /**
+     * Number of threads used by the parallel algorithms (e.g., the
+     * forecasting of the segment-cabins of a flight-date).
+     */
+    unsigned int _nbOfThreads;
+
+    /**
+     * Sliding windows of the historical bookings of the similar segments,
+     * kept from one forecast to the next.
+     */
+    HistoricalBookingWindowHolder _historicalBookingWindowHolder;
+
+    /**
+     * Cache of the last forecast of each segment-cabin.
+     */
+    ForecastCache _forecastCache;
+
+    /**
+     * Calendar index of the flight-dates and O&D-dates, by the dates of
+     * their DCPs (built lazily from the BOM tree).
+     */
+    DCPEventIndex _dcpEventIndex;
+
+    /**
+     * Table linking the leg-cabins to their images held by the marketing
+     * partners (built lazily from the BOM tree).
+     */
+    LegCabinImageTable _legCabinImageTable;
+
+    /**
+     * Incidence matrix between the segment-cabins of the O&D-dates and the
+     * leg-cabins (built lazily from the BOM tree).
+     */
+    OnDIncidenceMatrix _onDIncidenceMatrix;
+
+    /**
+     * Report of the last network optimisation (with advanced RM
+     * cooperation).
+     */
+    NetworkIterationReport _networkIterationReport;
+
+    /**
+     * Acceleration method of the iterations on the bid prices exchanged
+     * between partners.
+     */
+    BidPriceAccelerationMethod_T _bidPriceAccelerationMethod;
+
+    /**
+     * Damping factor of the accelerated iterations on the bid prices
+     * exchanged between partners.
+     */
+    double _bidPriceDampingFactor;
+
+    /**
+     * Method of the network optimisation with advanced RM cooperation.
+     */
+    NetworkOptimisationMethod_T _networkOptimisationMethod;
+
+    /**
+     * Number of demand scenarios of the randomised linear program of the
+     * network.
+     */
+    stdair::NbOfSamples_T _nbOfRLPScenarios;
+
+    /**
+     * Date of the last O&D forecast (the O&D forecast and optimisation
+     * being performed at most once a day).
+     */
+    stdair::Date_T _previousForecastDate;
+
+    /**
+     * Mutex serialising the accesses to the shared state of the service.
+     * It is recursive, as the service methods taking it call one another.
+     */
+    std::recursive_mutex _mutex;
+
+    /**
+     * Bases of the network linear programs, kept from one RM event to the
+     * next (warm start).
+     */
+    NetworkLPBasis _networkLPBasis;
+
+    /**
+     * Index of the yield features of the O&D-dates, memoising the
+     * look-ups of the O&D forecasts.
+     */
+    YieldFeaturesIndex _yieldFeaturesIndex;
+
+    /**
+     * Table of the O&D forecast parameters (remaining proportion and
+     * FRAT5 coefficient), by DTD.
+     */
+    OnDForecastTable _onDForecastTable;
   };
 
 }
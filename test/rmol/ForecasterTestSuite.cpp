@@ -10,19 +10,73 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <map>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <functional>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE ForecasterTestSuite
 #include <boost/test/unit_test.hpp>
 // StdAir
+#include <stdair/stdair_inventory_types.hpp>
 #include <stdair/basic/BasLogParams.hpp>
 #include <stdair/basic/BasDBParams.hpp>
 #include <stdair/basic/BasFileMgr.hpp>
 #include <stdair/service/Logger.hpp>
+#include <stdair/basic/BasConst_Inventory.hpp>
+#include <stdair/basic/BasConst_Request.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/ContinuousAttributeLite.hpp>
+#include <stdair/basic/ForecastingMethod.hpp>
+#include <stdair/basic/UnconstrainingMethod.hpp>
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/InventoryKey.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/FlightDateKey.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentDateKey.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/SegmentCabinKey.hpp>
+#include <stdair/bom/SegmentSnapshotTable.hpp>
+#include <stdair/bom/SegmentSnapshotTableKey.hpp>
+#include <stdair/bom/FareFamily.hpp>
+#include <stdair/bom/FareFamilyKey.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/BookingClassKey.hpp>
+#include <stdair/bom/OnDDate.hpp>
+#include <stdair/bom/OnDDateKey.hpp>
+#include <stdair/bom/AirportPair.hpp>
+#include <stdair/bom/AirportPairKey.hpp>
+#include <stdair/bom/DatePeriod.hpp>
+#include <stdair/bom/DatePeriodKey.hpp>
+#include <stdair/bom/PosChannel.hpp>
+#include <stdair/bom/PosChannelKey.hpp>
+#include <stdair/bom/TimePeriod.hpp>
+#include <stdair/bom/TimePeriodKey.hpp>
+#include <stdair/bom/YieldFeatures.hpp>
+#include <stdair/bom/YieldFeaturesKey.hpp>
+#include <stdair/factory/FacBom.hpp>
+#include <stdair/factory/FacBomManager.hpp>
 // RMOL
 #include <rmol/RMOL_Service.hpp>
+#include <rmol/bom/HistoricalBooking.hpp>
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingWindowHolder.hpp>
+#include <rmol/bom/ClassBookingMatrix.hpp>
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/ClassCurveMatrix.hpp>
+#include <rmol/bom/DCPEventIndex.hpp>
+#include <rmol/bom/ForecastCache.hpp>
+#include <rmol/bom/YieldFeaturesIndex.hpp>
+#include <rmol/bom/OnDForecastTable.hpp>
+#include <rmol/command/Forecaster.hpp>
 
 namespace boost_utf = boost::unit_test;
 
@@ -50,6 +104,368 @@ struct UnitTestConfig {
   }
 };
 
+namespace {
+
+  /**
+   * Gather the historical bookings of a single class, the way the based
+   * and hybrid forecasters did before the class booking matrix.
+   */
+  void gatherClassBookings
+  (const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iProductBookingView,
+   const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iPriceBookingView,
+   const stdair::ConstSegmentCabinDTDRangeSnapshotView_T& iAvlView,
+   const stdair::ClassIndex_T& iClassIdx,
+   const stdair::NbOfClasses_T iNbOfValueTypes,
+   const short iNbOfSegments, const short iNbOfDTDs,
+   const bool iAddPriceOrientedBookings,
+   RMOL::HistoricalBookingHolder& ioHBHolder) {
+    for (short i = 0; i < iNbOfSegments; ++i) {
+      stdair::Flag_T lCensorshipFlag = false;
+      const stdair::UnsignedIndex_T lIdx = i*iNbOfValueTypes + iClassIdx;
+      for (short j = 0; j < iNbOfDTDs; ++j) {
+        if (iAvlView[lIdx][j] < 1.0) {
+          lCensorshipFlag = true;
+          break;
+        }
+      }
+
+      stdair::NbOfBookings_T lNbOfHistoricalBkgs = 0.0;
+      for (short j = 0; j < iNbOfDTDs; ++j) {
+        lNbOfHistoricalBkgs += iProductBookingView[lIdx][j];
+        if (iAddPriceOrientedBookings == true) {
+          lNbOfHistoricalBkgs += iPriceBookingView[lIdx][j];
+        }
+      }
+      const RMOL::HistoricalBooking lHistoricalBkg (lNbOfHistoricalBkgs,
+                                                    lCensorshipFlag);
+      ioHBHolder.addHistoricalBooking (lHistoricalBkg);
+    }
+  }
+
+  /** Define the curves of the classes, by DTD, the way the forecasters
+      stored them before the class curve matrices. */
+  typedef std::map<const stdair::BookingClass*,
+                   std::map<stdair::DTD_T, double> > ClassCurveMap_T;
+
+  /**
+   * Compute the sell-up and dispatching factor curves of the given
+   * classes (from the highest to the lowest one), the way the
+   * forecasters did before the class curve matrices.
+   */
+  void computeClassCurves (const stdair::FRAT5Curve_T& iFRAT5Curve,
+                           const stdair::BookingClassList_T& iBCList,
+                           ClassCurveMap_T& ioSellUpCurveMap,
+                           ClassCurveMap_T& ioDispatchingCurveMap) {
+    const stdair::BookingClass* lLowestBC_ptr = iBCList.back();
+    const stdair::Yield_T& lLowestYield = lLowestBC_ptr->getYield();
+
+    for (stdair::FRAT5Curve_T::const_iterator itFRAT5 = iFRAT5Curve.begin();
+         itFRAT5 != iFRAT5Curve.end(); ++itFRAT5) {
+      const stdair::DTD_T& lDTD = itFRAT5->first;
+      const stdair::FRAT5_T& lFRAT5 = itFRAT5->second;
+      const double lSellUpCoef = log(0.5)/(lFRAT5-1);
+
+      // Sell-up factors, from the lowest class
+      for (stdair::BookingClassList_T::const_iterator itBC = iBCList.begin();
+           itBC != iBCList.end(); ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        ioSellUpCurveMap[lBC_ptr][lDTD] = (lBC_ptr == lLowestBC_ptr) ? 1.0
+          : exp ((lBC_ptr->getYield()/lLowestYield - 1.0) * lSellUpCoef);
+      }
+
+      // Dispatching factors, from the lowest class to the highest one
+      double lBasedFactor = 1.0;
+      stdair::BookingClassList_T::const_reverse_iterator itCurrentClass =
+        iBCList.rbegin();
+      stdair::BookingClassList_T::const_reverse_iterator itNextClass =
+        itCurrentClass; ++itNextClass;
+      for (; itNextClass != iBCList.rend(); ++itCurrentClass, ++itNextClass) {
+        const double lDispatchingFactor =
+          exp (((*itNextClass)->getYield()/lLowestYield - 1.0) * lSellUpCoef);
+        ioDispatchingCurveMap[*itCurrentClass][lDTD] =
+          lBasedFactor - lDispatchingFactor;
+        lBasedFactor = lDispatchingFactor;
+      }
+      ioDispatchingCurveMap[*itCurrentClass][lDTD] = lBasedFactor;
+    }
+  }
+
+  /**
+   * Look the yield features of an O&D-date and cabin up in the BOM tree,
+   * the way the O&D forecaster did before the yield features index.
+   */
+  stdair::YieldFeatures* findYieldFeatures (const stdair::OnDDate& iOnDDate,
+                                            const stdair::CabinCode_T&
+                                            iCabinCode,
+                                            stdair::BomRoot& iBomRoot) {
+    const stdair::AirportPairKey lAirportPairKey (iOnDDate.getOrigin(),
+                                                  iOnDDate.getDestination());
+    stdair::AirportPair* lAirportPair_ptr = stdair::BomManager::
+      getObjectPtr<stdair::AirportPair> (iBomRoot,
+                                         lAirportPairKey.toString());
+    BOOST_REQUIRE (lAirportPair_ptr != NULL);
+
+    const stdair::DatePeriodList_T lDatePeriodList =
+      stdair::BomManager::getList<stdair::DatePeriod> (*lAirportPair_ptr);
+    for (stdair::DatePeriodList_T::const_iterator itDatePeriod =
+           lDatePeriodList.begin();
+         itDatePeriod != lDatePeriodList.end(); ++itDatePeriod) {
+      const stdair::DatePeriod* lDatePeriod_ptr = *itDatePeriod;
+      if (lDatePeriod_ptr->isDepartureDateValid (iOnDDate.getDate()) == false) {
+        continue;
+      }
+      const stdair::PosChannelKey lPosChannelKey (stdair::DEFAULT_POS,
+                                                  stdair::DEFAULT_CHANNEL);
+      stdair::PosChannel* lPosChannel_ptr = stdair::BomManager::
+        getObjectPtr<stdair::PosChannel> (*lDatePeriod_ptr,
+                                          lPosChannelKey.toString());
+      BOOST_REQUIRE (lPosChannel_ptr != NULL);
+      const stdair::TimePeriodList_T lTimePeriodList = stdair::
+        BomManager::getList<stdair::TimePeriod> (*lPosChannel_ptr);
+      for (stdair::TimePeriodList_T::const_iterator itTimePeriod =
+             lTimePeriodList.begin();
+           itTimePeriod != lTimePeriodList.end(); ++itTimePeriod) {
+        const stdair::YieldFeaturesKey
+          lYieldFeaturesKey (stdair::TRIP_TYPE_ONE_WAY, iCabinCode);
+        stdair::YieldFeatures* lYieldFeatures_ptr = stdair::BomManager::
+          getObjectPtr<stdair::YieldFeatures> (**itTimePeriod,
+                                               lYieldFeaturesKey.toString());
+        if (lYieldFeatures_ptr != NULL) {
+          return lYieldFeatures_ptr;
+        }
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * Add to the given airport pair a date period, holding two time
+   * periods of the default PoS-channel, with the yield features of the
+   * given cabins (the first cabin in the first time period, the other
+   * ones in the second time period).
+   */
+  void addDatePeriod (stdair::AirportPair& ioAirportPair,
+                      const stdair::Date_T& iFirstDate,
+                      const stdair::Date_T& iLastDate,
+                      const std::vector<stdair::CabinCode_T>& iCabinCodeList) {
+    const stdair::DatePeriod_T lPeriod (iFirstDate,
+                                        iLastDate + stdair::DateOffset_T (1));
+    const stdair::DatePeriodKey lDatePeriodKey (lPeriod);
+    stdair::DatePeriod& lDatePeriod =
+      stdair::FacBom<stdair::DatePeriod>::instance().create (lDatePeriodKey);
+    stdair::FacBomManager::addToListAndMap (ioAirportPair, lDatePeriod);
+    stdair::FacBomManager::linkWithParent (ioAirportPair, lDatePeriod);
+
+    const stdair::PosChannelKey lPosChannelKey (stdair::DEFAULT_POS,
+                                                stdair::DEFAULT_CHANNEL);
+    stdair::PosChannel& lPosChannel =
+      stdair::FacBom<stdair::PosChannel>::instance().create (lPosChannelKey);
+    stdair::FacBomManager::addToListAndMap (lDatePeriod, lPosChannel);
+    stdair::FacBomManager::linkWithParent (lDatePeriod, lPosChannel);
+
+    for (unsigned int i = 0; i < 2; ++i) {
+      const stdair::TimePeriodKey
+        lTimePeriodKey (stdair::Time_T (12*i, 0, 0),
+                        stdair::Time_T (12*i + 11, 59, 0));
+      stdair::TimePeriod& lTimePeriod =
+        stdair::FacBom<stdair::TimePeriod>::instance().create (lTimePeriodKey);
+      stdair::FacBomManager::addToListAndMap (lPosChannel, lTimePeriod);
+      stdair::FacBomManager::linkWithParent (lPosChannel, lTimePeriod);
+
+      for (unsigned int c = 0; c < iCabinCodeList.size(); ++c) {
+        if ((c == 0) != (i == 0)) {
+          continue;
+        }
+        const stdair::YieldFeaturesKey
+          lYieldFeaturesKey (stdair::TRIP_TYPE_ONE_WAY, iCabinCodeList[c]);
+        stdair::YieldFeatures& lYieldFeatures = stdair::
+          FacBom<stdair::YieldFeatures>::instance().create (lYieldFeaturesKey);
+        stdair::FacBomManager::addToListAndMap (lTimePeriod, lYieldFeatures);
+        stdair::FacBomManager::linkWithParent (lTimePeriod, lYieldFeatures);
+      }
+    }
+  }
+
+  /**
+   * Retrieve the historical bookings of the given range of similar
+   * segments, each segment having as many bookings as its index. The
+   * thread gives way after each segment, so that the holder may be
+   * cleared while the window is being filled.
+   */
+  void prepareIndexBookings (RMOL::HistoricalBookingHolder& ioHBHolder,
+                             const stdair::NbOfSegments_T& iSegmentBegin,
+                             const stdair::NbOfSegments_T& iSegmentEnd) {
+    for (stdair::NbOfSegments_T i = iSegmentBegin; i <= iSegmentEnd; ++i) {
+      const RMOL::HistoricalBooking lHistoricalBkg (i, false);
+      ioHBHolder.addHistoricalBooking (lHistoricalBkg);
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Slide, many times, the window of the given segment-cabin over the
+   * similar segments, checking the historical bookings given back, and
+   * count the mismatches.
+   */
+  void slideWindow (const stdair::SegmentCabin& iSegmentCabin,
+                    const unsigned int iSeries,
+                    RMOL::HistoricalBookingWindowHolder& ioHBWindowHolder,
+                    unsigned int& oNbOfMismatches) {
+    oNbOfMismatches = 0;
+    std::ostringstream lSeriesKey;
+    lSeriesKey << "Series " << iSeries;
+    const RMOL::HistoricalBookingWindow::Preparer_T
+      lPreparer (&prepareIndexBookings);
+    for (unsigned int k = 0; k < 500; ++k) {
+      const stdair::NbOfSegments_T lSegmentBegin = k % 40;
+      const stdair::NbOfSegments_T lSegmentEnd = lSegmentBegin + 9;
+      RMOL::HistoricalBookingHolder lHBHolder;
+      ioHBWindowHolder.prepareHistoricalBooking (iSegmentCabin,
+                                                 lSeriesKey.str(), "", 7,
+                                                 lSegmentBegin, lSegmentEnd,
+                                                 lPreparer, lHBHolder);
+      if (lHBHolder.getNbOfFlights() != 10) {
+        ++oNbOfMismatches;
+        continue;
+      }
+      for (short i = 0; i < 10; ++i) {
+        if (lHBHolder.getHistoricalBooking (i) != lSegmentBegin + i) {
+          ++oNbOfMismatches;
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * Build, within the given inventory, a flight-date departing on the
+   * given date, the Y cabin of which holds three fare families of two
+   * booking classes each, along with its similar flight-dates, departed
+   * on the days before the given RM event date. The bookings and
+   * availabilities of the departed similar segment-cabins are recorded
+   * into a snapshot table shared by all the segment-cabins.
+   */
+  stdair::FlightDate&
+  buildForecastFlightDate (stdair::Inventory& ioInventory,
+                           const stdair::Date_T& iDepartureDate,
+                           const stdair::Date_T& iEventDate,
+                           const stdair::NbOfSegments_T& iNbOfDepartedSegments) {
+    // Booking classes, from the highest to the lowest one, and FRAT5
+    // curve of the fare families, defined on every DTD up to the first
+    // DCP
+    const char* lClassCodes[] = { "Y", "B", "M", "H", "Q", "K" };
+    const double lYields[] = { 900.0, 700.0, 520.0, 400.0, 300.0, 150.0 };
+    const unsigned int lNbOfClasses = 6;
+    const stdair::DTD_T lFirstDCP = RMOL::DCPCalendar::getDCP (0);
+    stdair::FRAT5Curve_T lFRAT5Curve;
+    for (stdair::DTD_T lDTD = 0; lDTD <= lFirstDCP; ++lDTD) {
+      lFRAT5Curve[lDTD] = 1.5 + 0.03 * (lFirstDCP - lDTD);
+    }
+
+    // Snapshot table: the segment-cabin, then its classes, for each
+    // segment-cabin
+    const stdair::SegmentSnapshotTableKey lTableKey (0);
+    stdair::SegmentSnapshotTable& lSegmentSnapshotTable =
+      stdair::FacBom<stdair::SegmentSnapshotTable>::instance().
+      create (lTableKey);
+    std::ostringstream lSCMapKey;
+    lSCMapKey << stdair::DEFAULT_SEGMENT_CABIN_VALUE_TYPE << "Y";
+    stdair::ClassIndexMap_T lClassIndexMap;
+    lClassIndexMap[lSCMapKey.str()] = 0;
+    for (unsigned int c = 0; c < lNbOfClasses; ++c) {
+      lClassIndexMap[lClassCodes[c]] = c + 1;
+    }
+
+    // Similar flight-dates, from the earliest departed one to the one
+    // to be forecasted
+    stdair::SegmentCabinIndexMap_T lSegmentCabinIndexMap;
+    stdair::FlightDate* lFlightDate_ptr = NULL;
+    for (stdair::NbOfSegments_T i = 0; i <= iNbOfDepartedSegments; ++i) {
+      const bool isDeparted = (i < iNbOfDepartedSegments);
+      const stdair::Date_T lDate = (isDeparted == true)
+        ? iEventDate - stdair::DateOffset_T (iNbOfDepartedSegments - i)
+        : iDepartureDate;
+      const stdair::FlightDateKey lFlightDateKey (10, lDate);
+      stdair::FlightDate& lFlightDate =
+        stdair::FacBom<stdair::FlightDate>::instance().create (lFlightDateKey);
+      stdair::FacBomManager::addToList (ioInventory, lFlightDate);
+      stdair::FacBomManager::linkWithParent (ioInventory, lFlightDate);
+      const stdair::SegmentDateKey lSegmentDateKey ("LHR", "JFK");
+      stdair::SegmentDate& lSegmentDate =
+        stdair::FacBom<stdair::SegmentDate>::instance().
+        create (lSegmentDateKey);
+      stdair::FacBomManager::addToList (lFlightDate, lSegmentDate);
+      stdair::FacBomManager::linkWithParent (lFlightDate, lSegmentDate);
+      lSegmentDate.setBoardingDate (lDate);
+      const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+      stdair::SegmentCabin& lSegmentCabin =
+        stdair::FacBom<stdair::SegmentCabin>::instance().
+        create (lSegmentCabinKey);
+      stdair::FacBomManager::addToList (lSegmentDate, lSegmentCabin);
+      stdair::FacBomManager::linkWithParent (lSegmentDate, lSegmentCabin);
+      lSegmentCabin.setSegmentSnapshotTable (lSegmentSnapshotTable);
+      lSegmentCabinIndexMap[&lSegmentCabin] = i;
+      if (isDeparted == true) {
+        continue;
+      }
+
+      // Fare families and booking classes of the flight-date to be
+      // forecasted
+      lFlightDate_ptr = &lFlightDate;
+      lSegmentCabin.activateFareFamily();
+      const char* lFamilyCodes[] = { "1", "2", "3" };
+      for (unsigned int f = 0; f < 3; ++f) {
+        const stdair::FareFamilyKey lFareFamilyKey (lFamilyCodes[f]);
+        stdair::FareFamily& lFareFamily =
+          stdair::FacBom<stdair::FareFamily>::instance().
+          create (lFareFamilyKey);
+        stdair::FacBomManager::addToList (lSegmentCabin, lFareFamily);
+        stdair::FacBomManager::linkWithParent (lSegmentCabin, lFareFamily);
+        lFareFamily.setFrat5Curve (lFRAT5Curve);
+        for (unsigned int c = 2*f; c < 2*f + 2; ++c) {
+          const stdair::BookingClassKey lBCKey (lClassCodes[c]);
+          stdair::BookingClass& lBookingClass =
+            stdair::FacBom<stdair::BookingClass>::instance().create (lBCKey);
+          stdair::FacBomManager::addToList (lFareFamily, lBookingClass);
+          stdair::FacBomManager::linkWithParent (lFareFamily, lBookingClass);
+          stdair::FacBomManager::addToList (lSegmentCabin, lBookingClass);
+          lBookingClass.setYield (lYields[c]);
+        }
+      }
+    }
+    assert (lFlightDate_ptr != NULL);
+
+    // Bookings and availabilities of the departed segment-cabins, the
+    // availability of a few classes being closed on some days
+    lSegmentSnapshotTable.initSnapshotBlocks (lSegmentCabinIndexMap,
+                                              lClassIndexMap);
+    const unsigned int lNbOfValueTypes = lClassIndexMap.size();
+    stdair::SegmentCabinDTDRangeSnapshotView_T lProductBookingView =
+      lSegmentSnapshotTable.
+      getSegmentCabinDTDRangeProductOrientedGrossBookingSnapshotView
+      (0, iNbOfDepartedSegments - 1, 0, lFirstDCP);
+    stdair::SegmentCabinDTDRangeSnapshotView_T lPriceBookingView =
+      lSegmentSnapshotTable.
+      getSegmentCabinDTDRangePriceOrientedGrossBookingSnapshotView
+      (0, iNbOfDepartedSegments - 1, 0, lFirstDCP);
+    stdair::SegmentCabinDTDRangeSnapshotView_T lAvlView =
+      lSegmentSnapshotTable.
+      getSegmentCabinDTDRangeAvailabilitySnapshotView
+      (0, iNbOfDepartedSegments - 1, 0, lFirstDCP);
+    for (stdair::NbOfSegments_T i = 0; i < iNbOfDepartedSegments; ++i) {
+      for (unsigned int c = 1; c < lNbOfValueTypes; ++c) {
+        const unsigned int lIdx = i*lNbOfValueTypes + c;
+        for (stdair::DTD_T lDTD = 0; lDTD <= lFirstDCP; ++lDTD) {
+          lProductBookingView[lIdx][lDTD] = (i + 3*c + lDTD) % 4 * 0.5;
+          lPriceBookingView[lIdx][lDTD] = (2*i + c + lDTD) % 5 * 0.25;
+          lAvlView[lIdx][lDTD] = ((i + c + lDTD) % 13 == 0) ? 0.0 : 20.0;
+        }
+      }
+    }
+    return *lFlightDate_ptr;
+  }
+}
+
 
 // /////////////// Main: Unit Test Suite //////////////
 
@@ -73,6 +489,733 @@ BOOST_AUTO_TEST_CASE (rmol_forecaster_q_forecasting) {
                        << "more details");
 }
 
+/**
+ * Test that the class booking matrix gathers the same historical
+ * bookings as the former class-by-class gathering
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_class_booking_matrix) {
+  // Snapshots of 5 similar segments, with 4 value types (the segment-cabin
+  // and 3 classes) each, over the DTDs [10, 16] of a DCP interval
+  const short lNbOfSegments = 5;
+  const stdair::NbOfClasses_T lNbOfValueTypes = 4;
+  const short lNbOfDTDs = 7;
+  const unsigned int lNbOfRows = lNbOfSegments * lNbOfValueTypes;
+  stdair::SnapshotBlock_T lProductBlock (boost::extents[lNbOfRows][lNbOfDTDs]);
+  stdair::SnapshotBlock_T lPriceBlock (boost::extents[lNbOfRows][lNbOfDTDs]);
+  stdair::SnapshotBlock_T lAvlBlock (boost::extents[lNbOfRows][lNbOfDTDs]);
+  for (unsigned int r = 0; r < lNbOfRows; ++r) {
+    for (short j = 0; j < lNbOfDTDs; ++j) {
+      lProductBlock[r][j] = (3*r + j) % 4;
+      lPriceBlock[r][j] = (r + 2*j) % 3;
+      lAvlBlock[r][j] = ((r + j) % 11 == 0) ? 0.0 : 5.0 + r;
+    }
+  }
+  const stdair::SnapshotBlock_T& lConstProductBlock = lProductBlock;
+  const stdair::SnapshotBlock_T& lConstPriceBlock = lPriceBlock;
+  const stdair::SnapshotBlock_T& lConstAvlBlock = lAvlBlock;
+  const stdair::SnapshotBlockRange_T lRows (0, lNbOfRows);
+  const stdair::SnapshotBlockRange_T lDTDs (0, lNbOfDTDs);
+  const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lProductView =
+    lConstProductBlock[boost::indices[lRows][lDTDs]];
+  const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lPriceView =
+    lConstPriceBlock[boost::indices[lRows][lDTDs]];
+  const stdair::ConstSegmentCabinDTDRangeSnapshotView_T lAvlView =
+    lConstAvlBlock[boost::indices[lRows][lDTDs]];
+
+  // The classes, in the order of the booking class list, are not in the
+  // order of the snapshot table
+  std::vector<stdair::ClassIndex_T> lClassIdxList;
+  lClassIdxList.push_back (2);
+  lClassIdxList.push_back (3);
+  lClassIdxList.push_back (1);
+
+  for (short lWithPrice = 0; lWithPrice < 2; ++lWithPrice) {
+    const bool lAddPriceOrientedBookings = (lWithPrice == 1);
+    RMOL::ClassBookingMatrix lClassBookingMatrix;
+    lClassBookingMatrix.gather (lProductView, lPriceView, lAvlView,
+                                lClassIdxList, lNbOfValueTypes, 8,
+                                lAddPriceOrientedBookings);
+    BOOST_REQUIRE_EQUAL (lClassBookingMatrix.getNbOfClasses(),
+                         lClassIdxList.size());
+    BOOST_REQUIRE_EQUAL (lClassBookingMatrix.getNbOfSegments(),
+                         lNbOfSegments);
+    BOOST_CHECK_EQUAL (lClassBookingMatrix.getSegmentBegin(), 8);
+
+    for (unsigned int c = 0; c < lClassIdxList.size(); ++c) {
+      RMOL::HistoricalBookingHolder lExpectedHBHolder;
+      gatherClassBookings (lProductView, lPriceView, lAvlView,
+                           lClassIdxList[c], lNbOfValueTypes, lNbOfSegments,
+                           lNbOfDTDs, lAddPriceOrientedBookings,
+                           lExpectedHBHolder);
+      RMOL::HistoricalBookingHolder lHBHolder;
+      lClassBookingMatrix.fillHistoricalBookingHolder (c, lHBHolder);
+
+      BOOST_REQUIRE_EQUAL (lHBHolder.getNbOfFlights(),
+                           lExpectedHBHolder.getNbOfFlights());
+      for (short i = 0; i < lHBHolder.getNbOfFlights(); ++i) {
+        BOOST_CHECK_EQUAL (lHBHolder.getHistoricalBooking (i),
+                           lExpectedHBHolder.getHistoricalBooking (i));
+        BOOST_CHECK_EQUAL (lHBHolder.getCensorshipFlag (i),
+                           lExpectedHBHolder.getCensorshipFlag (i));
+      }
+    }
+  }
+}
+
+/**
+ * Test that the class curve matrices hold the same sell-up and
+ * dispatching factors as the former per-class curves
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_class_curve_matrix) {
+  // Booking classes, from the highest to the lowest one
+  const char* lClassCodes[] = { "Y", "B", "M", "H", "Q", "K" };
+  const double lYields[] = { 900.0, 700.0, 520.0, 400.0, 300.0, 150.0 };
+  stdair::BookingClassList_T lBCList;
+  for (unsigned int c = 0; c < 6; ++c) {
+    const stdair::BookingClassKey lBCKey (lClassCodes[c]);
+    stdair::BookingClass& lBookingClass =
+      stdair::FacBom<stdair::BookingClass>::instance().create (lBCKey);
+    lBookingClass.setYield (lYields[c]);
+    lBCList.push_back (&lBookingClass);
+  }
+
+  // FRAT5 curve, defined on every DTD up to the first DCP
+  const stdair::DTD_T lFirstDCP = RMOL::DCPCalendar::getDCP (0);
+  stdair::FRAT5Curve_T lFRAT5Curve;
+  for (stdair::DTD_T lDTD = 0; lDTD <= lFirstDCP; ++lDTD) {
+    lFRAT5Curve[lDTD] = 1.5 + 0.03 * (lFirstDCP - lDTD);
+  }
+
+  ClassCurveMap_T lSellUpCurveMap;
+  ClassCurveMap_T lDispatchingCurveMap;
+  computeClassCurves (lFRAT5Curve, lBCList, lSellUpCurveMap,
+                      lDispatchingCurveMap);
+  RMOL::ClassCurveMatrix lSellUpCurves;
+  lSellUpCurves.buildSellUpCurves (lFRAT5Curve, lBCList);
+  RMOL::ClassCurveMatrix lDispatchingCurves;
+  lDispatchingCurves.buildDispatchingCurves (lFRAT5Curve, lBCList);
+
+  // The rows follow the order of the class list, and the factors are
+  // computed with the same arithmetic
+  BOOST_REQUIRE_EQUAL (lSellUpCurves.getNbOfClasses(), lBCList.size());
+  BOOST_REQUIRE_EQUAL (lDispatchingCurves.getNbOfClasses(), lBCList.size());
+  unsigned int lClassRow = 0;
+  for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+       itBC != lBCList.end(); ++itBC, ++lClassRow) {
+    const stdair::BookingClass* lBC_ptr = *itBC;
+    BOOST_CHECK_EQUAL (lSellUpCurves.getClassIndex (*lBC_ptr), lClassRow);
+    for (RMOL::DCPIndex_T idx = 0; idx < RMOL::DCPCalendar::getNbOfDCPs();
+         ++idx) {
+      const stdair::DCP_T& lDCP = RMOL::DCPCalendar::getDCP (idx);
+      BOOST_CHECK_EQUAL (lSellUpCurves.getFactor (lClassRow, idx),
+                         lSellUpCurveMap[lBC_ptr][lDCP]);
+      BOOST_CHECK_EQUAL (lDispatchingCurves.getFactor (lClassRow, idx),
+                         lDispatchingCurveMap[lBC_ptr][lDCP]);
+    }
+  }
+
+  // The dispatching factors of a DCP sum up to 1
+  for (RMOL::DCPIndex_T idx = 0; idx < RMOL::DCPCalendar::getNbOfDCPs();
+       ++idx) {
+    const double* lFactorList = lDispatchingCurves.getFactorList (idx);
+    double lSum = 0.0;
+    for (unsigned int c = 0; c < lBCList.size(); ++c) {
+      lSum += lFactorList[c];
+    }
+    BOOST_CHECK_CLOSE (lSum, 1.0, 1e-9);
+  }
+}
+
+/**
+ * Test that the DCP calendar answers the DCP queries the way the former
+ * searches within the DCP list did
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_dcp_calendar) {
+  const stdair::DCPList_T& lDCPList = stdair::DEFAULT_DCP_LIST;
+  BOOST_REQUIRE_EQUAL (RMOL::DCPCalendar::getNbOfDCPs(), lDCPList.size());
+  BOOST_REQUIRE_EQUAL (RMOL::DCPCalendar::getNbOfIntervals(),
+                       lDCPList.size() - 1);
+
+  // The DCPs are indexed in the order of the list
+  RMOL::DCPIndex_T lDCPIdx = 0;
+  for (stdair::DCPList_T::const_iterator itDCP = lDCPList.begin();
+       itDCP != lDCPList.end(); ++itDCP, ++lDCPIdx) {
+    BOOST_CHECK_EQUAL (RMOL::DCPCalendar::getDCP (lDCPIdx), *itDCP);
+    BOOST_CHECK_EQUAL (RMOL::DCPCalendar::getDCPIndex (*itDCP), lDCPIdx);
+  }
+
+  // Browse the DTDs, from after the departure to well before the first
+  // DCP
+  const stdair::DTD_T lFirstDCP = lDCPList.front();
+  for (stdair::DTD_T lDTD = -3; lDTD <= lFirstDCP + 10; ++lDTD) {
+    const bool isDCP =
+      (std::find (lDCPList.begin(), lDCPList.end(), lDTD) != lDCPList.end());
+    BOOST_CHECK_EQUAL (RMOL::DCPCalendar::isDCP (lDTD), isDCP);
+
+    // The forecasted DCP intervals are the ones whose end is after the
+    // DTD, and they follow one another up to the last one
+    const RMOL::DCPIndex_T lFirstIntervalIdx =
+      RMOL::DCPCalendar::getIntervalIndex (lDTD);
+    RMOL::DCPIndex_T lIntervalIdx = lFirstIntervalIdx;
+    stdair::DCPList_T::const_iterator itDCP = lDCPList.begin();
+    stdair::DCPList_T::const_iterator itNextDCP = itDCP; ++itNextDCP;
+    for (; itNextDCP != lDCPList.end(); ++itDCP, ++itNextDCP) {
+      if (*itNextDCP < lDTD) {
+        BOOST_REQUIRE (lIntervalIdx < RMOL::DCPCalendar::getNbOfIntervals());
+        BOOST_CHECK_EQUAL (RMOL::DCPCalendar::getIntervalBegin(lIntervalIdx),
+                           *itDCP);
+        BOOST_CHECK_EQUAL (RMOL::DCPCalendar::getIntervalEnd (lIntervalIdx),
+                           *itNextDCP);
+        ++lIntervalIdx;
+      }
+    }
+    BOOST_CHECK_EQUAL (lIntervalIdx, RMOL::DCPCalendar::getNbOfIntervals());
+  }
+}
+
+/**
+ * Test that the yield features index gives the yield features which the
+ * former look-up in the BOM tree found, whether they are memoised or not
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_yield_features_index) {
+  // Two overlapping date periods of LHR-JFK: the first one has yield
+  // features for the Y and J cabins, the second one for the Y, J and F
+  // cabins (F in its second time period)
+  stdair::BomRoot& lBomRoot =
+    stdair::FacBom<stdair::BomRoot>::instance().create();
+  const stdair::AirportPairKey lAirportPairKey ("LHR", "JFK");
+  stdair::AirportPair& lAirportPair =
+    stdair::FacBom<stdair::AirportPair>::instance().create (lAirportPairKey);
+  stdair::FacBomManager::addToListAndMap (lBomRoot, lAirportPair);
+  stdair::FacBomManager::linkWithParent (lBomRoot, lAirportPair);
+
+  std::vector<stdair::CabinCode_T> lCabinCodeList;
+  lCabinCodeList.push_back ("Y");
+  lCabinCodeList.push_back ("J");
+  addDatePeriod (lAirportPair, stdair::Date_T (2011, 6, 1),
+                 stdair::Date_T (2011, 6, 20), lCabinCodeList);
+  lCabinCodeList.push_back ("F");
+  addDatePeriod (lAirportPair, stdair::Date_T (2011, 6, 15),
+                 stdair::Date_T (2011, 7, 15), lCabinCodeList);
+
+  // O&D-dates departing within the first period, within both periods,
+  // within the second one and outside of both
+  const char* lOnDStrings[] = { "BA;10,2011-Jun-05;LHR,JFK;10:00",
+                                "BA;10,2011-Jun-17;LHR,JFK;10:00",
+                                "BA;10,2011-Jul-01;LHR,JFK;10:00",
+                                "BA;10,2011-Aug-01;LHR,JFK;10:00",
+                                "AF;30,2011-Jun-17;LHR,JFK;10:00" };
+  std::vector<stdair::OnDDate*> lOnDDateList;
+  for (unsigned int i = 0; i < 5; ++i) {
+    stdair::OnDStringList_T lOnDStringList;
+    lOnDStringList.push_back (lOnDStrings[i]);
+    const stdair::OnDDateKey lOnDDateKey (lOnDStringList);
+    lOnDDateList.push_back
+      (&stdair::FacBom<stdair::OnDDate>::instance().create (lOnDDateKey));
+  }
+
+  // The first pass fills the index, the second one reads the memoised
+  // results
+  RMOL::YieldFeaturesIndex lYieldFeaturesIndex;
+  const char* lCabinCodes[] = { "Y", "J", "F", "C" };
+  unsigned int lNbOfFoundYieldFeatures = 0;
+  for (unsigned int lPass = 0; lPass < 2; ++lPass) {
+    for (unsigned int i = 0; i < lOnDDateList.size(); ++i) {
+      const stdair::OnDDate& lOnDDate = *lOnDDateList[i];
+      for (unsigned int c = 0; c < 4; ++c) {
+        stdair::YieldFeatures* lExpectedYieldFeatures_ptr =
+          findYieldFeatures (lOnDDate, lCabinCodes[c], lBomRoot);
+        stdair::YieldFeatures* lYieldFeatures_ptr = lYieldFeaturesIndex.
+          getYieldFeatures (lOnDDate, lCabinCodes[c], lBomRoot);
+        BOOST_CHECK (lYieldFeatures_ptr == lExpectedYieldFeatures_ptr);
+        if (lYieldFeatures_ptr != NULL) {
+          ++lNbOfFoundYieldFeatures;
+        }
+      }
+    }
+  }
+  // Y and J for all the O&D-dates but the one departing in August, and
+  // F for the three ones departing within the second period
+  BOOST_CHECK_EQUAL (lNbOfFoundYieldFeatures, 2 * (2*4 + 3));
+
+  // The index gives the same results once cleared
+  lYieldFeaturesIndex.clear();
+  for (unsigned int i = 0; i < lOnDDateList.size(); ++i) {
+    const stdair::OnDDate& lOnDDate = *lOnDDateList[i];
+    for (unsigned int c = 0; c < 4; ++c) {
+      BOOST_CHECK (lYieldFeaturesIndex.getYieldFeatures (lOnDDate,
+                                                         lCabinCodes[c],
+                                                         lBomRoot)
+                   == findYieldFeatures (lOnDDate, lCabinCodes[c], lBomRoot));
+    }
+  }
+}
+
+/**
+ * Test that the DCP event index gives, for each date and inventory, the
+ * flight-dates which the former scan of the whole inventory found due
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_dcp_event_index) {
+  // Two inventories, with flight-dates departing on various dates
+  stdair::BomRoot& lBomRoot =
+    stdair::FacBom<stdair::BomRoot>::instance().create();
+  const char* lAirlineCodes[] = { "BA", "AF" };
+  std::vector<stdair::Inventory*> lInventoryList;
+  for (unsigned int i = 0; i < 2; ++i) {
+    const stdair::InventoryKey lInventoryKey (lAirlineCodes[i]);
+    stdair::Inventory& lInventory =
+      stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+    stdair::FacBomManager::addToList (lBomRoot, lInventory);
+    lInventoryList.push_back (&lInventory);
+
+    for (stdair::FlightNumber_T lFlightNumber = 10; lFlightNumber < 13;
+         ++lFlightNumber) {
+      for (short lDay = 0; lDay < 30; lDay += 3 + i) {
+        const stdair::Date_T lDepartureDate =
+          stdair::Date_T (2011, 6, 1) + stdair::DateOffset_T (lDay);
+        const stdair::FlightDateKey lFlightDateKey (lFlightNumber,
+                                                    lDepartureDate);
+        stdair::FlightDate& lFlightDate =
+          stdair::FacBom<stdair::FlightDate>::instance().create(lFlightDateKey);
+        stdair::FacBomManager::addToList (lInventory, lFlightDate);
+      }
+    }
+  }
+
+  RMOL::DCPEventIndex lDCPEventIndex;
+  lDCPEventIndex.build (lBomRoot);
+  BOOST_REQUIRE (lDCPEventIndex.isBuilt() == true);
+
+  // Browse the dates of the RM events, from before the first DCP of the
+  // first flight-date to after the last departure
+  const stdair::DCPList_T& lDCPList = stdair::DEFAULT_DCP_LIST;
+  for (stdair::Date_T lDate = stdair::Date_T (2011, 6, 1)
+         - stdair::DateOffset_T (lDCPList.front() + 5);
+       lDate <= stdair::Date_T (2011, 7, 5); lDate += stdair::DateOffset_T (1)) {
+    std::vector<stdair::FlightDate*> lExpectedNetworkList;
+    for (unsigned int i = 0; i < lInventoryList.size(); ++i) {
+      const stdair::Inventory& lInventory = *lInventoryList[i];
+
+      // The flight-dates whose DTD is a DCP, in the order of the BOM tree
+      std::vector<stdair::FlightDate*> lExpectedList;
+      const stdair::FlightDateList_T& lFlightDateList =
+        stdair::BomManager::getList<stdair::FlightDate> (lInventory);
+      for (stdair::FlightDateList_T::const_iterator itFD =
+             lFlightDateList.begin(); itFD != lFlightDateList.end(); ++itFD) {
+        stdair::FlightDate* lFlightDate_ptr = *itFD;
+        const stdair::DateOffset_T lDateOffset =
+          lFlightDate_ptr->getDepartureDate() - lDate;
+        const stdair::DTD_T lDTD = lDateOffset.days();
+        if (std::find (lDCPList.begin(), lDCPList.end(), lDTD)
+            != lDCPList.end()) {
+          lExpectedList.push_back (lFlightDate_ptr);
+          lExpectedNetworkList.push_back (lFlightDate_ptr);
+        }
+      }
+
+      const RMOL::DCPEventIndex::DueFlightDateList_T& lDueList =
+        lDCPEventIndex.getDueFlightDateList (lDate, lInventory);
+      BOOST_CHECK (lDueList == lExpectedList);
+      BOOST_CHECK (lDCPEventIndex.getDueOnDDateList (lDate,
+                                                     lInventory).empty());
+    }
+
+    const RMOL::DCPEventIndex::DueFlightDateList_T& lNetworkDueList =
+      lDCPEventIndex.getDueFlightDateList (lDate);
+    BOOST_CHECK (lNetworkDueList == lExpectedNetworkList);
+  }
+}
+
+/**
+ * Test that a cached segment-cabin forecast is reused on the same
+ * snapshots, and not any more after a snapshot update
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_forecast_cache) {
+  const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+  stdair::SegmentCabin& lSegmentCabin =
+    stdair::FacBom<stdair::SegmentCabin>::instance().create (lSegmentCabinKey);
+  const std::string lKey ("BA, 9, 2011-Jun-10, LHR-SYD, Y");
+  const stdair::Date_T lEventDate (2011, 5, 20);
+  const stdair::ForecastingMethod
+    lForecastingMethod (stdair::ForecastingMethod::Q_FORECASTING);
+  const stdair::UnconstrainingMethod
+    lUnconstrainingMethod (stdair::UnconstrainingMethod::EM);
+
+  // Nothing is cached yet
+  RMOL::ForecastCache lForecastCache;
+  bool isForecasted = true;
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey, lEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), false);
+
+  // The forecast (here, an unsuccessful one, which does not alter the
+  // segment-cabin) is reused on the same day, with the same methods
+  const RMOL::SnapshotStamp_T lSnapshotStamp =
+    lForecastCache.getSnapshotStamp();
+  lForecastCache.save (lSegmentCabin, lKey, lEventDate, lSnapshotStamp,
+                       lForecastingMethod, lUnconstrainingMethod, false);
+  BOOST_CHECK_EQUAL (lForecastCache.getNbOfForecasts(), 1);
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey, lEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), true);
+  BOOST_CHECK_EQUAL (isForecasted, false);
+
+  // But not on another day
+  const stdair::Date_T lNextEventDate (2011, 5, 21);
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey,
+                                             lNextEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), false);
+
+  // Nor on the same day, once the snapshots have been updated
+  lForecastCache.notifySnapshotUpdate();
+  BOOST_CHECK (lForecastCache.getSnapshotStamp() != lSnapshotStamp);
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey, lEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), false);
+
+  // A forecast made on the updated snapshots is reused again, while a
+  // forecast made on the former snapshots (e.g., by a concurrent
+  // forecast started before the update) is not
+  lForecastCache.save (lSegmentCabin, lKey, lEventDate,
+                       lForecastCache.getSnapshotStamp(),
+                       lForecastingMethod, lUnconstrainingMethod, false);
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey, lEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), true);
+  lForecastCache.save (lSegmentCabin, lKey, lEventDate, lSnapshotStamp,
+                       lForecastingMethod, lUnconstrainingMethod, false);
+  BOOST_CHECK_EQUAL (lForecastCache.restore (lSegmentCabin, lKey, lEventDate,
+                                             lForecastingMethod,
+                                             lUnconstrainingMethod,
+                                             isForecasted), false);
+  BOOST_CHECK_EQUAL (lForecastCache.getNbOfForecasts(), 1);
+}
+
+/**
+ * Test that the O&D forecast table gives, at every DTD, the parameters
+ * and the proportion factors computed from the default DTD maps
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_ond_forecast_table) {
+  RMOL::OnDForecastTable lOnDForecastTable;
+  BOOST_CHECK (lOnDForecastTable.isBuilt() == false);
+  lOnDForecastTable.build();
+  BOOST_REQUIRE (lOnDForecastTable.isBuilt() == true);
+
+  const stdair::DTDFratMap_T& lDTDFratMap = stdair::DEFAULT_DTD_FRAT5COEF_MAP;
+  BOOST_REQUIRE (lDTDFratMap.empty() == false);
+  const stdair::DTD_T lLowestDTD = lDTDFratMap.begin()->first;
+  const stdair::DTD_T lHighestDTD = lDTDFratMap.rbegin()->first;
+  const stdair::ContinuousAttributeLite<stdair::FloatDuration_T>
+    lArrivalPattern (stdair::DEFAULT_DTD_PROB_MAP);
+
+  // Yield ladders (in decreasing order) below, around and above the
+  // minimal WTP
+  const stdair::WTP_T lMinWTP = 300.0;
+  std::vector<RMOL::OnDForecastTable::YieldList_T> lYieldListList (3);
+  const double lYields[] = { 1200.0, 800.0, 500.0, 400.0, 300.0, 250.0, 100.0 };
+  lYieldListList[0].assign (lYields, lYields + 4);
+  lYieldListList[1].assign (lYields, lYields + 7);
+  lYieldListList[2].assign (lYields + 4, lYields + 7);
+
+  // DTDs outside of the FRAT5 map
+  BOOST_CHECK (lOnDForecastTable.hasDTD (lHighestDTD + 1) == false);
+  if (lLowestDTD > 0) {
+    BOOST_CHECK (lOnDForecastTable.hasDTD (lLowestDTD - 1) == false);
+  }
+
+  for (stdair::DTD_T lDTD = lLowestDTD; lDTD <= lHighestDTD; ++lDTD) {
+    stdair::DTDFratMap_T::const_iterator itDFC = lDTDFratMap.find (lDTD);
+    if (itDFC == lDTDFratMap.end()) {
+      BOOST_CHECK (lOnDForecastTable.hasDTD (lDTD) == false);
+      continue;
+    }
+    BOOST_REQUIRE (lOnDForecastTable.hasDTD (lDTD) == true);
+    const stdair::RealNumber_T& lFrat5Coef = itDFC->second;
+    BOOST_CHECK_EQUAL (lOnDForecastTable.getFrat5Coef (lDTD), lFrat5Coef);
+    BOOST_CHECK_EQUAL (lOnDForecastTable.getRemainingProportion (lDTD),
+                       lArrivalPattern.getRemainingProportion (-float(lDTD)));
+
+    // Proportion factors, as increments of the cumulative sell-up
+    // proportions
+    for (unsigned int l = 0; l < lYieldListList.size(); ++l) {
+      const RMOL::OnDForecastTable::YieldList_T& lYieldList =
+        lYieldListList[l];
+      stdair::ProportionFactorList_T lProportionFactorList;
+      lOnDForecastTable.computeProportionFactors (lDTD, lMinWTP, lYieldList,
+                                                  lProportionFactorList);
+      BOOST_REQUIRE_EQUAL (lProportionFactorList.size(), lYieldList.size());
+      stdair::ProportionFactor_T lPreviousProportionFactor = 0.0;
+      for (unsigned int idx = 0; idx < lYieldList.size(); ++idx) {
+        const stdair::ProportionFactor_T lProportionFactor =
+          std::min (exp ((lYieldList[idx] - lMinWTP) * log(0.5)
+                         / (lMinWTP * (lFrat5Coef - 1.0))), 1.0);
+        BOOST_CHECK_SMALL (lProportionFactorList[idx]
+                           - (lProportionFactor - lPreviousProportionFactor),
+                           1e-12);
+        lPreviousProportionFactor = lProportionFactor;
+      }
+    }
+  }
+}
+
+/**
+ * Test that the sliding windows of historical bookings may be used by
+ * concurrent forecasts while the forecast state is reset: a forecast
+ * keeps its window until it is over, and the next one starts afresh
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_window_holder_reset) {
+  // Segment-cabin of a flight-date, as the windows are keyed on it
+  const stdair::InventoryKey lInventoryKey ("BA");
+  stdair::Inventory& lInventory =
+    stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+  const stdair::FlightDateKey lFlightDateKey (9, stdair::Date_T (2011, 6, 10));
+  stdair::FlightDate& lFlightDate =
+    stdair::FacBom<stdair::FlightDate>::instance().create (lFlightDateKey);
+  stdair::FacBomManager::addToList (lInventory, lFlightDate);
+  stdair::FacBomManager::linkWithParent (lInventory, lFlightDate);
+  const stdair::SegmentDateKey lSegmentDateKey ("LHR", "SYD");
+  stdair::SegmentDate& lSegmentDate =
+    stdair::FacBom<stdair::SegmentDate>::instance().create (lSegmentDateKey);
+  stdair::FacBomManager::addToList (lFlightDate, lSegmentDate);
+  stdair::FacBomManager::linkWithParent (lFlightDate, lSegmentDate);
+  const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+  stdair::SegmentCabin& lSegmentCabin =
+    stdair::FacBom<stdair::SegmentCabin>::instance().create (lSegmentCabinKey);
+  stdair::FacBomManager::addToList (lSegmentDate, lSegmentCabin);
+  stdair::FacBomManager::linkWithParent (lSegmentDate, lSegmentCabin);
+
+  // A small initial capacity makes the windows grow while being used
+  RMOL::HistoricalBookingWindowHolder lHBWindowHolder (2);
+
+  // Forecasting threads, two of them sharing the same series
+  const unsigned int lNbOfThreads = 4;
+  std::vector<unsigned int> lNbOfMismatchesList (lNbOfThreads, 0);
+  std::atomic<bool> isOver (false);
+  std::vector<std::thread> lThreadList;
+  for (unsigned int t = 0; t < lNbOfThreads; ++t) {
+    lThreadList.push_back (std::thread (&slideWindow,
+                                        std::cref (lSegmentCabin), t % 3,
+                                        std::ref (lHBWindowHolder),
+                                        std::ref (lNbOfMismatchesList[t])));
+  }
+
+  // Reset of the forecast state, while the threads are forecasting
+  std::thread lResetThread ([&lHBWindowHolder, &isOver] () {
+      while (isOver.load() == false) {
+        lHBWindowHolder.clear();
+        std::this_thread::yield();
+      }
+    });
+  for (unsigned int t = 0; t < lNbOfThreads; ++t) {
+    lThreadList[t].join();
+  }
+  isOver.store (true);
+  lResetThread.join();
+
+  for (unsigned int t = 0; t < lNbOfThreads; ++t) {
+    BOOST_CHECK_EQUAL (lNbOfMismatchesList[t], 0);
+  }
+  BOOST_CHECK (lHBWindowHolder.getNbOfWindows() <= 3);
+
+  // Once reset, the holder starts afresh
+  lHBWindowHolder.clear();
+  BOOST_CHECK_EQUAL (lHBWindowHolder.getNbOfWindows(), 0);
+  unsigned int lNbOfMismatches = 1;
+  slideWindow (lSegmentCabin, 0, lHBWindowHolder, lNbOfMismatches);
+  BOOST_CHECK_EQUAL (lNbOfMismatches, 0);
+  BOOST_CHECK_EQUAL (lHBWindowHolder.getNbOfWindows(), 1);
+}
+
+/**
+ * Test that the Q, hybrid and new QFF forecasts of a flight-date give
+ * the same demand means and standard deviations, to the last bit, on one
+ * thread and on several threads
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_threads) {
+  // The forecast of a flight-date at its first DCP, from ten similar
+  // departed flight-dates
+  const stdair::InventoryKey lInventoryKey ("BA");
+  stdair::Inventory& lInventory =
+    stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+  const stdair::Date_T lDepartureDate (2011, 6, 10);
+  const stdair::DateOffset_T lDCPOffset (RMOL::DCPCalendar::getDCP (0));
+  const stdair::DateTime_T lRMEventTime (lDepartureDate - lDCPOffset,
+                                         stdair::Duration_T (0, 0, 0));
+  stdair::FlightDate& lFlightDate =
+    buildForecastFlightDate (lInventory, lDepartureDate,
+                             lRMEventTime.date(), 10);
+  const stdair::SegmentDateList_T& lSDList =
+    stdair::BomManager::getList<stdair::SegmentDate> (lFlightDate);
+  BOOST_REQUIRE_EQUAL (lSDList.size(), 1);
+  const stdair::SegmentCabinList_T& lSCList =
+    stdair::BomManager::getList<stdair::SegmentCabin> (*lSDList.front());
+  BOOST_REQUIRE_EQUAL (lSCList.size(), 1);
+  const stdair::SegmentCabin& lSegmentCabin = *lSCList.front();
+  const stdair::FareFamilyList_T& lFFList =
+    stdair::BomManager::getList<stdair::FareFamily> (lSegmentCabin);
+  const stdair::BookingClassList_T& lBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lSegmentCabin);
+  BOOST_REQUIRE_EQUAL (lFFList.size(), 3);
+  BOOST_REQUIRE_EQUAL (lBCList.size(), 6);
+
+  const stdair::UnconstrainingMethod
+    lUnconstrainingMethod (stdair::UnconstrainingMethod::EM);
+  const stdair::ForecastingMethod::EN_ForecastingMethod lMethods[3] =
+    { stdair::ForecastingMethod::Q_FORECASTING,
+      stdair::ForecastingMethod::HYBRID_FORECASTING,
+      stdair::ForecastingMethod::NEW_QFF };
+  const unsigned int lNbOfThreads[2] = { 1, 4 };
+  for (unsigned int m = 0; m < 3; ++m) {
+    const stdair::ForecastingMethod lForecastingMethod (lMethods[m]);
+
+    // Demand means and standard deviations of the fare families, then of
+    // the booking classes, for each number of threads. Each forecast
+    // starts with its own windows and cache, so that all of them are
+    // computed.
+    std::vector<double> lForecastList[2];
+    for (unsigned int t = 0; t < 2; ++t) {
+      RMOL::HistoricalBookingWindowHolder lHBWindowHolder;
+      RMOL::ForecastCache lForecastCache;
+      const bool isForecasted =
+        RMOL::Forecaster::forecast (lFlightDate, lRMEventTime,
+                                    lUnconstrainingMethod,
+                                    lForecastingMethod, lHBWindowHolder,
+                                    lForecastCache, lNbOfThreads[t]);
+      BOOST_REQUIRE (isForecasted == true);
+
+      std::vector<double>& lForecasts = lForecastList[t];
+      for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+           itFF != lFFList.end(); ++itFF) {
+        const stdair::FareFamily* lFF_ptr = *itFF;
+        assert (lFF_ptr != NULL);
+        lForecasts.push_back (lFF_ptr->getMean());
+        lForecasts.push_back (lFF_ptr->getStdDev());
+      }
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        lForecasts.push_back (lBC_ptr->getMean());
+        lForecasts.push_back (lBC_ptr->getStdDev());
+        lForecasts.push_back (lBC_ptr->getPriceDemMean());
+        lForecasts.push_back (lBC_ptr->getPriceDemStdDev());
+        lForecasts.push_back (lBC_ptr->getProductDemMean());
+        lForecasts.push_back (lBC_ptr->getProductDemStdDev());
+        lForecasts.push_back (lBC_ptr->getCumuPriceDemMean());
+        lForecasts.push_back (lBC_ptr->getCumuPriceDemStdDev());
+      }
+    }
+
+    // Some demand has been forecasted, the same on any number of threads
+    const double lTotalDemand =
+      std::accumulate (lForecastList[0].begin(), lForecastList[0].end(),
+                       0.0);
+    BOOST_CHECK (lTotalDemand > 0.0);
+    BOOST_REQUIRE_EQUAL (lForecastList[1].size(), lForecastList[0].size());
+    for (unsigned int idx = 0; idx < lForecastList[0].size(); ++idx) {
+      BOOST_CHECK_EQUAL (lForecastList[1][idx], lForecastList[0][idx]);
+    }
+  }
+}
+
+/**
+ * Test that the windows of Q-equivalent bookings follow the changes of
+ * the FRAT5 curves: once the curves have changed, a forecast reusing the
+ * windows gives the same demand as a forecast starting afresh
+ */
+BOOST_AUTO_TEST_CASE (rmol_forecaster_window_holder_frat5) {
+  // The forecast of a flight-date at its first DCP, from ten similar
+  // departed flight-dates
+  const stdair::InventoryKey lInventoryKey ("BA");
+  stdair::Inventory& lInventory =
+    stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+  const stdair::Date_T lDepartureDate (2011, 6, 10);
+  const stdair::DateOffset_T lDCPOffset (RMOL::DCPCalendar::getDCP (0));
+  const stdair::DateTime_T lRMEventTime (lDepartureDate - lDCPOffset,
+                                         stdair::Duration_T (0, 0, 0));
+  stdair::FlightDate& lFlightDate =
+    buildForecastFlightDate (lInventory, lDepartureDate,
+                             lRMEventTime.date(), 10);
+  const stdair::SegmentDateList_T& lSDList =
+    stdair::BomManager::getList<stdair::SegmentDate> (lFlightDate);
+  BOOST_REQUIRE_EQUAL (lSDList.size(), 1);
+  const stdair::SegmentCabinList_T& lSCList =
+    stdair::BomManager::getList<stdair::SegmentCabin> (*lSDList.front());
+  BOOST_REQUIRE_EQUAL (lSCList.size(), 1);
+  const stdair::SegmentCabin& lSegmentCabin = *lSCList.front();
+  const stdair::FareFamilyList_T& lFFList =
+    stdair::BomManager::getList<stdair::FareFamily> (lSegmentCabin);
+  const stdair::BookingClassList_T& lBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lSegmentCabin);
+  BOOST_REQUIRE_EQUAL (lFFList.size(), 3);
+  BOOST_REQUIRE_EQUAL (lBCList.size(), 6);
+
+  const stdair::UnconstrainingMethod
+    lUnconstrainingMethod (stdair::UnconstrainingMethod::EM);
+  const stdair::ForecastingMethod::EN_ForecastingMethod lMethods[2] =
+    { stdair::ForecastingMethod::Q_FORECASTING,
+      stdair::ForecastingMethod::NEW_QFF };
+
+  // Original FRAT5 curve of the fare families, and a higher one
+  const stdair::FRAT5Curve_T lFRAT5Curve = lFFList.front()->getFrat5Curve();
+  stdair::FRAT5Curve_T lHigherFRAT5Curve;
+  for (stdair::FRAT5Curve_T::const_iterator itFRAT5 = lFRAT5Curve.begin();
+       itFRAT5 != lFRAT5Curve.end(); ++itFRAT5) {
+    lHigherFRAT5Curve[itFRAT5->first] = 2.0 * itFRAT5->second;
+  }
+
+  for (unsigned int m = 0; m < 2; ++m) {
+    const stdair::ForecastingMethod lForecastingMethod (lMethods[m]);
+
+    // Forecast with the original curves, then with the higher ones
+    // reusing the windows, and with the higher ones starting afresh.
+    // Each forecast has its own cache, so that all of them are computed.
+    RMOL::HistoricalBookingWindowHolder lHBWindowHolder;
+    std::vector<double> lForecastList[2];
+    for (unsigned int k = 0; k < 3; ++k) {
+      for (stdair::FareFamilyList_T::const_iterator itFF = lFFList.begin();
+           itFF != lFFList.end(); ++itFF) {
+        stdair::FareFamily* lFF_ptr = *itFF;
+        assert (lFF_ptr != NULL);
+        lFF_ptr->setFrat5Curve ((k == 0) ? lFRAT5Curve : lHigherFRAT5Curve);
+      }
+      if (k == 2) {
+        lHBWindowHolder.clear();
+      }
+      RMOL::ForecastCache lForecastCache;
+      const bool isForecasted =
+        RMOL::Forecaster::forecast (lFlightDate, lRMEventTime,
+                                    lUnconstrainingMethod,
+                                    lForecastingMethod, lHBWindowHolder,
+                                    lForecastCache);
+      BOOST_REQUIRE (isForecasted == true);
+      if (k == 0) {
+        continue;
+      }
+
+      std::vector<double>& lForecasts = lForecastList[k-1];
+      for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+           itBC != lBCList.end(); ++itBC) {
+        const stdair::BookingClass* lBC_ptr = *itBC;
+        assert (lBC_ptr != NULL);
+        lForecasts.push_back (lBC_ptr->getPriceDemMean());
+        lForecasts.push_back (lBC_ptr->getPriceDemStdDev());
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL (lForecastList[1].size(), lForecastList[0].size());
+    for (unsigned int idx = 0; idx < lForecastList[0].size(); ++idx) {
+      BOOST_CHECK_EQUAL (lForecastList[0][idx], lForecastList[1][idx]);
+    }
+  }
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
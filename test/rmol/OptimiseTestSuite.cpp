@@ -9,18 +9,79 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <future>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+// Boost
+#include <boost/make_shared.hpp>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE OptimiseTestSuite
 #include <boost/test/unit_test.hpp>
 // StdAir
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/STDAIR_Service.hpp>
 #include <stdair/basic/BasLogParams.hpp>
 #include <stdair/basic/BasDBParams.hpp>
 #include <stdair/basic/BasFileMgr.hpp>
 #include <stdair/service/Logger.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/BasConst_Inventory.hpp>
+#include <stdair/basic/RandomGeneration.hpp>
+#include <stdair/bom/BomManager.hpp>
+#include <stdair/bom/BomRoot.hpp>
+#include <stdair/bom/Inventory.hpp>
+#include <stdair/bom/InventoryKey.hpp>
+#include <stdair/bom/FlightDate.hpp>
+#include <stdair/bom/FlightDateKey.hpp>
+#include <stdair/bom/LegDate.hpp>
+#include <stdair/bom/LegDateKey.hpp>
+#include <stdair/bom/LegCabin.hpp>
+#include <stdair/bom/LegCabinKey.hpp>
+#include <stdair/bom/SegmentDate.hpp>
+#include <stdair/bom/SegmentDateKey.hpp>
+#include <stdair/bom/SegmentCabin.hpp>
+#include <stdair/bom/SegmentCabinKey.hpp>
+#include <stdair/bom/OnDDate.hpp>
+#include <stdair/bom/OnDDateKey.hpp>
+#include <stdair/bom/FareFamily.hpp>
+#include <stdair/bom/FareFamilyKey.hpp>
+#include <stdair/bom/BookingClass.hpp>
+#include <stdair/bom/BookingClassKey.hpp>
+#include <stdair/bom/Policy.hpp>
+#include <stdair/bom/VirtualClassStruct.hpp>
+#include <stdair/bom/PolicyKey.hpp>
+#include <stdair/bom/NestingNode.hpp>
+#include <stdair/bom/NestingNodeKey.hpp>
+#include <stdair/bom/SimpleNestingStructure.hpp>
+#include <stdair/bom/NestingStructureKey.hpp>
+#include <stdair/factory/FacBom.hpp>
+#include <stdair/factory/FacBomManager.hpp>
 // RMOL
 #include <rmol/basic/BasConst_General.hpp>
+#include <rmol/bom/BasisFactorisation.hpp>
+#include <rmol/bom/BidPriceAccelerator.hpp>
+#include <rmol/bom/BidPriceActiveSet.hpp>
+#include <rmol/bom/DCPCalendar.hpp>
+#include <rmol/bom/DualSimplex.hpp>
+#include <rmol/bom/LegCabinImageTable.hpp>
+#include <rmol/bom/NetworkIterationReport.hpp>
+#include <rmol/bom/NetworkLP.hpp>
+#include <rmol/bom/NetworkLPBasis.hpp>
+#include <rmol/bom/OnDIncidenceMatrix.hpp>
+#include <rmol/bom/PolicyCodeTable.hpp>
+#include <rmol/bom/PolicyHelper.hpp>
+#include <rmol/command/Optimiser.hpp>
+#include <rmol/command/FareAdjustment.hpp>
+#include <rmol/command/MarginalRevenueTransformation.hpp>
+#include <rmol/command/PreOptimiser.hpp>
+#include <rmol/LegOptimiser.hpp>
+#include <rmol/OptimisationControl.hpp>
 #include <rmol/RMOL_Service.hpp>
 #include <rmol/config/rmol-paths.hpp>
 
@@ -50,6 +111,607 @@ struct UnitTestConfig {
   }
 };
 
+namespace {
+
+  /**
+   * Build, within the given inventory, a flight-date with a single leg
+   * of two cabins, each one holding the demand projected on it.
+   */
+  stdair::FlightDate& buildSampleFlightDate (stdair::Inventory& ioInventory,
+                                             const stdair::FlightNumber_T&
+                                             iFlightNumber) {
+    const stdair::FlightDateKey lFlightDateKey (iFlightNumber,
+                                                stdair::Date_T (2011, 6, 10));
+    stdair::FlightDate& lFlightDate =
+      stdair::FacBom<stdair::FlightDate>::instance().create (lFlightDateKey);
+    stdair::FacBomManager::addToList (ioInventory, lFlightDate);
+    stdair::FacBomManager::linkWithParent (ioInventory, lFlightDate);
+
+    const stdair::LegDateKey lLegDateKey ("LHR");
+    stdair::LegDate& lLegDate =
+      stdair::FacBom<stdair::LegDate>::instance().create (lLegDateKey);
+    stdair::FacBomManager::addToList (lFlightDate, lLegDate);
+    stdair::FacBomManager::linkWithParent (lFlightDate, lLegDate);
+
+    const char* lCabinCodes[] = { "J", "Y" };
+    for (unsigned int i = 0; i < 2; ++i) {
+      const stdair::LegCabinKey lLegCabinKey (lCabinCodes[i]);
+      stdair::LegCabin& lLegCabin =
+        stdair::FacBom<stdair::LegCabin>::instance().create (lLegCabinKey);
+      stdair::FacBomManager::addToList (lLegDate, lLegCabin);
+      stdair::FacBomManager::linkWithParent (lLegDate, lLegCabin);
+
+      lLegCabin.setAvailabilityPool (20.0 + 30.0*i);
+      lLegCabin.setCurrentBidPrice (1.0);
+      lLegCabin.addDemandInformation (1000.0 - 400.0*i, 12.0, 4.0);
+      lLegCabin.addDemandInformation (500.0 - 200.0*i, 25.0, 8.0);
+      lLegCabin.addDemandInformation (200.0 - 80.0*i, 40.0, 0.0);
+    }
+    return lFlightDate;
+  }
+
+  /**
+   * Add to the given flight-date a segment-date, with a segment-cabin
+   * travelling the given leg-cabins.
+   */
+  stdair::SegmentDate&
+  addSegmentDate (stdair::FlightDate& ioFlightDate,
+                  const stdair::AirportCode_T& iBoardingPoint,
+                  const stdair::AirportCode_T& iOffPoint,
+                  const std::vector<stdair::LegCabin*>& iLegCabinList) {
+    const stdair::SegmentDateKey lSegmentDateKey (iBoardingPoint, iOffPoint);
+    stdair::SegmentDate& lSegmentDate =
+      stdair::FacBom<stdair::SegmentDate>::instance().create (lSegmentDateKey);
+    stdair::FacBomManager::addToListAndMap (ioFlightDate, lSegmentDate);
+    stdair::FacBomManager::linkWithParent (ioFlightDate, lSegmentDate);
+    if (iLegCabinList.empty() == true) {
+      return lSegmentDate;
+    }
+
+    const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+    stdair::SegmentCabin& lSegmentCabin =
+      stdair::FacBom<stdair::SegmentCabin>::instance().create(lSegmentCabinKey);
+    stdair::FacBomManager::addToListAndMap (lSegmentDate, lSegmentCabin);
+    stdair::FacBomManager::linkWithParent (lSegmentDate, lSegmentCabin);
+    for (std::vector<stdair::LegCabin*>::const_iterator itLC =
+           iLegCabinList.begin(); itLC != iLegCabinList.end(); ++itLC) {
+      stdair::FacBomManager::addToList (lSegmentCabin, **itLC);
+    }
+    return lSegmentDate;
+  }
+
+  /**
+   * Add to the given flight-date a leg-date, with a Y leg-cabin holding
+   * the given bid price.
+   */
+  stdair::LegCabin& addLegCabin (stdair::FlightDate& ioFlightDate,
+                                 const stdair::AirportCode_T& iBoardingPoint,
+                                 const stdair::BidPrice_T& iBidPrice) {
+    const stdair::LegDateKey lLegDateKey (iBoardingPoint);
+    stdair::LegDate& lLegDate =
+      stdair::FacBom<stdair::LegDate>::instance().create (lLegDateKey);
+    stdair::FacBomManager::addToListAndMap (ioFlightDate, lLegDate);
+    stdair::FacBomManager::linkWithParent (ioFlightDate, lLegDate);
+
+    const stdair::LegCabinKey lLegCabinKey ("Y");
+    stdair::LegCabin& lLegCabin =
+      stdair::FacBom<stdair::LegCabin>::instance().create (lLegCabinKey);
+    stdair::FacBomManager::addToListAndMap (lLegDate, lLegCabin);
+    stdair::FacBomManager::linkWithParent (lLegDate, lLegCabin);
+    lLegCabin.setCurrentBidPrice (iBidPrice);
+    return lLegCabin;
+  }
+
+  /**
+   * Add to the given inventory an O&D-date travelling the given
+   * segment-dates, with one O&D string by segment.
+   */
+  stdair::OnDDate&
+  addOnDDate (stdair::Inventory& ioInventory,
+              const stdair::OnDStringList_T& iOnDStringList,
+              const std::vector<stdair::SegmentDate*>& iSegmentDateList) {
+    const stdair::OnDDateKey lOnDDateKey (iOnDStringList);
+    stdair::OnDDate& lOnDDate =
+      stdair::FacBom<stdair::OnDDate>::instance().create (lOnDDateKey);
+    stdair::FacBomManager::addToList (ioInventory, lOnDDate);
+    stdair::FacBomManager::linkWithParent (ioInventory, lOnDDate);
+    for (std::vector<stdair::SegmentDate*>::const_iterator itSD =
+           iSegmentDateList.begin(); itSD != iSegmentDateList.end(); ++itSD) {
+      stdair::FacBomManager::addToList (lOnDDate, **itSD);
+    }
+    return lOnDDate;
+  }
+
+  /**
+   * Add to the given inventory an O&D-date travelling the given
+   * segment-dates, keyed by a single O&D string.
+   */
+  stdair::OnDDate&
+  addOnDDate (stdair::Inventory& ioInventory,
+              const stdair::OnDString_T& iOnDString,
+              const std::vector<stdair::SegmentDate*>& iSegmentDateList) {
+    stdair::OnDStringList_T lOnDStringList;
+    lOnDStringList.push_back (iOnDString);
+    return addOnDDate (ioInventory, lOnDStringList, iSegmentDateList);
+  }
+
+  /**
+   * Set the demand of the given O&D-date, in the Y cabin of each of its
+   * segments.
+   */
+  void setOnDDemand (stdair::OnDDate& ioOnDDate, const stdair::Yield_T& iYield,
+                     const stdair::MeanValue_T& iMean,
+                     const stdair::StdDevValue_T& iStdDev = 0.0) {
+    const stdair::CabinClassPair_T lCabinClassPair ("Y", "Y");
+    const stdair::CabinClassPairList_T
+      lCabinClassPairList (ioOnDDate.getNbOfSegments(), lCabinClassPair);
+    const stdair::MeanStdDevPair_T lMeanStdDevPair (iMean, iStdDev);
+    const stdair::YieldDemandPair_T lYieldDemandPair (iYield, lMeanStdDevPair);
+    ioOnDDate.setDemandInformation (lCabinClassPairList, lYieldDemandPair);
+  }
+
+  /**
+   * Code-share network of two carriers: AF operates CDG-LHR (AF1), which
+   * BA markets (BA301) through the image of AF1 held by its AF
+   * sub-inventory, and BA operates LHR-SYD (BA9). AF sells CDG-LHR on
+   * AF1, and BA sells CDG-SYD on BA301 and BA9.
+   */
+  struct CodeShareNetwork {
+    /** BOM tree. */
+    stdair::BomRoot* _bomRoot;
+
+    /** Flight-dates operated by AF and by BA. */
+    stdair::FlightDate* _af1;
+    stdair::FlightDate* _ba9;
+
+    /** Leg-cabins of AF1, of its image held by BA, and of BA9. */
+    stdair::LegCabin* _af1LegCabin;
+    stdair::LegCabin* _af1Image;
+    stdair::LegCabin* _ba9LegCabin;
+
+    /** O&D-dates of AF (CDG-LHR) and of BA (CDG-SYD). */
+    std::vector<stdair::OnDDate*> _onDDateList;
+  };
+
+  /**
+   * Build the code-share network within the given BOM tree, AF1 (and its
+   * image) and BA9 having the given capacities.
+   */
+  void buildCodeShareNetwork (stdair::BomRoot& ioBomRoot,
+                              const stdair::Availability_T& iAF1Capacity,
+                              const stdair::Availability_T& iBA9Capacity,
+                              CodeShareNetwork& oNetwork) {
+    stdair::BomRoot& lBomRoot = ioBomRoot;
+    oNetwork._bomRoot = &lBomRoot;
+    const stdair::InventoryKey lBAKey ("BA");
+    stdair::Inventory& lBA =
+      stdair::FacBom<stdair::Inventory>::instance().create (lBAKey);
+    stdair::FacBomManager::addToListAndMap (lBomRoot, lBA);
+    stdair::FacBomManager::linkWithParent (lBomRoot, lBA);
+    const stdair::InventoryKey lAFKey ("AF");
+    stdair::Inventory& lAF =
+      stdair::FacBom<stdair::Inventory>::instance().create (lAFKey);
+    stdair::FacBomManager::addToListAndMap (lBomRoot, lAF);
+    stdair::FacBomManager::linkWithParent (lBomRoot, lAF);
+    stdair::Inventory& lBAAF =
+      stdair::FacBom<stdair::Inventory>::instance().create (lAFKey);
+    stdair::FacBomManager::addToListAndMap (lBA, lBAAF);
+    stdair::FacBomManager::linkWithParent (lBA, lBAAF);
+
+    // AF1, operated by AF, and its image held by BA
+    const stdair::Date_T lDate (2011, 6, 10);
+    const stdair::FlightDateKey lAF1Key (1, lDate);
+    stdair::FlightDate& lAF1 =
+      stdair::FacBom<stdair::FlightDate>::instance().create (lAF1Key);
+    stdair::FacBomManager::addToListAndMap (lAF, lAF1);
+    stdair::FacBomManager::linkWithParent (lAF, lAF1);
+    stdair::FlightDate& lAF1Image =
+      stdair::FacBom<stdair::FlightDate>::instance().create (lAF1Key);
+    stdair::FacBomManager::addToListAndMap (lBAAF, lAF1Image);
+    stdair::FacBomManager::linkWithParent (lBAAF, lAF1Image);
+    oNetwork._af1 = &lAF1;
+    oNetwork._af1LegCabin = &addLegCabin (lAF1, "CDG", 1.0);
+    oNetwork._af1Image = &addLegCabin (lAF1Image, "CDG", 1.0);
+    oNetwork._af1LegCabin->setAvailabilityPool (iAF1Capacity);
+    oNetwork._af1Image->setAvailabilityPool (iAF1Capacity);
+    const std::vector<stdair::LegCabin*> lAF1List (1, oNetwork._af1LegCabin);
+    const std::vector<stdair::LegCabin*> lAF1ImageList (1, oNetwork._af1Image);
+    stdair::SegmentDate& lCDGLHR =
+      addSegmentDate (lAF1, "CDG", "LHR", lAF1List);
+    stdair::SegmentDate& lCDGLHRImage =
+      addSegmentDate (lAF1Image, "CDG", "LHR", lAF1ImageList);
+    stdair::LegDate* lCDG_ptr = stdair::BomManager::
+      getParentPtr<stdair::LegDate> (*oNetwork._af1LegCabin);
+    assert (lCDG_ptr != NULL);
+    stdair::FacBomManager::addToList (lCDGLHR, *lCDG_ptr);
+
+    // BA301, marketed by BA and operated by AF1 (through its image)
+    const stdair::FlightDateKey lBA301Key (301, lDate);
+    stdair::FlightDate& lBA301 =
+      stdair::FacBom<stdair::FlightDate>::instance().create (lBA301Key);
+    stdair::FacBomManager::addToListAndMap (lBA, lBA301);
+    stdair::FacBomManager::linkWithParent (lBA, lBA301);
+    stdair::SegmentDate& lBACDGLHR =
+      addSegmentDate (lBA301, "CDG", "LHR", std::vector<stdair::LegCabin*>());
+    lBACDGLHR.linkWithOperating (lCDGLHRImage);
+    stdair::FacBomManager::addToList (lCDGLHR, lBACDGLHR);
+
+    // BA9, operated by BA
+    const stdair::FlightDateKey lBA9Key (9, lDate);
+    stdair::FlightDate& lBA9 =
+      stdair::FacBom<stdair::FlightDate>::instance().create (lBA9Key);
+    stdair::FacBomManager::addToListAndMap (lBA, lBA9);
+    stdair::FacBomManager::linkWithParent (lBA, lBA9);
+    oNetwork._ba9 = &lBA9;
+    oNetwork._ba9LegCabin = &addLegCabin (lBA9, "LHR", 1.0);
+    oNetwork._ba9LegCabin->setAvailabilityPool (iBA9Capacity);
+    const std::vector<stdair::LegCabin*> lBA9List (1, oNetwork._ba9LegCabin);
+    stdair::SegmentDate& lLHRSYD =
+      addSegmentDate (lBA9, "LHR", "SYD", lBA9List);
+
+    // O&D-dates
+    std::vector<stdair::SegmentDate*> lSegmentDateList (1, &lCDGLHR);
+    oNetwork._onDDateList.clear();
+    oNetwork._onDDateList.push_back
+      (&addOnDDate (lAF, "AF;1,2011-Jun-10;CDG,LHR", lSegmentDateList));
+    lSegmentDateList.assign (1, &lBACDGLHR);
+    lSegmentDateList.push_back (&lLHRSYD);
+    stdair::OnDStringList_T lOnDStringList;
+    lOnDStringList.push_back ("BA;301,2011-Jun-10;CDG,LHR");
+    lOnDStringList.push_back ("BA;9,2011-Jun-10;LHR,SYD");
+    oNetwork._onDDateList.push_back
+      (&addOnDDate (lBA, lOnDStringList, lSegmentDateList));
+  }
+
+  /**
+   * Build the code-share network within a new BOM tree.
+   */
+  void buildCodeShareNetwork (const stdair::Availability_T& iAF1Capacity,
+                              const stdair::Availability_T& iBA9Capacity,
+                              CodeShareNetwork& oNetwork) {
+    stdair::BomRoot& lBomRoot =
+      stdair::FacBom<stdair::BomRoot>::instance().create();
+    buildCodeShareNetwork (lBomRoot, iAF1Capacity, iBA9Capacity, oNetwork);
+  }
+
+  /**
+   * Solve the linear program of two legs, of the given capacities, and
+   * of four products:
+   * <ul>
+   *   <li>0: first leg, yield 100, at most 6 units;</li>
+   *   <li>1: second leg, yield 80, at most 5 units;</li>
+   *   <li>2: both legs, yield 150, at most the given number of units;</li>
+   *   <li>3: first leg, yield 40, at most 20 units.</li>
+   * </ul>
+   */
+  bool solveSampleLP (const double iFirstCapacity,
+                      const double iSecondCapacity,
+                      const double iConnectingUpperBound,
+                      RMOL::FlagVector_T& ioBasicFlagList,
+                      RMOL::DualSimplex& ioDualSimplex,
+                      const RMOL::OptimisationControl* iControl_ptr = NULL) {
+    const unsigned int lColumnPointers[] = { 0, 1, 2, 4, 5 };
+    const unsigned int lRowIndices[] = { 0, 1, 0, 1, 0 };
+    const double lYields[] = { 100.0, 80.0, 150.0, 40.0 };
+    const double lUpperBounds[] = { 6.0, 5.0, iConnectingUpperBound, 20.0 };
+    const std::vector<unsigned int> lColumnPointerList (lColumnPointers,
+                                                        lColumnPointers + 5);
+    const std::vector<unsigned int> lRowIndexList (lRowIndices,
+                                                   lRowIndices + 5);
+    const std::vector<double> lYieldList (lYields, lYields + 4);
+    const std::vector<double> lUpperBoundList (lUpperBounds, lUpperBounds + 4);
+    std::vector<double> lCapacityList;
+    lCapacityList.push_back (iFirstCapacity);
+    lCapacityList.push_back (iSecondCapacity);
+    return ioDualSimplex.solve (2, lColumnPointerList, lRowIndexList,
+                                lYieldList, lUpperBoundList, lCapacityList,
+                                ioBasicFlagList, iControl_ptr);
+  }
+
+  /** Define a shortcut for the policy points of the MRT. */
+  typedef RMOL::MarginalRevenueTransformation::PolicyPoint PolicyPoint_T;
+  typedef RMOL::MarginalRevenueTransformation::PolicyPointList_T
+  PolicyPointList_T;
+
+  /**
+   * Add a policy point, opening the given class of the single fare
+   * family (none for the empty policy), so that the policies opening
+   * lower classes nest the other ones.
+   */
+  void addPolicyPoint (const int iClassIndex, const double iDemand,
+                       const double iTotalRevenue,
+                       PolicyPointList_T& ioPolicyPointList) {
+    PolicyPoint_T lPolicyPoint;
+    if (iClassIndex >= 0) {
+      RMOL::PolicyCodeTable::ClassPosition lClassPosition;
+      lClassPosition._fareFamilyIndex = 0;
+      lClassPosition._classIndex = iClassIndex;
+      lPolicyPoint._policyCode.push_back (lClassPosition);
+    }
+    lPolicyPoint._policy = NULL;
+    lPolicyPoint._demand = iDemand;
+    lPolicyPoint._stdDev = std::sqrt (iDemand);
+    lPolicyPoint._totalRevenue = iTotalRevenue;
+    ioPolicyPointList.push_back (lPolicyPoint);
+  }
+
+  /**
+   * Build the convex hull the way the MRT did before the monotone chain:
+   * from the empty policy, walk to the policy of greater demand and
+   * total revenue giving the greatest gradient, the first one on the
+   * list in case of a tie.
+   */
+  void buildGreedyConvexHull (const PolicyPointList_T& iPolicyPointList,
+                              PolicyPointList_T& oConvexHull) {
+    oConvexHull.clear();
+    const PolicyPoint_T* lCurrentPoint_ptr = &iPolicyPointList.front();
+    while (lCurrentPoint_ptr != NULL) {
+      oConvexHull.push_back (*lCurrentPoint_ptr);
+      const double lCurrentDem = lCurrentPoint_ptr->_demand;
+      const double lCurrentTR = lCurrentPoint_ptr->_totalRevenue;
+      double lGradient = 0.0;
+      lCurrentPoint_ptr = NULL;
+      for (PolicyPointList_T::const_iterator itPoint =
+             iPolicyPointList.begin();
+           itPoint != iPolicyPointList.end(); ++itPoint) {
+        const double lDem = itPoint->_demand;
+        const double lTR = itPoint->_totalRevenue;
+        if (lDem > lCurrentDem && lTR > lCurrentTR) {
+          const double lNewGradient = (lTR-lCurrentTR)/(lDem-lCurrentDem);
+          if (lNewGradient > lGradient) {
+            lGradient = lNewGradient;
+            lCurrentPoint_ptr = &*itPoint;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Build a segment-cabin of two fare families of three classes each,
+   * with their yields and cumulated price-oriented demand forecasts:
+   * <ul>
+   *   <li>first fare family: Y (1000, 2), B (800, 4), M (600, 7);</li>
+   *   <li>second fare family: H (400, 3), Q (300, 6), K (200, 10).</li>
+   * </ul>
+   * The yield-based nesting structure holds a single node. When asked
+   * for, all the policies (the empty policy first, then the ones opening
+   * the first fare family, then both of them) are built as the inventory
+   * does, and their demand is dispatched from their classes.
+   */
+  stdair::SegmentCabin& buildFareFamilyCabin (const bool iWithPolicies) {
+    const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+    stdair::SegmentCabin& lSegmentCabin =
+      stdair::FacBom<stdair::SegmentCabin>::instance().create
+      (lSegmentCabinKey);
+    const stdair::NestingStructureKey
+      lNestingStructureKey (stdair::YIELD_BASED_NESTING_STRUCTURE_CODE);
+    stdair::SimpleNestingStructure& lNestingStructure = stdair::
+      FacBom<stdair::SimpleNestingStructure>::instance().create
+      (lNestingStructureKey);
+    stdair::FacBomManager::addToListAndMap (lSegmentCabin, lNestingStructure);
+    stdair::FacBomManager::linkWithParent (lSegmentCabin, lNestingStructure);
+    const stdair::NestingNodeKey lNestingNodeKey ("0");
+    stdair::NestingNode& lNestingNode =
+      stdair::FacBom<stdair::NestingNode>::instance().create (lNestingNodeKey);
+    stdair::FacBomManager::addToList (lNestingStructure, lNestingNode);
+    stdair::FacBomManager::linkWithParent (lNestingStructure, lNestingNode);
+
+    const char* lFamilyCodes[] = { "1", "2" };
+    const char* lClassCodes[] = { "Y", "B", "M", "H", "Q", "K" };
+    const double lYields[] = { 1000.0, 800.0, 600.0, 400.0, 300.0, 200.0 };
+    const double lCumuPriceDemMeans[] = { 2.0, 4.0, 7.0, 3.0, 6.0, 10.0 };
+    std::vector<std::vector<stdair::BookingClass*> > lClassListList (2);
+    for (unsigned int f = 0; f < 2; ++f) {
+      const stdair::FareFamilyKey lFareFamilyKey (lFamilyCodes[f]);
+      stdair::FareFamily& lFareFamily =
+        stdair::FacBom<stdair::FareFamily>::instance().create (lFareFamilyKey);
+      stdair::FacBomManager::addToListAndMap (lSegmentCabin, lFareFamily);
+      stdair::FacBomManager::linkWithParent (lSegmentCabin, lFareFamily);
+      for (unsigned int c = 3*f; c < 3*f + 3; ++c) {
+        const stdair::BookingClassKey lBookingClassKey (lClassCodes[c]);
+        stdair::BookingClass& lBookingClass = stdair::
+          FacBom<stdair::BookingClass>::instance().create (lBookingClassKey);
+        stdair::FacBomManager::addToListAndMap (lFareFamily, lBookingClass);
+        stdair::FacBomManager::linkWithParent (lFareFamily, lBookingClass);
+        stdair::FacBomManager::addToListAndMap (lSegmentCabin, lBookingClass);
+        lBookingClass.setYield (lYields[c]);
+        lBookingClass.setCumuPriceDemMean (lCumuPriceDemMeans[c]);
+        lBookingClass.setCumuPriceDemStdDev (std::sqrt (lCumuPriceDemMeans[c]));
+        lClassListList[f].push_back (&lBookingClass);
+      }
+    }
+    if (iWithPolicies == false) {
+      return lSegmentCabin;
+    }
+
+    // The empty policy, the three policies opening the first fare family
+    // and the nine ones opening both fare families.
+    std::vector<std::vector<stdair::BookingClass*> > lPolicyClassListList;
+    lPolicyClassListList.push_back (std::vector<stdair::BookingClass*>());
+    for (unsigned int c = 0; c < 3; ++c) {
+      lPolicyClassListList.push_back
+        (std::vector<stdair::BookingClass*> (1, lClassListList[0][c]));
+    }
+    for (unsigned int c = 0; c < 3; ++c) {
+      for (unsigned int d = 0; d < 3; ++d) {
+        std::vector<stdair::BookingClass*> lPolicyClassList;
+        lPolicyClassList.push_back (lClassListList[0][c]);
+        lPolicyClassList.push_back (lClassListList[1][d]);
+        lPolicyClassListList.push_back (lPolicyClassList);
+      }
+    }
+    for (unsigned int p = 0; p < lPolicyClassListList.size(); ++p) {
+      const stdair::PolicyKey lPolicyKey (p);
+      stdair::Policy& lPolicy =
+        stdair::FacBom<stdair::Policy>::instance().create (lPolicyKey);
+      stdair::FacBomManager::addToList (lSegmentCabin, lPolicy);
+      stdair::FacBomManager::linkWithParent (lSegmentCabin, lPolicy);
+
+      // Dispatch the cumulated price-oriented demand of the classes.
+      lPolicy.resetDemandForecast();
+      stdair::MeanValue_T lDemand = 0.0;
+      double lVariance = 0.0;
+      const std::vector<stdair::BookingClass*>& lPolicyClassList =
+        lPolicyClassListList[p];
+      for (unsigned int c = 0; c < lPolicyClassList.size(); ++c) {
+        stdair::BookingClass& lBookingClass = *lPolicyClassList[c];
+        stdair::FacBomManager::addToList (lPolicy, lBookingClass);
+        const stdair::MeanValue_T& lMean = lBookingClass.getCumuPriceDemMean();
+        const stdair::StdDevValue_T& lStdDev =
+          lBookingClass.getCumuPriceDemStdDev();
+        lPolicy.addYieldDemand (lBookingClass.getYield(), lMean);
+        lDemand += lMean;
+        lVariance += lStdDev*lStdDev;
+      }
+      lPolicy.setDemand (lDemand);
+      lPolicy.setStdDev (std::sqrt (lVariance));
+    }
+    return lSegmentCabin;
+  }
+
+  /** Create an empty nesting node. */
+  stdair::NestingNode& createNestingNode() {
+    const stdair::NestingNodeKey lNestingNodeKey ("T");
+    return stdair::FacBom<stdair::NestingNode>::instance().create
+      (lNestingNodeKey);
+  }
+
+  /** Check that two nesting nodes hold the same classes, in the same
+      order. */
+  void checkSameClassList (const stdair::NestingNode& iNode,
+                           const stdair::NestingNode& iExpectedNode) {
+    const bool hasAListOfBC =
+      stdair::BomManager::hasList<stdair::BookingClass> (iNode);
+    BOOST_REQUIRE_EQUAL (hasAListOfBC, stdair::BomManager::
+                         hasList<stdair::BookingClass> (iExpectedNode));
+    if (hasAListOfBC == false) {
+      return;
+    }
+    const stdair::BookingClassList_T& lBCList =
+      stdair::BomManager::getList<stdair::BookingClass> (iNode);
+    const stdair::BookingClassList_T& lExpectedBCList =
+      stdair::BomManager::getList<stdair::BookingClass> (iExpectedNode);
+    BOOST_REQUIRE_EQUAL (lBCList.size(), lExpectedBCList.size());
+    BOOST_CHECK (std::equal (lBCList.begin(), lBCList.end(),
+                             lExpectedBCList.begin()));
+  }
+
+  /** Check that two convex hulls go through the same points. */
+  void checkSameConvexHull (const PolicyPointList_T& iConvexHull,
+                            const PolicyPointList_T& iExpectedConvexHull) {
+    BOOST_REQUIRE_EQUAL (iConvexHull.size(), iExpectedConvexHull.size());
+    for (unsigned int idx = 0; idx < iConvexHull.size(); ++idx) {
+      BOOST_CHECK_EQUAL (iConvexHull[idx]._demand,
+                         iExpectedConvexHull[idx]._demand);
+      BOOST_CHECK_EQUAL (iConvexHull[idx]._totalRevenue,
+                         iExpectedConvexHull[idx]._totalRevenue);
+    }
+  }
+
+  /** Number of classes of the leg-cabin of sample2.csv. */
+  const unsigned int SAMPLE2_NB_OF_CLASSES = 4;
+
+  /** Yields, demand means and demand standard deviations of the classes
+      of sample2.csv. */
+  const double SAMPLE2_YIELDS[] = { 1050.0, 567.0, 534.0, 520.0 };
+  const double SAMPLE2_MEANS[] = { 17.3, 45.1, 39.6, 34.0 };
+  const double SAMPLE2_STDDEVS[] = { 5.8, 15.0, 13.2, 11.3 };
+
+  /**
+   * Build a leg-cabin of the given capacity, travelled by a
+   * segment-cabin of the given classes, each one being a virtual class
+   * of the leg-cabin (as the inventory parser does).
+   */
+  stdair::LegCabin& buildVirtualClassLegCabin (const unsigned int iNbOfClasses,
+                                               const double* iYieldList,
+                                               const double* iMeanList,
+                                               const double* iStdDevList,
+                                               const unsigned int iCapacity) {
+    const stdair::LegCabinKey lLegCabinKey ("Y");
+    stdair::LegCabin& lLegCabin =
+      stdair::FacBom<stdair::LegCabin>::instance().create (lLegCabinKey);
+    lLegCabin.setCapacities (iCapacity);
+    lLegCabin.setAvailabilityPool (iCapacity);
+    const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+    stdair::SegmentCabin& lSegmentCabin =
+      stdair::FacBom<stdair::SegmentCabin>::instance().create(lSegmentCabinKey);
+    stdair::FacBomManager::addToList (lLegCabin, lSegmentCabin);
+    stdair::FacBomManager::addToList (lSegmentCabin, lLegCabin);
+
+    const stdair::BookingClassKey lBookingClassKey (stdair::DEFAULT_CLASS_CODE);
+    for (unsigned int j = 0; j < iNbOfClasses; ++j) {
+      stdair::BookingClass& lBookingClass = stdair::
+        FacBom<stdair::BookingClass>::instance().create (lBookingClassKey);
+      stdair::FacBomManager::addToList (lSegmentCabin, lBookingClass);
+      lBookingClass.setYield (iYieldList[j]);
+      lBookingClass.setMean (iMeanList[j]);
+      lBookingClass.setStdDev (iStdDevList[j]);
+      stdair::BookingClassList_T lBookingClassList;
+      lBookingClassList.push_back (&lBookingClass);
+      stdair::VirtualClassStruct lVirtualClass (lBookingClassList);
+      lVirtualClass.setYield (iYieldList[j]);
+      lVirtualClass.setMean (iMeanList[j]);
+      lVirtualClass.setStdDev (iStdDevList[j]);
+      lLegCabin.addVirtualClass (lVirtualClass);
+    }
+    return lLegCabin;
+  }
+
+  /**
+   * Check the protections of EMSR-a or EMSR-b against the ones of the
+   * BOM optimiser, which are not bounded: they must be kept within
+   * [0, C] and be non-decreasing, the bid prices following them.
+   */
+  void checkBoundedProtections (const RMOL::OptimizationType::
+                                EN_OptimizationType& iOptimizationType,
+                                const unsigned int iNbOfClasses,
+                                const double* iYieldList,
+                                const double* iMeanList,
+                                const double* iStdDevList,
+                                const unsigned int iCapacity) {
+    stdair::LegCabin& lLegCabin =
+      buildVirtualClassLegCabin (iNbOfClasses, iYieldList, iMeanList,
+                                 iStdDevList, iCapacity);
+    if (iOptimizationType == RMOL::OptimizationType::HEUR_EMSRA) {
+      RMOL::Optimiser::heuristicOptimisationByEmsrA (lLegCabin);
+    } else {
+      RMOL::Optimiser::heuristicOptimisationByEmsrB (lLegCabin);
+    }
+
+    RMOL::LegOptimisationWorkspace lWorkspace;
+    std::vector<double> lProtectionList (iNbOfClasses);
+    std::vector<double> lBidPriceList (iCapacity);
+    RMOL::LegOptimiser::optimise (iOptimizationType, iNbOfClasses,
+                                  iYieldList, iMeanList, iStdDevList,
+                                  iCapacity, 0, lWorkspace,
+                                  &lProtectionList[0], &lBidPriceList[0]);
+
+    const stdair::VirtualClassList_T& lVirtualClassList =
+      lLegCabin.getVirtualClassList();
+    stdair::VirtualClassList_T::const_iterator itVC =
+      lVirtualClassList.begin();
+    double lPreviousProtection = 0.0;
+    for (unsigned int j = 0; j + 1 < iNbOfClasses; ++j, ++itVC) {
+      const double lExpectedProtection =
+        std::min (static_cast<double> (iCapacity),
+                  std::max (itVC->getCumulatedProtection(),
+                            lPreviousProtection));
+      BOOST_CHECK_CLOSE (lProtectionList[j], lExpectedProtection, 1e-9);
+      lPreviousProtection = lExpectedProtection;
+    }
+    BOOST_CHECK_EQUAL (lProtectionList[iNbOfClasses - 1],
+                       static_cast<double> (iCapacity));
+
+    for (unsigned int k = 0; k < iCapacity; ++k) {
+      BOOST_CHECK (lBidPriceList[k] <= iYieldList[0]);
+      BOOST_CHECK (lBidPriceList[k] >= iYieldList[iNbOfClasses - 1]);
+      if (k > 0) {
+        BOOST_CHECK (lBidPriceList[k] <= lBidPriceList[k - 1]);
+      }
+    }
+  }
+}
 
 // //////////////////////////////////////////////////////////////////////
 int testOptimiseHelper (const unsigned short optimisationMethodFlag,
@@ -302,7 +964,1665 @@ BOOST_AUTO_TEST_CASE (rmol_optimisation_emsr_b_built_in) {
   BOOST_CHECK_NO_THROW (testOptimiseHelper(4, isBuiltin););
 }
 
+/**
+ * Test that skipping, within the network iterations, the leg-cabins
+ * which the bid price active set does not flag gives the bid prices of
+ * optimising all of them at each iteration
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_bid_price_active_set) {
+  // The optimisation logs through the StdAir service
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_active_set.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  RMOL::RMOL_Service rmolService (lLogParams);
+
+  // Two identical networks: the leg-cabins of the first one are all
+  // optimised at each iteration, the ones of the second one only when
+  // the active set flags them
+  stdair::BomRoot& lBomRoot =
+    stdair::FacBom<stdair::BomRoot>::instance().create();
+  const char* lAirlineCodes[] = { "BA", "AF" };
+  std::vector<RMOL::BidPriceActiveSet> lActiveSetList (2);
+  for (unsigned int i = 0; i < 2; ++i) {
+    const stdair::InventoryKey lInventoryKey (lAirlineCodes[i]);
+    stdair::Inventory& lInventory =
+      stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+    stdair::FacBomManager::addToList (lBomRoot, lInventory);
+    stdair::FacBomManager::linkWithParent (lBomRoot, lInventory);
+
+    std::vector<stdair::FlightDate*> lFlightDateList;
+    lFlightDateList.push_back (&buildSampleFlightDate (lInventory, 10));
+    lFlightDateList.push_back (&buildSampleFlightDate (lInventory, 12));
+    lActiveSetList[i].build (lFlightDateList,
+                             std::vector<stdair::OnDDate*>());
+  }
+  const RMOL::BidPriceActiveSet::LegCabinList_T& lFullList =
+    lActiveSetList[0].getLegCabinList();
+  const RMOL::BidPriceActiveSet::LegCabinList_T& lActiveList =
+    lActiveSetList[1].getLegCabinList();
+  BOOST_REQUIRE_EQUAL (lFullList.size(), 4);
+  BOOST_REQUIRE_EQUAL (lActiveList.size(), 4);
+
+  for (unsigned int lIteration = 0; lIteration < 3; ++lIteration) {
+    lActiveSetList[0].update();
+    lActiveSetList[1].update();
+
+    // No O&D-date reads the bid prices: the leg-cabins are only active
+    // at the first iteration
+    const unsigned int lNbOfActiveLegCabins =
+      lActiveSetList[1].getNbOfActiveLegCabins();
+    BOOST_CHECK_EQUAL (lNbOfActiveLegCabins,
+                       (lIteration == 0) ? lActiveList.size() : 0);
+
+    const RMOL::FlagVector_T lAllFlagList (lFullList.size(), true);
+    const double lFullVariation = RMOL::Optimiser::
+      optimiseUsingOnDForecast (lFullList, lAllFlagList, 1);
+    const double lActiveVariation = RMOL::Optimiser::
+      optimiseUsingOnDForecast (lActiveList,
+                                lActiveSetList[1].getActiveFlagList(), 2);
+    BOOST_CHECK_EQUAL (lFullVariation, lActiveVariation);
+
+    for (unsigned int lLCIdx = 0; lLCIdx < lFullList.size(); ++lLCIdx) {
+      const stdair::LegCabin& lFullLC = *lFullList[lLCIdx];
+      const stdair::LegCabin& lActiveLC = *lActiveList[lLCIdx];
+      BOOST_CHECK (lFullLC.getBidPriceVector()
+                   == lActiveLC.getBidPriceVector());
+      BOOST_CHECK_EQUAL (lFullLC.getCurrentBidPrice(),
+                         lActiveLC.getCurrentBidPrice());
+      BOOST_CHECK_EQUAL (lFullLC.getPreviousBidPrice(),
+                         lActiveLC.getPreviousBidPrice());
+    }
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the active set follows the dependencies of the leg-cabins
+ * on the bid prices read by the O&D-dates of a code-share network: a
+ * leg-cabin is reactivated only when one of the bid prices read for the
+ * O&D-dates it carries changes
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_bid_price_active_set_ond) {
+  // AF1 carries the local demand of AF, which reads AF1; BA9 carries the
+  // connecting demand of BA, which reads the image of AF1 and BA9
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0);
+  std::vector<stdair::FlightDate*> lFlightDateList;
+  lFlightDateList.push_back (lNetwork._af1);
+  lFlightDateList.push_back (lNetwork._ba9);
+  RMOL::BidPriceActiveSet lBidPriceActiveSet;
+  lBidPriceActiveSet.build (lFlightDateList, lNetwork._onDDateList);
+  const RMOL::BidPriceActiveSet::LegCabinList_T& lLegCabinList =
+    lBidPriceActiveSet.getLegCabinList();
+  BOOST_REQUIRE_EQUAL (lLegCabinList.size(), 2);
+  BOOST_CHECK (lLegCabinList[0] == lNetwork._af1LegCabin);
+  BOOST_CHECK (lLegCabinList[1] == lNetwork._ba9LegCabin);
+  const RMOL::FlagVector_T& lActiveFlagList =
+    lBidPriceActiveSet.getActiveFlagList();
+
+  // All the leg-cabins are active at the first iteration, and none of
+  // them when no bid price changes
+  lBidPriceActiveSet.update();
+  BOOST_CHECK_EQUAL (lBidPriceActiveSet.getNbOfActiveLegCabins(), 2);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK_EQUAL (lBidPriceActiveSet.getNbOfActiveLegCabins(), 0);
+
+  // BA9 reads its own bid price
+  lNetwork._ba9LegCabin->setCurrentBidPrice (50.0);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK (lActiveFlagList[0] == false && lActiveFlagList[1] == true);
+
+  // BA9 reads the bid price sent by AF to the image of AF1
+  lNetwork._af1Image->setCurrentBidPrice (70.0);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK (lActiveFlagList[0] == false && lActiveFlagList[1] == true);
+
+  // Whereas the bid price of the real AF1 is read by the local demand
+  // only, until it is sent to the image
+  lNetwork._af1LegCabin->setCurrentBidPrice (80.0);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK (lActiveFlagList[0] == true && lActiveFlagList[1] == false);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK_EQUAL (lBidPriceActiveSet.getNbOfActiveLegCabins(), 0);
+  lNetwork._af1Image->setCurrentBidPrice (80.0);
+  lBidPriceActiveSet.update();
+  BOOST_CHECK (lActiveFlagList[0] == false && lActiveFlagList[1] == true);
+}
+
+/**
+ * Test the damped and Anderson (depth 1) iterations on the bid prices of
+ * the leg-cabins of a small network, against hand-computed values
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_bid_price_accelerator) {
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  std::vector<stdair::LegCabin*> lLegCabinList;
+  lLegCabinList.push_back (lNetwork._af1LegCabin);
+  lLegCabinList.push_back (lNetwork._ba9LegCabin);
+
+  // Bid prices x(k) given to the optimisation of AF1 and BA9, and bid
+  // prices G(x(k)) given back, at the first two iterations
+  const double lBidPrices[2][2] = { { 100.0, 50.0 }, { 110.0, 45.0 } };
+  const double lNewBidPrices[2][2] = { { 120.0, 40.0 }, { 116.0, 43.0 } };
+
+  // With a damping factor of 0.5, the residuals are f(0) = (20, -10) and
+  // f(1) = (6, -2); for the Anderson iterations, dx = (10, -5),
+  // df = (-14, 8) and g = (df.f(1)) / (df.df) = -100/260 = -5/13
+  const double lExpectedBidPrices[2][2][2] =
+    { { { 110.0, 45.0 }, { 113.0, 44.0 } },
+      { { 110.0, 45.0 }, { 113.0 + 15.0/13.0, 44.0 - 5.0/13.0 } } };
+  const RMOL::BidPriceAccelerationMethod_T lMethods[2] =
+    { RMOL::BP_ACCELERATION_DAMPED, RMOL::BP_ACCELERATION_ANDERSON };
+  for (unsigned int m = 0; m < 2; ++m) {
+    RMOL::BidPriceAccelerator lBidPriceAccelerator (lMethods[m], 0.5);
+    for (unsigned int k = 0; k < 2; ++k) {
+      // The optimisation records x(k) as the previous bid prices, and
+      // gives G(x(k)) as the current ones
+      std::vector<double> lBidPriceList;
+      std::vector<double> lNewBidPriceList;
+      for (unsigned int idx = 0; idx < 2; ++idx) {
+        stdair::LegCabin& lLegCabin = *lLegCabinList[idx];
+        lLegCabin.setCurrentBidPrice (lBidPrices[k][idx]);
+        lLegCabin.updatePreviousBidPrice();
+        lLegCabin.setCurrentBidPrice (lNewBidPrices[k][idx]);
+        lBidPriceList.push_back (lLegCabin.getPreviousBidPrice());
+        lNewBidPriceList.push_back (lLegCabin.getCurrentBidPrice());
+      }
+      lBidPriceAccelerator.accelerate (lBidPriceList, lNewBidPriceList);
+      for (unsigned int idx = 0; idx < 2; ++idx) {
+        BOOST_CHECK_CLOSE (lNewBidPriceList[idx],
+                           lExpectedBidPrices[m][k][idx], 1e-9);
+      }
+    }
+  }
+
+  // A non-positive Anderson bid price is given the damped value: here,
+  // x = (10, 8), G(x) = (8, 6.1) and the secant step would give -30
+  RMOL::BidPriceAccelerator lBidPriceAccelerator (RMOL::
+                                                  BP_ACCELERATION_ANDERSON,
+                                                  1.0);
+  std::vector<double> lNewBidPriceList (1, 8.0);
+  lBidPriceAccelerator.accelerate (std::vector<double> (1, 10.0),
+                                   lNewBidPriceList);
+  BOOST_CHECK_CLOSE (lNewBidPriceList[0], 8.0, 1e-9);
+  lNewBidPriceList.assign (1, 6.1);
+  lBidPriceAccelerator.accelerate (std::vector<double> (1, 8.0),
+                                   lNewBidPriceList);
+  BOOST_CHECK_CLOSE (lNewBidPriceList[0], 6.1, 1e-9);
+
+  // Once reset, the previous iterate is forgotten: damped iteration
+  lBidPriceAccelerator.reset();
+  lNewBidPriceList.assign (1, 12.0);
+  lBidPriceAccelerator.accelerate (std::vector<double> (1, 6.1),
+                                   lNewBidPriceList);
+  BOOST_CHECK_CLOSE (lNewBidPriceList[0], 12.0, 1e-9);
+
+  // Without acceleration, G(x) is kept
+  RMOL::BidPriceAccelerator lPlainBidPriceAccelerator (RMOL::
+                                                       BP_ACCELERATION_NONE,
+                                                       0.5);
+  lPlainBidPriceAccelerator.accelerate (std::vector<double> (1, 6.1),
+                                        lNewBidPriceList);
+  BOOST_CHECK_EQUAL (lNewBidPriceList[0], 12.0);
+}
+
+/**
+ * Test that the network optimisation with advanced RM cooperation gives,
+ * with or without acceleration, the same bid prices and the same
+ * iterations on one thread and on several threads
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_advanced_rm_cooperation_threads) {
+  // The optimisation logs through the StdAir services
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_advanced_rmc_threads.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // The RM event hits the first DCP of the flight-dates of the network
+  const stdair::DateOffset_T lDCPOffset (RMOL::DCPCalendar::getDCP (0));
+  const stdair::DateTime_T lRMEventTime (stdair::Date_T (2011, 6, 10)
+                                         - lDCPOffset,
+                                         stdair::Duration_T (0, 0, 0));
+
+  // One code-share network per acceleration method and number of
+  // threads, each one within the BOM tree of its own StdAir service. As
+  // a StdAir service cleans all the BOM objects when it is destroyed,
+  // all the services are kept until the networks have been compared.
+  const RMOL::BidPriceAccelerationMethod_T lMethods[2] =
+    { RMOL::BP_ACCELERATION_NONE, RMOL::BP_ACCELERATION_ANDERSON };
+  const unsigned int lNbOfThreads[2] = { 1, 4 };
+  std::vector<stdair::STDAIR_ServicePtr_T> lSTDAIRServiceList;
+  std::vector<boost::shared_ptr<RMOL::RMOL_Service> > lRMOLServiceList;
+  std::vector<CodeShareNetwork> lNetworkList (4);
+  for (unsigned int idx = 0; idx < 4; ++idx) {
+    const stdair::STDAIR_ServicePtr_T lSTDAIR_Service_ptr =
+      boost::make_shared<stdair::STDAIR_Service> (lLogParams);
+    lSTDAIRServiceList.push_back (lSTDAIR_Service_ptr);
+    const boost::shared_ptr<RMOL::RMOL_Service> lRMOL_Service_ptr =
+      boost::make_shared<RMOL::RMOL_Service> (lSTDAIR_Service_ptr);
+    lRMOLServiceList.push_back (lRMOL_Service_ptr);
+    RMOL::RMOL_Service& lRMOL_Service = *lRMOL_Service_ptr;
+    lRMOL_Service.setNbOfThreads (lNbOfThreads[idx % 2]);
+    lRMOL_Service.setBidPriceAcceleration (lMethods[idx / 2], 0.5);
+
+    CodeShareNetwork& lNetwork = lNetworkList[idx];
+    buildCodeShareNetwork (lSTDAIR_Service_ptr->getBomRoot(), 10.0, 5.0,
+                           lNetwork);
+    setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0, 2.0);
+    setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0, 2.0);
+
+    // The steps of the A-RMC partnership technique, but for the O&D
+    // forecast (the demand being set above)
+    lRMOL_Service.resetDemandInformation (lRMEventTime);
+    lRMOL_Service.updateBidPrice (lRMEventTime);
+    lRMOL_Service.projectOnDDemandOnLegCabinsUsingDYP (lRMEventTime);
+    lRMOL_Service.optimiseOnDUsingAdvancedRMCooperation (lRMEventTime);
+  }
+
+  for (unsigned int m = 0; m < 2; ++m) {
+    const RMOL::NetworkIterationReport& lReport =
+      lRMOLServiceList[2*m]->getNetworkIterationReport();
+    const RMOL::NetworkIterationReport& lThreadReport =
+      lRMOLServiceList[2*m + 1]->getNetworkIterationReport();
+    BOOST_REQUIRE (lReport.getNbOfIterations() > 0);
+    BOOST_CHECK_EQUAL (lThreadReport.getNbOfIterations(),
+                       lReport.getNbOfIterations());
+    BOOST_CHECK (lThreadReport.getBidPriceVariationList()
+                 == lReport.getBidPriceVariationList());
+    BOOST_CHECK (lThreadReport.getNbOfOptimisedLegCabinsList()
+                 == lReport.getNbOfOptimisedLegCabinsList());
+    BOOST_CHECK (lThreadReport.hasConverged() == lReport.hasConverged());
+
+    // The leg-cabins of AF1, of its image held by BA and of BA9
+    const CodeShareNetwork& lNetwork = lNetworkList[2*m];
+    const CodeShareNetwork& lThreadNetwork = lNetworkList[2*m + 1];
+    const stdair::LegCabin* lLegCabins[3] =
+      { lNetwork._af1LegCabin, lNetwork._af1Image, lNetwork._ba9LegCabin };
+    const stdair::LegCabin* lThreadLegCabins[3] =
+      { lThreadNetwork._af1LegCabin, lThreadNetwork._af1Image,
+        lThreadNetwork._ba9LegCabin };
+    for (unsigned int lLCIdx = 0; lLCIdx < 3; ++lLCIdx) {
+      const stdair::LegCabin& lLegCabin = *lLegCabins[lLCIdx];
+      const stdair::LegCabin& lThreadLegCabin = *lThreadLegCabins[lLCIdx];
+      BOOST_CHECK (lThreadLegCabin.getBidPriceVector()
+                   == lLegCabin.getBidPriceVector());
+      BOOST_CHECK_EQUAL (lThreadLegCabin.getCurrentBidPrice(),
+                         lLegCabin.getCurrentBidPrice());
+      BOOST_CHECK_EQUAL (lThreadLegCabin.getPreviousBidPrice(),
+                         lLegCabin.getPreviousBidPrice());
+    }
+
+    // The bid prices have been sent to the image of AF1
+    BOOST_CHECK_EQUAL (lNetwork._af1Image->getCurrentBidPrice(),
+                       lNetwork._af1LegCabin->getCurrentBidPrice());
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the O&D incidence matrix gives, for each segment of each
+ * O&D-date, the operating segment-cabins, leg-cabins and sums of bid
+ * prices which the demand projections formerly read from the BOM tree
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_ond_incidence_matrix) {
+  // BA operates LHR-JFK (BA10) and JFK-ORD-LAX (BA20); AF markets
+  // LHR-JFK (AF30), operated by BA10
+  stdair::BomRoot& lBomRoot =
+    stdair::FacBom<stdair::BomRoot>::instance().create();
+  const stdair::InventoryKey lBAKey ("BA");
+  stdair::Inventory& lBA =
+    stdair::FacBom<stdair::Inventory>::instance().create (lBAKey);
+  stdair::FacBomManager::addToList (lBomRoot, lBA);
+  stdair::FacBomManager::linkWithParent (lBomRoot, lBA);
+  const stdair::InventoryKey lAFKey ("AF");
+  stdair::Inventory& lAF =
+    stdair::FacBom<stdair::Inventory>::instance().create (lAFKey);
+  stdair::FacBomManager::addToList (lBomRoot, lAF);
+  stdair::FacBomManager::linkWithParent (lBomRoot, lAF);
+
+  const stdair::Date_T lDate (2011, 6, 10);
+  const stdair::FlightDateKey lBA10Key (10, lDate);
+  stdair::FlightDate& lBA10 =
+    stdair::FacBom<stdair::FlightDate>::instance().create (lBA10Key);
+  stdair::FacBomManager::addToList (lBA, lBA10);
+  stdair::FacBomManager::linkWithParent (lBA, lBA10);
+  std::vector<stdair::LegCabin*> lLHRList;
+  lLHRList.push_back (&addLegCabin (lBA10, "LHR", 150.0));
+  stdair::SegmentDate& lLHRJFK =
+    addSegmentDate (lBA10, "LHR", "JFK", lLHRList);
+
+  const stdair::FlightDateKey lBA20Key (20, lDate);
+  stdair::FlightDate& lBA20 =
+    stdair::FacBom<stdair::FlightDate>::instance().create (lBA20Key);
+  stdair::FacBomManager::addToList (lBA, lBA20);
+  stdair::FacBomManager::linkWithParent (lBA, lBA20);
+  std::vector<stdair::LegCabin*> lJFKList, lORDList, lJFKORDList;
+  lJFKList.push_back (&addLegCabin (lBA20, "JFK", 85.5));
+  lORDList.push_back (&addLegCabin (lBA20, "ORD", 42.25));
+  lJFKORDList.push_back (lJFKList.front());
+  lJFKORDList.push_back (lORDList.front());
+  stdair::SegmentDate& lJFKORD = addSegmentDate (lBA20, "JFK", "ORD", lJFKList);
+  stdair::SegmentDate& lORDLAX = addSegmentDate (lBA20, "ORD", "LAX", lORDList);
+  stdair::SegmentDate& lJFKLAX =
+    addSegmentDate (lBA20, "JFK", "LAX", lJFKORDList);
+
+  const stdair::FlightDateKey lAF30Key (30, lDate);
+  stdair::FlightDate& lAF30 =
+    stdair::FacBom<stdair::FlightDate>::instance().create (lAF30Key);
+  stdair::FacBomManager::addToList (lAF, lAF30);
+  stdair::FacBomManager::linkWithParent (lAF, lAF30);
+  stdair::SegmentDate& lAFLHRJFK =
+    addSegmentDate (lAF30, "LHR", "JFK", std::vector<stdair::LegCabin*>());
+  lAFLHRJFK.linkWithOperating (lLHRJFK);
+
+  std::vector<stdair::SegmentDate*> lSegmentDateList;
+  lSegmentDateList.push_back (&lLHRJFK);
+  addOnDDate (lBA, "BA;10,2011-Jun-10;LHR,JFK", lSegmentDateList);
+  lSegmentDateList.push_back (&lJFKLAX);
+  addOnDDate (lBA, "BA;10,2011-Jun-10;LHR,LAX", lSegmentDateList);
+  lSegmentDateList.clear();
+  lSegmentDateList.push_back (&lJFKORD);
+  lSegmentDateList.push_back (&lORDLAX);
+  addOnDDate (lBA, "BA;20,2011-Jun-10;JFK,ORD", lSegmentDateList);
+  lSegmentDateList.clear();
+  lSegmentDateList.push_back (&lAFLHRJFK);
+  addOnDDate (lAF, "AF;30,2011-Jun-10;LHR,JFK", lSegmentDateList);
+
+  RMOL::OnDIncidenceMatrix lOnDIncidenceMatrix;
+  lOnDIncidenceMatrix.build (lBomRoot);
+  BOOST_REQUIRE (lOnDIncidenceMatrix.isBuilt() == true);
+  BOOST_CHECK_EQUAL (lOnDIncidenceMatrix.getNbOfRows(), 6);
+  BOOST_CHECK_EQUAL (lOnDIncidenceMatrix.getNbOfColumns(), 3);
+
+  std::vector<stdair::BidPrice_T> lColumnBidPriceList;
+  lOnDIncidenceMatrix.getBidPriceList (lColumnBidPriceList);
+  std::vector<stdair::BidPrice_T> lRowBidPriceList;
+  lOnDIncidenceMatrix.multiply (lColumnBidPriceList, lRowBidPriceList);
+
+  // Browse the O&D-dates the way the projections did, from the segment-
+  // dates to the segment-cabins of the operating segment-dates
+  unsigned int lExpectedRowIdx = 0;
+  const stdair::InventoryList_T& lInventoryList =
+    stdair::BomManager::getList<stdair::Inventory> (lBomRoot);
+  for (stdair::InventoryList_T::const_iterator itInv = lInventoryList.begin();
+       itInv != lInventoryList.end(); ++itInv) {
+    const stdair::OnDDateList_T& lOnDDateList =
+      stdair::BomManager::getList<stdair::OnDDate> (**itInv);
+    for (stdair::OnDDateList_T::const_iterator itOD = lOnDDateList.begin();
+         itOD != lOnDDateList.end(); ++itOD) {
+      const stdair::OnDDate& lOnDDate = **itOD;
+      const stdair::SegmentDateList_T& lOnDSegmentDateList =
+        stdair::BomManager::getList<stdair::SegmentDate> (lOnDDate);
+      BOOST_CHECK_EQUAL (lOnDIncidenceMatrix.getNbOfSegments (lOnDDate),
+                         lOnDSegmentDateList.size());
+
+      unsigned int lSegmentIdx =
+        lOnDIncidenceMatrix.getFirstSegmentIndex (lOnDDate);
+      for (stdair::SegmentDateList_T::const_iterator itSD =
+             lOnDSegmentDateList.begin();
+           itSD != lOnDSegmentDateList.end(); ++itSD, ++lSegmentIdx) {
+        const stdair::SegmentDate* lSegmentDate_ptr = *itSD;
+        const stdair::SegmentDate* lOperatingSegmentDate_ptr =
+          lSegmentDate_ptr->getOperatingSegmentDate();
+        const bool isOperated = (lOperatingSegmentDate_ptr == NULL);
+        if (isOperated == false) {
+          lSegmentDate_ptr = lOperatingSegmentDate_ptr;
+        }
+        const stdair::SegmentCabin* lSegmentCabin_ptr = stdair::BomManager::
+          getObjectPtr<stdair::SegmentCabin> (*lSegmentDate_ptr, "Y");
+        BOOST_REQUIRE (lSegmentCabin_ptr != NULL);
+
+        const unsigned int lRowIdx =
+          lOnDIncidenceMatrix.getRowIndex (lSegmentIdx, "Y");
+        BOOST_CHECK_EQUAL (lRowIdx, lExpectedRowIdx);
+        BOOST_CHECK (&lOnDIncidenceMatrix.getSegmentCabin (lRowIdx)
+                     == lSegmentCabin_ptr);
+        BOOST_CHECK_EQUAL (lOnDIncidenceMatrix.isOperated (lRowIdx),
+                           isOperated);
+
+        // The leg-cabins, in the order of the BOM tree, and the sum of
+        // their bid prices
+        const stdair::LegCabinList_T& lLegCabinList =
+          stdair::BomManager::getList<stdair::LegCabin> (*lSegmentCabin_ptr);
+        BOOST_REQUIRE_EQUAL (lOnDIncidenceMatrix.getRowEnd (lRowIdx)
+                             - lOnDIncidenceMatrix.getRowBegin (lRowIdx),
+                             lLegCabinList.size());
+        stdair::BidPrice_T lBidPriceSum = 0;
+        unsigned int lPos = lOnDIncidenceMatrix.getRowBegin (lRowIdx);
+        for (stdair::LegCabinList_T::const_iterator itLC =
+               lLegCabinList.begin(); itLC != lLegCabinList.end();
+             ++itLC, ++lPos) {
+          const stdair::LegCabin* lLegCabin_ptr = *itLC;
+          BOOST_CHECK (&lOnDIncidenceMatrix.
+                       getLegCabin (lOnDIncidenceMatrix.getColumnIndex (lPos))
+                       == lLegCabin_ptr);
+          lBidPriceSum += lLegCabin_ptr->getCurrentBidPrice();
+        }
+        BOOST_CHECK_EQUAL (lRowBidPriceList[lRowIdx], lBidPriceSum);
+        ++lExpectedRowIdx;
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL (lExpectedRowIdx, lOnDIncidenceMatrix.getNbOfRows());
+}
+
+/**
+ * Test that the leg-cabin image table resolves each leg-cabin of an
+ * operating flight-date to its image held, in the operating
+ * sub-inventory of the marketer, by the marketing partner, and back
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_cabin_image_table) {
+  // AF1 is marketed by BA (BA301), BA9 by no partner
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  RMOL::LegCabinImageTable lLegCabinImageTable;
+  BOOST_CHECK (lLegCabinImageTable.isBuilt() == false);
+  lLegCabinImageTable.build (*lNetwork._bomRoot);
+  BOOST_CHECK (lLegCabinImageTable.isBuilt() == true);
+
+  // The leg-cabin of AF1 is linked to its image in the AF sub-inventory
+  // of BA
+  const RMOL::LegCabinImageTable::LegCabinImageList_T& lAF1ImageList =
+    lLegCabinImageTable.getLegCabinImageList (*lNetwork._af1);
+  BOOST_REQUIRE_EQUAL (lAF1ImageList.size(), 1);
+  BOOST_CHECK (lAF1ImageList[0]._legCabin == lNetwork._af1LegCabin);
+  BOOST_CHECK (lAF1ImageList[0]._image == lNetwork._af1Image);
+  BOOST_CHECK (lAF1ImageList[0]._isFirst == true);
+  const stdair::LegDate* lImageLD_ptr =
+    stdair::BomManager::getParentPtr<stdair::LegDate> (*lNetwork._af1Image);
+  BOOST_REQUIRE (lImageLD_ptr != NULL);
+  const stdair::FlightDate* lImageFD_ptr =
+    stdair::BomManager::getParentPtr<stdair::FlightDate> (*lImageLD_ptr);
+  BOOST_REQUIRE (lImageFD_ptr != NULL);
+  const stdair::Inventory* lImageInv_ptr =
+    stdair::BomManager::getParentPtr<stdair::Inventory> (*lImageFD_ptr);
+  BOOST_REQUIRE (lImageInv_ptr != NULL);
+  BOOST_CHECK_EQUAL (lImageInv_ptr->getAirlineCode(), "AF");
+  const stdair::Inventory* lMktInv_ptr =
+    stdair::BomManager::getParentPtr<stdair::Inventory> (*lImageInv_ptr);
+  BOOST_REQUIRE (lMktInv_ptr != NULL);
+  BOOST_CHECK_EQUAL (lMktInv_ptr->getAirlineCode(), "BA");
+
+  // The image gives back the real leg-cabin, which is its own real
+  // leg-cabin
+  BOOST_CHECK (&lLegCabinImageTable.getRealLegCabin (*lNetwork._af1Image)
+               == lNetwork._af1LegCabin);
+  BOOST_CHECK (&lLegCabinImageTable.getRealLegCabin (*lNetwork._af1LegCabin)
+               == lNetwork._af1LegCabin);
+
+  // The leg-cabin of BA9 has no image, and is its own real leg-cabin
+  BOOST_CHECK (lLegCabinImageTable.getLegCabinImageList (*lNetwork._ba9).
+               empty() == true);
+  BOOST_CHECK (&lLegCabinImageTable.getRealLegCabin (*lNetwork._ba9LegCabin)
+               == lNetwork._ba9LegCabin);
+
+  // Once cleared, the table must be built again
+  lLegCabinImageTable.clear();
+  BOOST_CHECK (lLegCabinImageTable.isBuilt() == false);
+}
+
+/**
+ * Test that the network LP counts the seats of a code-share leg once:
+ * the image of AF1 held by BA shares the row of AF1, so that the demand
+ * of BA on AF1 prices AF1
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_network_lp_code_share) {
+  // The optimisation logs through the StdAir service
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_network_lp_code_share.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  RMOL::RMOL_Service rmolService (lLogParams);
+
+  // AF sells 8 seats of AF1 at 100, and BA 6 seats of BA301 (AF1) and
+  // BA9 at 500: the 10 seats of AF1 are shared
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 100.0, lNetwork);
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0);
+
+  // The incidence matrix holds the image, as BA301 is operated by it
+  RMOL::OnDIncidenceMatrix lOnDIncidenceMatrix;
+  lOnDIncidenceMatrix.build (*lNetwork._bomRoot);
+  BOOST_CHECK_EQUAL (lOnDIncidenceMatrix.getNbOfColumns(), 3);
+  RMOL::LegCabinImageTable lLegCabinImageTable;
+  lLegCabinImageTable.build (*lNetwork._bomRoot);
+
+  // But the program has a single row by physical leg-cabin
+  RMOL::NetworkLP lNetworkLP;
+  lNetworkLP.build (lOnDIncidenceMatrix, lLegCabinImageTable,
+                    lNetwork._onDDateList);
+  BOOST_REQUIRE_EQUAL (lNetworkLP.getNbOfRows(), 2);
+  BOOST_CHECK_EQUAL (lNetworkLP.getNbOfColumns(), 2);
+  for (unsigned int lRowIdx = 0; lRowIdx < 2; ++lRowIdx) {
+    const stdair::LegCabin* lLegCabin_ptr = &lNetworkLP.getLegCabin (lRowIdx);
+    BOOST_CHECK (lLegCabin_ptr == lNetwork._af1LegCabin
+                 || lLegCabin_ptr == lNetwork._ba9LegCabin);
+    BOOST_CHECK_EQUAL (lNetworkLP.getCapacityList()[lRowIdx],
+                       lLegCabin_ptr->getAvailabilityPool());
+  }
+
+  // The local demand of AF is the marginal one on AF1 (4 seats out of
+  // 8), whereas BA9 is not binding
+  std::vector<stdair::FlightDate*> lFlightDateList;
+  lFlightDateList.push_back (lNetwork._af1);
+  lFlightDateList.push_back (lNetwork._ba9);
+  RMOL::NetworkLPBasis lNetworkLPBasis;
+  BOOST_REQUIRE (RMOL::Optimiser::
+                 optimiseUsingNetworkLP (lOnDIncidenceMatrix,
+                                         lLegCabinImageTable,
+                                         lNetwork._onDDateList,
+                                         lFlightDateList, 0, 1,
+                                         lNetworkLPBasis) == true);
+  BOOST_CHECK_CLOSE (lNetwork._af1LegCabin->getCurrentBidPrice(), 100.0,
+                     1e-9);
+  BOOST_CHECK_CLOSE (lNetwork._ba9LegCabin->getCurrentBidPrice(), 1.0, 1e-9);
+
+  // The image gets the bid price of AF1 from the partner exchange only
+  BOOST_CHECK_EQUAL (lNetwork._af1Image->getCurrentBidPrice(), 1.0);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the bid prices of the randomised LP are the averages of the
+ * shadow prices of the programs of the demand scenarios
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_randomised_lp_average) {
+  // The optimisation logs through the StdAir service
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_randomised_lp_average.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  RMOL::RMOL_Service rmolService (lLogParams);
+
+  // Both AF1 and BA9 are binding on average, but not in every scenario
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0, 3.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0, 2.0);
+  RMOL::OnDIncidenceMatrix lOnDIncidenceMatrix;
+  lOnDIncidenceMatrix.build (*lNetwork._bomRoot);
+  RMOL::LegCabinImageTable lLegCabinImageTable;
+  lLegCabinImageTable.build (*lNetwork._bomRoot);
+
+  // Solve the programs of the scenarios one by one, each one from the
+  // optimal basis of the deterministic program
+  RMOL::NetworkLP lNetworkLP;
+  lNetworkLP.build (lOnDIncidenceMatrix, lLegCabinImageTable,
+                    lNetwork._onDDateList);
+  const unsigned int lNbOfRows = lNetworkLP.getNbOfRows();
+  BOOST_REQUIRE_EQUAL (lNbOfRows, 2);
+  RMOL::FlagVector_T lBasicFlagList;
+  const RMOL::NetworkLPBasis lColdNetworkLPBasis;
+  lColdNetworkLPBasis.load (lNetworkLP, lBasicFlagList);
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_REQUIRE (lDualSimplex.solve (lNbOfRows,
+                                     lNetworkLP.getColumnPointerList(),
+                                     lNetworkLP.getRowIndexList(),
+                                     lNetworkLP.getYieldList(),
+                                     lNetworkLP.getMeanList(),
+                                     lNetworkLP.getCapacityList(),
+                                     lBasicFlagList) == true);
+
+  const stdair::NbOfSamples_T lNbOfScenarios = 40;
+  stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+  std::vector<double> lDualSumList (lNbOfRows, 0.0);
+  std::vector<double> lMinDualList (lNbOfRows,
+                                    std::numeric_limits<double>::max());
+  std::vector<double> lMaxDualList (lNbOfRows, 0.0);
+  for (unsigned int k = 0; k < lNbOfScenarios; ++k) {
+    std::vector<double> lDemandList;
+    lNetworkLP.drawDemandList (lGenerator, lDemandList);
+    RMOL::FlagVector_T lScenarioBasicFlagList (lBasicFlagList);
+    RMOL::DualSimplex lScenarioDualSimplex;
+    BOOST_REQUIRE (lScenarioDualSimplex.
+                   solve (lNbOfRows, lNetworkLP.getColumnPointerList(),
+                          lNetworkLP.getRowIndexList(),
+                          lNetworkLP.getYieldList(), lDemandList,
+                          lNetworkLP.getCapacityList(),
+                          lScenarioBasicFlagList) == true);
+    const std::vector<double>& lDualList = lScenarioDualSimplex.getDualList();
+    for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+      lDualSumList[lRowIdx] += lDualList[lRowIdx];
+      lMinDualList[lRowIdx] = std::min (lMinDualList[lRowIdx],
+                                        lDualList[lRowIdx]);
+      lMaxDualList[lRowIdx] = std::max (lMaxDualList[lRowIdx],
+                                        lDualList[lRowIdx]);
+    }
+  }
+
+  // The shadow prices do vary from one scenario to the next
+  for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+    BOOST_CHECK (lMinDualList[lRowIdx] < lMaxDualList[lRowIdx]);
+  }
+
+  // The randomised LP gives their averages (the minimal bid price
+  // being 1.0)
+  std::vector<stdair::FlightDate*> lFlightDateList;
+  lFlightDateList.push_back (lNetwork._af1);
+  lFlightDateList.push_back (lNetwork._ba9);
+  RMOL::NetworkLPBasis lNetworkLPBasis;
+  BOOST_REQUIRE (RMOL::Optimiser::
+                 optimiseUsingNetworkLP (lOnDIncidenceMatrix,
+                                         lLegCabinImageTable,
+                                         lNetwork._onDDateList,
+                                         lFlightDateList, lNbOfScenarios, 1,
+                                         lNetworkLPBasis) == true);
+  for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+    const double lAverageDual = lDualSumList[lRowIdx] / lNbOfScenarios;
+    BOOST_CHECK_CLOSE (lNetworkLP.getLegCabin (lRowIdx).getCurrentBidPrice(),
+                       std::max (1.0, lAverageDual), 1e-9);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the bid prices of the randomised LP do not depend on the
+ * number of threads solving the programs of the scenarios
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_randomised_lp_threads) {
+  // The optimisation logs through the StdAir service
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_randomised_lp_threads.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  RMOL::RMOL_Service rmolService (lLogParams);
+
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0, 3.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0, 2.0);
+  RMOL::OnDIncidenceMatrix lOnDIncidenceMatrix;
+  lOnDIncidenceMatrix.build (*lNetwork._bomRoot);
+  RMOL::LegCabinImageTable lLegCabinImageTable;
+  lLegCabinImageTable.build (*lNetwork._bomRoot);
+  std::vector<stdair::FlightDate*> lFlightDateList;
+  lFlightDateList.push_back (lNetwork._af1);
+  lFlightDateList.push_back (lNetwork._ba9);
+
+  // Bid prices of AF1 and BA9, with 1 to 4 threads
+  std::vector<std::vector<stdair::BidPrice_T> > lBidPriceLists;
+  for (unsigned int lNbOfThreads = 1; lNbOfThreads <= 4; ++lNbOfThreads) {
+    RMOL::NetworkLPBasis lNetworkLPBasis;
+    BOOST_REQUIRE (RMOL::Optimiser::
+                   optimiseUsingNetworkLP (lOnDIncidenceMatrix,
+                                           lLegCabinImageTable,
+                                           lNetwork._onDDateList,
+                                           lFlightDateList, 100, lNbOfThreads,
+                                           lNetworkLPBasis) == true);
+    std::vector<stdair::BidPrice_T> lBidPriceList;
+    lBidPriceList.push_back (lNetwork._af1LegCabin->getCurrentBidPrice());
+    lBidPriceList.push_back (lNetwork._ba9LegCabin->getCurrentBidPrice());
+    lBidPriceLists.push_back (lBidPriceList);
+  }
+
+  // The averages are summed in the order of the scenarios: the bid
+  // prices are exactly the same
+  for (unsigned int t = 1; t < lBidPriceLists.size(); ++t) {
+    BOOST_CHECK (lBidPriceLists[t] == lBidPriceLists[0]);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the basis of the former network program shortens the solve
+ * of the next one, without changing its shadow prices
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_network_lp_warm_start) {
+  CodeShareNetwork lNetwork;
+  buildCodeShareNetwork (10.0, 5.0, lNetwork);
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 8.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 6.0);
+  RMOL::OnDIncidenceMatrix lOnDIncidenceMatrix;
+  lOnDIncidenceMatrix.build (*lNetwork._bomRoot);
+  RMOL::LegCabinImageTable lLegCabinImageTable;
+  lLegCabinImageTable.build (*lNetwork._bomRoot);
+
+  // Program of the first RM event, solved from the slacks
+  RMOL::NetworkLPBasis lNetworkLPBasis;
+  RMOL::NetworkLP lNetworkLP;
+  lNetworkLP.build (lOnDIncidenceMatrix, lLegCabinImageTable,
+                    lNetwork._onDDateList);
+  RMOL::FlagVector_T lBasicFlagList;
+  lNetworkLPBasis.load (lNetworkLP, lBasicFlagList);
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_REQUIRE (lDualSimplex.solve (lNetworkLP.getNbOfRows(),
+                                     lNetworkLP.getColumnPointerList(),
+                                     lNetworkLP.getRowIndexList(),
+                                     lNetworkLP.getYieldList(),
+                                     lNetworkLP.getMeanList(),
+                                     lNetworkLP.getCapacityList(),
+                                     lBasicFlagList) == true);
+  lNetworkLPBasis.save (lNetworkLP, lBasicFlagList);
+
+  // Program of the next RM event, the forecasts having changed
+  setOnDDemand (*lNetwork._onDDateList[0], 100.0, 9.0);
+  setOnDDemand (*lNetwork._onDDateList[1], 500.0, 7.0);
+  RMOL::NetworkLP lNextNetworkLP;
+  lNextNetworkLP.build (lOnDIncidenceMatrix, lLegCabinImageTable,
+                        lNetwork._onDDateList);
+  const unsigned int lNbOfRows = lNextNetworkLP.getNbOfRows();
+  BOOST_REQUIRE_EQUAL (lNbOfRows, 2);
+
+  // Solved from the slacks, and from the saved basis
+  RMOL::FlagVector_T lColdBasicFlagList;
+  const RMOL::NetworkLPBasis lColdNetworkLPBasis;
+  lColdNetworkLPBasis.load (lNextNetworkLP, lColdBasicFlagList);
+  RMOL::DualSimplex lColdDualSimplex;
+  BOOST_REQUIRE (lColdDualSimplex.solve (lNbOfRows,
+                                         lNextNetworkLP.getColumnPointerList(),
+                                         lNextNetworkLP.getRowIndexList(),
+                                         lNextNetworkLP.getYieldList(),
+                                         lNextNetworkLP.getMeanList(),
+                                         lNextNetworkLP.getCapacityList(),
+                                         lColdBasicFlagList) == true);
+  RMOL::FlagVector_T lWarmBasicFlagList;
+  lNetworkLPBasis.load (lNextNetworkLP, lWarmBasicFlagList);
+  RMOL::DualSimplex lWarmDualSimplex;
+  BOOST_REQUIRE (lWarmDualSimplex.solve (lNbOfRows,
+                                         lNextNetworkLP.getColumnPointerList(),
+                                         lNextNetworkLP.getRowIndexList(),
+                                         lNextNetworkLP.getYieldList(),
+                                         lNextNetworkLP.getMeanList(),
+                                         lNextNetworkLP.getCapacityList(),
+                                         lWarmBasicFlagList) == true);
+
+  // The saved basis is still optimal: no pivot is needed, and the
+  // solution is the same. The connecting demand is limited by BA9, and
+  // the local one by AF1.
+  BOOST_CHECK (lWarmDualSimplex.getNbOfIterations()
+               < lColdDualSimplex.getNbOfIterations());
+  BOOST_CHECK_CLOSE (lWarmDualSimplex.getObjectiveValue(),
+                     lColdDualSimplex.getObjectiveValue(), 1e-9);
+  for (unsigned int lRowIdx = 0; lRowIdx < lNbOfRows; ++lRowIdx) {
+    BOOST_CHECK_CLOSE (lWarmDualSimplex.getDualList()[lRowIdx],
+                       lColdDualSimplex.getDualList()[lRowIdx], 1e-9);
+    const double lExpectedDual =
+      (&lNextNetworkLP.getLegCabin (lRowIdx) == lNetwork._af1LegCabin)
+      ? 100.0 : 400.0;
+    BOOST_CHECK_CLOSE (lWarmDualSimplex.getDualList()[lRowIdx], lExpectedDual,
+                       1e-9);
+  }
+}
+
+/**
+ * Test the solves of the sparse LU factorisation of a basis, before and
+ * after an update, against the products by the basis
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_basis_factorisation) {
+  // Candidate columns (1,1,0,0), (0,1,1,0), (1,1,0,0) again, which depends
+  // on the first one, and (0,0,1,1)
+  const unsigned int lColumnPointers[] = { 0, 2, 4, 6, 8 };
+  const unsigned int lRowIndices[] = { 0, 1, 1, 2, 0, 1, 2, 3 };
+  const double lValues[] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  const std::vector<unsigned int> lColumnPointerList (lColumnPointers,
+                                                      lColumnPointers + 5);
+  const std::vector<unsigned int> lRowIndexList (lRowIndices, lRowIndices + 8);
+  const std::vector<double> lValueList (lValues, lValues + 8);
+
+  RMOL::BasisFactorisation lBasisFactorisation;
+  std::vector<unsigned int> lBasisList;
+  lBasisFactorisation.factorise (4, lColumnPointerList, lRowIndexList,
+                                 lValueList, lBasisList);
+  BOOST_REQUIRE_EQUAL (lBasisList.size(), 4);
+
+  // The dependent column is left out, and one unit column completes the
+  // basis
+  std::vector<std::vector<double> > lBasis (4, std::vector<double> (4, 0.0));
+  unsigned int lNbOfUnitColumns = 0;
+  for (unsigned int k = 0; k < 4; ++k) {
+    BOOST_CHECK (lBasisList[k] != 2);
+    if (lBasisList[k] >= 4) {
+      ++lNbOfUnitColumns;
+      lBasis[k][lBasisList[k] - 4] = 1.0;
+      continue;
+    }
+    for (unsigned int lPos = lColumnPointers[lBasisList[k]];
+         lPos < lColumnPointers[lBasisList[k] + 1]; ++lPos) {
+      lBasis[k][lRowIndices[lPos]] = lValues[lPos];
+    }
+  }
+  BOOST_CHECK_EQUAL (lNbOfUnitColumns, 1);
+
+  for (unsigned int lUpdate = 0; lUpdate < 2; ++lUpdate) {
+    // B.x = a
+    const double lRightHandSides[] = { 3.0, -1.0, 2.5, 7.0 };
+    std::vector<double> lSolution (lRightHandSides, lRightHandSides + 4);
+    lBasisFactorisation.solve (lSolution);
+    for (unsigned int r = 0; r < 4; ++r) {
+      double lProduct = 0.0;
+      for (unsigned int k = 0; k < 4; ++k) {
+        lProduct += lBasis[k][r] * lSolution[k];
+      }
+      BOOST_CHECK_CLOSE (lProduct + 10.0, lRightHandSides[r] + 10.0, 1e-9);
+    }
+
+    // y.B = d
+    std::vector<double> lTransposeSolution (lRightHandSides,
+                                            lRightHandSides + 4);
+    lBasisFactorisation.solveTranspose (lTransposeSolution);
+    for (unsigned int k = 0; k < 4; ++k) {
+      double lProduct = 0.0;
+      for (unsigned int r = 0; r < 4; ++r) {
+        lProduct += lTransposeSolution[r] * lBasis[k][r];
+      }
+      BOOST_CHECK_CLOSE (lProduct + 10.0, lRightHandSides[k] + 10.0, 1e-9);
+    }
+
+    // Replace the column at the second position by (0,0,1,0)
+    std::vector<double> lColumn (4, 0.0);
+    lColumn[2] = 1.0;
+    for (unsigned int r = 0; r < 4; ++r) {
+      lBasis[1][r] = lColumn[r];
+    }
+    lBasisFactorisation.solve (lColumn);
+    lBasisFactorisation.update (1, lColumn);
+  }
+  BOOST_CHECK_EQUAL (lBasisFactorisation.getNbOfUpdates(), 2);
+}
+
+/**
+ * Test the dual simplex on a program with bounded columns, the primal
+ * and dual solutions of which are known: the connecting product fills
+ * the first leg after the best local product (at its bound), and the
+ * second leg is shared with the local product of that leg
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_lp_bounded_columns) {
+  const double lInfinity = std::numeric_limits<double>::infinity();
+  const double lUpperBounds[] = { 20.0, lInfinity };
+  for (unsigned int i = 0; i < 2; ++i) {
+    RMOL::FlagVector_T lBasicFlagList;
+    RMOL::DualSimplex lDualSimplex;
+    BOOST_REQUIRE (solveSampleLP (10.0, 8.0, lUpperBounds[i], lBasicFlagList,
+                                  lDualSimplex) == true);
+    BOOST_CHECK (lDualSimplex.isInfeasible() == false);
+    BOOST_CHECK (lDualSimplex.isUnbounded() == false);
+    BOOST_CHECK_CLOSE (lDualSimplex.getObjectiveValue(), 1520.0, 1e-9);
+
+    const std::vector<double>& lPrimalList = lDualSimplex.getPrimalList();
+    BOOST_REQUIRE_EQUAL (lPrimalList.size(), 4);
+    BOOST_CHECK_CLOSE (lPrimalList[0], 6.0, 1e-9);
+    BOOST_CHECK_CLOSE (lPrimalList[1], 4.0, 1e-9);
+    BOOST_CHECK_CLOSE (lPrimalList[2], 4.0, 1e-9);
+    BOOST_CHECK_SMALL (lPrimalList[3], 1e-9);
+
+    const std::vector<double>& lDualList = lDualSimplex.getDualList();
+    BOOST_REQUIRE_EQUAL (lDualList.size(), 2);
+    BOOST_CHECK_CLOSE (lDualList[0], 70.0, 1e-9);
+    BOOST_CHECK_CLOSE (lDualList[1], 80.0, 1e-9);
+  }
+}
+
+/**
+ * Test the dual simplex on a degenerate program, where two identical
+ * products tie in the ratio test
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_lp_degenerate_ties) {
+  // A single leg of capacity 10; products 0 and 1 are identical (yield
+  // 100, at most 10 units), product 2 has a yield of 50
+  const unsigned int lColumnPointers[] = { 0, 1, 2, 3 };
+  const std::vector<unsigned int> lColumnPointerList (lColumnPointers,
+                                                      lColumnPointers + 4);
+  const std::vector<unsigned int> lRowIndexList (3, 0);
+  const double lYields[] = { 100.0, 100.0, 50.0 };
+  const std::vector<double> lYieldList (lYields, lYields + 3);
+  const double lUpperBounds[] = { 10.0, 10.0, 5.0 };
+  const std::vector<double> lUpperBoundList (lUpperBounds, lUpperBounds + 3);
+  const std::vector<double> lCapacityList (1, 10.0);
+
+  RMOL::FlagVector_T lBasicFlagList;
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_REQUIRE (lDualSimplex.solve (1, lColumnPointerList, lRowIndexList,
+                                     lYieldList, lUpperBoundList,
+                                     lCapacityList, lBasicFlagList) == true);
+  BOOST_CHECK_CLOSE (lDualSimplex.getObjectiveValue(), 1000.0, 1e-9);
+  const std::vector<double>& lPrimalList = lDualSimplex.getPrimalList();
+  BOOST_CHECK_CLOSE (lPrimalList[0] + lPrimalList[1], 10.0, 1e-9);
+  BOOST_CHECK_SMALL (lPrimalList[2], 1e-9);
+  BOOST_CHECK_CLOSE (lDualSimplex.getDualList()[0], 100.0, 1e-9);
+
+  // The basis holds one of the tied products
+  BOOST_REQUIRE_EQUAL (lBasicFlagList.size(), 4);
+  BOOST_CHECK (lBasicFlagList[0] != lBasicFlagList[1]);
+  BOOST_CHECK (lBasicFlagList[2] == false && lBasicFlagList[3] == false);
+}
+
+/**
+ * Test the warm start of the dual simplex from a saved basis
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_lp_warm_start) {
+  RMOL::FlagVector_T lBasicFlagList;
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_REQUIRE (solveSampleLP (10.0, 8.0, 20.0, lBasicFlagList,
+                                lDualSimplex) == true);
+  BOOST_CHECK (lDualSimplex.getNbOfIterations() > 0);
+
+  // From its own optimal basis, the program needs no iteration
+  RMOL::FlagVector_T lSavedBasicFlagList (lBasicFlagList);
+  RMOL::DualSimplex lWarmDualSimplex;
+  BOOST_REQUIRE (solveSampleLP (10.0, 8.0, 20.0, lSavedBasicFlagList,
+                                lWarmDualSimplex) == true);
+  BOOST_CHECK_EQUAL (lWarmDualSimplex.getNbOfIterations(), 0);
+  BOOST_CHECK (lSavedBasicFlagList == lBasicFlagList);
+  BOOST_CHECK_CLOSE (lWarmDualSimplex.getObjectiveValue(), 1520.0, 1e-9);
+
+  // A larger first leg: the warm and cold starts give the same solution
+  // (the connecting product takes the extra seats)
+  RMOL::FlagVector_T lColdBasicFlagList;
+  RMOL::DualSimplex lColdDualSimplex;
+  BOOST_REQUIRE (solveSampleLP (12.0, 8.0, 20.0, lColdBasicFlagList,
+                                lColdDualSimplex) == true);
+  lSavedBasicFlagList = lBasicFlagList;
+  BOOST_REQUIRE (solveSampleLP (12.0, 8.0, 20.0, lSavedBasicFlagList,
+                                lWarmDualSimplex) == true);
+  BOOST_CHECK (lWarmDualSimplex.getNbOfIterations()
+               <= lColdDualSimplex.getNbOfIterations());
+  BOOST_CHECK_CLOSE (lColdDualSimplex.getObjectiveValue(), 1660.0, 1e-9);
+  BOOST_CHECK_CLOSE (lWarmDualSimplex.getObjectiveValue(), 1660.0, 1e-9);
+  const double lExpectedPrimals[] = { 6.0, 2.0, 6.0, 0.0 };
+  for (unsigned int j = 0; j < 4; ++j) {
+    BOOST_CHECK_SMALL (lWarmDualSimplex.getPrimalList()[j]
+                       - lExpectedPrimals[j], 1e-9);
+    BOOST_CHECK_SMALL (lColdDualSimplex.getPrimalList()[j]
+                       - lExpectedPrimals[j], 1e-9);
+  }
+  const double lExpectedDuals[] = { 70.0, 80.0 };
+  for (unsigned int k = 0; k < 2; ++k) {
+    BOOST_CHECK_CLOSE (lWarmDualSimplex.getDualList()[k],
+                       lExpectedDuals[k], 1e-9);
+    BOOST_CHECK_CLOSE (lColdDualSimplex.getDualList()[k],
+                       lExpectedDuals[k], 1e-9);
+  }
+}
+
+/**
+ * Test that the dual simplex reports the infeasible and unbounded
+ * programs
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_lp_infeasible_unbounded) {
+  // A negative capacity cannot be met
+  RMOL::FlagVector_T lBasicFlagList;
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_CHECK (solveSampleLP (-1.0, 8.0, 20.0, lBasicFlagList,
+                              lDualSimplex) == false);
+  BOOST_CHECK (lDualSimplex.isOptimal() == false);
+  BOOST_CHECK (lDualSimplex.isInfeasible() == true);
+  BOOST_CHECK (lDualSimplex.isUnbounded() == false);
+
+  // A product without any leg nor upper bound can be sold without limit
+  const unsigned int lColumnPointers[] = { 0, 1, 1 };
+  const std::vector<unsigned int> lColumnPointerList (lColumnPointers,
+                                                      lColumnPointers + 3);
+  const std::vector<unsigned int> lRowIndexList (1, 0);
+  const double lYields[] = { 100.0, 10.0 };
+  const std::vector<double> lYieldList (lYields, lYields + 2);
+  const double lUpperBounds[] = { 5.0,
+                                  std::numeric_limits<double>::infinity() };
+  const std::vector<double> lUpperBoundList (lUpperBounds, lUpperBounds + 2);
+  const std::vector<double> lCapacityList (1, 10.0);
+  BOOST_CHECK (lDualSimplex.solve (1, lColumnPointerList, lRowIndexList,
+                                   lYieldList, lUpperBoundList, lCapacityList,
+                                   lBasicFlagList) == false);
+  BOOST_CHECK (lDualSimplex.isInfeasible() == false);
+  BOOST_CHECK (lDualSimplex.isUnbounded() == true);
+}
+
+/**
+ * Test that the dual simplex stops, without reaching optimality, once
+ * its control requests it
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_lp_interrupted) {
+  // Without any stop, the control does not alter the resolution
+  RMOL::OptimisationControl lControl;
+  RMOL::FlagVector_T lBasicFlagList;
+  RMOL::DualSimplex lDualSimplex;
+  BOOST_REQUIRE (solveSampleLP (10.0, 8.0, 20.0, lBasicFlagList,
+                                lDualSimplex, &lControl) == true);
+  BOOST_CHECK (lDualSimplex.isInterrupted() == false);
+  BOOST_CHECK (lDualSimplex.getNbOfIterations() > 0);
+  BOOST_CHECK_CLOSE (lDualSimplex.getObjectiveValue(), 1520.0, 1e-9);
+
+  // A cancelled resolution stops before its first iteration
+  lControl.cancel();
+  RMOL::FlagVector_T lCancelledBasicFlagList;
+  BOOST_CHECK (solveSampleLP (10.0, 8.0, 20.0, lCancelledBasicFlagList,
+                              lDualSimplex, &lControl) == false);
+  BOOST_CHECK (lDualSimplex.isInterrupted() == true);
+  BOOST_CHECK (lDualSimplex.isOptimal() == false);
+  BOOST_CHECK (lDualSimplex.isInfeasible() == false);
+  BOOST_CHECK_EQUAL (lDualSimplex.getNbOfIterations(), 0);
+
+  // So does a resolution the deadline of which has passed
+  RMOL::OptimisationControl lLateControl;
+  lLateControl.setDeadline (RMOL::OptimisationControl::Clock_T::now()
+                            - std::chrono::seconds (1));
+  RMOL::FlagVector_T lLateBasicFlagList;
+  BOOST_CHECK (solveSampleLP (10.0, 8.0, 20.0, lLateBasicFlagList,
+                              lDualSimplex, &lLateControl) == false);
+  BOOST_CHECK (lDualSimplex.isInterrupted() == true);
+}
+
+/**
+ * Test that the convex hull of the MRT keeps the policies lying on its
+ * segments, and the policy of greatest total revenue among the ones of
+ * equal demand, as the former greedy walk does over the policies sorted
+ * by demand
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_mrt_convex_hull) {
+  // Policies, by increasing demand: A and B lie on a same segment from
+  // the empty policy, B, D and E on another one; C has the demand of B,
+  // F is a copy of E, I lies under the hull and H is past its peak.
+  PolicyPointList_T lPolicyPointList;
+  addPolicyPoint (-1, 0.0, 0.0, lPolicyPointList);
+  addPolicyPoint (0, 2.0, 200.0, lPolicyPointList);   // A
+  addPolicyPoint (1, 3.0, 100.0, lPolicyPointList);   // I
+  addPolicyPoint (2, 4.0, 400.0, lPolicyPointList);   // B
+  addPolicyPoint (3, 4.0, 300.0, lPolicyPointList);   // C
+  addPolicyPoint (4, 6.0, 560.0, lPolicyPointList);   // D
+  addPolicyPoint (5, 8.0, 720.0, lPolicyPointList);   // E
+  addPolicyPoint (6, 8.0, 720.0, lPolicyPointList);   // F
+  addPolicyPoint (7, 10.0, 760.0, lPolicyPointList);  // G
+  addPolicyPoint (8, 12.0, 700.0, lPolicyPointList);  // H
+
+  PolicyPointList_T lGreedyConvexHull;
+  buildGreedyConvexHull (lPolicyPointList, lGreedyConvexHull);
+  PolicyPointList_T lConvexHull;
+  RMOL::MarginalRevenueTransformation::buildConvexHull (lPolicyPointList,
+                                                        lConvexHull);
+  checkSameConvexHull (lConvexHull, lGreedyConvexHull);
+
+  // Empty policy, A, B, D, E and G
+  BOOST_REQUIRE_EQUAL (lConvexHull.size(), 6);
+  const double lExpectedDemands[] = { 0.0, 2.0, 4.0, 6.0, 8.0, 10.0 };
+  for (unsigned int idx = 0; idx < lConvexHull.size(); ++idx) {
+    BOOST_CHECK_EQUAL (lConvexHull[idx]._demand, lExpectedDemands[idx]);
+  }
+  // Among the copies of equal demand and total revenue, the first one
+  BOOST_CHECK_EQUAL (lConvexHull[4]._policyCode.front()._classIndex, 5);
+
+  // All the policies are nested in the ones of greater demand, so that
+  // the nested convex hull is the same
+  PolicyPointList_T lNestedConvexHull;
+  RMOL::MarginalRevenueTransformation::
+    buildNestedConvexHull (lPolicyPointList, lNestedConvexHull);
+  checkSameConvexHull (lNestedConvexHull, lConvexHull);
+
+  // The hull does not depend on the order of the list (the empty policy
+  // excepted), whereas the greedy walk over an unsorted list may skip
+  // the policies lying on a segment: B is reached before A
+  PolicyPointList_T lReversedPolicyPointList (1, lPolicyPointList.front());
+  lReversedPolicyPointList.insert (lReversedPolicyPointList.end(),
+                                   lPolicyPointList.rbegin(),
+                                   lPolicyPointList.rend() - 1);
+  PolicyPointList_T lReversedConvexHull;
+  RMOL::MarginalRevenueTransformation::
+    buildConvexHull (lReversedPolicyPointList, lReversedConvexHull);
+  checkSameConvexHull (lReversedConvexHull, lConvexHull);
+  buildGreedyConvexHull (lReversedPolicyPointList, lGreedyConvexHull);
+  BOOST_REQUIRE_EQUAL (lGreedyConvexHull.size(), 4);
+  BOOST_CHECK_EQUAL (lGreedyConvexHull[1]._demand, 4.0);
+}
+
+/**
+ * Test that the encoded versions of isNested, diffBetweenTwoPolicies and
+ * computeLastNode agree with the ones comparing the booking classes of
+ * the policies
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_policy_encoding) {
+  stdair::SegmentCabin& lSegmentCabin = buildFareFamilyCabin (true);
+  RMOL::PolicyCodeTable lPolicyCodeTable;
+  lPolicyCodeTable.build (lSegmentCabin);
+  BOOST_REQUIRE_EQUAL (lPolicyCodeTable.getNbOfFareFamilies(), 2);
+
+  const stdair::PolicyList_T& lPolicyList =
+    stdair::BomManager::getList<stdair::Policy> (lSegmentCabin);
+  BOOST_REQUIRE_EQUAL (lPolicyList.size(), 13);
+  unsigned int lNbOfNestedPairs = 0;
+  for (stdair::PolicyList_T::const_iterator itFirst = lPolicyList.begin();
+       itFirst != lPolicyList.end(); ++itFirst) {
+    const stdair::Policy& lFirstPolicy = **itFirst;
+    const RMOL::PolicyCodeTable::PolicyCode_T& lFirstCode =
+      lPolicyCodeTable.getPolicyCode (lFirstPolicy);
+    const bool isEmptyPolicy =
+      !stdair::BomManager::hasList<stdair::BookingClass> (lFirstPolicy);
+    BOOST_CHECK_EQUAL (lFirstCode.empty(), isEmptyPolicy);
+
+    for (stdair::PolicyList_T::const_iterator itSecond = lPolicyList.begin();
+         itSecond != lPolicyList.end(); ++itSecond) {
+      const stdair::Policy& lSecondPolicy = **itSecond;
+      const RMOL::PolicyCodeTable::PolicyCode_T& lSecondCode =
+        lPolicyCodeTable.getPolicyCode (lSecondPolicy);
+      BOOST_CHECK_EQUAL (RMOL::PolicyHelper::isNested (lFirstCode,
+                                                       lSecondCode),
+                         RMOL::PolicyHelper::isNested (lFirstPolicy,
+                                                       lSecondPolicy));
+
+      // The difference is taken, as along the nested convex hull, between
+      // a policy and one of lower demand nested under it.
+      if (isEmptyPolicy == true
+          || lSecondPolicy.getDemand() > lFirstPolicy.getDemand()
+          || RMOL::PolicyHelper::isNested (lSecondPolicy,
+                                           lFirstPolicy) == false) {
+        continue;
+      }
+      ++lNbOfNestedPairs;
+      stdair::NestingNode& lNode = createNestingNode();
+      RMOL::PolicyHelper::diffBetweenTwoPolicies (lNode, lFirstCode,
+                                                  lSecondCode,
+                                                  lPolicyCodeTable);
+      stdair::NestingNode& lExpectedNode = createNestingNode();
+      RMOL::PolicyHelper::diffBetweenTwoPolicies (lExpectedNode, lFirstPolicy,
+                                                  lSecondPolicy);
+      checkSameClassList (lNode, lExpectedNode);
+    }
+
+    // Last node, made of the classes the policy leaves closed
+    if (isEmptyPolicy == true) {
+      continue;
+    }
+    stdair::NestingNode& lNode = createNestingNode();
+    RMOL::PolicyHelper::computeLastNode (lNode, lFirstCode, lPolicyCodeTable);
+    stdair::NestingNode& lExpectedNode = createNestingNode();
+    RMOL::PolicyHelper::computeLastNode (lExpectedNode, lFirstPolicy,
+                                         lSegmentCabin);
+    checkSameClassList (lNode, lExpectedNode);
+    BOOST_CHECK_EQUAL (lNode.getYield(), lExpectedNode.getYield());
+  }
+
+  // The policies opening the first fare family nest the empty policy and
+  // the ones opening the same or a higher class (3 + 6 pairs). The ones
+  // opening both fare families nest the empty policy, the ones opening
+  // the same or a higher class of the first fare family (9 + 18 pairs),
+  // and the ones opening the same or higher classes of both (36 pairs)
+  BOOST_CHECK_EQUAL (lNbOfNestedPairs, 3 + 6 + 9 + 18 + 36);
+}
+
+/**
+ * Test that the MRT gives the same adjusted yields and demands, whether
+ * the policies of a fare-family cabin have been built by the inventory
+ * or are generated out of its fare families
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_mrt_generated_policies) {
+  stdair::SegmentCabin& lMaterialisedCabin = buildFareFamilyCabin (true);
+  stdair::SegmentCabin& lGeneratedCabin = buildFareFamilyCabin (false);
+  BOOST_REQUIRE (RMOL::MarginalRevenueTransformation::
+                 prepareDemandInput (lMaterialisedCabin) == true);
+  BOOST_REQUIRE (RMOL::MarginalRevenueTransformation::
+                 prepareDemandInput (lGeneratedCabin) == true);
+
+  const stdair::BookingClassList_T& lMaterialisedBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lMaterialisedCabin);
+  const stdair::BookingClassList_T& lGeneratedBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lGeneratedCabin);
+  BOOST_REQUIRE_EQUAL (lMaterialisedBCList.size(), lGeneratedBCList.size());
+  unsigned int lNbOfPositiveYields = 0;
+  stdair::BookingClassList_T::const_iterator itGeneratedBC =
+    lGeneratedBCList.begin();
+  for (stdair::BookingClassList_T::const_iterator itMaterialisedBC =
+         lMaterialisedBCList.begin();
+       itMaterialisedBC != lMaterialisedBCList.end();
+       ++itMaterialisedBC, ++itGeneratedBC) {
+    const stdair::BookingClass& lMaterialisedBC = **itMaterialisedBC;
+    const stdair::BookingClass& lGeneratedBC = **itGeneratedBC;
+    BOOST_CHECK_EQUAL (lGeneratedBC.describeKey(),
+                       lMaterialisedBC.describeKey());
+    BOOST_CHECK_CLOSE (lGeneratedBC.getAdjustedYield(),
+                       lMaterialisedBC.getAdjustedYield(), 1e-9);
+    BOOST_CHECK_CLOSE (lGeneratedBC.getMean(), lMaterialisedBC.getMean(),
+                       1e-9);
+    BOOST_CHECK_CLOSE (lGeneratedBC.getStdDev(),
+                       lMaterialisedBC.getStdDev(), 1e-9);
+    if (lGeneratedBC.getAdjustedYield() > 0.0) {
+      ++lNbOfPositiveYields;
+    }
+  }
+  // The hull goes through several policies
+  BOOST_CHECK (lNbOfPositiveYields > 1);
+
+  // The policies of the hull are recorded for the materialised policies
+  // only
+  BOOST_CHECK (lMaterialisedCabin.getConvexHull().empty() == false);
+  BOOST_CHECK (lGeneratedCabin.getConvexHull().empty() == true);
+}
+
+/**
+ * Test that repeated pre-optimisations of a cabin reuse the nodes of its
+ * yield-based nesting structure, without creating new ones
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_mrt_nesting_node_pool) {
+  stdair::SegmentCabin& lSegmentCabin = buildFareFamilyCabin (false);
+  const stdair::SimpleNestingStructure& lNestingStructure = stdair::
+    BomManager::getObject<stdair::SimpleNestingStructure>
+    (lSegmentCabin, stdair::YIELD_BASED_NESTING_STRUCTURE_CODE);
+
+  // The first pre-optimisation grows the pool from its single node
+  BOOST_REQUIRE (RMOL::MarginalRevenueTransformation::
+                 prepareDemandInput (lSegmentCabin) == true);
+  const stdair::NestingNodeList_T lPooledNodeList =
+    stdair::BomManager::getList<stdair::NestingNode> (lNestingStructure);
+  BOOST_CHECK (lPooledNodeList.size() > 1);
+
+  for (unsigned int lPass = 0; lPass < 3; ++lPass) {
+    BOOST_REQUIRE (RMOL::MarginalRevenueTransformation::
+                   prepareDemandInput (lSegmentCabin) == true);
+    const stdair::NestingNodeList_T& lNodeList =
+      stdair::BomManager::getList<stdair::NestingNode> (lNestingStructure);
+    BOOST_REQUIRE_EQUAL (lNodeList.size(), lPooledNodeList.size());
+    BOOST_CHECK (std::equal (lNodeList.begin(), lNodeList.end(),
+                             lPooledNodeList.begin()));
+
+    // Each class of the cabin is in a single node
+    unsigned int lNbOfClasses = 0;
+    for (stdair::NestingNodeList_T::const_iterator itNode =
+           lNodeList.begin(); itNode != lNodeList.end(); ++itNode) {
+      const stdair::NestingNode& lNode = **itNode;
+      if (stdair::BomManager::hasList<stdair::BookingClass> (lNode)) {
+        lNbOfClasses +=
+          stdair::BomManager::getList<stdair::BookingClass> (lNode).size();
+      }
+    }
+    BOOST_CHECK_EQUAL (lNbOfClasses, 6);
+  }
+}
+
+/**
+ * Test the fare-adjusted yields of the classes of a fare-family cabin
+ * against their marginal revenues, computed by hand within each fare
+ * family: (y_c.Q_c - y_{c-1}.Q_{c-1}) / (Q_c - Q_{c-1})
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_fare_adjustment) {
+  stdair::SegmentCabin& lSegmentCabin = buildFareFamilyCabin (false);
+  BOOST_REQUIRE (RMOL::FareAdjustment::adjustYield (lSegmentCabin) == true);
+
+  // Y, B, M, then H, Q, K
+  const double lExpectedYields[] = { 1000.0, (800.0*4 - 1000.0*2) / (4 - 2),
+                                     (600.0*7 - 800.0*4) / (7 - 4),
+                                     400.0, (300.0*6 - 400.0*3) / (6 - 3),
+                                     (200.0*10 - 300.0*6) / (10 - 6) };
+  const stdair::BookingClassList_T& lBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lSegmentCabin);
+  BOOST_REQUIRE_EQUAL (lBCList.size(), 6);
+  unsigned int idx = 0;
+  for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+       itBC != lBCList.end(); ++itBC, ++idx) {
+    const stdair::BookingClass& lBC = **itBC;
+    BOOST_CHECK_CLOSE (lBC.getAdjustedYield(), lExpectedYields[idx], 1e-9);
+  }
+}
+
+/**
+ * Test that the MRT pre-optimisation of a cabin without fare family
+ * falls back on the fare adjustment, against hand-computed marginal
+ * revenues (floored at zero)
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_mrt_without_fare_families) {
+  const stdair::FlightDateKey lFlightDateKey (10, stdair::Date_T (2011, 6, 10));
+  stdair::FlightDate& lFlightDate =
+    stdair::FacBom<stdair::FlightDate>::instance().create (lFlightDateKey);
+  stdair::SegmentDate& lSegmentDate =
+    addSegmentDate (lFlightDate, "LHR", "JFK",
+                    std::vector<stdair::LegCabin*>());
+  const stdair::SegmentCabinKey lSegmentCabinKey ("Y");
+  stdair::SegmentCabin& lSegmentCabin =
+    stdair::FacBom<stdair::SegmentCabin>::instance().create (lSegmentCabinKey);
+  stdair::FacBomManager::addToListAndMap (lSegmentDate, lSegmentCabin);
+  stdair::FacBomManager::linkWithParent (lSegmentDate, lSegmentCabin);
+
+  // The sell-up of K makes its marginal revenue negative
+  const char* lClassCodes[] = { "Y", "B", "M", "K" };
+  const double lYields[] = { 1000.0, 800.0, 600.0, 200.0 };
+  const double lCumuPriceDemMeans[] = { 2.0, 4.0, 7.0, 7.5 };
+  const double lExpectedYields[] = { 1000.0, (800.0*4 - 1000.0*2) / (4 - 2),
+                                     (600.0*7 - 800.0*4) / (7 - 4), 0.0 };
+  for (unsigned int c = 0; c < 4; ++c) {
+    const stdair::BookingClassKey lBookingClassKey (lClassCodes[c]);
+    stdair::BookingClass& lBookingClass =
+      stdair::FacBom<stdair::BookingClass>::instance().create(lBookingClassKey);
+    stdair::FacBomManager::addToListAndMap (lSegmentCabin, lBookingClass);
+    stdair::FacBomManager::linkWithParent (lSegmentCabin, lBookingClass);
+    lBookingClass.setYield (lYields[c]);
+    lBookingClass.setCumuPriceDemMean (lCumuPriceDemMeans[c]);
+    lBookingClass.setCumuPriceDemStdDev (std::sqrt (lCumuPriceDemMeans[c]));
+  }
+  BOOST_REQUIRE (lSegmentCabin.getFareFamilyStatus() == false);
+
+  const stdair::PreOptimisationMethod
+    lPreOptimisationMethod (stdair::PreOptimisationMethod::MRT);
+  BOOST_REQUIRE (RMOL::PreOptimiser::preOptimise (lFlightDate,
+                                                  lPreOptimisationMethod)
+                 == true);
+
+  const stdair::BookingClassList_T& lBCList =
+    stdair::BomManager::getList<stdair::BookingClass> (lSegmentCabin);
+  unsigned int idx = 0;
+  for (stdair::BookingClassList_T::const_iterator itBC = lBCList.begin();
+       itBC != lBCList.end(); ++itBC, ++idx) {
+    const stdair::BookingClass& lBC = **itBC;
+    if (lExpectedYields[idx] == 0.0) {
+      BOOST_CHECK_SMALL (lBC.getAdjustedYield(), 1e-9);
+    } else {
+      BOOST_CHECK_CLOSE (lBC.getAdjustedYield(), lExpectedYields[idx], 1e-9);
+    }
+  }
+}
+
+/**
+ * Test that the leg optimisation by EMSR gives the bid prices and the
+ * protections of the BOM optimiser, on the classes of sample2.csv
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_optimiser_emsr) {
+  const unsigned int lCapacity = 100;
+  stdair::LegCabin& lLegCabin =
+    buildVirtualClassLegCabin (SAMPLE2_NB_OF_CLASSES, SAMPLE2_YIELDS,
+                               SAMPLE2_MEANS, SAMPLE2_STDDEVS, lCapacity);
+  RMOL::Optimiser::heuristicOptimisationByEmsr (lLegCabin);
+
+  RMOL::LegOptimisationWorkspace lWorkspace;
+  std::vector<double> lProtectionList (SAMPLE2_NB_OF_CLASSES);
+  std::vector<double> lBidPriceList (lCapacity);
+  RMOL::LegOptimiser::optimise (RMOL::OptimizationType::HEUR_EMSR,
+                                SAMPLE2_NB_OF_CLASSES, SAMPLE2_YIELDS,
+                                SAMPLE2_MEANS, SAMPLE2_STDDEVS, lCapacity, 0,
+                                lWorkspace, &lProtectionList[0],
+                                &lBidPriceList[0]);
+
+  const stdair::BidPriceVector_T& lBPV = lLegCabin.getBidPriceVector();
+  BOOST_REQUIRE_EQUAL (lBPV.size(), lCapacity);
+  for (unsigned int k = 0; k < lCapacity; ++k) {
+    BOOST_CHECK_CLOSE (lBidPriceList[k], lBPV[k], 1e-9);
+  }
+  const stdair::VirtualClassList_T& lVirtualClassList =
+    lLegCabin.getVirtualClassList();
+  stdair::VirtualClassList_T::const_iterator itVC = lVirtualClassList.begin();
+  for (unsigned int j = 0; j + 1 < SAMPLE2_NB_OF_CLASSES; ++j, ++itVC) {
+    BOOST_CHECK_EQUAL (lProtectionList[j], itVC->getCumulatedProtection());
+  }
+}
+
+/**
+ * Test that the leg optimisations by EMSR-a and EMSR-b give the
+ * protections of the BOM optimisers, bounded by the capacity and made
+ * non-decreasing: on the classes of sample2.csv (with a capacity large
+ * enough, then too small), and on classes of close yields, whose
+ * quantiles are negative or decreasing
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_optimiser_emsr_a_b) {
+  const double lYields[] = { 100.0, 99.0, 98.0 };
+  const double lMeans[] = { 20.0, 1.0, 10.0 };
+  const double lStdDevs[] = { 1.0, 10.0, 1.0 };
+  const RMOL::OptimizationType::EN_OptimizationType lOptimizationTypes[] =
+    { RMOL::OptimizationType::HEUR_EMSRA, RMOL::OptimizationType::HEUR_EMSRB };
+  for (unsigned int t = 0; t < 2; ++t) {
+    checkBoundedProtections (lOptimizationTypes[t], SAMPLE2_NB_OF_CLASSES,
+                             SAMPLE2_YIELDS, SAMPLE2_MEANS, SAMPLE2_STDDEVS,
+                             100);
+    checkBoundedProtections (lOptimizationTypes[t], SAMPLE2_NB_OF_CLASSES,
+                             SAMPLE2_YIELDS, SAMPLE2_MEANS, SAMPLE2_STDDEVS,
+                             30);
+    checkBoundedProtections (lOptimizationTypes[t], 3, lYields, lMeans,
+                             lStdDevs, 50);
+  }
+}
+
+/**
+ * Test that the leg optimisation by Monte-Carlo integration gives the
+ * bid prices and the protections of the BOM optimiser, on the classes
+ * of sample2.csv: as the demands of each class are drawn with the same
+ * seed, they are the same to the last bit
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_optimiser_monte_carlo) {
+  const unsigned int lCapacity = 100;
+  const stdair::NbOfSamples_T lNbOfSamples =
+    RMOL::DEFAULT_NUMBER_OF_DRAWS_FOR_MC_SIMULATION;
+  stdair::LegCabin& lLegCabin =
+    buildVirtualClassLegCabin (SAMPLE2_NB_OF_CLASSES, SAMPLE2_YIELDS,
+                               SAMPLE2_MEANS, SAMPLE2_STDDEVS, lCapacity);
+  RMOL::Optimiser::optimalOptimisationByMCIntegration (lNbOfSamples,
+                                                       lLegCabin);
+
+  RMOL::LegOptimisationWorkspace lWorkspace;
+  std::vector<double> lProtectionList (SAMPLE2_NB_OF_CLASSES);
+  std::vector<double> lBidPriceList (lCapacity);
+  RMOL::LegOptimiser::optimise (RMOL::OptimizationType::OPT_MC,
+                                SAMPLE2_NB_OF_CLASSES, SAMPLE2_YIELDS,
+                                SAMPLE2_MEANS, SAMPLE2_STDDEVS, lCapacity,
+                                lNbOfSamples, lWorkspace, &lProtectionList[0],
+                                &lBidPriceList[0]);
+
+  const stdair::BidPriceVector_T& lBPV = lLegCabin.getBidPriceVector();
+  BOOST_REQUIRE_EQUAL (lBPV.size(), lCapacity);
+  for (unsigned int k = 0; k < lCapacity; ++k) {
+    BOOST_CHECK_EQUAL (lBidPriceList[k], lBPV[k]);
+  }
+  const stdair::VirtualClassList_T& lVirtualClassList =
+    lLegCabin.getVirtualClassList();
+  stdair::VirtualClassList_T::const_iterator itVC = lVirtualClassList.begin();
+  for (unsigned int j = 0; j + 1 < SAMPLE2_NB_OF_CLASSES; ++j, ++itVC) {
+    BOOST_CHECK_EQUAL (lProtectionList[j], itVC->getCumulatedProtection());
+  }
+}
+
+/**
+ * Test the leg optimisation by dynamic programming against values
+ * computed by hand, for deterministic demands: 2 seats at 100, 3 at 60
+ * and 10 at 30, with 6 seats. The classes 0 to j are protected as long
+ * as a seat is worth more than the next yield, i.e., 2 seats, then 5;
+ * the bid prices are the yields of the classes selling the seats
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_optimiser_dp) {
+  const double lYields[] = { 100.0, 60.0, 30.0 };
+  const double lMeans[] = { 2.0, 3.0, 10.0 };
+  const double lStdDevs[] = { 0.0, 0.0, 0.0 };
+  const double lExpectedProtections[] = { 2.0, 5.0, 6.0 };
+  const double lExpectedBidPrices[] = { 100.0, 100.0, 60.0, 60.0, 60.0, 30.0 };
+
+  RMOL::LegOptimisationWorkspace lWorkspace;
+  std::vector<double> lProtectionList (3);
+  std::vector<double> lBidPriceList (6);
+  RMOL::LegOptimiser::optimise (RMOL::OptimizationType::OPT_DP, 3, lYields,
+                                lMeans, lStdDevs, 6, 0, lWorkspace,
+                                &lProtectionList[0], &lBidPriceList[0]);
+  for (unsigned int j = 0; j < 3; ++j) {
+    BOOST_CHECK_EQUAL (lProtectionList[j], lExpectedProtections[j]);
+  }
+  for (unsigned int k = 0; k < 6; ++k) {
+    BOOST_CHECK_CLOSE (lBidPriceList[k], lExpectedBidPrices[k], 1e-9);
+  }
+}
+
+/**
+ * Test that the batch leg optimisation gives, for each problem, the
+ * protections and bid prices of its own optimisation (the seats beyond
+ * its capacity being priced 0), whatever the number of threads
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_leg_optimiser_batch) {
+  // sample2.csv with 100 seats, then two smaller problems
+  const unsigned int lNbOfProblems = 3;
+  const unsigned int lClassOffsets[] = { 0, 4, 7, 9 };
+  const double lYields[] = { 1050.0, 567.0, 534.0, 520.0,
+                             100.0, 60.0, 30.0, 500.0, 200.0 };
+  const double lMeans[] = { 17.3, 45.1, 39.6, 34.0, 2.0, 3.0, 10.0,
+                            20.0, 30.0 };
+  const double lStdDevs[] = { 5.8, 15.0, 13.2, 11.3, 1.0, 1.0, 2.0,
+                              5.0, 8.0 };
+  const unsigned int lCapacities[] = { 100, 6, 40 };
+  const unsigned int lMaxCapacity = 100;
+  const unsigned int lNbOfClasses = lClassOffsets[lNbOfProblems];
+  RMOL::LegOptimisationBatch lBatch;
+  lBatch._nbOfProblems = lNbOfProblems;
+  lBatch._classOffsetList = lClassOffsets;
+  lBatch._yieldList = lYields;
+  lBatch._meanList = lMeans;
+  lBatch._stdDevList = lStdDevs;
+  lBatch._capacityList = lCapacities;
+
+  const stdair::NbOfSamples_T lNbOfSamples =
+    RMOL::DEFAULT_NUMBER_OF_DRAWS_FOR_MC_SIMULATION;
+  const RMOL::OptimizationType::EN_OptimizationType lOptimizationTypes[] =
+    { RMOL::OptimizationType::OPT_MC, RMOL::OptimizationType::OPT_DP,
+      RMOL::OptimizationType::HEUR_EMSR, RMOL::OptimizationType::HEUR_EMSRA,
+      RMOL::OptimizationType::HEUR_EMSRB };
+  for (unsigned int t = 0; t < 5; ++t) {
+    const RMOL::OptimizationType::EN_OptimizationType& lOptimizationType =
+      lOptimizationTypes[t];
+
+    // The matrix is filled beforehand, so that the padding is checked.
+    std::vector<double> lProtectionList (lNbOfClasses, -1.0);
+    std::vector<double> lBidPriceMatrix (lNbOfProblems * lMaxCapacity, -1.0);
+    RMOL::LegOptimiser::optimiseBatch (lBatch, lOptimizationType,
+                                       lNbOfSamples, lMaxCapacity, 1,
+                                       &lProtectionList[0],
+                                       &lBidPriceMatrix[0]);
+
+    RMOL::LegOptimisationWorkspace lWorkspace;
+    for (unsigned int i = 0; i < lNbOfProblems; ++i) {
+      const unsigned int& lOffset = lClassOffsets[i];
+      const unsigned int lNbOfProblemClasses = lClassOffsets[i + 1] - lOffset;
+      const unsigned int& lCapacity = lCapacities[i];
+      std::vector<double> lExpectedProtectionList (lNbOfProblemClasses);
+      std::vector<double> lExpectedBidPriceList (lCapacity);
+      RMOL::LegOptimiser::optimise (lOptimizationType, lNbOfProblemClasses,
+                                    lYields + lOffset, lMeans + lOffset,
+                                    lStdDevs + lOffset, lCapacity,
+                                    lNbOfSamples, lWorkspace,
+                                    &lExpectedProtectionList[0],
+                                    &lExpectedBidPriceList[0]);
+      for (unsigned int j = 0; j < lNbOfProblemClasses; ++j) {
+        BOOST_CHECK_EQUAL (lProtectionList[lOffset + j],
+                           lExpectedProtectionList[j]);
+      }
+      const double* lBPV = &lBidPriceMatrix[i * lMaxCapacity];
+      for (unsigned int k = 0; k < lCapacity; ++k) {
+        BOOST_CHECK_EQUAL (lBPV[k], lExpectedBidPriceList[k]);
+      }
+      for (unsigned int k = lCapacity; k < lMaxCapacity; ++k) {
+        BOOST_CHECK_EQUAL (lBPV[k], 0.0);
+      }
+    }
+
+    // The results do not depend on the number of threads.
+    for (unsigned int lNbOfThreads = 2; lNbOfThreads <= 4; ++lNbOfThreads) {
+      std::vector<double> lThreadProtectionList (lNbOfClasses, -1.0);
+      std::vector<double> lThreadBidPriceMatrix (lNbOfProblems * lMaxCapacity,
+                                                 -1.0);
+      RMOL::LegOptimiser::optimiseBatch (lBatch, lOptimizationType,
+                                         lNbOfSamples, lMaxCapacity,
+                                         lNbOfThreads,
+                                         &lThreadProtectionList[0],
+                                         &lThreadBidPriceMatrix[0]);
+      BOOST_CHECK (lThreadProtectionList == lProtectionList);
+      BOOST_CHECK (lThreadBidPriceMatrix == lBidPriceMatrix);
+    }
+  }
+}
+
 // End the test suite
+/**
+ * Test that an asynchronous optimisation, cancelled or the deadline of
+ * which has passed, stops before forecasting, and leaves the bid prices
+ * of the flight-date untouched
+ */
+BOOST_AUTO_TEST_CASE (rmol_optimisation_async_control) {
+  // The optimisation logs through the StdAir service
+  std::ofstream logOutputFile;
+  logOutputFile.open ("OptimiseTestSuite_async_control.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  RMOL::RMOL_Service rmolService (lLogParams);
+
+  stdair::BomRoot& lBomRoot =
+    stdair::FacBom<stdair::BomRoot>::instance().create();
+  const stdair::InventoryKey lInventoryKey ("BA");
+  stdair::Inventory& lInventory =
+    stdair::FacBom<stdair::Inventory>::instance().create (lInventoryKey);
+  stdair::FacBomManager::addToList (lBomRoot, lInventory);
+  stdair::FacBomManager::linkWithParent (lBomRoot, lInventory);
+  stdair::FlightDate& lFlightDate = buildSampleFlightDate (lInventory, 10);
+
+  // Bid prices before the optimisation
+  std::vector<stdair::LegCabin*> lLCList;
+  const stdair::LegDateList_T& lLDList =
+    stdair::BomManager::getList<stdair::LegDate> (lFlightDate);
+  for (stdair::LegDateList_T::const_iterator itLD = lLDList.begin();
+       itLD != lLDList.end(); ++itLD) {
+    const stdair::LegCabinList_T& lLegCabinList =
+      stdair::BomManager::getList<stdair::LegCabin> (**itLD);
+    lLCList.insert (lLCList.end(), lLegCabinList.begin(),
+                    lLegCabinList.end());
+  }
+  BOOST_REQUIRE_EQUAL (lLCList.size(), 2);
+  std::vector<stdair::BidPriceVector_T> lBPVList;
+  std::vector<stdair::BidPrice_T> lBidPriceList;
+  for (unsigned int lLCIdx = 0; lLCIdx < lLCList.size(); ++lLCIdx) {
+    lBPVList.push_back (lLCList[lLCIdx]->getBidPriceVector());
+    lBidPriceList.push_back (lLCList[lLCIdx]->getCurrentBidPrice());
+  }
+
+  const stdair::DateTime_T lRMEventTime (stdair::Date_T (2011, 5, 20),
+                                         stdair::Duration_T (0, 0, 0));
+  const stdair::UnconstrainingMethod
+    lUnconstrainingMethod (stdair::UnconstrainingMethod::EM);
+  const stdair::ForecastingMethod
+    lForecastingMethod (stdair::ForecastingMethod::Q_FORECASTING);
+  const stdair::PreOptimisationMethod
+    lPreOptimisationMethod (stdair::PreOptimisationMethod::NONE);
+  const stdair::OptimisationMethod
+    lOptimisationMethod (stdair::OptimisationMethod::LEG_BASED_MC);
+  const stdair::PartnershipTechnique
+    lPartnershipTechnique (stdair::PartnershipTechnique::NONE);
+
+  // A cancelled optimisation, and one the deadline of which has passed
+  RMOL::OptimisationControl lCancelledControl;
+  lCancelledControl.cancel();
+  RMOL::OptimisationControl lLateControl;
+  lLateControl.setDeadline (RMOL::OptimisationControl::Clock_T::now()
+                            - std::chrono::seconds (1));
+  BOOST_CHECK (lLateControl.isCancelled() == false);
+  BOOST_CHECK (lLateControl.isStopRequested() == true);
+  RMOL::OptimisationControl* lControls[] = { &lCancelledControl,
+                                             &lLateControl };
+  for (unsigned int i = 0; i < 2; ++i) {
+    RMOL::OptimisationControl& lControl = *lControls[i];
+    BOOST_CHECK (lControl.isInterrupted() == false);
+    std::future<bool> lResult =
+      rmolService.optimiseAsync (lFlightDate, lRMEventTime,
+                                 lUnconstrainingMethod, lForecastingMethod,
+                                 lPreOptimisationMethod, lOptimisationMethod,
+                                 lPartnershipTechnique, lControl);
+    BOOST_CHECK (lResult.get() == false);
+    BOOST_CHECK (lControl.isInterrupted() == true);
+
+    for (unsigned int lLCIdx = 0; lLCIdx < lLCList.size(); ++lLCIdx) {
+      const stdair::LegCabin& lLegCabin = *lLCList[lLCIdx];
+      BOOST_CHECK (lLegCabin.getBidPriceVector() == lBPVList[lLCIdx]);
+      BOOST_CHECK_EQUAL (lLegCabin.getCurrentBidPrice(),
+                         lBidPriceList[lLCIdx]);
+    }
+  }
+
+  // A time budget still running does not stop anything
+  RMOL::OptimisationControl lBudgetControl;
+  lBudgetControl.setTimeBudget (std::chrono::hours (1));
+  BOOST_CHECK (lBudgetControl.hasDeadline() == true);
+  BOOST_CHECK (lBudgetControl.isStopRequested() == false);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 /*!
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <vector>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
@@ -21,6 +22,11 @@
 #include <stdair/service/Logger.hpp>
 // RMOL
 #include <rmol/RMOL_Service.hpp>
+#include <rmol/bom/HistoricalBooking.hpp>
+#include <rmol/bom/HistoricalBookingHolder.hpp>
+#include <rmol/bom/HistoricalBookingMatrix.hpp>
+#include <rmol/bom/HistoricalBookingWindow.hpp>
+#include <rmol/bom/EMDetruncator.hpp>
 
 namespace boost_utf = boost::unit_test;
 
@@ -71,6 +77,101 @@ BOOST_AUTO_TEST_CASE (rmol_unconstraining_em) {
                        << "more details");
 }
 
+/**
+ * Test that the batch version of the Expectation-Maximisation (EM) algorithm
+ * gives the same results as the series-by-series version
+ */
+BOOST_AUTO_TEST_CASE (rmol_unconstraining_em_batch) {
+  // Historical bookings and censorship flags of a few series
+  const short lNbOfSeries = 3;
+  const short lNbOfFlights = 8;
+  const double lBookings[lNbOfSeries][lNbOfFlights] = {
+    { 12.0, 15.0, 9.0, 20.0, 20.0, 11.0, 20.0, 14.0 },
+    { 3.0, 5.0, 5.0, 2.0, 7.0, 5.0, 4.0, 6.0 },
+    { 30.0, 25.0, 28.0, 30.0, 22.0, 30.0, 27.0, 24.0 } };
+  const bool lFlags[lNbOfSeries][lNbOfFlights] = {
+    { false, false, false, true, true, false, true, false },
+    { false, true, true, false, false, true, false, false },
+    { true, false, false, true, false, true, false, false } };
+
+  // Unconstrain each series on its own, and gather all of them
+  // into the matrix
+  std::vector<RMOL::HistoricalBookingHolder> lHBHolderList (lNbOfSeries);
+  RMOL::HistoricalBookingMatrix lHBMatrix;
+  for (short s = 0; s < lNbOfSeries; ++s) {
+    RMOL::HistoricalBookingHolder& lHBHolder = lHBHolderList[s];
+    for (short i = 0; i < lNbOfFlights; ++i) {
+      const RMOL::HistoricalBooking lHistoricalBkg (lBookings[s][i],
+                                                    lFlags[s][i]);
+      lHBHolder.addHistoricalBooking (lHistoricalBkg);
+    }
+    lHBMatrix.addSeries (lHBHolder);
+    RMOL::EMDetruncator::unconstrain (lHBHolder);
+  }
+
+  // Unconstrain all the series at once, on two threads
+  RMOL::EMDetruncator::unconstrain (lHBMatrix, 2);
+
+  BOOST_REQUIRE_EQUAL (lHBMatrix.getNbOfSeries(), lNbOfSeries);
+  for (short s = 0; s < lNbOfSeries; ++s) {
+    const RMOL::HistoricalBookingHolder& lHBHolder = lHBHolderList[s];
+    BOOST_CHECK_EQUAL (lHBMatrix.getNbOfFlights (s), lNbOfFlights);
+    for (short i = 0; i < lNbOfFlights; ++i) {
+      BOOST_CHECK_EQUAL (lHBMatrix.getUnconstrainedDemand (s, i),
+                         lHBHolder.getUnconstrainedDemand (i));
+    }
+    const double lMean = lHBHolder.getDemandMean();
+    BOOST_CHECK_CLOSE (lHBMatrix.getDemandMean (s), lMean, 1e-9);
+    BOOST_CHECK_CLOSE (lHBMatrix.getStandardDeviation (s),
+                       lHBHolder.getStandardDeviation (lMean), 1e-9);
+  }
+}
+
+/**
+ * Test the sliding window of historical bookings
+ */
+BOOST_AUTO_TEST_CASE (rmol_historical_booking_window) {
+  // Historical bookings and censorship flags of the similar segments
+  const short lNbOfSegments = 10;
+  const double lBookings[lNbOfSegments] =
+    { 12.0, 15.0, 9.0, 20.0, 20.0, 11.0, 20.0, 14.0, 17.0, 8.0 };
+  const bool lFlags[lNbOfSegments] =
+    { false, false, false, true, true, false, true, false, false, false };
+
+  // Retrieval of the historical bookings, counting the segments read
+  short lNbOfReadSegments = 0;
+  const RMOL::HistoricalBookingWindow::Preparer_T lPreparer =
+    [&] (RMOL::HistoricalBookingHolder& ioHBHolder,
+         const stdair::NbOfSegments_T& iBegin,
+         const stdair::NbOfSegments_T& iEnd) {
+    for (short i = iBegin; i <= iEnd; ++i, ++lNbOfReadSegments) {
+      const RMOL::HistoricalBooking lHistoricalBkg (lBookings[i], lFlags[i]);
+      ioHBHolder.addHistoricalBooking (lHistoricalBkg);
+    }
+  };
+
+  // Slide the window (whose initial capacity is exceeded on purpose)
+  RMOL::HistoricalBookingWindow lWindow (3);
+  const short lRanges[][2] = { {0, 4}, {0, 5}, {2, 7}, {2, 7}, {3, 9},
+                               {1, 4} };
+  const short lExpectedNbOfReadSegments[] = { 5, 6, 8, 8, 10, 14 };
+  const short lNbOfRanges = 6;
+  for (short r = 0; r < lNbOfRanges; ++r) {
+    const short lBegin = lRanges[r][0];
+    const short lEnd = lRanges[r][1];
+    RMOL::HistoricalBookingHolder lHBHolder;
+    lWindow.update (lBegin, lEnd, lPreparer, lHBHolder);
+
+    BOOST_CHECK_EQUAL (lNbOfReadSegments, lExpectedNbOfReadSegments[r]);
+    BOOST_REQUIRE_EQUAL (lHBHolder.getNbOfFlights(), lEnd - lBegin + 1);
+    for (short i = 0; i < lHBHolder.getNbOfFlights(); ++i) {
+      BOOST_CHECK_EQUAL (lHBHolder.getHistoricalBooking (i),
+                         lBookings[lBegin + i]);
+      BOOST_CHECK_EQUAL (lHBHolder.getCensorshipFlag (i), lFlags[lBegin + i]);
+    }
+  }
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 